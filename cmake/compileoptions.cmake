@@ -125,6 +125,7 @@ macro(ivw_define_standard_definitions project_name target)
     target_compile_definitions(${target} PRIVATE 
         $<$<BOOL:${BUILD_SHARED_LIBS}>:INVIWO_ALL_DYN_LINK>
         $<$<BOOL:${IVW_CFG_PROFILING}>:IVW_PROFILING>
+        $<$<BOOL:${IVW_CFG_TRACING}>:IVW_TRACING>
         $<$<BOOL:${IVW_CFG_FORCE_ASSERTIONS}>:IVW_FORCE_ASSERTIONS>
         $<$<BOOL:${IVW_USE_OPENMP}>:IVW_USE_OPENMP>
         $<$<CONFIG:Debug>:IVW_DEBUG>
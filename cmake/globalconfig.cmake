@@ -170,6 +170,9 @@ include(${CMAKE_CURRENT_LIST_DIR}/compileresources.cmake)
 # Calculate and display profiling information
 option(IVW_CFG_PROFILING "Enable profiling" OFF)
 
+# Compile in the trace scopes of the built-in tracer, see inviwo/core/util/tracer.h
+option(IVW_CFG_TRACING "Enable built-in tracing, recording is turned on at runtime" ON)
+
 # Build unittest for all modules
 include(${CMAKE_CURRENT_LIST_DIR}/unittests.cmake)
 
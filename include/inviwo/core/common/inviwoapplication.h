@@ -34,6 +34,7 @@
 #include <inviwo/core/common/runtimemoduleregistration.h>
 #include <inviwo/core/util/singleton.h>
 #include <inviwo/core/util/threadpool.h>
+#include <inviwo/core/util/frontqueue.h>
 #include <inviwo/core/util/vectoroperations.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/pathtype.h>
@@ -229,8 +230,33 @@ public:
      */
     void dispatchFrontAndForget(std::function<void()> fun);
 
+    /**
+     * Enqueue a functor to be run in the GUI thread, unless a functor posted with the same
+     * \p token has not run yet. Use this for notifications that only need to report the latest
+     * state, like progress, the functor should read that state when it runs.
+     * @see FrontQueue::makeToken
+     */
+    void dispatchFrontCoalesced(const FrontQueue::Token& token, std::function<void()> fun);
+
+    /**
+     * Run the functors enqueued for the GUI thread until the queue is empty.
+     * @return the number of functors left
+     */
     virtual size_t processFront();
 
+    /**
+     * Run the functors enqueued for the GUI thread until the queue is empty or \p budget has
+     * passed. If functors are left, the post enqueue callback is called again such that the rest
+     * is run in a later iteration of the event loop.
+     * @return the number of functors left
+     */
+    size_t processFrontFor(std::chrono::microseconds budget);
+
+    /**
+     * Depth, latency, and throughput of the GUI thread queue
+     */
+    FrontQueue::Metrics getFrontQueueMetrics() const;
+
     /**
      * Get the current number of worker threads in the thread pool
      */
@@ -430,25 +456,18 @@ public:
     void setApplicationUsageMode(UsageMode mode);
 
 protected:
-    struct Queue {
-        // Task queue
-        std::queue<std::function<void()>> tasks;
-        // synchronization
-        std::mutex mutex;
-
-        // This is called after putting a task in the queue.
-        std::function<void()> postEnqueue;
-    };
-
     std::string displayName_;
     std::unique_ptr<CommandLineParser> commandLineParser_;
     std::shared_ptr<ConsoleLogger> consoleLogger_;
     std::shared_ptr<FileLogger> filelogger_;
+    std::string traceFile_;
     std::function<void(std::string)> progressCallback_;
     std::unique_ptr<FileSystemObserver> fileSystemObserver_;
 
     ThreadPool pool_;
-    Queue queue_;  // "Interaction/GUI" queue
+    FrontQueue queue_;  // "Interaction/GUI" queue
+    // This is called after putting a task in an empty queue.
+    std::function<void()> postEnqueue_;
 
     util::OnScopeExit clearAllSingeltons_;
 
@@ -545,16 +564,12 @@ auto InviwoApplication::dispatchFront(F&& f, Args&&... args)
     -> std::future<std::invoke_result_t<F, Args...>> {
     using return_type = std::invoke_result_t<F, Args...>;
 
-    auto task = std::make_shared<std::packaged_task<return_type()>>(
+    // The queue stores move only tasks, hence the packaged_task does not need to be shared
+    std::packaged_task<return_type()> task(
         std::bind(std::forward<F>(f), std::forward<Args>(args)...));
 
-    std::future<return_type> res = task->get_future();
-    {
-        std::unique_lock<std::mutex> lock(queue_.mutex);
-        queue_.tasks.emplace([task]() { (*task)(); });
-    }
-
-    if (queue_.postEnqueue) queue_.postEnqueue();
+    std::future<return_type> res = task.get_future();
+    if (queue_.push(std::move(task)) && postEnqueue_) postEnqueue_();
     return res;
 }
 
@@ -33,11 +33,15 @@
 #include <inviwo/core/datastructures/representationfactory.h>
 #include <inviwo/core/datastructures/representationconverterfactory.h>
 #include <inviwo/core/datastructures/representationfactorymanager.h>
+#include <inviwo/core/util/tracer.h>
+#include <inviwo/core/util/metriccounters.h>
 
 #include <typeindex>
 #include <mutex>
 #include <unordered_map>
 #include <memory>
+#include <vector>
+#include <algorithm>
 
 namespace inviwo {
 
@@ -80,11 +84,15 @@ namespace inviwo {
  * 1 and 2 are needed to be a vaild member type of std::vector.
  * 3 is needed for the factory pattern, 3 should be implemented using 1.
  *
+ * Copies are copy-on-write: a copy shares the valid representations of the source, and a shared
+ * representation is only cloned when one of the Data objects asks for it using
+ * getEditableRepresentation. Hence, a copy only costs memory once it diverges from the source.
+ * Representations that are invalidated while shared are dropped instead of being marked invalid,
+ * such that the other Data objects are not affected.
  *
- *
- * @note Do not use the same representation in different Data objects.
- * This can cause inconsistencies since the Data objects cannot know if
- * another one has edited the representation.
+ * @note Do not add the same representation to different Data objects, and do not modify a
+ * representation obtained from getRepresentation. The Data objects cannot know if another one has
+ * edited the representation.
  * @see Representation and RepresentationConverter
  */
 template <typename Self, typename Repr>
@@ -94,7 +102,7 @@ public:
     using repr = Repr;
 
     virtual Data<Self, Repr>* clone() const = 0;
-    virtual ~Data() = default;
+    virtual ~Data();
 
     /**
      * Get a representation of type T. If there already is a valid representation of type T, just
@@ -108,7 +116,8 @@ public:
 
     /**
      * Get an editable representation. This will invalidate all other representations.
-     * They will now have to be updated from this one before use.
+     * They will now have to be updated from this one before use. If the representation is shared
+     * with another Data object, it will first be replaced by a copy.
      * @see getRepresentation and invalidateAllOther
      */
     template <typename T>
@@ -165,6 +174,12 @@ public:
      */
     void invalidateAllOther(const Repr* repr);
 
+    /**
+     * Check if a representation is shared with another Data object, i.e. if it would be copied by
+     * getEditableRepresentation.
+     */
+    bool isShared(const Repr* representation) const;
+
 protected:
     Data() = default;
     Data(const Data<Self, Repr>& rhs);
@@ -174,12 +189,32 @@ protected:
     const T* getValidRepresentation() const;
     void copyRepresentationsTo(Data<Self, Repr>* targetData) const;
 
+    /**
+     * Prepare a representation for modification. A shared representation is replaced by a copy,
+     * and all other representations are invalidated.
+     * @return the representation to modify, the copy if one was made
+     */
+    Repr* editRepresentation(const Repr* representation);
+
+    /**
+     * Called after \p repr was handed out for modification by getEditableRepresentation, or made
+     * the only valid representation by invalidateAllOther. Override to discard anything derived
+     * from the previous content. Called without holding the lock.
+     */
+    virtual void representationModified(const Repr* repr);
+
     std::shared_ptr<Repr> addRepresentationInternal(std::shared_ptr<Repr> representation) const;
+    void invalidateAllOtherInternal(const Repr* repr);
+    bool isSharedInternal(const Repr* repr) const;
+    void pruneShared() const;
 
     mutable std::mutex mutex_;
     mutable std::unordered_map<std::type_index, std::shared_ptr<Repr>> representations_;
     // A pointer to the the most recently updated representation. Makes updates and creation faster.
     mutable std::shared_ptr<Repr> lastValidRepresentation_;
+    // All Data objects sharing a representation hold a copy of the same token, the representation
+    // is shared as long as the use count of the token is larger than one.
+    mutable std::unordered_map<const Repr*, std::shared_ptr<const void>> shared_;
 };
 
 template <typename Self, typename Repr>
@@ -195,6 +230,14 @@ Data<Self, Repr>& Data<Self, Repr>::operator=(const Data<Self, Repr>& that) {
     return *this;
 }
 
+template <typename Self, typename Repr>
+Data<Self, Repr>::~Data() {
+    // Shared representations might outlive this object, make sure they do not refer to it.
+    for (auto& elem : representations_) {
+        elem.second->releaseOwner(static_cast<const Self*>(this));
+    }
+}
+
 template <typename Self, typename Repr>
 template <typename T>
 const T* Data<Self, Repr>::getRepresentation() const {
@@ -224,7 +267,9 @@ const T* Data<Self, Repr>::getValidRepresentation() const {
     auto factory = RepresentationFactoryManager::getRepresentationConverterFactory<Repr>();
     if (auto package = factory->getRepresentationConverter(lastValidRepresentation_->getTypeIndex(),
                                                            std::type_index(typeid(T)))) {
+        IVW_TRACE_SCOPE("conversion", "Convert representation");
         for (auto converter : package->getConverters()) {
+            util::countRepresentationConversion();
             auto dest = converter->getConverterID().second;
             auto it = representations_.find(dest);
             if (it != representations_.end()) {  // Next repr. already exist, just update it
@@ -246,9 +291,7 @@ const T* Data<Self, Repr>::getValidRepresentation() const {
 template <typename Self, typename Repr>
 template <typename T>
 T* Data<Self, Repr>::getEditableRepresentation() {
-    auto repr = getRepresentation<T>();
-    invalidateAllOther(repr);
-    return const_cast<T*>(repr);
+    return dynamic_cast<T*>(editRepresentation(getRepresentation<T>()));
 }
 
 template <typename Self, typename Repr>
@@ -260,33 +303,118 @@ bool Data<Self, Repr>::hasRepresentation() const {
 
 template <typename Self, typename Repr>
 void Data<Self, Repr>::invalidateAllOther(const Repr* repr) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        invalidateAllOtherInternal(repr);
+    }
+    representationModified(repr);
+}
+
+template <typename Self, typename Repr>
+void Data<Self, Repr>::invalidateAllOtherInternal(const Repr* repr) {
     bool found = false;
-    std::unique_lock<std::mutex> lock(mutex_);
-    for (auto& elem : representations_) {
-        if (elem.second.get() != repr) {
-            elem.second->setValid(false);
-        } else {
+    for (auto it = representations_.begin(); it != representations_.end();) {
+        if (it->second.get() == repr) {
             found = true;
-            elem.second->setValid(true);
-            lastValidRepresentation_ = elem.second;
+            it->second->setValid(true);
+            lastValidRepresentation_ = it->second;
+            ++it;
+        } else if (isSharedInternal(it->second.get())) {
+            // Other Data objects still rely on it, just let go of our reference
+            it = representations_.erase(it);
+        } else {
+            it->second->setValid(false);
+            ++it;
         }
     }
     if (!found) throw Exception("Called with representation not in representations.", IVW_CONTEXT);
+    pruneShared();
+}
+
+template <typename Self, typename Repr>
+Repr* Data<Self, Repr>::editRepresentation(const Repr* representation) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (isSharedInternal(representation)) {
+            auto it =
+                std::find_if(representations_.begin(), representations_.end(),
+                             [&](auto& elem) { return elem.second.get() == representation; });
+            if (it == representations_.end()) {
+                throw Exception("Called with representation not in representations.",
+                                IVW_CONTEXT);
+            }
+            auto copy = std::shared_ptr<Repr>(it->second->clone());
+            representations_.erase(it);
+            representation = addRepresentationInternal(copy).get();
+        } else {
+            // No longer shared, the owner might have been a Data object that has let go of it
+            const_cast<Repr*>(representation)->setOwner(static_cast<const Self*>(this));
+        }
+        invalidateAllOtherInternal(representation);
+    }
+    representationModified(representation);
+    return const_cast<Repr*>(representation);
+}
+
+template <typename Self, typename Repr>
+void Data<Self, Repr>::representationModified(const Repr*) {}
+
+template <typename Self, typename Repr>
+bool Data<Self, Repr>::isShared(const Repr* representation) const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return isSharedInternal(representation);
+}
+
+template <typename Self, typename Repr>
+bool Data<Self, Repr>::isSharedInternal(const Repr* repr) const {
+    auto it = shared_.find(repr);
+    return it != shared_.end() && it->second.use_count() > 1;
+}
+
+template <typename Self, typename Repr>
+void Data<Self, Repr>::pruneShared() const {
+    for (auto it = shared_.begin(); it != shared_.end();) {
+        const bool held =
+            it->second.use_count() > 1 &&
+            std::any_of(representations_.begin(), representations_.end(),
+                        [&](const auto& elem) { return elem.second.get() == it->first; });
+        it = held ? std::next(it) : shared_.erase(it);
+    }
 }
 
 template <typename Self, typename Repr>
 void Data<Self, Repr>::clearRepresentations() {
     std::unique_lock<std::mutex> lock(mutex_);
     representations_.clear();
+    lastValidRepresentation_.reset();
+    shared_.clear();
 }
 
 template <typename Self, typename Repr>
 void Data<Self, Repr>::copyRepresentationsTo(Data<Self, Repr>* targetData) const {
-    targetData->clearRepresentations();
+    std::vector<std::pair<std::shared_ptr<Repr>, std::shared_ptr<const void>>> reprs;
+    std::shared_ptr<Repr> lastValid;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (auto& elem : representations_) {
+            if (!elem.second->isValid()) continue;
+            auto& token = shared_[elem.second.get()];
+            if (!token) token = std::make_shared<char>();
+            reprs.emplace_back(elem.second, token);
+        }
+        lastValid = lastValidRepresentation_;
+    }
 
-    if (lastValidRepresentation_) {
-        auto rep = std::shared_ptr<Repr>(lastValidRepresentation_->clone());
-        targetData->addRepresentation(rep);
+    std::unique_lock<std::mutex> lock(targetData->mutex_);
+    targetData->representations_.clear();
+    targetData->lastValidRepresentation_.reset();
+    targetData->shared_.clear();
+    for (auto& [repr, token] : reprs) {
+        targetData->representations_[repr->getTypeIndex()] = repr;
+        targetData->shared_[repr.get()] = token;
+        if (repr == lastValid || !targetData->lastValidRepresentation_) {
+            targetData->lastValidRepresentation_ = repr;
+        }
     }
 }
 
@@ -296,6 +424,7 @@ std::shared_ptr<Repr> Data<Self, Repr>::addRepresentationInternal(
     repr->setValid(true);
     repr->setOwner(static_cast<const Self*>(this));
     representations_[repr->getTypeIndex()] = repr;
+    shared_.erase(repr.get());
     return repr;
 }
 
@@ -312,6 +441,7 @@ void Data<Self, Repr>::removeRepresentation(const Repr* representation) {
     for (auto& elem : representations_) {
         if (elem.second.get() == representation) {
             representations_.erase(elem.first);
+            shared_.erase(representation);
             break;
         }
     }
@@ -346,6 +476,7 @@ void Data<Self, Repr>::removeOtherRepresentations(const Repr* representation) {
         }
     }
     std::swap(repr, representations_);
+    pruneShared();
 }
 
 template <typename Self, typename Repr>
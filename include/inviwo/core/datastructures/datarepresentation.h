@@ -32,6 +32,7 @@
 #include <inviwo/core/util/formats.h>
 #include <inviwo/core/util/exception.h>
 #include <typeindex>
+#include <atomic>
 
 namespace inviwo {
 
@@ -45,6 +46,9 @@ public:
 /**
  * \ingroup datastructures
  * \brief Base class for all DataRepresentations \see Data
+ * A representation can be shared between several Data objects, see Data. The owner of a shared
+ * representation is the Data object that created it, it only changes when a Data object detaches
+ * the representation to edit it. The owner and the valid flag are atomic.
  */
 template <typename Owner>
 class DataRepresentation {
@@ -62,6 +66,10 @@ public:
 
     void setOwner(const Owner* owner);
     const Owner* getOwner() const;
+    /**
+     * Reset the owner to nullptr if it is \p owner
+     */
+    void releaseOwner(const Owner* owner);
 
     bool isValid() const;
     void setValid(bool valid);
@@ -69,19 +77,33 @@ public:
 protected:
     DataRepresentation() = default;
     DataRepresentation(const DataFormatBase* format);
-    DataRepresentation(const DataRepresentation& rhs) = default;
-    DataRepresentation& operator=(const DataRepresentation& that) = default;
+    DataRepresentation(const DataRepresentation& rhs);
+    DataRepresentation& operator=(const DataRepresentation& that);
     void setDataFormat(const DataFormatBase* format);
 
-    bool isValid_ = true;
+    std::atomic<bool> isValid_{true};
     const DataFormatBase* dataFormatBase_ = DataUInt8::get();
-    const Owner* owner_ = nullptr;
+    std::atomic<const Owner*> owner_{nullptr};
 };
 
 template <typename Owner>
 DataRepresentation<Owner>::DataRepresentation(const DataFormatBase* format)
     : isValid_(true), dataFormatBase_(format), owner_(nullptr) {}
 
+template <typename Owner>
+DataRepresentation<Owner>::DataRepresentation(const DataRepresentation& rhs)
+    : isValid_(rhs.isValid_.load())
+    , dataFormatBase_(rhs.dataFormatBase_)
+    , owner_(rhs.owner_.load()) {}
+
+template <typename Owner>
+DataRepresentation<Owner>& DataRepresentation<Owner>::operator=(const DataRepresentation& that) {
+    isValid_ = that.isValid_.load();
+    dataFormatBase_ = that.dataFormatBase_;
+    owner_ = that.owner_.load();
+    return *this;
+}
+
 template <typename Owner>
 const DataFormatBase* DataRepresentation<Owner>::getDataFormat() const {
     return dataFormatBase_;
@@ -112,6 +134,11 @@ const Owner* DataRepresentation<Owner>::getOwner() const {
     return owner_;
 }
 
+template <typename Owner>
+void DataRepresentation<Owner>::releaseOwner(const Owner* owner) {
+    owner_.compare_exchange_strong(owner, nullptr);
+}
+
 template <typename Owner>
 bool DataRepresentation<Owner>::isValid() const {
     return isValid_;
@@ -31,8 +31,14 @@
 
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/quantilesketch.h>
+#include <inviwo/core/util/threadutil.h>
 
+#include <algorithm>
+#include <array>
 #include <iterator>
+#include <limits>
+#include <type_traits>
 #include <vector>
 #include <bitset>
 
@@ -61,6 +67,13 @@ public:
     NormalizedHistogram(dvec2 dataRange, std::vector<double> counts, double min, double max,
                         double mean, double standardDeviation);
 
+    /**
+     * Use the distribution of the data given by \p sketch for stats_.percentiles instead of
+     * approximating it from the cumulative bin counts.
+     */
+    NormalizedHistogram(dvec2 dataRange, std::vector<double> counts, double min, double max,
+                        double mean, double standardDeviation, const util::QuantileSketch& sketch);
+
     std::vector<double>& getData();
     const std::vector<double>& getData() const;
     double& operator[](size_t i);
@@ -80,6 +93,13 @@ protected:
 class IVW_CORE_API HistogramContainer {
 public:
     HistogramContainer() = default;
+    /**
+     * Calculate one histogram per channel of the values in [begin, end) together with min, max,
+     * mean, standard deviation and percentiles. For random access iterators the data is split
+     * into parts that are processed on the thread pool and merged afterwards. The percentiles
+     * come from a util::QuantileSketch filled in the same pass, so no copy or sort of the data
+     * is needed.
+     */
     template <typename FirstIter, typename LastIter>
     HistogramContainer(dvec2 range, size_t bins, FirstIter begin, LastIter end);
 
@@ -115,48 +135,86 @@ HistogramContainer::HistogramContainer(dvec2 dataRange, size_t bins, FirstIter b
         bins = std::min(bins, static_cast<std::size_t>(dataRange.y - dataRange.x + 1));
     }
 
-    std::array<std::vector<double>, extent> histData;
-    for (size_t i = 0; i < extent; ++i) {
-        histData[i].resize(bins, 0.0);
-    }
-
-    D min(std::numeric_limits<double>::max());
-    D max(std::numeric_limits<double>::lowest());
-    D sum(0);
-    D sum2(0);
-    size_t count(0);
-
     const D rangeMin(dataRange.x);
     const D rangeScaleFactor(static_cast<double>(bins - 1) / (dataRange.y - dataRange.x));
 
-    for (; begin != end; ++begin) {
-
-        const auto val = static_cast<D>(*begin);
-
-        min = glm::min(min, val);
-        max = glm::max(max, val);
-        sum += val;
-        sum2 += val * val;
-        count++;
-
-        const auto ind = static_cast<I>((val - rangeMin) * rangeScaleFactor);
+    struct Partial {
+        std::array<std::vector<double>, extent> histData;
+        std::array<util::QuantileSketch, extent> sketches;
+        D min{std::numeric_limits<double>::max()};
+        D max{std::numeric_limits<double>::lowest()};
+        D sum{0};
+        D sum2{0};
+        size_t count{0};
+    };
 
+    const auto accumulate = [&](Partial& p, auto first, auto last) {
         for (size_t i = 0; i < extent; ++i) {
-            const auto v = util::glmcomp(ind, i);
-            if (v < bins) {
-                histData[i][v]++;
+            p.histData[i].resize(bins, 0.0);
+        }
+        for (; first != last; ++first) {
+            const auto val = static_cast<D>(*first);
+
+            p.min = glm::min(p.min, val);
+            p.max = glm::max(p.max, val);
+            p.sum += val;
+            p.sum2 += val * val;
+            p.count++;
+
+            const auto ind = static_cast<I>((val - rangeMin) * rangeScaleFactor);
+
+            for (size_t i = 0; i < extent; ++i) {
+                const auto v = util::glmcomp(ind, i);
+                if (v < bins) {
+                    p.histData[i][v]++;
+                }
+                p.sketches[i].add(util::glmcomp(val, i));
+            }
+        }
+    };
+
+    Partial res;
+    using Category = typename std::iterator_traits<FirstIter>::iterator_category;
+    if constexpr (std::is_same_v<FirstIter, LastIter> &&
+                  std::is_base_of_v<std::random_access_iterator_tag, Category>) {
+        constexpr size_t minValuesPerJob = size_t{1} << 16;
+        constexpr size_t maxJobs = 64;
+        const auto size = static_cast<size_t>(std::distance(begin, end));
+        const auto jobs = std::clamp(size / minValuesPerJob, size_t{1}, maxJobs);
+
+        std::vector<Partial> partials(jobs);
+        util::cooperativeFor(jobs, [&](size_t job) {
+            accumulate(partials[job], begin + size * job / jobs, begin + size * (job + 1) / jobs);
+        });
+
+        res = std::move(partials.front());
+        for (size_t job = 1; job < jobs; ++job) {
+            const auto& p = partials[job];
+            res.min = glm::min(res.min, p.min);
+            res.max = glm::max(res.max, p.max);
+            res.sum += p.sum;
+            res.sum2 += p.sum2;
+            res.count += p.count;
+            for (size_t i = 0; i < extent; ++i) {
+                std::transform(res.histData[i].begin(), res.histData[i].end(),
+                               p.histData[i].begin(), res.histData[i].begin(),
+                               [](double a, double b) { return a + b; });
+                res.sketches[i].merge(p.sketches[i]);
             }
         }
+    } else {
+        accumulate(res, begin, end);
     }
 
-    const auto dcount = static_cast<double>(count);
-    const auto mean = sum / dcount;
-    const auto stddev = glm::sqrt((dcount * sum2 - sum * sum) / (dcount * (dcount - D{1})));
+    const auto dcount = static_cast<double>(res.count);
+    const auto mean = res.sum / dcount;
+    const auto stddev =
+        glm::sqrt((dcount * res.sum2 - res.sum * res.sum) / (dcount * (dcount - D{1})));
 
     for (size_t i = 0; i < extent; ++i) {
-        histograms_.emplace_back(dataRange, std::move(histData[i]), util::glmcomp(min, i),
-                                 util::glmcomp(max, i), util::glmcomp(mean, i),
-                                 util::glmcomp(stddev, i));
+        histograms_.emplace_back(dataRange, std::move(res.histData[i]), util::glmcomp(res.min, i),
+                                 util::glmcomp(res.max, i), util::glmcomp(mean, i),
+                                 util::glmcomp(stddev, i), res.sketches[i]);
     }
 }
 
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/util/rampool.h>
 
 #include <algorithm>
 
@@ -47,11 +48,18 @@ public:
                                LayerType type = LayerType::Color,
                                const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                                InterpolationType interpolation = InterpolationType::Linear,
-                               const Wrapping2D& wrap = wrapping2d::clampAll);
+                               const Wrapping2D& wrap = wrapping2d::clampAll,
+                               DataInitialization init = DataInitialization::Zero);
+    /**
+     * Create a layer from \p data, which has to be allocated with new[]. The layer takes
+     * ownership of the data. If \p data is nullptr storage is allocated from the RAMPool. With
+     * DataInitialization::Zero it is cleared to 0, or to 1 for depth layers.
+     */
     LayerRAMPrecision(T* data, size2_t dimensions, LayerType type = LayerType::Color,
                       const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                       InterpolationType interpolation = InterpolationType::Linear,
-                      const Wrapping2D& wrap = wrapping2d::clampAll);
+                      const Wrapping2D& wrap = wrapping2d::clampAll,
+                      DataInitialization init = DataInitialization::Zero);
     LayerRAMPrecision(const LayerRAMPrecision<T>& rhs);
     LayerRAMPrecision<T>& operator=(const LayerRAMPrecision<T>& that);
     virtual LayerRAMPrecision<T>* clone() const override;
@@ -102,7 +110,7 @@ public:
 
 private:
     size2_t dimensions_;
-    std::unique_ptr<T[]> data_;
+    util::RAMArray<T> data_;
     SwizzleMask swizzleMask_;
     InterpolationType interpolation_;
     Wrapping2D wrapping_;
@@ -118,41 +126,41 @@ private:
  * @param swizzleMask used in for the layer, defaults to RGB-alpha
  * @param interpolation method to use.
  * @param wrapping method to use.
+ * @param init initialization of the allocated data.
  * @return nullptr if no valid format was specified.
  */
 IVW_CORE_API std::shared_ptr<LayerRAM> createLayerRAM(
     const size2_t& dimensions, LayerType type, const DataFormatBase* format,
     const SwizzleMask& swizzleMask = swizzlemasks::rgba,
     InterpolationType interpolation = InterpolationType::Linear,
-    const Wrapping2D& wrapping = wrapping2d::clampAll);
+    const Wrapping2D& wrapping = wrapping2d::clampAll,
+    DataInitialization init = DataInitialization::Zero);
 
 template <typename T>
 LayerRAMPrecision<T>::LayerRAMPrecision(size2_t dimensions, LayerType type,
                                         const SwizzleMask& swizzleMask,
-                                        InterpolationType interpolation, const Wrapping2D& wrapping)
-    : LayerRAM(type, DataFormat<T>::get())
-    , dimensions_(dimensions)
-    , data_(new T[dimensions_.x * dimensions_.y]())
-    , swizzleMask_(swizzleMask)
-    , interpolation_{interpolation}
-    , wrapping_{wrapping} {
-    std::fill(data_.get(), data_.get() + glm::compMul(dimensions_),
-              (type == LayerType::Depth) ? T{1} : T{0});
-}
+                                        InterpolationType interpolation, const Wrapping2D& wrapping,
+                                        DataInitialization init)
+    : LayerRAMPrecision(nullptr, dimensions, type, swizzleMask, interpolation, wrapping, init) {}
 
 template <typename T>
 LayerRAMPrecision<T>::LayerRAMPrecision(T* data, size2_t dimensions, LayerType type,
                                         const SwizzleMask& swizzleMask,
-                                        InterpolationType interpolation, const Wrapping2D& wrapping)
+                                        InterpolationType interpolation, const Wrapping2D& wrapping,
+                                        DataInitialization init)
     : LayerRAM(type, DataFormat<T>::get())
     , dimensions_(dimensions)
-    , data_(data ? data : new T[dimensions_.x * dimensions_.y]())
+    , data_(data ? util::adoptRAM(data)
+                 : util::allocateRAM<T>(dimensions_.x * dimensions_.y,
+                                        type == LayerType::Depth
+                                            ? DataInitialization::Uninitialized
+                                            : init))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {
-    if (!data) {
-        std::fill(data_.get(), data_.get() + glm::compMul(dimensions_),
-                  (type == LayerType::Depth) ? T{1} : T{0});
+    // Depth layers are cleared to 1, allocate them uninitialized to only write the data once
+    if (!data && type == LayerType::Depth && init == DataInitialization::Zero) {
+        std::fill(data_.get(), data_.get() + glm::compMul(dimensions_), T{1});
     }
 }
 
@@ -160,7 +168,7 @@ template <typename T>
 LayerRAMPrecision<T>::LayerRAMPrecision(const LayerRAMPrecision<T>& rhs)
     : LayerRAM(rhs)
     , dimensions_(rhs.dimensions_)
-    , data_(new T[dimensions_.x * dimensions_.y])
+    , data_(util::allocateRAM<T>(dimensions_.x * dimensions_.y, DataInitialization::Uninitialized))
     , swizzleMask_(rhs.swizzleMask_)
     , interpolation_{rhs.interpolation_}
     , wrapping_{rhs.wrapping_} {
@@ -173,7 +181,7 @@ LayerRAMPrecision<T>& LayerRAMPrecision<T>::operator=(const LayerRAMPrecision<T>
         LayerRAM::operator=(that);
 
         const auto dim = that.dimensions_;
-        auto data = std::make_unique<T[]>(dim.x * dim.y);
+        auto data = util::allocateRAM<T>(dim.x * dim.y, DataInitialization::Uninitialized);
         std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * sizeof(T));
         data_.swap(data);
 
@@ -211,7 +219,7 @@ const void* LayerRAMPrecision<T>::getData() const {
 
 template <typename T>
 void inviwo::LayerRAMPrecision<T>::setData(void* d, size2_t dimensions) {
-    std::unique_ptr<T[]> data(static_cast<T*>(d));
+    auto data = util::adoptRAM(static_cast<T*>(d));
     data_.swap(data);
     std::swap(dimensions_, dimensions);
 }
@@ -219,7 +227,7 @@ void inviwo::LayerRAMPrecision<T>::setData(void* d, size2_t dimensions) {
 template <typename T>
 void LayerRAMPrecision<T>::setDimensions(size2_t dimensions) {
     if (dimensions != dimensions_) {
-        auto data = std::make_unique<T[]>(dimensions.x * dimensions.y);
+        auto data = util::allocateRAM<T>(dimensions.x * dimensions.y);
         data_.swap(data);
         std::swap(dimensions, dimensions_);
     }
@@ -122,7 +122,7 @@ private:
     double maskMax_;
 
     mutable bool invalidData_;
-    std::shared_ptr<LayerRAMPrecision<vec4>> dataRepr_;
+    mutable std::shared_ptr<LayerRAMPrecision<vec4>> dataRepr_;
     std::unique_ptr<Layer> data_;
 };
 
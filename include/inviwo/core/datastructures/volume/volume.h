@@ -37,6 +37,7 @@
 #include <inviwo/core/datastructures/datamapper.h>
 #include <inviwo/core/datastructures/representationtraits.h>
 #include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
 #include <inviwo/core/metadata/metadataowner.h>
 #include <inviwo/core/util/glm.h>
 #include <inviwo/core/util/document.h>
@@ -63,7 +64,8 @@ class Camera;
 class IVW_CORE_API Volume : public Data<Volume, VolumeRepresentation>,
                             public StructuredGridEntity<3>,
                             public MetaDataOwner,
-                            public HistogramSupplier {
+                            public HistogramSupplier,
+                            public VolumePyramidSupplier {
 public:
     explicit Volume(size3_t defaultDimensions = size3_t(128, 128, 128),
                     const DataFormatBase* defaultFormat = DataUInt8::get(),
@@ -156,7 +158,24 @@ public:
 
     std::shared_ptr<HistogramCalculationState> calculateHistograms(size_t bins = 2048) const;
 
+    /**
+     * Get the multi-resolution pyramid of the volume for \p filter. The pyramid is built in the
+     * calling thread on first use and cached until the RAM representation is replaced or edited.
+     * @see VolumePyramid, invalidatePyramids
+     */
+    std::shared_ptr<const VolumePyramid> getPyramid(
+        PyramidFilter filter = PyramidFilter::Mean) const;
+    /**
+     * Start building the multi-resolution pyramid for \p filter in a background thread, unless
+     * it is already cached or being built. Use VolumePyramidCalculationState::whenDone to get
+     * notified when it is ready. The calculation is aborted when the returned state is released.
+     */
+    std::shared_ptr<VolumePyramidCalculationState> calculatePyramid(
+        PyramidFilter filter = PyramidFilter::Mean) const;
+
 protected:
+    virtual void representationModified(const VolumeRepresentation* repr) override;
+
     size3_t defaultDimensions_;
     const DataFormatBase* defaultDataFormat_;
     SwizzleMask defaultSwizzleMask_;
@@ -0,0 +1,186 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/util/formats.h>
+
+#include <vector>
+#include <memory>
+#include <mutex>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * \ingroup datastructures
+ * \brief A lossless, block-compressed in-memory volume representation
+ *
+ * The volume is split into bricks of a fixed size, each brick is compressed independently with
+ * the smallest of the following codecs:
+ *  * Constant: all voxels of the brick are equal, only a single voxel is stored
+ *  * FrameOfReference: the brick minimum followed by the bitpacked offsets from it
+ *  * Delta: the first voxel followed by the bitpacked, zigzag encoded, differences between
+ *    consecutive values of each component
+ *  * Raw: the uncompressed voxels
+ *
+ * The bitpacking codecs are only used for integer formats of up to 32 bits, which covers the
+ * typical label and segmentation volumes. Bricks are decompressed on demand, recently used bricks
+ * are kept in a small cache. Bricks are immutable and shared between copies, which makes cloning
+ * cheap. Readers can fill the representation brick by brick or slab by slab using setBrick() and
+ * setSlab(), without ever holding the full uncompressed volume in memory.
+ *
+ * Converters to and from VolumeRAM are registered with the core representation converters.
+ * @see VolumeRAM2CompressedConverter, VolumeCompressed2RAMConverter
+ */
+class IVW_CORE_API VolumeCompressed : public VolumeRepresentation {
+public:
+    enum class Codec : unsigned char { Constant, FrameOfReference, Delta, Raw };
+
+    static constexpr size3_t defaultBrickSize{32, 32, 32};
+    static constexpr size_t defaultCacheSize = 64;
+
+    VolumeCompressed(size3_t dimensions = size3_t(128, 128, 128),
+                     const DataFormatBase* format = DataUInt8::get(),
+                     const SwizzleMask& swizzleMask = swizzlemasks::rgba,
+                     InterpolationType interpolation = InterpolationType::Linear,
+                     const Wrapping3D& wrapping = wrapping3d::clampAll,
+                     size3_t brickSize = defaultBrickSize);
+    /**
+     * Compress the data of \p ram, swizzle mask, interpolation and wrapping are copied from it.
+     */
+    explicit VolumeCompressed(const VolumeRAM& ram, size3_t brickSize = defaultBrickSize);
+    VolumeCompressed(const VolumeCompressed& rhs);
+    VolumeCompressed& operator=(const VolumeCompressed& that);
+    virtual VolumeCompressed* clone() const override;
+    virtual ~VolumeCompressed() = default;
+
+    virtual std::type_index getTypeIndex() const override final;
+
+    virtual void setDimensions(size3_t dimensions) override;
+    virtual const size3_t& getDimensions() const override;
+
+    virtual void setSwizzleMask(const SwizzleMask& mask) override;
+    virtual SwizzleMask getSwizzleMask() const override;
+
+    virtual void setInterpolation(InterpolationType interpolation) override;
+    virtual InterpolationType getInterpolation() const override;
+
+    virtual void setWrapping(const Wrapping3D& wrapping) override;
+    virtual Wrapping3D getWrapping() const override;
+
+    const size3_t& getBrickSize() const;
+    /// Number of bricks along each axis
+    size3_t getBrickCounts() const;
+    size_t getNumberOfBricks() const;
+    /// Index of voxel in the brick grid
+    size3_t getBrickOffset(size_t brickIndex) const;
+    /// Dimensions of a brick, bricks at the upper borders of the volume might be smaller
+    size3_t getBrickDimensions(size_t brickIndex) const;
+    size_t getBrickIndex(const size3_t& voxel) const;
+    Codec getCodec(size_t brickIndex) const;
+
+    /**
+     * Compress and store a single brick. \p data should hold the voxels of the brick in x, y, z
+     * order with dimensions getBrickDimensions(brickIndex).
+     */
+    void setBrick(size_t brickIndex, const void* data);
+    /**
+     * Compress and store a slab of bricks, i.e. all the bricks with brick z-index \p slab.
+     * \p data should hold getBrickSize().z (or less, for the last slab) full xy-slices of the
+     * volume.
+     */
+    void setSlab(size_t slab, const void* data);
+    /**
+     * Compress a full volume, \p data should hold all voxels of the volume in x, y, z order.
+     * The bricks are compressed in parallel.
+     */
+    void setData(const void* data);
+
+    /**
+     * Decompress a single brick into \p dst, see setBrick() for the layout.
+     */
+    void decompressBrick(size_t brickIndex, void* dst) const;
+    /**
+     * Decompress the full volume into \p dst, which has to be able to hold all voxels of the
+     * volume. The bricks are decompressed in parallel.
+     */
+    void decompress(void* dst) const;
+    /**
+     * Get the decompressed voxels of a brick, via the brick cache.
+     */
+    std::shared_ptr<const std::vector<unsigned char>> getBrick(size_t brickIndex) const;
+
+    /**
+     * Value of a single voxel, the brick containing it is decompressed via the brick cache.
+     */
+    dvec4 getAsDVec4(const size3_t& pos) const;
+    dvec4 getAsNormalizedDVec4(const size3_t& pos) const;
+
+    /// Size of the compressed bricks in bytes
+    size_t getCompressedSize() const;
+    /// Size of the uncompressed volume in bytes
+    size_t getUncompressedSize() const;
+    /// Uncompressed size over compressed size
+    double getCompressionRatio() const;
+
+    /// Number of decompressed bricks kept in the brick cache
+    void setCacheSize(size_t bricks);
+    size_t getCacheSize() const;
+    void clearCache() const;
+
+private:
+    struct Brick {
+        Codec codec;
+        std::vector<unsigned char> data;
+    };
+    using Decompressed = std::shared_ptr<const std::vector<unsigned char>>;
+
+    std::shared_ptr<const Brick> compress(const unsigned char* data, size_t voxels) const;
+    void decompress(const Brick& brick, unsigned char* dst, size_t voxels) const;
+    template <typename Func>
+    void forEachVoxelRow(size_t brickIndex, Func&& func) const;
+    void invalidate(size_t brickIndex);
+
+    size3_t dimensions_;
+    size3_t brickSize_;
+    SwizzleMask swizzleMask_;
+    InterpolationType interpolation_;
+    Wrapping3D wrapping_;
+    std::vector<std::shared_ptr<const Brick>> bricks_;
+
+    mutable std::mutex cacheMutex_;
+    size_t cacheSize_;
+    mutable std::vector<std::pair<size_t, Decompressed>> cache_;  // most recently used first
+};
+
+}  // namespace inviwo
@@ -0,0 +1,268 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/dispatcher.h>
+#include <inviwo/core/util/glm.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace inviwo {
+
+class VolumeRAM;
+
+/**
+ * The filter used to combine each block of 2x2x2 voxels into one voxel of the next coarser level
+ * of a VolumePyramid. All filters are applied per component.
+ *  * Mean: the average value, a box filter
+ *  * Min / Max: the smallest / largest value, conservative bounds for empty space skipping
+ *  * MaxAbs: the value with the largest magnitude, keeping its sign, useful for vector fields
+ */
+enum class PyramidFilter { Mean, Min, Max, MaxAbs };
+
+template <class Elem, class Traits>
+std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& ss,
+                                             PyramidFilter filter) {
+    switch (filter) {
+        case PyramidFilter::Mean:
+            ss << "Mean";
+            break;
+        case PyramidFilter::Min:
+            ss << "Min";
+            break;
+        case PyramidFilter::Max:
+            ss << "Max";
+            break;
+        case PyramidFilter::MaxAbs:
+            ss << "MaxAbs";
+            break;
+    }
+    return ss;
+}
+
+namespace util {
+
+/**
+ * Downsample \p volume by integer \p factors using \p filter. The resulting dimensions are
+ * dims / factors rounded up, blocks along the upper border are clamped to the volume.
+ * The slices of the result are computed in parallel.
+ */
+IVW_CORE_API std::shared_ptr<VolumeRAM> volumeDownsample(const VolumeRAM& volume, size3_t factors,
+                                                         PyramidFilter filter);
+
+}  // namespace util
+
+class VolumePyramidSupplier;
+
+/**
+ * \ingroup datastructures
+ * A multi-resolution representation of a VolumeRAM. Level 0 is the source volume, each following
+ * level halves the dimensions, rounding up, until all dimensions are one. All levels cover the
+ * same spatial extent, hence the basis, offset and texture coordinates of the source volume apply
+ * to every level. A pyramid is immutable once built.
+ * @see Volume::getPyramid, Volume::calculatePyramid
+ */
+class IVW_CORE_API VolumePyramid {
+public:
+    /**
+     * Build all levels from \p source. The build is aborted, leaving a partial pyramid, if \p stop
+     * becomes true.
+     */
+    VolumePyramid(std::shared_ptr<const VolumeRAM> source, PyramidFilter filter,
+                  const std::atomic<bool>* stop = nullptr);
+
+    size_t size() const { return levels_.size(); }
+    PyramidFilter getFilter() const { return filter_; }
+
+    const VolumeRAM* getLevel(size_t level) const;
+    std::shared_ptr<const VolumeRAM> getSharedLevel(size_t level) const;
+    size3_t getDimensions(size_t level) const;
+
+    /// Returns true if the pyramid was built from \p ram
+    bool isBuiltFrom(const VolumeRAM* ram) const;
+
+    /**
+     * Select the level matching a screen-space footprint, i.e. the number of source voxels
+     * covered by one pixel along its longest axis. Returns the coarsest level whose voxels are
+     * still no larger than a pixel.
+     */
+    size_t levelForFootprint(double voxelsPerPixel) const;
+
+    /**
+     * Select the finest level for which \p cost(dims) is within \p budget, or the coarsest level
+     * if none is.
+     */
+    template <typename Cost>
+    size_t levelWithin(double budget, Cost&& cost) const;
+
+    /// Select the finest level with at most \p maxVoxels voxels
+    size_t levelForVoxelBudget(size_t maxVoxels) const;
+
+private:
+    friend VolumePyramidSupplier;
+    using Levels = std::vector<std::shared_ptr<const VolumeRAM>>;
+    VolumePyramid(PyramidFilter filter, Levels levels);
+
+    PyramidFilter filter_;
+    Levels levels_;
+};
+
+template <typename Cost>
+size_t VolumePyramid::levelWithin(double budget, Cost&& cost) const {
+    for (size_t level = 0; level < levels_.size(); ++level) {
+        if (static_cast<double>(cost(getDimensions(level))) <= budget) return level;
+    }
+    return levels_.empty() ? 0 : levels_.size() - 1;
+}
+
+/**
+ * Keeps a running estimate of the time an operation takes per processed voxel to select the
+ * finest pyramid level that can be processed within a time budget.
+ */
+class IVW_CORE_API LevelOfDetailBudget {
+public:
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    explicit LevelOfDetailBudget(Milliseconds budget = Milliseconds{30.0});
+
+    void setBudget(Milliseconds budget);
+    Milliseconds getBudget() const;
+
+    /**
+     * Select a level where \p voxels(dims) is the number of voxels processed at a level of the
+     * given dimensions. Until a measurement has been made, level 0 is selected.
+     */
+    template <typename Voxels>
+    size_t select(const VolumePyramid& pyramid, Voxels&& voxels) const;
+
+    /// Add a measurement of processing \p voxels in \p elapsed time
+    void update(Milliseconds elapsed, size_t voxels);
+    void reset();
+
+private:
+    Milliseconds budget_;
+    double msPerVoxel_ = 0.0;
+};
+
+template <typename Voxels>
+size_t LevelOfDetailBudget::select(const VolumePyramid& pyramid, Voxels&& voxels) const {
+    if (msPerVoxel_ <= 0.0) return 0;
+    return pyramid.levelWithin(budget_.count() / msPerVoxel_, std::forward<Voxels>(voxels));
+}
+
+class IVW_CORE_API VolumePyramidCalculationState {
+public:
+    friend VolumePyramidSupplier;
+    using Callback = std::function<void(std::shared_ptr<const VolumePyramid>)>;
+    using Handle = std::shared_ptr<Callback>;
+
+    explicit VolumePyramidCalculationState(PyramidFilter filter);
+    ~VolumePyramidCalculationState();
+
+    /**
+     * Call \p callback in the front thread once the pyramid is built. If it is already built the
+     * callback is called directly. The callback is only called while the returned handle is kept
+     * alive, which makes it safe to capture an object that holds the handle.
+     */
+    [[nodiscard]] Handle whenDone(Callback callback);
+
+    bool isDone() const { return pyramid_ != nullptr; }
+    /// The built pyramid, or nullptr if it is still being built
+    std::shared_ptr<const VolumePyramid> getPyramid() const { return pyramid_; }
+    PyramidFilter getFilter() const { return filter_; }
+
+private:
+    PyramidFilter filter_;
+    std::weak_ptr<const VolumeRAM> source_;
+    Dispatcher<void(std::shared_ptr<const VolumePyramid>)> callbacks_;
+    std::shared_ptr<std::atomic<bool>> stop_;
+    std::shared_ptr<const VolumePyramid> pyramid_;
+};
+
+/**
+ * Caches one VolumePyramid per PyramidFilter. The cache only keeps the coarser levels, the source
+ * RAM representation is referenced weakly such that the cache does not keep it in memory. A cached
+ * pyramid is only used as long as its source is still the current RAM representation. Editing
+ * that representation in place does not change it, hence the owner has to call
+ * invalidatePyramids after such edits. Copies start out with an empty cache.
+ */
+class IVW_CORE_API VolumePyramidSupplier {
+public:
+    VolumePyramidSupplier();
+    VolumePyramidSupplier(const VolumePyramidSupplier& rhs);
+    VolumePyramidSupplier(VolumePyramidSupplier&& rhs) = default;
+    VolumePyramidSupplier& operator=(const VolumePyramidSupplier& that);
+    VolumePyramidSupplier& operator=(VolumePyramidSupplier&& that) = default;
+    virtual ~VolumePyramidSupplier() = default;
+
+    void invalidatePyramids();
+
+protected:
+    /// Get the cached pyramid for \p source or build it in the calling thread
+    std::shared_ptr<const VolumePyramid> getPyramid(std::shared_ptr<const VolumeRAM> source,
+                                                    PyramidFilter filter) const;
+
+    /**
+     * Get the cached pyramid for \p source or build it in a background thread. The calculation
+     * is aborted when the returned state is released.
+     */
+    std::shared_ptr<VolumePyramidCalculationState> startPyramidCalculation(
+        std::shared_ptr<const VolumeRAM> source, PyramidFilter filter) const;
+
+private:
+    struct Entry {
+        std::weak_ptr<const VolumeRAM> source;
+        VolumePyramid::Levels coarse;
+        std::weak_ptr<const VolumePyramid> pyramid;
+    };
+    struct Cache {
+        std::mutex mutex;
+        // Incremented by invalidatePyramids, pyramids started before that are not cached
+        size_t generation = 0;
+        std::array<Entry, 4> pyramids;
+        std::array<std::weak_ptr<VolumePyramidCalculationState>, 4> calculations;
+    };
+
+    /// Get the pyramid of \p entry if it was built from \p source, or nullptr
+    static std::shared_ptr<const VolumePyramid> lookup(
+        Entry& entry, const std::shared_ptr<const VolumeRAM>& source, PyramidFilter filter);
+    static void store(Entry& entry, const std::shared_ptr<const VolumePyramid>& pyramid);
+
+    mutable std::shared_ptr<Cache> cache_;
+};
+
+}  // namespace inviwo
@@ -32,6 +32,7 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/util/glm.h>
 #include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/rampool.h>
 
 namespace inviwo {
 
@@ -46,11 +47,18 @@ public:
     explicit VolumeRAMPrecision(size3_t dimensions = size3_t(128, 128, 128),
                                 const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                                 InterpolationType interpolation = InterpolationType::Linear,
-                                const Wrapping3D& wrapping = wrapping3d::clampAll);
+                                const Wrapping3D& wrapping = wrapping3d::clampAll,
+                                DataInitialization init = DataInitialization::Zero);
+    /**
+     * Create a volume from \p data, which has to be allocated with new[]. The volume takes
+     * ownership of the data. If \p data is nullptr storage is allocated from the RAMPool and
+     * initialized according to \p init.
+     */
     VolumeRAMPrecision(T* data, size3_t dimensions,
                        const SwizzleMask& swizzleMask = swizzlemasks::rgba,
                        InterpolationType interpolation = InterpolationType::Linear,
-                       const Wrapping3D& wrapping = wrapping3d::clampAll);
+                       const Wrapping3D& wrapping = wrapping3d::clampAll,
+                       DataInitialization init = DataInitialization::Zero);
     VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs);
     VolumeRAMPrecision<T>& operator=(const VolumeRAMPrecision<T>& that);
     virtual VolumeRAMPrecision<T>* clone() const override;
@@ -111,7 +119,7 @@ public:
 private:
     size3_t dimensions_;
     bool ownsDataPtr_;
-    std::unique_ptr<T[]> data_;
+    util::RAMArray<T> data_;
     SwizzleMask swizzleMask_;
     InterpolationType interpolation_;
     Wrapping3D wrapping_;
@@ -127,22 +135,24 @@ private:
  * @param swizzleMask of volume to create.
  * @param interpolation of volume to create.
  * @param wrapping of volume to create.
+ * @param init initialization of the allocated data, ignored if dataPtr is given.
  * @return nullptr if no valid format was specified.
  */
 IVW_CORE_API std::shared_ptr<VolumeRAM> createVolumeRAM(
     const size3_t& dimensions, const DataFormatBase* format, void* dataPtr = nullptr,
     const SwizzleMask& swizzleMask = swizzlemasks::rgba,
     InterpolationType interpolation = InterpolationType::Linear,
-    const Wrapping3D& wrapping = wrapping3d::clampAll);
+    const Wrapping3D& wrapping = wrapping3d::clampAll,
+    DataInitialization init = DataInitialization::Zero);
 
 template <typename T>
 VolumeRAMPrecision<T>::VolumeRAMPrecision(size3_t dimensions, const SwizzleMask& swizzleMask,
                                           InterpolationType interpolation,
-                                          const Wrapping3D& wrapping)
+                                          const Wrapping3D& wrapping, DataInitialization init)
     : VolumeRAM(DataFormat<T>::get())
     , dimensions_(dimensions)
     , ownsDataPtr_(true)
-    , data_(new T[dimensions_.x * dimensions_.y * dimensions_.z]())
+    , data_(util::allocateRAM<T>(dimensions_.x * dimensions_.y * dimensions_.z, init))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {}
@@ -151,11 +161,12 @@ template <typename T>
 VolumeRAMPrecision<T>::VolumeRAMPrecision(T* data, size3_t dimensions,
                                           const SwizzleMask& swizzleMask,
                                           InterpolationType interpolation,
-                                          const Wrapping3D& wrapping)
+                                          const Wrapping3D& wrapping, DataInitialization init)
     : VolumeRAM(DataFormat<T>::get())
     , dimensions_(dimensions)
     , ownsDataPtr_(true)
-    , data_(data ? data : new T[dimensions_.x * dimensions_.y * dimensions_.z]())
+    , data_(data ? util::adoptRAM(data)
+                 : util::allocateRAM<T>(dimensions_.x * dimensions_.y * dimensions_.z, init))
     , swizzleMask_(swizzleMask)
     , interpolation_{interpolation}
     , wrapping_{wrapping} {}
@@ -165,7 +176,8 @@ VolumeRAMPrecision<T>::VolumeRAMPrecision(const VolumeRAMPrecision<T>& rhs)
     : VolumeRAM(rhs)
     , dimensions_(rhs.dimensions_)
     , ownsDataPtr_(true)
-    , data_(new T[dimensions_.x * dimensions_.y * dimensions_.z])
+    , data_(util::allocateRAM<T>(dimensions_.x * dimensions_.y * dimensions_.z,
+                                 DataInitialization::Uninitialized))
     , swizzleMask_(rhs.swizzleMask_)
     , interpolation_{rhs.interpolation_}
     , wrapping_{rhs.wrapping_} {
@@ -178,7 +190,8 @@ VolumeRAMPrecision<T>& VolumeRAMPrecision<T>::operator=(const VolumeRAMPrecision
     if (this != &that) {
         VolumeRAM::operator=(that);
         auto dim = that.dimensions_;
-        auto data = std::make_unique<T[]>(dim.x * dim.y * dim.z);
+        auto data =
+            util::allocateRAM<T>(dim.x * dim.y * dim.z, DataInitialization::Uninitialized);
         std::memcpy(data.get(), that.data_.get(), dim.x * dim.y * dim.z * sizeof(T));
         data_.swap(data);
         std::swap(dim, dimensions_);
@@ -231,7 +244,7 @@ const void* VolumeRAMPrecision<T>::getData(size_t pos) const {
 
 template <typename T>
 void VolumeRAMPrecision<T>::setData(void* d, size3_t dimensions) {
-    std::unique_ptr<T[]> data(static_cast<T*>(d));
+    auto data = util::adoptRAM(static_cast<T*>(d));
     data_.swap(data);
     std::swap(dimensions_, dimensions);
 
@@ -257,7 +270,7 @@ size_t VolumeRAMPrecision<T>::getNumberOfBytes() const {
 template <typename T>
 void VolumeRAMPrecision<T>::setDimensions(size3_t dimensions) {
     if (dimensions_ != dimensions) {
-        auto data = std::make_unique<T[]>(dimensions.x * dimensions.y * dimensions.z);
+        auto data = util::allocateRAM<T>(dimensions.x * dimensions.y * dimensions.z);
         data_.swap(data);
         dimensions_ = dimensions;
         if (!ownsDataPtr_) data.release();
@@ -40,6 +40,11 @@ namespace inviwo {
 
 class MetaDataOwner;
 
+namespace pool {
+class Stop;
+class Progress;
+}  // namespace pool
+
 /**
  * \defgroup dataio Data Reader & Writers
  */
@@ -62,6 +67,15 @@ public:
     const std::vector<FileExtension>& getExtensions() const;
     void addExtension(FileExtension ext);
 
+    /**
+     * @brief The precedence of the reader when several readers of the same data type are
+     * registered for the same file extension. The reader with the highest priority is selected,
+     * the default is 0.
+     * @see DataReaderFactory::getReaderForTypeAndExtension
+     */
+    int getPriority() const;
+    void setPriority(int priority);
+
     /**
      * @brief Set reader specific options
      * See the documentation of the specific reader about which options that are available
@@ -83,6 +97,7 @@ public:
 
 private:
     std::vector<FileExtension> extensions_;
+    int priority_ = 0;
 };
 
 /**
@@ -111,6 +126,22 @@ public:
     virtual std::shared_ptr<T> readData(const std::string& filePath, MetaDataOwner*) {
         return readData(filePath);
     };
+
+    /**
+     * Optional overload used when the data is read in a background job, e.g. by DataSource.
+     * Readers that support it should check \p stop periodically and return nullptr early if it
+     * is set, and report their progress in the range [0, 1] through \p progress. The default
+     * implementation falls back to the synchronous readData(filePath, metaDataOwner), which the
+     * caller then simply runs on the thread pool.
+     * @see pool::Stop
+     * @see pool::Progress
+     * @see CSVReader
+     */
+    virtual std::shared_ptr<T> readData(const std::string& filePath, MetaDataOwner* metaDataOwner,
+                                        [[maybe_unused]] const pool::Stop& stop,
+                                        [[maybe_unused]] const pool::Progress& progress) {
+        return readData(filePath, metaDataOwner);
+    }
 };
 
 }  // namespace inviwo
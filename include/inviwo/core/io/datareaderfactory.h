@@ -59,9 +59,10 @@ public:
      * \brief Return a reader matching the file extension of DataReader of type T.
      * Does case insensitive comparison between the last part of filePathOrExtension and each
      * registered extension. Does not check for "." before the extension, so it is valid to pass for
-     * example "png".
+     * example "png". The longest matching extension wins, and among readers registered for
+     * extensions of that length the one with the highest DataReader::getPriority() is selected.
      * @param filePathOrExtension Path to file, or simply the extension.
-     * @return First available DataReaderType<T> if found, nullptr otherwise.
+     * @return The best matching DataReaderType<T> if found, nullptr otherwise.
      */
     template <typename T>
     std::unique_ptr<DataReaderType<T>> getReaderForTypeAndExtension(
@@ -115,14 +116,21 @@ std::vector<FileExtension> DataReaderFactory::getExtensionsForType() const {
 template <typename T>
 std::unique_ptr<DataReaderType<T>> DataReaderFactory::getReaderForTypeAndExtension(
     std::string_view path) const {
+    DataReaderType<T>* best = nullptr;
+    size_t bestSize = 0;
     for (auto& elem : map_) {
+        // map_ is sorted by extension length, shorter extensions can not be better matches
+        if (best && elem.first.extension_.size() < bestSize) break;
         if (util::iCaseEndsWith(path, elem.first.extension_)) {
             if (auto r = dynamic_cast<DataReaderType<T>*>(elem.second)) {
-                return std::unique_ptr<DataReaderType<T>>(r->clone());
+                if (!best || r->getPriority() > best->getPriority()) {
+                    best = r;
+                    bestSize = elem.first.extension_.size();
+                }
             }
         }
     }
-    return std::unique_ptr<DataReaderType<T>>{};
+    return std::unique_ptr<DataReaderType<T>>(best ? best->clone() : nullptr);
 }
 
 template <typename T>
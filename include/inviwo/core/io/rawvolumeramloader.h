@@ -34,7 +34,9 @@
 #include <inviwo/core/io/datareaderexception.h>
 #include <inviwo/core/datastructures/diskrepresentation.h>
 #include <inviwo/core/datastructures/volume/volumerepresentation.h>
+#include <inviwo/core/datastructures/volume/volumecompressed.h>
 
+#include <functional>
 #include <string>
 #include <memory>
 
@@ -61,4 +63,25 @@ private:
     bool littleEndian_;
 };
 
+namespace util {
+
+/**
+ * Read a raw volume into a VolumeCompressed. The file is read one slab of bricks at a time and
+ * each slab is compressed before the next one is read, so the full uncompressed volume is never
+ * held in memory.
+ * @param rawFile the file to read from
+ * @param offset the position of the first voxel in the file in bytes
+ * @param littleEndian the byte order of the file
+ * @param dimensions the dimensions of the volume
+ * @param format the format of the voxels
+ * @param brickSize the brick size of the compressed volume
+ * @param onSlab optional callback called with the uncompressed voxels of each slab
+ */
+IVW_CORE_API std::shared_ptr<VolumeCompressed> readRawVolumeCompressed(
+    const std::string& rawFile, size_t offset, bool littleEndian, const size3_t& dimensions,
+    const DataFormatBase* format, const size3_t& brickSize = VolumeCompressed::defaultBrickSize,
+    const std::function<void(const VolumeRAM&)>& onSlab = {});
+
+}  // namespace util
+
 }  // namespace inviwo
@@ -0,0 +1,226 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/io/serialization/serializebase.h>
+
+#include <iosfwd>
+#include <cstdint>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include <limits>
+#include <cmath>
+#include <type_traits>
+
+namespace inviwo {
+
+/**
+ * \brief A compact binary encoding of serialized workspaces.
+ *
+ * The binary format stores the same document tree as the xml format and can be converted to and
+ * from xml without loss. Element and attribute names and string values are interned in a string
+ * table and referenced by index. Attribute values that are the canonical text of an integer or a
+ * floating point number are stored in native binary form. Each element stores the byte size of
+ * its children, which lets a reader skip whole subtrees, and large lists of siblings, like the
+ * processors of a network, are decoded in parallel.
+ *
+ * A binary workspace is decoded into a Document, a read only tree that refers directly into the
+ * string table and keeps numbers in their binary form. The Deserializer reads from that tree
+ * without building an xml document. It detects the format from the leading magic bytes, hence
+ * binary workspaces can be loaded wherever xml workspaces are accepted.
+ */
+namespace binaryworkspace {
+
+/// Magic bytes at the start of each binary workspace
+constexpr std::string_view magic = "IVWB";
+constexpr std::uint8_t version = 1;
+
+enum class NodeType : std::uint8_t { Element = 1, Text, CData, Comment, Declaration };
+
+/// An attribute value, numbers are kept in the binary form they were stored in.
+using Value = std::variant<std::string_view, std::int64_t, float, double>;
+
+/**
+ * The text form of the value, identical to the attribute text of the xml encoding.
+ */
+IVW_CORE_API std::string toString(const Value& value);
+
+struct Attribute {
+    std::string_view name;
+    Value value;
+};
+
+/**
+ * \brief A node of a decoded binary Document.
+ *
+ * The value is the tag name of an element and the text of text, CDATA, and comment nodes. A
+ * declaration stores its version, encoding and standalone fields as attributes. All strings refer
+ * into the owning Document.
+ */
+struct IVW_CORE_API Node {
+    /// The first child element with the given tag name, or any tag name if name is empty.
+    const Node* firstChildElement(std::string_view name = {}) const;
+    /// The next sibling element with the given tag name, or any tag name if name is empty.
+    const Node* nextSiblingElement(std::string_view name = {}) const;
+
+    const Attribute* attribute(std::string_view name) const;
+    /// The text of the attribute, or an empty string if there is no such attribute.
+    std::string getAttribute(std::string_view name) const;
+
+    /**
+     * Read a numeric attribute without going through its text form. Only succeeds if the stored
+     * value converts exactly to T, i.e. the result is the same as parsing the text form would
+     * give. Non-finite values are left to the text form as well. Returns false otherwise, in which
+     * case dest is not modified.
+     */
+    template <typename T>
+    bool getNumber(std::string_view name, T& dest) const;
+
+    NodeType type;
+    std::string_view value;
+    const Attribute* attributes = nullptr;
+    size_t attributeCount = 0;
+    const Node* parent = nullptr;
+    const Node* firstChild = nullptr;
+    const Node* next = nullptr;
+};
+
+/**
+ * \brief A decoded binary workspace.
+ *
+ * Owns the encoded data, the string table refers into it, and the node tree that refers into the
+ * string table.
+ */
+class IVW_CORE_API Document {
+public:
+    /**
+     * Decode a binary workspace from the stream.
+     * @throws SerializationException if the data is not a valid binary workspace.
+     */
+    explicit Document(std::istream& stream);
+    Document(const Document&) = delete;
+    Document& operator=(const Document&) = delete;
+    ~Document();
+
+    /// The first top level node, or nullptr if the document is empty.
+    const Node* firstChild() const;
+    /// The first top level element, i.e. the workspace element, or nullptr if there is none.
+    const Node* root() const;
+
+private:
+    std::vector<char> data_;
+    std::vector<Node> nodes_;
+    std::vector<Attribute> attributes_;
+};
+
+/**
+ * Check the leading bytes of the stream for the binary magic, the stream position is not changed.
+ */
+IVW_CORE_API bool isBinary(std::istream& stream);
+
+/**
+ * Encode the document into the stream.
+ * @throws SerializationException
+ */
+IVW_CORE_API void write(const TxDocument& doc, std::ostream& stream);
+
+/**
+ * Copy the element and its subtree into doc as xml. The ancestors of the element are copied
+ * first, without their other children, so that the copy keeps its path for error reporting.
+ * @return the copy of the element.
+ */
+IVW_CORE_API TxElement* toXml(const Node& element, TxDocument& doc);
+
+/**
+ * Convert an xml workspace to the binary format
+ * @throws SerializationException
+ */
+IVW_CORE_API void xmlToBinary(std::istream& xml, std::ostream& binary);
+
+/**
+ * Convert a binary workspace to xml.
+ * @param format Format the output, i.e. insert line breaks and tabs.
+ * @throws SerializationException
+ */
+IVW_CORE_API void binaryToXml(std::istream& binary, std::ostream& xml, bool format = true);
+
+template <typename T>
+bool Node::getNumber(std::string_view name, T& dest) const {
+    static_assert(std::is_arithmetic_v<T>, "T has to be a number");
+
+    const auto* attr = attribute(name);
+    if (!attr) return false;
+
+    if (const auto* i = std::get_if<std::int64_t>(&attr->value)) {
+        const auto v = *i;
+        if constexpr (std::is_same_v<T, bool>) {
+            if (v != 0 && v != 1) return false;
+            dest = v == 1;
+        } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+            if (v < std::numeric_limits<T>::min() || v > std::numeric_limits<T>::max()) {
+                return false;
+            }
+            dest = static_cast<T>(v);
+        } else if constexpr (std::is_integral_v<T>) {
+            if (v < 0 || static_cast<std::uint64_t>(v) > std::numeric_limits<T>::max()) {
+                return false;
+            }
+            dest = static_cast<T>(v);
+        } else {
+            // Integers beyond the mantissa might round differently than the parsed text
+            constexpr int digits = std::numeric_limits<T>::digits;
+            if constexpr (digits < 63) {
+                constexpr auto limit = std::int64_t{1} << digits;
+                if (v < -limit || v > limit) return false;
+            }
+            dest = static_cast<T>(v);
+        }
+        return true;
+    } else if (const auto* f = std::get_if<float>(&attr->value)) {
+        if constexpr (std::is_same_v<T, float>) {
+            if (!std::isfinite(*f)) return false;
+            dest = *f;
+            return true;
+        }
+    } else if (const auto* d = std::get_if<double>(&attr->value)) {
+        if constexpr (std::is_same_v<T, double>) {
+            if (!std::isfinite(*d)) return false;
+            dest = *d;
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace binaryworkspace
+
+}  // namespace inviwo
@@ -31,6 +31,7 @@
 
 #include <inviwo/core/io/serialization/serializebase.h>
 #include <inviwo/core/io/serialization/nodedebugger.h>
+#include <inviwo/core/io/serialization/binaryworkspace.h>
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/factory.h>
 #include <inviwo/core/util/logfilter.h>
@@ -256,8 +257,17 @@ public:
     void setExceptionHandler(ExceptionHandler handler);
     void handleError(const ExceptionContext& context);
 
+    /**
+     * \brief Run \p converter on the current element. Elements of binary workspaces are copied
+     * to xml first, the rest of the element is then read from the copy.
+     */
     void convertVersion(VersionConverter* converter);
 
+    /**
+     * \brief Whether the current element is read from a binary workspace.
+     */
+    bool isBinary() const;
+
     /**
      * \brief For allocating objects such as processors, properties.. using registered factories.
      *
@@ -293,7 +303,9 @@ private:
     template <typename T, typename std::enable_if<util::is_floating_point<T>::value, int>::type = 0>
     void getSafeValue(std::string_view key, T& data);
 
-    TxElement* retrieveChild(std::string_view key);
+    ElementRef retrieveChild(std::string_view key);
+
+    void setRootElement();
 
     ExceptionHandler exceptionHandler_;
     std::vector<FactoryBase*> registeredFactories_;
@@ -316,18 +328,22 @@ constexpr bool canDeserialize() {
            util::is_detected_v<isDeserializable, T> || std::is_enum_v<T>;
 }
 
-IVW_CORE_API std::string getNodeAttribute(TxElement* node, std::string_view key);
+IVW_CORE_API std::string getNodeAttribute(ElementRef node, std::string_view key);
 
 template <typename T>
-void getNodeAttribute(TxElement* node, std::string_view key, T& dest) {
+void getNodeAttribute(ElementRef node, std::string_view key, T& dest) {
+    if constexpr (std::is_arithmetic_v<T>) {
+        // Binary workspaces store numbers natively, skip the text round trip when exact
+        if (node.binary && node.binary->getNumber(key, dest)) return;
+    }
     const auto val = getNodeAttribute(node, key);
     if (!val.empty()) {
         detail::fromStr(val, dest);
     }
 }
 
-IVW_CORE_API void forEachChild(TxElement* node, std::string_view key,
-                               std::function<void(TxElement*)> func);
+IVW_CORE_API void forEachChild(ElementRef node, std::string_view key,
+                               std::function<void(ElementRef)> func);
 
 }  // namespace detail
 
@@ -343,14 +359,14 @@ public:
         std::function<void(T&)> callback;
     };
     using Getter = std::function<Item(const K& id, size_t ind)>;
-    using IdentityGetter = std::function<K(TxElement* node)>;
+    using IdentityGetter = std::function<K(ElementRef node)>;
 
     ContainerWrapper(std::string itemKey, Getter getItem) : getItem_(getItem), itemKey_(itemKey) {}
     ~ContainerWrapper() = default;
 
     std::string_view getItemKey() const { return itemKey_; }
 
-    void deserialize(Deserializer& d, TxElement* node, size_t ind) {
+    void deserialize(Deserializer& d, ElementRef node, size_t ind) {
         auto item = getItem_(idGetter_(node), ind);
         if (item.doDeserialize) {
             try {
@@ -365,7 +381,7 @@ public:
     void setIdentityGetter(IdentityGetter getter) { idGetter_ = getter; }
 
 private:
-    IdentityGetter idGetter_ = [](TxElement* node) {
+    IdentityGetter idGetter_ = [](ElementRef node) {
         K val{};
         detail::getNodeAttribute(node, "identifier", val);
         return val;
@@ -572,7 +588,7 @@ public:
                 }
             });
 
-        cont.setIdentityGetter([&](TxElement* node) {
+        cont.setIdentityGetter([&](ElementRef node) {
             K key{};
             inviwo::detail::getNodeAttribute(node, attribKey_, key);
             return identifierTransform_(key);
@@ -693,17 +709,20 @@ std::basic_istream<Elem, Traits>& operator>>(std::basic_istream<Elem, Traits>& i
 // integers, strings
 template <typename T, typename std::enable_if<!util::is_floating_point<T>::value, int>::type>
 void Deserializer::getSafeValue(std::string_view key, T& data) {
-    detail::getNodeAttribute(rootElement_, key, data);
+    detail::getNodeAttribute(currentElement(), key, data);
 }
 
 // reals specialization for reals to handled inf/nan values
 template <typename T, typename std::enable_if<util::is_floating_point<T>::value, int>::type>
 void Deserializer::getSafeValue(std::string_view key, T& data) {
+    if constexpr (std::is_floating_point_v<T>) {
+        if (binaryElement_ && binaryElement_->getNumber(key, data)) return;
+    }
     ParseWrapper<T> wrapper(data);
     try {
-        detail::getNodeAttribute(rootElement_, key, wrapper);
+        detail::getNodeAttribute(currentElement(), key, wrapper);
     } catch (SerializationException& e) {
-        NodeDebugger nd(rootElement_);
+        NodeDebugger nd(currentElement());
         throw SerializationException(e.getMessage() + ". At " + nd.getDescription(),
                                      e.getContext());
     }
@@ -800,7 +819,7 @@ void Deserializer::deserialize(std::string_view key, std::vector<T*>& vector,
     if (!vectorNodeSwitch) return;
 
     size_t i = 0;
-    detail::forEachChild(rootElement_, itemKey, [&](TxElement* child) {
+    detail::forEachChild(currentElement(), itemKey, [&](ElementRef child) {
         // In the next deserialization call do not fetch the "child" since we are looping...
         // hence the "false" as the last arg.
         NodeSwitch elementNodeSwitch(*this, child, false);
@@ -833,8 +852,8 @@ void Deserializer::deserialize(std::string_view key, std::vector<std::unique_ptr
     if (!vectorNodeSwitch) return;
 
     size_t i = 0;
-    detail::forEachChild(rootElement_, itemKey,
-                         [&](TxElement* child) {  // In the next deserialization call do not fetch
+    detail::forEachChild(currentElement(), itemKey,
+                         [&](ElementRef child) {  // In the next deserialization call do not fetch
                                                   // the "child" since we are looping...
                              // hence the "false" as the last arg.
                              NodeSwitch elementNodeSwitch(*this, child, false);
@@ -864,7 +883,7 @@ void Deserializer::deserialize(std::string_view key, std::vector<T*>& vector,
 
     auto lastInsertion = vector.begin();
 
-    detail::forEachChild(rootElement_, itemKey, [&](TxElement* child) {
+    detail::forEachChild(currentElement(), itemKey, [&](ElementRef child) {
         identifier.setKey(child);
         auto it = std::find_if(vector.begin(), vector.end(), identifier);
 
@@ -901,7 +920,7 @@ void Deserializer::deserialize(std::string_view key, std::vector<T>& vector,
     if (!vectorNodeSwitch) return;
 
     size_t i = 0;
-    detail::forEachChild(rootElement_, itemKey, [&](TxElement* child) {
+    detail::forEachChild(currentElement(), itemKey, [&](ElementRef child) {
         // In the next deserialization call do not fetch the "child" since we are looping...
         // hence the "false" as the last arg.
         NodeSwitch elementNodeSwitch(*this, child, false);
@@ -928,7 +947,7 @@ void Deserializer::deserialize(std::string_view key, std::unordered_set<T>& set,
     NodeSwitch vectorNodeSwitch(*this, key);
     if (!vectorNodeSwitch) return;
 
-    detail::forEachChild(rootElement_, itemKey, [&](TxElement* child) {
+    detail::forEachChild(currentElement(), itemKey, [&](ElementRef child) {
         // In the next deserialization call do not fetch the "child" since we are looping...
         // hence the "false" as the last arg.
         NodeSwitch elementNodeSwitch(*this, child, false);
@@ -951,8 +970,8 @@ void Deserializer::deserialize(std::string_view key, std::list<T>& container,
     NodeSwitch vectorNodeSwitch(*this, key);
     if (!vectorNodeSwitch) return;
     size_t i = 0;
-    detail::forEachChild(rootElement_, itemKey,
-                         [&](TxElement* child) {  // In the next deserialization call do not fetch
+    detail::forEachChild(currentElement(), itemKey,
+                         [&](ElementRef child) {  // In the next deserialization call do not fetch
                                                   // the "child" since we are looping...
                              // hence the "false" as the last arg.
                              NodeSwitch elementNodeSwitch(*this, child, false);
@@ -980,8 +999,8 @@ void Deserializer::deserialize(std::string_view key, std::array<T, N>& cont,
     if (!vectorNodeSwitch) return;
 
     size_t i = 0;
-    detail::forEachChild(rootElement_, itemKey,
-                         [&](TxElement* child) {  // In the next deserialization call do not fetch
+    detail::forEachChild(currentElement(), itemKey,
+                         [&](ElementRef child) {  // In the next deserialization call do not fetch
                                                   // the "child" since we are looping...
                              // hence the "false" as the last arg.
                              NodeSwitch elementNodeSwitch(*this, child, false);
@@ -1008,7 +1027,7 @@ void Deserializer::deserialize(std::string_view key, std::map<K, V, C, A>& map,
     NodeSwitch mapNodeSwitch(*this, key);
     if (!mapNodeSwitch) return;
 
-    detail::forEachChild(rootElement_, itemKey, [&](TxElement* child) {
+    detail::forEachChild(currentElement(), itemKey, [&](ElementRef child) {
         // In the next deserialization call do not fetch the "child" since we are looping...
         // hence the "false" as the last arg.
         NodeSwitch elementNodeSwitch(*this, child, false);
@@ -1037,8 +1056,8 @@ void Deserializer::deserialize(std::string_view key, std::map<K, V*, C, A>& map,
     NodeSwitch mapNodeSwitch(*this, key);
     if (!mapNodeSwitch) return;
 
-    detail::forEachChild(rootElement_, itemKey,
-                         [&](TxElement* child) {  // In the next deserialization call do not fetch
+    detail::forEachChild(currentElement(), itemKey,
+                         [&](ElementRef child) {  // In the next deserialization call do not fetch
                                                   // the "child" since we are looping...
                              // hence the "false" as the last arg.
                              NodeSwitch elementNodeSwitch(*this, child, false);
@@ -1067,7 +1086,7 @@ void Deserializer::deserialize(std::string_view key, std::map<K, std::unique_ptr
     NodeSwitch mapNodeSwitch(*this, key);
     if (!mapNodeSwitch) return;
 
-    detail::forEachChild(rootElement_, itemKey, [&](TxElement* child) {
+    detail::forEachChild(currentElement(), itemKey, [&](ElementRef child) {
         // In the next deserialization call do not fetch the "child" since we are looping...
         // hence the "false" as the last arg.
         NodeSwitch elementNodeSwitch(*this, child, false);
@@ -1098,7 +1117,7 @@ void Deserializer::deserialize(std::string_view key, std::unordered_map<K, V, H,
     NodeSwitch mapNodeSwitch(*this, key);
     if (!mapNodeSwitch) return;
 
-    detail::forEachChild(rootElement_, itemKey, [&](TxElement* child) {
+    detail::forEachChild(currentElement(), itemKey, [&](ElementRef child) {
         // In the next deserialization call do not fetch the "child" since we are looping...
         // hence the "false" as the last arg.
         NodeSwitch elementNodeSwitch(*this, child, false);
@@ -1194,7 +1213,7 @@ void Deserializer::deserialize(std::string_view key, ContainerWrapper<T, K>& con
     if (!vectorNodeSwitch) return;
     size_t i = 0;
 
-    detail::forEachChild(rootElement_, container.getItemKey(), [&](TxElement* child) {
+    detail::forEachChild(currentElement(), container.getItemKey(), [&](ElementRef child) {
         // In the next deserialization call do not fetch the "child" since we are looping...
         // hence the "false" as the last arg.
         NodeSwitch elementNodeSwitch(*this, child, false);
@@ -30,15 +30,11 @@
 #pragma once
 
 #include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/io/serialization/elementref.h>
 
 #include <string>
 #include <vector>
 
-namespace ticpp {
-class Element;
-}
-using TxElement = ticpp::Element;
-
 namespace inviwo {
 
 struct IVW_CORE_API NodeDebugger {
@@ -50,7 +46,7 @@ struct IVW_CORE_API NodeDebugger {
         int line;
     };
 
-    NodeDebugger(TxElement* node);
+    NodeDebugger(ElementRef node);
 
     const Node& operator[](std::size_t idx) const;
     std::string toString(std::size_t idx) const;
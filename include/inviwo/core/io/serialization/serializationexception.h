@@ -35,18 +35,13 @@
 
 #include <string>
 
-namespace ticpp {
-class Element;
-}
-using TxElement = ticpp::Element;
-
 namespace inviwo {
 
 class IVW_CORE_API SerializationException : public Exception {
 public:
     struct SerializationExceptionData {
         SerializationExceptionData(std::string_view k = "", std::string_view t = "",
-                                   std::string_view i = "", TxElement* n = nullptr)
+                                   std::string_view i = "", ElementRef n = nullptr)
             : key(k), type(t), id(i), nd(n) {}
         std::string key;
         std::string type;
@@ -57,7 +52,7 @@ public:
     SerializationException(std::string_view message = "",
                            ExceptionContext context = ExceptionContext(), std::string_view key = "",
                            std::string_view type = "", std::string_view id = "",
-                           TxElement* n = nullptr);
+                           ElementRef n = nullptr);
     virtual ~SerializationException() noexcept = default;
 
     virtual const std::string& getKey() const noexcept;
@@ -32,6 +32,7 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/io/serialization/serializeconstants.h>
 #include <inviwo/core/io/serialization/serializationexception.h>
+#include <inviwo/core/io/serialization/elementref.h>
 
 #include <map>
 #include <string>
@@ -47,6 +48,10 @@ namespace inviwo {
 using TxElement = ticpp::Element;
 using TxDocument = ticpp::Document;
 
+namespace binaryworkspace {
+class Document;
+}  // namespace binaryworkspace
+
 namespace config {
 #if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
 constexpr bool charconv = true;
@@ -56,14 +61,14 @@ constexpr bool charconv = false;
 }  // namespace config
 
 namespace detail {
-IVW_CORE_API std::string getNodeAttributeOrDefault(TxElement* node, const std::string& key,
+IVW_CORE_API std::string getNodeAttributeOrDefault(ElementRef node, const std::string& key,
                                                    const std::string& defaultValue);
 }
 
 template <typename T>
 struct ElementIdentifier {
     virtual ~ElementIdentifier() = default;
-    virtual void setKey(TxElement*) = 0;
+    virtual void setKey(ElementRef) = 0;
     virtual bool operator()(const T* elem) const = 0;
 };
 
@@ -74,7 +79,7 @@ struct StandardIdentifier : public ElementIdentifier<T> {
     StandardIdentifier(std::string key = "identifier", funcPtr ptr = &T::getIdentifier)
         : ptr_(ptr), key_(std::move(key)) {}
 
-    virtual void setKey(TxElement* node) {
+    virtual void setKey(ElementRef node) {
         identifier_ = detail::getNodeAttributeOrDefault(node, key_, "");
     }
     virtual bool operator()(const T* elem) const { return identifier_ == (*elem.*ptr_)(); }
@@ -119,7 +124,7 @@ public:
      * and de-serializer. Some of them are reference data manager,
      * (ticpp::Node) node switch and factory registration.
      *
-     * @param stream containing all xml data (for reading).
+     * @param stream containing all xml or binary data (for reading).
      * @param path A path that will be used to decode the location of data during deserialization.
      */
     SerializeBase(std::istream& stream, std::string_view path);
@@ -162,9 +167,17 @@ public:
 protected:
     friend class NodeSwitch;
 
+    /**
+     * The element currently being read, in the binary document if the content is binary and has
+     * not been converted to xml, otherwise in the xml document.
+     */
+    ElementRef currentElement() const;
+
     std::string fileName_;
     std::unique_ptr<TxDocument> doc_;
     TxElement* rootElement_;
+    std::unique_ptr<binaryworkspace::Document> binary_;
+    const binaryworkspace::Node* binaryElement_;
     bool retrieveChild_;
 };
 
@@ -233,7 +246,7 @@ public:
      * @param node //Parent (Ticpp Node) element.
      * @param retrieveChild whether to retrieve child node or not.
      */
-    NodeSwitch(SerializeBase& serializer, TxElement* node, bool retrieveChild = true);
+    NodeSwitch(SerializeBase& serializer, ElementRef node, bool retrieveChild = true);
 
     /**
      * \brief NodeSwitch helps track parent node during recursive/nested function calls.
@@ -264,7 +277,7 @@ public:
 private:
     std::unique_ptr<TxElement> node_;
     SerializeBase* serializer_;  // reference to serializer or deserializer
-    TxElement* storedNode_;      // Parent (Ticpp Node) element.
+    ElementRef storedNode_;      // Parent (Ticpp Node) element.
     bool storedRetrieveChild_;
 };
 
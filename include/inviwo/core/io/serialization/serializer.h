@@ -79,6 +79,15 @@ public:
      */
     virtual void writeFile(std::ostream& stream, bool format = false);
 
+    /**
+     * \brief Writes serialized data to stream in the binary workspace format.
+     *
+     * @param stream Stream to be written to, should be opened in binary mode.
+     * @throws SerializationException
+     * @see binaryworkspace
+     */
+    virtual void writeBinaryFile(std::ostream& stream);
+
     // std containers
     template <typename T, typename Pred = util::alwaysTrue, typename Proj = util::identity>
     void serialize(std::string_view key, const std::vector<T>& sVector,
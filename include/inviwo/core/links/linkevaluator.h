@@ -34,6 +34,7 @@
 #include <inviwo/core/links/propertylink.h>
 
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace inviwo {
@@ -60,6 +61,19 @@ public:
 
     void evaluateLinksFromProperty(Property*);
 
+    /**
+     * Evaluate the links of several modified properties in one pass. The links of all properties
+     * are merged, and each link is only converted once, at the position of its last occurrence.
+     * A link to a property that comes later in \p modified is skipped, since that property was
+     * set after the source.
+     *
+     * @param modified properties, ordered by when they were last modified
+     * @param evaluated properties that already have been linked, these are skipped as sources.
+     * All sources and destinations of the converted links are added.
+     */
+    void evaluateLinksFromProperties(const std::vector<Property*>& modified,
+                                     std::unordered_set<Property*>& evaluated);
+
     /**
      * Properties that are linked to the given property where the given property is a source
      * property
@@ -68,4 +68,54 @@ inline NetworkLock::~NetworkLock() {
     if (network_) network_->unlock();
 }
 
+/**
+ * A RAII utility for batching property changes. The network is locked, and the links and
+ * invalidations of all properties modified within the scope are handled once when it ends.
+ * Useful when setting many, possibly linked, properties at once.
+ * \code{.cpp}
+ * {
+ *     NetworkBatch batch;
+ *     for (auto& [property, value] : keyframe) property->set(value);
+ * }  // links are evaluated and processors invalidated here
+ * \endcode
+ * @see ProcessorNetwork::beginBatch
+ */
+struct IVW_CORE_API NetworkBatch {
+    NetworkBatch();
+    NetworkBatch(ProcessorNetwork* network);
+    NetworkBatch(Processor* network);
+    NetworkBatch(Property* network);
+    ~NetworkBatch();
+
+    NetworkBatch(NetworkBatch const&) = delete;
+    NetworkBatch& operator=(NetworkBatch const& that) = delete;
+    NetworkBatch(NetworkBatch&& rhs);
+    NetworkBatch& operator=(NetworkBatch&& that);
+
+private:
+    ProcessorNetwork* network_;
+};
+
+inline NetworkBatch::NetworkBatch(ProcessorNetwork* network) : network_(network) {
+    if (network_) {
+        network_->lock();
+        network_->beginBatch();
+    }
+}
+
+inline NetworkBatch::NetworkBatch(Processor* processor)
+    : NetworkBatch(processor ? processor->getNetwork() : nullptr) {}
+
+inline NetworkBatch::NetworkBatch(Property* property)
+    : NetworkBatch(property ? (property->getOwner() ? property->getOwner()->getProcessor()
+                                                    : nullptr)
+                            : nullptr) {}
+
+inline NetworkBatch::~NetworkBatch() {
+    if (network_) {
+        network_->endBatch();
+        network_->unlock();
+    }
+}
+
 }  // namespace inviwo
@@ -0,0 +1,129 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/metriccounters.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace inviwo {
+
+class Processor;
+
+/**
+ * \brief Per processor performance counters collected by the ProcessorNetworkEvaluator
+ *
+ * For every processor the number of invalidations and evaluations, the time spent in
+ * Processor::process, the number of representation conversions and the bytes of RAM
+ * representation storage allocated while processing are recorded. The counters can be queried
+ * from C++ and Python, written as CSV or JSON, and optionally streamed to a file after every
+ * network evaluation, see `--metrics` on the command line.
+ */
+class IVW_CORE_API ProcessorMetrics {
+public:
+    using duration = std::chrono::steady_clock::duration;
+    /// The number of process timings kept for the percentile estimate
+    static constexpr size_t historySize = 128;
+
+    struct IVW_CORE_API Entry {
+        std::string identifier;
+        std::string classIdentifier;
+        size_t invalidations = 0;
+        size_t evaluations = 0;
+        size_t conversions = 0;
+        size_t bytesAllocated = 0;
+        double lastMs = 0.0;
+        double totalMs = 0.0;
+        size_t lastConversions = 0;
+        size_t lastBytesAllocated = 0;
+        /// The network evaluation in which the processor was last processed
+        size_t lastEvaluation = 0;
+
+        double meanMs() const;
+        /// The 95th percentile of the last historySize process timings
+        double p95Ms() const;
+
+        std::array<double, historySize> history{};
+    };
+
+    ProcessorMetrics();
+    ProcessorMetrics(const ProcessorMetrics&) = delete;
+    ProcessorMetrics& operator=(const ProcessorMetrics&) = delete;
+    ~ProcessorMetrics();
+
+    /// The entry of \p processor or nullptr if it has never been invalidated or processed
+    const Entry* get(const Processor* processor) const;
+    /// All entries ordered by identifier
+    std::vector<Entry> getEntries() const;
+    /// The number of network evaluations seen since construction or the last reset
+    size_t getEvaluationCount() const;
+    void reset();
+
+    void writeCSV(std::ostream& os, bool header = true) const;
+    void writeJSON(std::ostream& os) const;
+
+    /**
+     * Append the entries of the processors that were processed to \p filename after every
+     * network evaluation. A ".csv" extension writes CSV rows, anything else one JSON object per
+     * line. An empty filename disables the log.
+     */
+    void setEvaluationLog(std::string_view filename);
+    const std::string& getEvaluationLog() const;
+
+    // Called by the ProcessorNetworkEvaluator
+    void evaluationBegin();
+    void evaluationEnd();
+    void invalidated(const Processor* processor);
+    void processed(const Processor* processor, duration time, const util::MetricCounters& before,
+                   const util::MetricCounters& after);
+    void remove(const Processor* processor);
+
+private:
+    Entry& entry(const Processor* processor);
+
+    std::unordered_map<const Processor*, Entry> entries_;
+    size_t evaluations_ = 0;
+    std::string logFile_;
+    std::unique_ptr<std::ofstream> log_;
+    bool logCSV_ = false;
+    bool logHeader_ = false;
+};
+
+}  // namespace inviwo
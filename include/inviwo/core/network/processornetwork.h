@@ -274,6 +274,29 @@ public:
     void unlock();
     bool islocked() const;
 
+    /**
+     * Start a batch of property changes. Until the matching endBatch, modified properties of
+     * processors in this network only record the change, instead of directly evaluating their
+     * links and invalidating their owners. Batches nest, only the outermost endBatch commits.
+     * Prefer the RAII helper NetworkBatch.
+     * @see NetworkBatch
+     */
+    void beginBatch();
+    /**
+     * End a batch of property changes. The outermost call evaluates the links of all modified
+     * properties in one pass over the union of their links, and then invalidates each affected
+     * owner once. Within a batch, a property that was explicitly set keeps its value against
+     * links from properties that were set before it, as if the changes were propagated in order.
+     */
+    void endBatch();
+    bool isBatching() const;
+
+    /**
+     * Record a change of \p property if a batch is active.
+     * @return true if the change was recorded, false if it should be propagated directly.
+     */
+    bool deferPropertyChange(Property* property);
+
     virtual void serialize(Serializer& s) const override;
     virtual void deserialize(Deserializer& d) override;
     bool isDeserializing() const;
@@ -314,9 +337,20 @@ private:
     void addPropertyOwnerObservation(PropertyOwner*);
     void removePropertyOwnerObservation(PropertyOwner*);
 
+    // Batch helpers
+    std::vector<Property*> takeBatchedProperties();
+    void commitBatch();
+
     static const int processorNetworkVersion_;
 
     unsigned int locked_ = 0;
+    unsigned int batching_ = 0;
+    size_t batchCounter_ = 0;
+    // Modified properties of the current batch, and the order of their last modification
+    std::unordered_map<Property*, size_t> batchedProperties_;
+    // Owners to invalidate when committing, and the level and property to invalidate with
+    std::unordered_map<PropertyOwner*, std::pair<InvalidationLevel, Property*>>
+        batchedInvalidations_;
     bool deserializing_ = false;
     int backgoundJobs_ = 0;
 
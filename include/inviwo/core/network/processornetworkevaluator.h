@@ -34,6 +34,7 @@
 #include <inviwo/core/processors/processorobserver.h>
 #include <inviwo/core/network/processornetworkevaluationobserver.h>
 #include <inviwo/core/network/evaluationerrorhandler.h>
+#include <inviwo/core/network/processormetrics.h>
 
 namespace inviwo {
 
@@ -50,6 +51,10 @@ public:
     virtual ~ProcessorNetworkEvaluator() = default;
     void setExceptionHandler(EvaluationErrorHandler handler);
 
+    /// Performance counters of the processors evaluated by this evaluator
+    ProcessorMetrics& getMetrics();
+    const ProcessorMetrics& getMetrics() const;
+
 private:
     // ProcessorNetworkObserver overrides
     virtual void onProcessorNetworkEvaluateRequest() override;
@@ -60,6 +65,7 @@ private:
     virtual void onProcessorNetworkDidRemoveConnection(const PortConnection& connection) override;
 
     // ProcessorObserver overrides
+    virtual void onProcessorInvalidationEnd(Processor*) override;
     virtual void onProcessorSinkChanged(Processor*) override;
     virtual void onProcessorActiveConnectionsChanged(Processor*) override;
 
@@ -67,10 +73,13 @@ private:
     void evaluate();
 
     ProcessorNetwork* processorNetwork_;
-    // the sorted list of processors obtained through topological sorting
+    // the sorted list of processors obtained through topological sorting, recomputed lazily on
+    // the next evaluation when sortDirty_ is set, i.e. after any change to the network topology
     std::vector<Processor*> processorsSorted_;
+    bool sortDirty_;
     bool evaulationQueued_;
     EvaluationErrorHandler exceptionHandler_;
+    ProcessorMetrics metrics_;
 };
 
 }  // namespace inviwo
@@ -0,0 +1,188 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/network/processornetworkobserver.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace inviwo {
+
+class WorkspaceManager;
+class ProcessorNetwork;
+class Processor;
+
+/**
+ * \ingroup network
+ * \brief Records states of a workspace for undo and redo.
+ *
+ * The history keeps a list of states. Each state is either a full snapshot of the workspace or a
+ * delta. A delta stores the serialized state of each changed processor before and after the
+ * change. The history observes the network to find out which processors have changed. Only those
+ * processors are serialized when a new state is pushed, and only those are deserialized on undo
+ * and redo. Changes that are not attributed to a single processor result in a full snapshot.
+ * These are added or removed processors, connections or links, renamed processors, network
+ * changes that no processor reported, and calls to markDirty(), e.g. for changes outside of the
+ * network. States of processors that did not change are shared between snapshots and deltas.
+ *
+ * The memory used by the history is capped, it is tracked as states are added and removed. When
+ * the limit is exceeded, the oldest states are dropped, up to the next full snapshot. If there is
+ * no such snapshot, the next state pushed will be a full snapshot.
+ *
+ * The history does not depend on any user interface. It is up to the caller to decide when to
+ * push a new state, typically once a user interaction has finished.
+ */
+class IVW_CORE_API WorkspaceHistory : public ProcessorNetworkObserver {
+public:
+    static constexpr size_t defaultMemoryLimit = 256 * 1024 * 1024;
+
+    WorkspaceHistory(WorkspaceManager* manager, ProcessorNetwork* network, std::string refPath,
+                     size_t memoryLimit = defaultMemoryLimit);
+    WorkspaceHistory(const WorkspaceHistory&) = delete;
+    WorkspaceHistory(WorkspaceHistory&&) = delete;
+    WorkspaceHistory& operator=(const WorkspaceHistory&) = delete;
+    WorkspaceHistory& operator=(WorkspaceHistory&&) = delete;
+    virtual ~WorkspaceHistory();
+
+    /**
+     * Record the current state of the workspace if anything changed since the last state.
+     * All states after the current one are discarded.
+     * @return true if a new state was added
+     */
+    bool pushState();
+    /**
+     * Restore the previous state
+     * @return true if a state was restored
+     */
+    bool undo();
+    /**
+     * Restore the next state
+     * @return true if a state was restored
+     */
+    bool redo();
+    bool canUndo() const;
+    bool canRedo() const;
+    /**
+     * Remove all states, the next state pushed will be a full snapshot.
+     */
+    void clear();
+
+    /**
+     * Mark the workspace as changed in a way that the history can not observe, the next state
+     * pushed will be a full snapshot.
+     */
+    void markDirty();
+    /**
+     * True if any change has been observed since the last state was pushed
+     */
+    bool isDirty() const;
+    /**
+     * True while a state is being restored, changes in that period are not recorded.
+     */
+    bool isRestoring() const;
+
+    void setMemoryLimit(size_t bytes);
+    size_t getMemoryLimit() const;
+    /**
+     * The number of bytes used by the serialized states
+     */
+    size_t getMemoryUsage() const;
+    size_t getNumberOfStates() const;
+
+    /**
+     * The serialized workspace of the current state, if it is a full snapshot, nullptr otherwise.
+     */
+    std::shared_ptr<const std::string> getWorkspace() const;
+
+private:
+    using Text = std::shared_ptr<const std::string>;
+    using ProcessorStates = std::map<std::string, Text, std::less<>>;
+    struct State {
+        // Only set for full snapshots
+        Text workspace;
+        // For full snapshots: all processors. For deltas: the changed processors with their
+        // state before and after the change.
+        ProcessorStates processors;
+        std::vector<std::tuple<std::string, Text, Text>> changes;
+    };
+    class Watcher;
+
+    bool pushSnapshot();
+    void append(State state);
+    void erase(std::vector<State>::iterator begin, std::vector<State>::iterator end);
+    void track(const State& state, bool add);
+    void enforceMemoryLimit();
+    void restore(size_t index);
+    void apply(const State& state, bool undo);
+    Text serialize(const Processor& processor) const;
+    void deserialize(Processor& processor, const std::string& text) const;
+    void markChanged(Processor* processor, bool networkChange);
+    void resetChanges();
+
+    // ProcessorNetworkObserver overrides
+    virtual void onProcessorNetworkChange() override;
+    virtual void onProcessorNetworkDidAddProcessor(Processor* processor) override;
+    virtual void onProcessorNetworkWillRemoveProcessor(Processor* processor) override;
+    virtual void onProcessorNetworkDidAddConnection(const PortConnection& connection) override;
+    virtual void onProcessorNetworkDidRemoveConnection(const PortConnection& connection) override;
+    virtual void onProcessorNetworkDidAddLink(const PropertyLink& propertyLink) override;
+    virtual void onProcessorNetworkDidRemoveLink(const PropertyLink& propertyLink) override;
+
+    WorkspaceManager* manager_;
+    ProcessorNetwork* network_;
+    std::string refPath_;
+    size_t memoryLimit_;
+
+    std::vector<State> states_;
+    size_t head_ = 0;
+    // Number of states referring to each text, and the total size of all referred texts
+    std::unordered_map<const std::string*, size_t> references_;
+    size_t memoryUsage_ = 0;
+    // The serialized processors of the current state
+    ProcessorStates current_;
+
+    bool restoring_ = false;
+    bool dirty_ = true;
+    bool structural_ = true;
+    // Network changes minus the processor changes that caused them. Any surplus comes from
+    // outside the observed processors and requires a full snapshot.
+    int unattributed_ = 0;
+    std::unordered_set<Processor*> changed_;
+    std::unordered_map<Processor*, std::unique_ptr<Watcher>> watchers_;
+};
+
+}  // namespace inviwo
@@ -50,6 +50,13 @@ enum class WorkspaceSaveMode { Disk = 1 << 0, Undo = 1 << 1 };
 ALLOW_FLAGS_FOR_ENUM(WorkspaceSaveMode)
 using WorkspaceSaveModes = flags::flags<WorkspaceSaveMode>;
 
+/**
+ * The encoding of a saved workspace, workspaces are loaded in either format.
+ * Binary workspaces use the ".invb" file extension.
+ * @see binaryworkspace
+ */
+enum class WorkspaceFormat { Xml, Binary };
+
 /**
  * The WorkspaceManager is responsible for clearing, loading, and saving a workspace. Different
  * items such as the processor network can register callbacks for clearing, loading, or saving a
@@ -92,13 +99,16 @@ public:
      *      saved file.
      * \param exceptionHandler A callback for handling errors.
      * \param mode to indicate if we are saving to disk or undo-stack
+     * \param format the encoding to write, binary streams should be opened in binary mode.
      */
     void save(std::ostream& stream, std::string_view refPath,
               const ExceptionHandler& exceptionHandler = StandardExceptionHandler(),
-              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk);
+              WorkspaceSaveMode mode = WorkspaceSaveMode::Disk,
+              WorkspaceFormat format = WorkspaceFormat::Xml);
 
     /**
-     * Save the current workspace to a file
+     * Save the current workspace to a file, in the binary format if the file extension is
+     * ".invb" and as xml otherwise.
      * \param path the file to save into.
      * \param exceptionHandler A callback for handling errors.
      * \param mode to indicate if we are saving to disk or undo-stack
@@ -108,7 +118,7 @@ public:
               WorkspaceSaveMode mode = WorkspaceSaveMode::Disk);
 
     /**
-     * Load a workspace from a stream
+     * Load a workspace from a stream, in xml or binary format
      * \param stream the stream to read from.
      * \param refPath a reference that that can be use by the deserializer to calculate relative
      *      paths. The same refPath should be given when loading. Most often this should be the
@@ -292,7 +292,7 @@ private:
     template <typename Job>
     void setupProgress();
 
-    void progress(pool::detail::State* state, float progress);
+    void progress(pool::detail::State* state);
 
     template <typename Result, typename Done>
     std::shared_ptr<pool::detail::StateTemplate<Result, Done>> makeState(size_t count, Done&& done);
@@ -330,7 +330,7 @@ struct IVW_CORE_API State {
     std::atomic<size_t> count;
     std::atomic<bool> stop;
     std::vector<std::atomic<float>> progress;
-    std::future<void> progressUpdate;
+    FrontQueue::Token progressUpdate = FrontQueue::makeToken();
     size_t nJobs;
 
     Stop getStop() { return Stop(stop); }
@@ -37,6 +37,7 @@
 #include <vector>
 #include <memory>
 #include <string_view>
+#include <unordered_map>
 #include <tcb/span.hpp>
 
 namespace inviwo {
@@ -117,9 +118,19 @@ public:
     const std::vector<Property*>& getProperties() const;
     const std::vector<CompositeProperty*>& getCompositeProperties() const;
     std::vector<Property*> getPropertiesRecursive() const;
+
+    /**
+     * Find the property with identifier \p identifier. The properties of this owner are found
+     * through a hash index, a recursive search only has to look into each composite property.
+     */
     Property* getPropertyByIdentifier(std::string_view identifier,
                                       bool recursiveSearch = false) const;
 
+    /**
+     * Find the property at \p path, a dot separated list of identifiers relative to this owner,
+     * i.e. "composite.subproperty". Found paths are cached until the properties of this owner or
+     * any of its composite properties change.
+     */
     Property* getPropertyByPath(std::string_view path) const;
 
     template <class T>
@@ -184,9 +195,22 @@ protected:
                          bool recursiveSearch = false) const;
 
 private:
+    friend Property;
     Property* removeProperty(std::vector<Property*>::iterator it);
     bool findPropsForComposites(TxElement*);
+
+    // Called by the property when its identifier changes.
+    void indexProperty(Property* property);
+    void unindexProperty(Property* property);
+    // Called on any structural change, clears the cache of this and all owners above.
+    void invalidatePathCache();
+
     InvalidationLevel invalidationLevel_;
+
+    // Identifier to property, the keys refer to the identifiers of the properties.
+    std::unordered_map<std::string_view, Property*> identifierIndex_;
+    // Hash of path to path and property. Keyed by hash to avoid allocating on lookup.
+    mutable std::unordered_map<size_t, std::pair<std::string, Property*>> pathCache_;
 };
 
 template <class T>
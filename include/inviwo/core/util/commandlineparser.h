@@ -103,10 +103,24 @@ public:
     const std::string getOutputPath() const;
     const std::string getWorkspacePath() const;
     const std::string getLogToFileFileName() const;
+    /**
+     * The file given by --trace, where a Chrome trace of the session should be written.
+     * @see Tracer
+     */
+    const std::string getTraceFileName() const;
     bool getQuitApplicationAfterStartup() const;
     bool getLoadWorkspaceFromArg() const;
     bool getShowSplashScreen() const;
     bool getLogToFile() const;
+    bool getTrace() const;
+
+    /**
+     * The file given by --metrics, where per processor performance counters are written after
+     * every network evaluation.
+     * @see ProcessorMetrics
+     */
+    const std::string getMetricsFileName() const;
+    bool getMetrics() const;
     bool getLogToConsole() const;
     bool getDisableResourceManager() const;
 
@@ -128,6 +142,8 @@ private:
     TCLAP::ValueArg<std::string> workspace_;
     TCLAP::ValueArg<std::string> outputPath_;
     TCLAP::ValueArg<std::string> logfile_;
+    TCLAP::ValueArg<std::string> tracefile_;
+    TCLAP::ValueArg<std::string> metricsfile_;
     TCLAP::SwitchArg logConsole_;
     TCLAP::SwitchArg noSplashScreen_;
     TCLAP::SwitchArg quitAfterStartup_;
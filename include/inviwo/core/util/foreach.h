@@ -32,6 +32,7 @@
 #include <inviwo/core/common/inviwocoredefine.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/settings/systemsettings.h>
+#include <inviwo/core/util/threadutil.h>
 
 #include <utility>
 
@@ -122,23 +123,26 @@ std::vector<std::future<void>> forEachParallelAsync(const Iterable& iterable, Ca
  * Use multiple threads to iterate over all elements in an iterable data structure (such as
  * std::vector). If the Inviwo pool size is zero it will be executed directly in the same thread as
  * the caller.
- * The function will return once all jobs as has finished processing.
+ * The function will return once all jobs as has finished processing. The calling thread takes
+ * part in the work, see cooperativeFor.
  *
  * @param iterable the data structure to iterate over
  * @param callback to call for each element, can be either `[](auto &a){}` or `[](auto &a,
  * size_t id){}` where `a` is an data item from the iterable data structure and `id` is the index in
  * the data structure
  * @param jobs optional parameter specifying how many jobs to create, if jobs==0 (default) it will
- * create pool size * 4 jobs
+ * create 4 jobs per thread, see util::concurrency()
  */
 template <typename Iterable, typename Callback>
 void forEachParallel(const Iterable& iterable, Callback&& callback, size_t jobs = 0) {
-    const auto futures =
-        forEachParallelAsync<Iterable, Callback>(iterable, std::forward<Callback>(callback), jobs);
+    if (jobs == 0) jobs = 4 * concurrency();
 
-    for (const auto& e : futures) {
-        e.wait();
-    }
+    const auto s = iterable.size();
+    cooperativeFor(jobs, [&](size_t job) {
+        const size_t start = (s * job) / jobs;
+        const size_t end = (s * (job + 1)) / jobs;
+        detail::foreach (std::begin(iterable) + start, std::begin(iterable) + end, callback, start);
+    });
 }
 
 }  // namespace util
@@ -0,0 +1,224 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \ingroup util
+ * A multi producer single consumer queue of tasks to be run in the front (GUI) thread.
+ *
+ * Producers enqueue into a fixed ring of preallocated cells without taking locks. Tasks with small
+ * captures are stored inline in the cells, so enqueuing does not allocate. Should the ring ever
+ * fill up, tasks spill over into a mutex protected list, which preserves the order of the tasks of
+ * each producer.
+ *
+ * A task can be posted with a coalescing token, then further posts with the same token are dropped
+ * until the task has run. Such tasks should read the state they report when they run rather than
+ * capture it, e.g. the latest progress of a job.
+ *
+ * Only one thread may call process at a time.
+ */
+class IVW_CORE_API FrontQueue {
+public:
+    using clock_t = std::chrono::steady_clock;
+    using Token = std::shared_ptr<std::atomic<bool>>;
+
+    /**
+     * A move only type erased task. Callables that fit in the inline buffer and are nothrow move
+     * constructible are stored inline, others are allocated on the heap.
+     */
+    class IVW_CORE_API Task {
+    public:
+        static constexpr size_t bufferSize = 48;
+
+        Task() noexcept = default;
+        template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+        Task(F&& f);  // NOLINT(google-explicit-constructor)
+        Task(Task&& rhs) noexcept;
+        Task& operator=(Task&& rhs) noexcept;
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        ~Task();
+
+        explicit operator bool() const noexcept { return ops_ != nullptr; }
+        void operator()();
+        void reset() noexcept;
+
+    private:
+        struct Ops {
+            void (*invoke)(void*);
+            void (*move)(void* dst, void* src) noexcept;
+            void (*destroy)(void*) noexcept;
+        };
+        template <typename F>
+        static constexpr bool fitsInline =
+            sizeof(F) <= bufferSize && alignof(F) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<F>;
+        template <typename F>
+        static const Ops* inlineOps();
+        template <typename F>
+        static const Ops* heapOps();
+
+        alignas(std::max_align_t) unsigned char buffer_[bufferSize];
+        const Ops* ops_ = nullptr;
+    };
+
+    struct Metrics {
+        size_t depth = 0;         ///< Number of tasks currently waiting
+        size_t maxDepth = 0;      ///< Largest number of waiting tasks seen
+        size_t processed = 0;     ///< Number of tasks run
+        size_t coalesced = 0;     ///< Number of posts dropped by coalescing
+        size_t overflowed = 0;    ///< Number of tasks that did not fit in the ring
+        double meanLatency = 0.0;  ///< Moving average of the time from post to run, in ms
+        double maxLatency = 0.0;   ///< Largest time from post to run, in ms
+    };
+
+    explicit FrontQueue(size_t capacity = 1024);
+    FrontQueue(const FrontQueue&) = delete;
+    FrontQueue& operator=(const FrontQueue&) = delete;
+    ~FrontQueue();
+
+    static Token makeToken();
+
+    /**
+     * Enqueue \p task. Returns true if the consumer should be woken up, i.e. if no wake up is
+     * pending since the last call to process.
+     */
+    bool push(Task task);
+
+    /**
+     * Enqueue \p task unless a task posted with \p token is still waiting. Returns true if the
+     * consumer should be woken up.
+     */
+    bool push(const Token& token, Task task);
+
+    /**
+     * Run waiting tasks, including tasks enqueued while processing, until the queue is empty.
+     * Returns the number of tasks left.
+     */
+    size_t process();
+
+    /**
+     * Run waiting tasks until the queue is empty or \p budget has passed. At least one task is run.
+     * Returns the number of tasks left, the caller should schedule another call if it is not zero.
+     */
+    size_t process(clock_t::duration budget);
+
+    /// The number of waiting tasks
+    size_t size() const;
+
+    Metrics getMetrics() const;
+    void resetMetrics();
+
+private:
+    struct Item {
+        Task task;
+        Token token;
+        clock_t::time_point posted;
+    };
+    struct Cell {
+        std::atomic<size_t> sequence;
+        Item item;
+    };
+
+    bool enqueue(Item& item);
+    bool tryPushRing(Item& item);
+    bool tryPopRing(Item& item);
+    bool tryPop(Item& item);
+    void run(Item& item);
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> enqueuePos_{0};
+    alignas(64) size_t dequeuePos_ = 0;
+
+    std::mutex overflowMutex_;
+    std::deque<Item> overflow_;
+    std::atomic<bool> overflowing_{false};
+
+    std::atomic<bool> wakeUpPending_{false};
+
+    std::atomic<size_t> posted_{0};
+    std::atomic<size_t> processed_{0};
+    std::atomic<size_t> maxDepth_{0};
+    std::atomic<size_t> coalesced_{0};
+    std::atomic<size_t> overflowed_{0};
+    std::atomic<double> meanLatency_{0.0};
+    std::atomic<double> maxLatency_{0.0};
+};
+
+template <typename F>
+auto FrontQueue::Task::inlineOps() -> const Ops* {
+    static constexpr Ops ops{
+        [](void* f) { (*static_cast<F*>(f))(); },
+        [](void* dst, void* src) noexcept {
+            new (dst) F(std::move(*static_cast<F*>(src)));
+            static_cast<F*>(src)->~F();
+        },
+        [](void* f) noexcept { static_cast<F*>(f)->~F(); }};
+    return &ops;
+}
+
+template <typename F>
+auto FrontQueue::Task::heapOps() -> const Ops* {
+    static constexpr Ops ops{
+        [](void* f) { (**static_cast<F**>(f))(); },
+        [](void* dst, void* src) noexcept { new (dst) F*(*static_cast<F**>(src)); },
+        [](void* f) noexcept { delete *static_cast<F**>(f); }};
+    return &ops;
+}
+
+template <typename F, typename>
+FrontQueue::Task::Task(F&& f) {
+    using Fn = std::decay_t<F>;
+    if constexpr (fitsInline<Fn>) {
+        new (buffer_) Fn(std::forward<F>(f));
+        ops_ = inlineOps<Fn>();
+    } else {
+        new (buffer_) Fn*(new Fn(std::forward<F>(f)));
+        ops_ = heapOps<Fn>();
+    }
+}
+
+}  // namespace inviwo
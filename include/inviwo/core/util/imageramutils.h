@@ -35,6 +35,7 @@
 #include <inviwo/core/datastructures/image/image.h>
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/datastructures/image/layerram.h>
+#include <inviwo/core/util/threadutil.h>
 
 #include <memory>
 #include <vector>
@@ -65,33 +66,19 @@ void forEachPixel(const LayerRAM& layer, C callback) {
 
 template <typename C>
 void forEachPixelParallel(const size2_t dims, C callback, size_t jobs = 0) {
-    if (jobs == 0) {
-        jobs = 4 * detail::getPoolSize();
-        if (jobs == 0) {  // if poolsize is zero
-            forEachPixel(dims, callback);
-            return;
-        }
-    }
+    if (jobs == 0) jobs = 4 * concurrency();
 
-    std::vector<std::future<void>> futures;
-    for (size_t job = 0; job < jobs; ++job) {
-        size2_t start = size2_t(0, job * dims.y / jobs);
-        size2_t stop = size2_t(dims.x, std::min(dims.y, (job + 1) * dims.y / jobs));
+    cooperativeFor(jobs, [&](size_t job) {
+        const size2_t start = size2_t(0, job * dims.y / jobs);
+        const size2_t stop = size2_t(dims.x, std::min(dims.y, (job + 1) * dims.y / jobs));
 
-        futures.push_back(dispatchPool([&callback, start, stop]() {
-            size2_t pos{0};
-
-            for (pos.y = start.y; pos.y < stop.y; ++pos.y) {
-                for (pos.x = start.x; pos.x < stop.x; ++pos.x) {
-                    callback(pos);
-                }
+        size2_t pos{0};
+        for (pos.y = start.y; pos.y < stop.y; ++pos.y) {
+            for (pos.x = start.x; pos.x < stop.x; ++pos.x) {
+                callback(pos);
             }
-        }));
-    }
-
-    for (const auto& e : futures) {
-        e.wait();
-    }
+        }
+    });
 }
 
 template <typename C>
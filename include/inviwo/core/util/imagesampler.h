@@ -58,14 +58,13 @@ class ImageSpatialSampler : public SpatialSampler<2, DataDims, T> {
 public:
     /**
      * Creates a ImageSpatialSampler for the given LayerRAM, does not take ownership of ram.
-     * Use ImageSpatialSampler(std::shared_ptr<const Image>) to ensure that the LayerRAM is
-     * available for the lifetime of the ImageSpatialSampler
+     * The spatial information is taken from the owner of \p ram. Representations are shared
+     * between copies of a Layer, so the owner might be a different Layer than the one \p ram was
+     * retrieved from. Use ImageSpatialSampler(const Layer*) instead.
      */
-    ImageSpatialSampler(const LayerRAM* ram)
-        : SpatialSampler<2, DataDims, T>(*ram->getOwner())
-        , layer_(ram)
-        , dims_(layer_->getDimensions())
-        , sharedImage_(nullptr) {}
+    [[deprecated("Use `ImageSpatialSampler(const Layer*)` instead")]] ImageSpatialSampler(
+        const LayerRAM* ram)
+        : ImageSpatialSampler(*ram->getOwner(), ram) {}
 
     /**
      * Creates a ImageSpatialSampler for the given Layer, does not take ownership of ram.
@@ -73,7 +72,7 @@ public:
      * for the lifetime of the ImageSpatialSampler
      */
     ImageSpatialSampler(const Layer* layer)
-        : ImageSpatialSampler(layer->getRepresentation<LayerRAM>()) {}
+        : ImageSpatialSampler(*layer, layer->getRepresentation<LayerRAM>()) {}
 
     /**
      * Creates a ImageSpatialSampler for the given Image, does not take ownership of ram.
@@ -136,6 +135,12 @@ protected:
     }
 
 private:
+    ImageSpatialSampler(const Layer& layer, const LayerRAM* ram)
+        : SpatialSampler<2, DataDims, T>(layer)
+        , layer_(ram)
+        , dims_(layer_->getDimensions())
+        , sharedImage_(nullptr) {}
+
     dvec4 getPixel(const size2_t& pos) const {
         auto p = glm::clamp(pos, size2_t(0), dims_ - size2_t(1));
         return layer_->getAsDVec4(p);
@@ -0,0 +1,86 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <string_view>
+#include <cstddef>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \class MemoryMappedFile
+ * \brief RAII class for a read only memory mapping of a file.
+ * The whole file is mapped into the address space of the process on construction and
+ * unmapped on destruction. Pages are loaded lazily by the operating system when accessed,
+ * which makes this suitable for reading large binary files without an intermediate copy.
+ * @see MemoryFileHandle
+ */
+class IVW_CORE_API MemoryMappedFile {
+public:
+    /**
+     * Map the file at \p filePath into memory.
+     * @throw FileException if the file could not be opened or mapped
+     */
+    explicit MemoryMappedFile(std::string_view filePath);
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    MemoryMappedFile(MemoryMappedFile&& rhs) noexcept;
+    MemoryMappedFile& operator=(MemoryMappedFile&& rhs) noexcept;
+
+    ~MemoryMappedFile();
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+
+private:
+    void unmap();
+
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef WIN32
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#else
+    int file_ = -1;
+#endif
+};
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,116 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace inviwo {
+
+namespace util {
+
+/**
+ * \ingroup util
+ * A mergeable sketch of the distribution of a stream of values, used to answer quantile queries
+ * over data that is too large to copy and sort, e.g. the percentiles of a volume. It follows
+ * the KLL construction: values are kept in a stack of compactors where an item at level h
+ * represents 2^h input values. When a compactor is full it is sorted and every other item is
+ * promoted to the level above, the capacities shrink geometrically towards the bottom of the
+ * stack. The memory used is O(k) independent of the number of values and the rank error of a
+ * query is roughly 1.7 / k, i.e. around 1% for the default k.
+ *
+ * As long as fewer than k values have been added nothing is compacted and the quantiles are
+ * exact. Sketches built over disjoint parts of the data can be merged, which makes it possible
+ * to compute them in parallel. The compactors alternate deterministically between keeping the
+ * odd and the even items, so the result does not depend on a random seed.
+ * NaNs are ignored.
+ */
+class IVW_CORE_API QuantileSketch {
+public:
+    static constexpr size_t defaultK = 200;
+
+    explicit QuantileSketch(size_t k = defaultK);
+
+    void add(double value);
+    void merge(const QuantileSketch& other);
+
+    /**
+     * The value below which a fraction \p q of the values lie, using the nearest rank method,
+     * i.e. the value with rank ceil(q * N). q = 0 and q = 1 give the exact min and max.
+     * @throw Exception if q is outside [0, 1] or the sketch is empty
+     */
+    double quantile(double q) const;
+    /**
+     * Same as quantile but for several fractions at once, which only sorts the retained items
+     * once.
+     */
+    std::vector<double> quantiles(const std::vector<double>& qs) const;
+
+    /**
+     * Total number of values added, including the ones merged from other sketches
+     */
+    std::uint64_t count() const;
+    bool empty() const;
+    /**
+     * True if no values have been compacted away and quantile queries are exact
+     */
+    bool isExact() const;
+
+    double min() const;
+    double max() const;
+
+    size_t getK() const;
+    /**
+     * Number of items currently retained by the sketch
+     */
+    size_t retained() const;
+
+private:
+    size_t capacity(size_t level) const;
+    void compress();
+    void compact(size_t level);
+
+    size_t k_;
+    std::vector<std::vector<double>> levels_;
+    std::vector<bool> parity_;
+    size_t retained_ = 0;
+    size_t maxRetained_ = 0;
+    std::uint64_t count_ = 0;
+    double min_ = std::numeric_limits<double>::max();
+    double max_ = std::numeric_limits<double>::lowest();
+};
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,189 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <map>
+#include <unordered_map>
+#include <type_traits>
+#include <vector>
+#include <utility>
+
+namespace inviwo {
+
+/**
+ * How newly allocated representation storage should be initialized. Use Uninitialized only when
+ * the producer is guaranteed to overwrite every element, e.g. when downloading a texture or
+ * decompressing into the buffer.
+ */
+enum class DataInitialization { Zero, Uninitialized };
+
+/**
+ * \ingroup util
+ * Allocator for the large arrays backing RAM representations. Blocks are rounded up to a size
+ * class, with four classes per power of two, and freed blocks are kept in a cache so that the
+ * next evaluation producing a representation of the same size gets already faulted-in memory
+ * back instead of going to the system allocator. Blocks smaller than minPooledBytes are passed
+ * straight through.
+ *
+ * Two optional backings are available:
+ *  * Huge pages: on Linux blocks of at least hugePageSize are mapped with mmap and advised to
+ *    use transparent huge pages, which reduces the number of page faults and TLB misses.
+ *  * Parallel first touch: zero-initialization of large blocks is split over the thread pool.
+ *    Since memory is placed on the NUMA node of the thread that first touches it, this spreads
+ *    the pages over the nodes of the workers that will later process them.
+ *
+ * The pool is thread safe. The settings are exposed in the SystemSettings.
+ */
+class IVW_CORE_API RAMPool {
+public:
+    struct Stats {
+        size_t allocations = 0;  ///< Number of allocations served
+        size_t poolHits = 0;     ///< Allocations served from the cache
+        size_t liveBytes = 0;    ///< Bytes currently handed out
+        size_t cachedBytes = 0;  ///< Bytes kept in the cache for reuse
+    };
+
+    static constexpr size_t minPooledBytes = size_t{1} << 16;
+    static constexpr size_t hugePageSize = size_t{1} << 21;
+    static constexpr size_t defaultCacheLimit = size_t{1} << 30;
+
+    static RAMPool& get();
+
+    RAMPool(size_t cacheLimit = defaultCacheLimit);
+    RAMPool(const RAMPool&) = delete;
+    RAMPool& operator=(const RAMPool&) = delete;
+    ~RAMPool();
+
+    /**
+     * Allocate at least \p bytes of memory aligned to 64 bytes.
+     * @throws std::bad_alloc if the memory could not be allocated
+     */
+    void* allocate(size_t bytes, DataInitialization init = DataInitialization::Zero);
+    /**
+     * Return memory obtained from allocate to the pool.
+     */
+    void deallocate(void* ptr) noexcept;
+
+    /**
+     * Set the maximum number of bytes kept in the cache, excess blocks are released immediately.
+     */
+    void setCacheLimit(size_t bytes);
+    size_t getCacheLimit() const;
+
+    void setHugePages(bool enable);
+    bool getHugePages() const;
+
+    void setParallelFirstTouch(bool enable);
+    bool getParallelFirstTouch() const;
+
+    /**
+     * Release all cached blocks back to the system.
+     */
+    void clear();
+
+    Stats getStats() const;
+
+    /**
+     * The number of bytes actually reserved for an allocation of \p bytes.
+     */
+    static size_t sizeClass(size_t bytes);
+
+private:
+    struct Block {
+        size_t bytes;
+        bool mapped;
+    };
+    struct Cached {
+        void* ptr;
+        bool mapped;
+    };
+
+    static void* allocateBlock(size_t bytes, bool mapped);
+    static void releaseBlock(void* ptr, const Block& block) noexcept;
+    std::vector<std::pair<void*, Block>> evict(size_t limit);
+    static void zero(void* ptr, size_t bytes, bool parallel);
+
+    mutable std::mutex mutex_;
+    std::unordered_map<void*, Block> live_;
+    std::multimap<size_t, Cached> cache_;
+    size_t cacheLimit_;
+    bool hugePages_ = false;
+    bool parallelFirstTouch_ = true;
+    Stats stats_;
+};
+
+namespace util {
+
+/**
+ * Deleter for representation storage, returns pooled blocks to the RAMPool and deletes external
+ * data handed to the representation, which is expected to have been allocated with new[].
+ */
+template <typename T>
+struct RAMDeleter {
+    bool pooled = false;
+    void operator()(T* ptr) const noexcept {
+        if (pooled) {
+            RAMPool::get().deallocate(ptr);
+        } else {
+            delete[] ptr;
+        }
+    }
+};
+
+template <typename T>
+using RAMArray = std::unique_ptr<T[], RAMDeleter<T>>;
+
+/**
+ * Allocate storage for \p size elements of T from the RAMPool.
+ */
+template <typename T>
+RAMArray<T> allocateRAM(size_t size, DataInitialization init = DataInitialization::Zero) {
+    static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>,
+                  "Pooled storage is only supported for trivial types");
+    return RAMArray<T>{static_cast<T*>(RAMPool::get().allocate(size * sizeof(T), init)),
+                       RAMDeleter<T>{true}};
+}
+
+/**
+ * Take ownership of \p data allocated with new[].
+ */
+template <typename T>
+RAMArray<T> adoptRAM(T* data) {
+    return RAMArray<T>{data, RAMDeleter<T>{false}};
+}
+
+}  // namespace util
+
+}  // namespace inviwo
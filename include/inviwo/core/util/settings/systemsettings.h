@@ -51,6 +51,11 @@ public:
     StringProperty workspaceAuthor_;
     TemplateOptionProperty<UsageMode> applicationUsageMode_;
     IntSizeTProperty poolSize_;
+    IntSizeTProperty maxConcurrency_;  ///< Threads per parallel region, 0 for pool size + 1
+    IntProperty frontQueueBudget_;     ///< In ms per event loop iteration, 0 for no limit
+    IntSizeTProperty ramPoolCacheSize_;  ///< In MB, see RAMPool
+    BoolProperty ramPoolHugePages_;
+    BoolProperty ramPoolFirstTouch_;
     BoolProperty enablePortInspectors_;
     IntProperty portInspectorSize_;
     BoolProperty enableTouchProperty_;
@@ -59,6 +59,16 @@ public:
     virtual bool withinBounds(const dvec4& pos, Space space = Space::Data) const;
     virtual bool withinBounds(const vec4& pos, Space space = Space::Data) const;
 
+    /**
+     * Sample \p count data space positions at once. Subclasses can override
+     * sampleDataSpaceBatch to avoid the virtual call and the setup per sample.
+     */
+    void sample(const dvec4* pos, Vector<DataDims, T>* result, size_t count) const;
+    /**
+     * Test \p count data space positions at once.
+     */
+    void withinBounds(const dvec4* pos, bool* result, size_t count) const;
+
     const SpatialCoordinateTransformer<3>& getCoordinateTransformer() const;
     mat4 getModelMatrix() const;
     mat4 getWorldMatrix() const;
@@ -67,6 +77,10 @@ protected:
     virtual Vector<DataDims, T> sampleDataSpace(const dvec4& pos) const = 0;
     virtual bool withinBoundsDataSpace(const dvec4& pos) const = 0;
 
+    virtual void sampleDataSpaceBatch(const dvec4* pos, Vector<DataDims, T>* result,
+                                      size_t count) const;
+    virtual void withinBoundsDataSpaceBatch(const dvec4* pos, bool* result, size_t count) const;
+
     std::shared_ptr<const SpatialEntity<3>> spatialEntity_;
 };
 
@@ -134,6 +148,35 @@ bool Spatial4DSampler<DataDims, T>::withinBounds(const vec4& pos, Space space) c
     return withinBounds(static_cast<dvec4>(pos), space);
 }
 
+template <unsigned DataDims, typename T>
+void Spatial4DSampler<DataDims, T>::sample(const dvec4* pos, Vector<DataDims, T>* result,
+                                           size_t count) const {
+    sampleDataSpaceBatch(pos, result, count);
+}
+
+template <unsigned DataDims, typename T>
+void Spatial4DSampler<DataDims, T>::withinBounds(const dvec4* pos, bool* result,
+                                                 size_t count) const {
+    withinBoundsDataSpaceBatch(pos, result, count);
+}
+
+template <unsigned DataDims, typename T>
+void Spatial4DSampler<DataDims, T>::sampleDataSpaceBatch(const dvec4* pos,
+                                                         Vector<DataDims, T>* result,
+                                                         size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = sampleDataSpace(pos[i]);
+    }
+}
+
+template <unsigned DataDims, typename T>
+void Spatial4DSampler<DataDims, T>::withinBoundsDataSpaceBatch(const dvec4* pos, bool* result,
+                                                               size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = withinBoundsDataSpace(pos[i]);
+    }
+}
+
 template <unsigned DataDims, typename T>
 const SpatialCoordinateTransformer<3>& Spatial4DSampler<DataDims, T>::getCoordinateTransformer()
     const {
@@ -32,6 +32,9 @@
 #include <inviwo/core/datastructures/spatialdata.h>
 #include <inviwo/core/datastructures/datatraits.h>
 
+#include <algorithm>
+#include <array>
+
 namespace inviwo {
 
 /**
@@ -60,6 +63,17 @@ public:
     virtual bool withinBounds(const Vector<SpatialDims, double>& pos, Space space) const;
     virtual bool withinBounds(const Vector<SpatialDims, float>& pos, Space space) const;
 
+    /**
+     * Sample \p count positions at once, positions are in the space of the sampler. Subclasses
+     * can override sampleDataSpaceBatch to avoid the virtual call and the setup per sample.
+     */
+    void sample(const Vector<SpatialDims, double>* pos, Vector<DataDims, T>* result,
+                size_t count) const;
+    /**
+     * Test \p count positions at once, positions are in the space of the sampler.
+     */
+    void withinBounds(const Vector<SpatialDims, double>* pos, bool* result, size_t count) const;
+
     Matrix<SpatialDims, float> getBasis() const;
     Matrix<SpatialDims + 1, float> getModelMatrix() const;
     Matrix<SpatialDims + 1, float> getWorldMatrix() const;
@@ -70,6 +84,19 @@ protected:
     virtual Vector<DataDims, T> sampleDataSpace(const Vector<SpatialDims, double>& pos) const = 0;
     virtual bool withinBoundsDataSpace(const Vector<SpatialDims, double>& pos) const = 0;
 
+    virtual void sampleDataSpaceBatch(const Vector<SpatialDims, double>* pos,
+                                      Vector<DataDims, T>* result, size_t count) const;
+    virtual void withinBoundsDataSpaceBatch(const Vector<SpatialDims, double>* pos, bool* result,
+                                            size_t count) const;
+
+    /**
+     * Transform \p count positions to data space in blocks and call \p func(dataPos, offset, n)
+     * for each block.
+     */
+    template <typename Func>
+    void forEachDataSpaceBlock(const Vector<SpatialDims, double>* pos, size_t count,
+                               Func&& func) const;
+
     Space space_;
     const SpatialEntity<SpatialDims>& spatialEntity_;
     Matrix<SpatialDims + 1, double> transform_;
@@ -171,6 +198,62 @@ bool SpatialSampler<SpatialDims, DataDims, T>::withinBounds(const Vector<Spatial
     }
 }
 
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+void SpatialSampler<SpatialDims, DataDims, T>::sample(const Vector<SpatialDims, double>* pos,
+                                                      Vector<DataDims, T>* result,
+                                                      size_t count) const {
+    if (space_ != Space::Data) {
+        forEachDataSpaceBlock(pos, count, [&](const auto* dataPos, size_t offset, size_t n) {
+            sampleDataSpaceBatch(dataPos, result + offset, n);
+        });
+    } else {
+        sampleDataSpaceBatch(pos, result, count);
+    }
+}
+
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+void SpatialSampler<SpatialDims, DataDims, T>::withinBounds(const Vector<SpatialDims, double>* pos,
+                                                            bool* result, size_t count) const {
+    if (space_ != Space::Data) {
+        forEachDataSpaceBlock(pos, count, [&](const auto* dataPos, size_t offset, size_t n) {
+            withinBoundsDataSpaceBatch(dataPos, result + offset, n);
+        });
+    } else {
+        withinBoundsDataSpaceBatch(pos, result, count);
+    }
+}
+
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+void SpatialSampler<SpatialDims, DataDims, T>::sampleDataSpaceBatch(
+    const Vector<SpatialDims, double>* pos, Vector<DataDims, T>* result, size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = sampleDataSpace(pos[i]);
+    }
+}
+
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+void SpatialSampler<SpatialDims, DataDims, T>::withinBoundsDataSpaceBatch(
+    const Vector<SpatialDims, double>* pos, bool* result, size_t count) const {
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = withinBoundsDataSpace(pos[i]);
+    }
+}
+
+template <unsigned int SpatialDims, unsigned int DataDims, typename T>
+template <typename Func>
+void SpatialSampler<SpatialDims, DataDims, T>::forEachDataSpaceBlock(
+    const Vector<SpatialDims, double>* pos, size_t count, Func&& func) const {
+    std::array<Vector<SpatialDims, double>, 16> block;
+    for (size_t offset = 0; offset < count; offset += block.size()) {
+        const auto n = std::min(block.size(), count - offset);
+        for (size_t i = 0; i < n; ++i) {
+            const auto p = transform_ * Vector<SpatialDims + 1, double>(pos[offset + i], 1.0);
+            block[i] = Vector<SpatialDims, double>(p) / p[SpatialDims];
+        }
+        func(block.data(), offset, n);
+    }
+}
+
 template <unsigned int SpatialDims, unsigned int DataDims, typename T>
 const SpatialCoordinateTransformer<SpatialDims>&
 SpatialSampler<SpatialDims, DataDims, T>::getCoordinateTransformer() const {
@@ -280,6 +280,12 @@ IVW_CORE_API bool iCaseEndsWith(std::string_view str, std::string_view suffix);
 IVW_CORE_API std::string elideLines(std::string_view str, std::string_view abbrev = "...",
                                     size_t maxLineLength = 500);
 
+/**
+ * \brief Write \p str to \p os as a quoted JSON string, escaping quotes, backslashes and control
+ * characters.
+ */
+IVW_CORE_API void writeJSONString(std::ostream& os, std::string_view str);
+
 }  // namespace util
 
 // Keep this here to avoid breaking old code
@@ -32,9 +32,90 @@
 
 #include <string>
 #include <thread>
+#include <functional>
+#include <optional>
+#include <vector>
+#include <algorithm>
 
 namespace inviwo::util {
 
 IVW_CORE_API void setThreadDescription(std::thread& thread, const std::string& desc);
 
+/**
+ * Run task(i) for i in [0, count) on the thread pool and return once all tasks are done. The
+ * calling thread takes part in the work and only waits for tasks that have been picked up by a
+ * worker, which makes it safe to call from within a pool thread, e.g. when a representation is
+ * converted in a background job. The first exception thrown by a task is rethrown.
+ *
+ * Parallel regions do not nest, a cooperativeFor called from within a task runs all its tasks
+ * on the calling thread. The number of threads working on one region is bounded by the pool
+ * size and the concurrency limit.
+ * @see setConcurrencyLimit
+ */
+IVW_CORE_API void cooperativeFor(size_t count, std::function<void(size_t)> task);
+
+/**
+ * Set the maximum number of threads, including the calling thread, that may work on a single
+ * parallel region. Zero, the default, only limits by the pool size.
+ * @see SystemSettings::maxConcurrency_
+ */
+IVW_CORE_API void setConcurrencyLimit(size_t limit);
+IVW_CORE_API size_t getConcurrencyLimit();
+
+/**
+ * The number of threads, including the calling thread, that a parallel region started from the
+ * calling thread will use. Always 1 from within a running parallel region.
+ */
+IVW_CORE_API size_t concurrency();
+
+namespace detail {
+
+inline size_t parallelChunks(size_t count, size_t grain) {
+    const auto maxChunks = (count + std::max(grain, size_t{1}) - 1) / std::max(grain, size_t{1});
+    const auto threads = concurrency();
+    return threads <= 1 ? 1 : std::min(maxChunks, 4 * threads);
+}
+
+}  // namespace detail
+
+/**
+ * Call func(i) for all i in [begin, end) in parallel. The range is split into contiguous chunks
+ * of at least \p grain indices which are run using cooperativeFor.
+ */
+template <typename Func>
+void parallelFor(size_t begin, size_t end, Func&& func, size_t grain = 1) {
+    if (end <= begin) return;
+    const auto count = end - begin;
+    const auto chunks = detail::parallelChunks(count, grain);
+    if (chunks <= 1) {
+        for (auto i = begin; i < end; ++i) func(i);
+        return;
+    }
+    cooperativeFor(chunks, [&](size_t chunk) {
+        const auto last = begin + count * (chunk + 1) / chunks;
+        for (auto i = begin + count * chunk / chunks; i < last; ++i) func(i);
+    });
+}
+
+/**
+ * Reduce the range [begin, end) in parallel. map(first, last) computes the result of the chunk
+ * [first, last) and reduce(a, b) combines two results. The chunk results are combined in order
+ * starting from \p init, the chunking only depends on the range, \p grain, and concurrency().
+ */
+template <typename T, typename Map, typename Reduce>
+T parallelReduce(size_t begin, size_t end, T init, Map&& map, Reduce&& reduce, size_t grain = 1) {
+    if (end <= begin) return init;
+    const auto count = end - begin;
+    const auto chunks = detail::parallelChunks(count, grain);
+    if (chunks <= 1) return reduce(std::move(init), map(begin, end));
+
+    std::vector<std::optional<T>> results(chunks);
+    cooperativeFor(chunks, [&](size_t chunk) {
+        results[chunk].emplace(
+            map(begin + count * chunk / chunks, begin + count * (chunk + 1) / chunks));
+    });
+    for (auto& result : results) init = reduce(std::move(init), std::move(*result));
+    return init;
+}
+
 }  // namespace inviwo::util
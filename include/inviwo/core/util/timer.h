@@ -32,6 +32,7 @@
 #pragma once
 
 #include <inviwo/core/common/inviwocoredefine.h>
+#include <inviwo/core/util/frontqueue.h>
 
 #include <warn/push>
 #include <warn/ignore/all>
@@ -74,7 +75,7 @@ private:
         std::function<void()> callback_;
         Milliseconds interval_;
         bool repeating_;
-        std::future<void> finished_;
+        FrontQueue::Token finished_ = FrontQueue::makeToken();
     };
 
     struct TimerInfo {
@@ -0,0 +1,170 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/common/inviwocoredefine.h>
+
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace inviwo {
+
+/**
+ * \ingroup util
+ * A low overhead tracer recording nested spans of time, e.g. processor evaluations, link
+ * evaluations, representation conversions and thread pool tasks. Every thread writes the spans
+ * it completes into its own ring buffer, so recording only costs two clock reads and a store,
+ * and no locks are taken. When a buffer is full the oldest spans are overwritten. Names are
+ * interned to 32 bit ids, for names known at compile time this only happens once per call site.
+ *
+ * Tracing is off by default, a disabled scope only checks an atomic flag. The recorded spans
+ * can be exported in the Chrome trace event format, which can be viewed in chrome://tracing or
+ * https://ui.perfetto.dev. Use the command line argument --trace <file> to record from startup
+ * and write the trace when the application exits.
+ *
+ * \code{.cpp}
+ * void MyProcessor::process() {
+ *     IVW_TRACE_SCOPE("mymodule", "Build mesh");
+ *     ...
+ * }
+ * \endcode
+ * @see TraceScope
+ */
+class IVW_CORE_API Tracer {
+public:
+    /// Number of spans kept per thread
+    static constexpr size_t bufferCapacity = size_t{1} << 16;
+
+    static bool isEnabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+    static void setEnabled(bool enabled);
+
+    /**
+     * Get the id for \p name, the same name always gives the same id.
+     */
+    static std::uint32_t intern(std::string_view name);
+
+    /**
+     * Nanoseconds from an arbitrary but fixed point in time
+     */
+    static std::int64_t now() noexcept;
+
+    /**
+     * Record a span on the calling thread. \p category has to be a string with static storage
+     * duration, usually a string literal.
+     */
+    static void record(const char* category, std::uint32_t name, std::int64_t begin,
+                       std::int64_t end) noexcept;
+
+    /**
+     * Set the name the calling thread is shown with in the exported trace.
+     */
+    static void setThreadName(std::string_view name);
+
+    /**
+     * Remove all recorded spans. Threads keep writing to their buffers, the exporter skips the
+     * spans recorded before the last clear.
+     */
+    static void clear();
+
+    /**
+     * Write all recorded spans as Chrome trace event JSON. Spans recorded while exporting might
+     * be missing, disable tracing first to get a consistent snapshot.
+     */
+    static void exportChromeTrace(std::ostream& os);
+    static void exportChromeTrace(const std::string& filename);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+/**
+ * \ingroup util
+ * Records a span from construction to destruction if tracing is enabled.
+ * @see Tracer, IVW_TRACE_SCOPE, IVW_TRACE_SCOPE_NAMED
+ */
+class TraceScope {
+public:
+    TraceScope(const char* category, std::uint32_t name) noexcept
+        : category_{category}, name_{name}, begin_{Tracer::isEnabled() ? Tracer::now() : -1} {}
+
+    /**
+     * Only interns \p name when tracing is enabled
+     */
+    TraceScope(const char* category, std::string_view name)
+        : TraceScope(category, Tracer::isEnabled() ? Tracer::intern(name) : 0) {}
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    ~TraceScope() {
+        if (begin_ >= 0) Tracer::record(category_, name_, begin_, Tracer::now());
+    }
+
+private:
+    const char* category_;
+    std::uint32_t name_;
+    std::int64_t begin_;
+};
+
+#define IVW_TRACE_CONCAT_PART1(x, y) x##y
+#define IVW_TRACE_CONCAT_PART2(x, y) IVW_TRACE_CONCAT_PART1(x, y)
+#define IVW_TRACE_CONCAT(x) IVW_TRACE_CONCAT_PART2(x, __LINE__)
+
+/**
+ * \def IVW_TRACE_SCOPE(category, name)
+ * Trace the rest of the current scope. Both \p category and \p name should be string literals,
+ * the name is interned once per call site.
+ * Does nothing unless IVW_TRACING is defined.
+ */
+
+/**
+ * \def IVW_TRACE_SCOPE_NAMED(category, name)
+ * Trace the rest of the current scope with a name that is only known at runtime, e.g. a processor
+ * identifier. \p name is anything convertible to a std::string_view, it is interned on every call
+ * while tracing is enabled.
+ * Does nothing unless IVW_TRACING is defined.
+ */
+
+#if IVW_TRACING
+#define IVW_TRACE_SCOPE(category, name)                                                        \
+    static const std::uint32_t IVW_TRACE_CONCAT(ivwTraceName_) = ::inviwo::Tracer::intern(name); \
+    ::inviwo::TraceScope IVW_TRACE_CONCAT(ivwTraceScope_)(category,                            \
+                                                          IVW_TRACE_CONCAT(ivwTraceName_));
+#define IVW_TRACE_SCOPE_NAMED(category, name) \
+    ::inviwo::TraceScope IVW_TRACE_CONCAT(ivwTraceScope_)(category, std::string_view{name});
+#else
+#define IVW_TRACE_SCOPE(category, name)
+#define IVW_TRACE_SCOPE_NAMED(category, name)
+#endif
+
+}  // namespace inviwo
@@ -35,6 +35,7 @@
 #include <inviwo/core/util/interpolation.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
 
 #include <inviwo/core/util/spatialsampler.h>
 
@@ -42,6 +43,8 @@ namespace inviwo {
 
 /**
  * \class VolumeDoubleSampler
+ * Samples a volume using trilinear interpolation. A level of a VolumePyramid of the volume can be
+ * sampled instead of the full resolution data, the coordinates are the same for all levels.
  */
 template <unsigned int DataDims>
 class VolumeDoubleSampler : public SpatialSampler<3, DataDims, double> {
@@ -49,6 +52,13 @@ public:
     VolumeDoubleSampler(std::shared_ptr<const Volume> vol,
                         CoordinateSpace space = CoordinateSpace::Data);
     VolumeDoubleSampler(const Volume& vol, CoordinateSpace space = CoordinateSpace::Data);
+    /**
+     * Sample \p level of \p pyramid, which has to be a pyramid of \p vol
+     * @see Volume::getPyramid, VolumePyramid::levelForFootprint
+     */
+    VolumeDoubleSampler(std::shared_ptr<const Volume> vol,
+                        std::shared_ptr<const VolumePyramid> pyramid, size_t level,
+                        CoordinateSpace space = CoordinateSpace::Data);
     virtual ~VolumeDoubleSampler() = default;
 
     VolumeDoubleSampler& operator=(const VolumeDoubleSampler&) = default;
@@ -57,9 +67,16 @@ public:
     virtual bool withinBoundsDataSpace(const dvec3& pos) const override;
 
 protected:
+    virtual void sampleDataSpaceBatch(const dvec3* pos, Vector<DataDims, double>* result,
+                                      size_t count) const override;
+
+    template <typename GetVoxel>
+    Vector<DataDims, double> interpolate(const dvec3& pos, GetVoxel&& getVoxel) const;
+
     Vector<DataDims, double> getVoxel(const size3_t& pos) const;
 
     std::shared_ptr<const Volume> volume_;
+    std::shared_ptr<const VolumePyramid> pyramid_;
     const VolumeRAM* ram_;
     size3_t dims_;
 };
@@ -79,9 +96,44 @@ VolumeDoubleSampler<DataDims>::VolumeDoubleSampler(const Volume& vol, Coordinate
     , ram_(vol.getRepresentation<VolumeRAM>())
     , dims_(vol.getDimensions()) {}
 
+template <unsigned int DataDims>
+VolumeDoubleSampler<DataDims>::VolumeDoubleSampler(std::shared_ptr<const Volume> vol,
+                                                   std::shared_ptr<const VolumePyramid> pyramid,
+                                                   size_t level, CoordinateSpace space)
+    : SpatialSampler<3, DataDims, double>(*vol, space)
+    , volume_(vol)
+    , pyramid_(pyramid)
+    , ram_(pyramid->getLevel(level))
+    , dims_(ram_->getDimensions()) {}
+
 template <unsigned int DataDims>
 Vector<DataDims, double> VolumeDoubleSampler<DataDims>::sampleDataSpace(const dvec3& pos) const {
-    if (!withinBoundsDataSpace(pos)) {
+    return interpolate(pos, [&](const size3_t& p) { return getVoxel(p); });
+}
+
+template <unsigned int DataDims>
+void VolumeDoubleSampler<DataDims>::sampleDataSpaceBatch(const dvec3* pos,
+                                                         Vector<DataDims, double>* result,
+                                                         size_t count) const {
+    // Resolve the voxel type once for all samples instead of a virtual call per voxel
+    ram_->dispatch<void>([&](auto vrprecision) {
+        const auto data = vrprecision->getDataTyped();
+        const auto getTypedVoxel = [&](const size3_t& pos) {
+            const auto p = glm::clamp(pos, size3_t(0), dims_ - size3_t(1));
+            return util::glm_convert<Vector<DataDims, double>>(
+                data[VolumeRAM::posToIndex(p, dims_)]);
+        };
+        for (size_t i = 0; i < count; ++i) {
+            result[i] = interpolate(pos[i], getTypedVoxel);
+        }
+    });
+}
+
+template <unsigned int DataDims>
+template <typename GetVoxel>
+Vector<DataDims, double> VolumeDoubleSampler<DataDims>::interpolate(const dvec3& pos,
+                                                                    GetVoxel&& getVoxel) const {
+    if (!VolumeDoubleSampler::withinBoundsDataSpace(pos)) {
         return Vector<DataDims, double>(0.0);
     }
     const dvec3 samplePos = pos * dvec3(dims_ - size3_t(1));
@@ -31,15 +31,17 @@
 
 #include <inviwo/qt/editor/inviwoqteditordefine.h>
 
-#include <inviwo/core/network/processornetworkobserver.h>
 #include <inviwo/core/network/workspacemanager.h>
+#include <inviwo/core/network/workspacehistory.h>
 
 #include <memory>
 #include <optional>
 #include <string>
+#include <chrono>
 
 class QAction;
 class QEvent;
+class QTimer;
 
 namespace inviwo {
 
@@ -48,8 +50,12 @@ class AutoSaver;
 
 /**
  * \class UndoManager
+ * Connects the WorkspaceHistory of the current workspace to the undo and redo actions of the
+ * editor, and writes an autosave of the workspace in the background. Full snapshots are saved
+ * right away, other states at most every 30 seconds.
+ * @see WorkspaceHistory
  */
-class IVW_QTEDITOR_API UndoManager : public ProcessorNetworkObserver {
+class IVW_QTEDITOR_API UndoManager {
 public:
     UndoManager(InviwoMainWindow* mainWindow);
     UndoManager(const UndoManager&) = delete;
@@ -73,27 +79,18 @@ public:
     void restore();
 
 private:
-    using DiffType = std::vector<std::string>::iterator::difference_type;
-
     void updateActions();
-
-    // ProcessorNetworkObserver overrides;
-    virtual void onProcessorNetworkChange() override;
-    virtual void onProcessorNetworkDidAddProcessor(Processor* processor) override;
-    virtual void onProcessorNetworkDidRemoveProcessor(Processor* processor) override;
-    virtual void onProcessorNetworkDidAddConnection(const PortConnection& connection) override;
-    virtual void onProcessorNetworkDidRemoveConnection(const PortConnection& connection) override;
-    virtual void onProcessorNetworkDidAddLink(const PropertyLink& propertyLink) override;
-    virtual void onProcessorNetworkDidRemoveLink(const PropertyLink& propertyLink) override;
+    void autoSave();
+    void saveWorkspace();
 
     InviwoMainWindow* mainWindow_;
     WorkspaceManager* manager_;
     std::string refPath_;
 
-    bool dirty_ = true;
-    bool isRestoring = false;
-    DiffType head_ = -1;
-    std::vector<std::shared_ptr<const std::string>> undoBuffer_;
+    WorkspaceHistory history_;
+    std::chrono::steady_clock::time_point lastAutoSave_;
+    // Saves the latest state once the interval has passed, if it was not saved when pushed
+    std::unique_ptr<QTimer> autoSaveTimer_;
 
     QAction* undoAction_;
     QAction* redoAction_;
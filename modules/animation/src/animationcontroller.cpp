@@ -468,7 +468,8 @@ void AnimationController::tickRender() {
 }
 
 void AnimationController::eval(Seconds oldTime, Seconds newTime) {
-    NetworkLock lock;
+    // A key frame usually sets many, often linked, properties. Propagate them all at once.
+    NetworkBatch batch;
     auto ts = (*animation_)(oldTime, newTime, state_);
     setState(ts.state);
     setTime(ts.time);
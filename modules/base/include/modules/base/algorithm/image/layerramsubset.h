@@ -35,6 +35,7 @@
 #include <inviwo/core/datastructures/image/layerram.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 #include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/threadutil.h>
 
 #include <algorithm>
 
@@ -121,14 +122,12 @@ std::shared_ptr<LayerRAMPrecision<U>> extractLayerSubSet(const LayerRAMPrecision
         std::fill(dst, dst + dstDim.x * dstDim.y, U(0));
     }
     // memcpy each row to form sub layer
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int j = 0; j < copyExtent.y; j++) {
+    util::parallelFor(0, static_cast<size_t>(std::max(copyExtent.y, 0)), [&](size_t row) {
+        const auto j = static_cast<int>(row);
         size_t srcPos = (j + srcOffset.y) * srcDim.x + srcOffset.x;
         size_t dstPos = (j + dstOffset.y) * dstDim.x + dstOffset.x;
         conversionCopy(src + srcPos, dst + dstPos, static_cast<size_t>(copyExtent.x));
-    }
+    });
 
     return newLayer;
 }
@@ -78,6 +78,7 @@ IVW_MODULE_BASE_API std::vector<std::vector<std::uint32_t>> gatherLoops(
  * If holes should be closed, the input mesh must be manifold.
  * Vertex attributes are interpolated. Floating types use linear interpolation, integer types use
  * nearest. Connectivity types loop and fan are not handled.
+ * This is clipMeshAgainstPlanes with a single plane.
  * @param mesh to clip
  * @param worldSpacePlane in world space coordinate system
  * @param capClippedHoles: replaces removed parts with triangles aligned with the plane
@@ -88,6 +89,22 @@ IVW_MODULE_BASE_API std::shared_ptr<Mesh> clipMeshAgainstPlane(const Mesh& mesh,
                                                                const Plane& worldSpacePlane,
                                                                bool capClippedHoles = true);
 
+/**
+ * Clip mesh against a convex set of planes, keeping the parts inside all of them, in one pass.
+ * Triangles are clipped in parallel chunks, each against all the planes it crosses in turn.
+ * Vertices created on a mesh edge are shared by all primitives using that edge. When capping,
+ * the cross section of the mesh with each plane is closed and then clipped against the other
+ * planes. Vertex attributes are interpolated as in clipMeshAgainstPlane. More than 32 planes are
+ * handled in several passes.
+ * @param mesh to clip
+ * @param worldSpacePlanes in world space coordinate system
+ * @param capClippedHoles: replaces removed parts with triangles aligned with the planes
+ * @throws Exception if mesh is not supported.
+ * @returns Clipped Mesh
+ */
+IVW_MODULE_BASE_API std::shared_ptr<Mesh> clipMeshAgainstPlanes(
+    const Mesh& mesh, const std::vector<Plane>& worldSpacePlanes, bool capClippedHoles = true);
+
 }  // namespace meshutil
 
 }  // namespace inviwo
@@ -0,0 +1,101 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/util/glm.h>
+
+#include <vector>
+#include <cstdint>
+#include <any>
+#include <string_view>
+
+namespace inviwo {
+
+namespace meshutil {
+
+/**
+ * Reader options for welding of vertices, used by the native mesh readers.
+ *  * "WeldVertices" (bool) enable or disable welding, default false
+ *  * "WeldEpsilon" (float) merge distance, default 0, i.e. only merge identical positions
+ * @see DataReader::setOption
+ */
+struct IVW_MODULE_BASE_API WeldOptions {
+    bool set(std::string_view key, const std::any& value);
+    std::any get(std::string_view key) const;
+
+    bool enabled = false;
+    float epsilon = 0.0f;
+};
+
+struct WeldResult {
+    /// For each input vertex, the index of the vertex it was merged into
+    std::vector<std::uint32_t> remap;
+    /// For each output vertex, the index of the input vertex it represents
+    std::vector<std::uint32_t> unique;
+};
+
+/**
+ * Merge vertices that lie within \p epsilon of each other. The positions are bucketed into a
+ * uniform hash grid with a cell size of \p epsilon, so each vertex only has to be compared
+ * against the vertices in the 27 neighboring cells. With an epsilon of zero only equal positions
+ * are merged. The first vertex of each cluster, in input order, becomes its
+ * representative.
+ */
+IVW_MODULE_BASE_API WeldResult weldVertices(const std::vector<vec3>& positions, float epsilon);
+
+/**
+ * Replace the contents of \p data with the elements selected by \p weld.unique
+ */
+template <typename T>
+void applyWeld(const WeldResult& weld, std::vector<T>& data) {
+    std::vector<T> welded;
+    welded.reserve(weld.unique.size());
+    for (auto i : weld.unique) welded.push_back(data[i]);
+    data = std::move(welded);
+}
+
+/**
+ * Map every index in \p indices to its welded vertex
+ */
+IVW_MODULE_BASE_API void applyWeldToIndices(const WeldResult& weld,
+                                            std::vector<std::uint32_t>& indices);
+
+/**
+ * Compute vertex normals of the triangle list \p indices as the area weighted average of the
+ * normals of the adjacent triangles. Used to replace per-facet normals that can not be merged
+ * when welding, e.g. for STL files.
+ */
+IVW_MODULE_BASE_API std::vector<vec3> smoothNormals(const std::vector<vec3>& positions,
+                                                    const std::vector<std::uint32_t>& indices);
+
+}  // namespace meshutil
+
+}  // namespace inviwo
@@ -33,10 +33,7 @@
 #include <inviwo/core/util/indexmapper.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
-
-#ifdef IVW_USE_OPENMP
-#include <omp.h>
-#endif
+#include <inviwo/core/util/threadutil.h>
 
 namespace inviwo {
 
@@ -94,10 +91,6 @@ void util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T>* inVolume,
                                       Predicate predicate, ValueTransform valueTransform,
                                       ProgressCallback callback) {
 
-#ifdef IVW_USE_OPENMP
-    omp_set_num_threads(std::thread::hardware_concurrency());
-#endif
-
     using int64 = glm::int64;
 
     auto square = [](auto a) { return a * a; };
@@ -151,12 +144,10 @@ void util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T>* inVolume,
         return predicate(src[srcInd(x / sm.x, y / sm.y, z / sm.z)]);
     };
 
-// first pass, forward and backward scan along x
-// result: min distance in x direction
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64 z = 0; z < dstDim.z; ++z) {
+    // first pass, forward and backward scan along x
+    // result: min distance in x direction
+    util::parallelFor(0, static_cast<size_t>(dstDim.z), [&](size_t zi) {
+        const auto z = static_cast<int64>(zi);
         for (int64 y = 0; y < dstDim.y; ++y) {
             // forward
             U dist = static_cast<U>(dstDim.x);
@@ -181,95 +172,72 @@ void util::volumeRAMDistanceTransform(const VolumeRAMPrecision<T>* inVolume,
                     std::min<U>(dst[dstInd(x, y, z)], squareVoxelSize.x * square(dist));
             }
         }
-    }
+    });
 
     // second pass, scan y direction
     // for each voxel v(x,y,z) find min_i(data(x,i,z) + (y - i)^2), 0 <= i < dimY
     // result: min distance in x and y direction
     callback(0.3);
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel
-#endif
-    {
-        std::vector<U> buff;
-        buff.resize(dstDim.y);
-#ifdef IVW_USE_OPENMP
-#pragma omp for
-#endif
-        for (int64 z = 0; z < dstDim.z; ++z) {
-            for (int64 x = 0; x < dstDim.x; ++x) {
-
-                // cache column data into temporary buffer
-                for (int64 y = 0; y < dstDim.y; ++y) {
-                    buff[y] = dst[dstInd(x, y, z)];
-                }
+    util::parallelFor(0, static_cast<size_t>(dstDim.z), [&](size_t zi) {
+        const auto z = static_cast<int64>(zi);
+        std::vector<U> buff(static_cast<size_t>(dstDim.y));
+        for (int64 x = 0; x < dstDim.x; ++x) {
+
+            // cache column data into temporary buffer
+            for (int64 y = 0; y < dstDim.y; ++y) {
+                buff[y] = dst[dstInd(x, y, z)];
+            }
 
-                for (int64 y = 0; y < dstDim.y; ++y) {
-                    auto d = buff[y];
-                    if (d != U(0)) {
-                        const auto rMax =
-                            static_cast<int64>(std::sqrt(d * invSquareVoxelSize.y)) + 1;
-                        const auto rStart = std::min(rMax, y - 1);
-                        const auto rEnd = std::min(rMax, dstDim.y - y);
-                        for (int64 n = -rStart; n < rEnd; ++n) {
-                            const auto w = buff[y + n] + squareVoxelSize.y * square(n);
-                            if (w < d) d = w;
-                        }
+            for (int64 y = 0; y < dstDim.y; ++y) {
+                auto d = buff[y];
+                if (d != U(0)) {
+                    const auto rMax = static_cast<int64>(std::sqrt(d * invSquareVoxelSize.y)) + 1;
+                    const auto rStart = std::min(rMax, y - 1);
+                    const auto rEnd = std::min(rMax, dstDim.y - y);
+                    for (int64 n = -rStart; n < rEnd; ++n) {
+                        const auto w = buff[y + n] + squareVoxelSize.y * square(n);
+                        if (w < d) d = w;
                     }
-                    dst[dstInd(x, y, z)] = d;
                 }
+                dst[dstInd(x, y, z)] = d;
             }
         }
-    }
+    });
 
     // third pass, scan z direction
     // for each voxel v(x,y,z) find min_i(data(x,y,i) + (z - i)^2), 0 <= i < dimZ
     // result: min distance in x and y direction
     callback(0.6);
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel
-#endif
-    {
-        std::vector<U> buff;
-        buff.resize(dstDim.z);
-#ifdef IVW_USE_OPENMP
-#pragma omp for
-#endif
-        for (int64 y = 0; y < dstDim.y; ++y) {
-            for (int64 x = 0; x < dstDim.x; ++x) {
-
-                // cache column data into temporary buffer
-                for (int64 z = 0; z < dstDim.z; ++z) {
-                    buff[z] = dst[dstInd(x, y, z)];
-                }
+    util::parallelFor(0, static_cast<size_t>(dstDim.y), [&](size_t yi) {
+        const auto y = static_cast<int64>(yi);
+        std::vector<U> buff(static_cast<size_t>(dstDim.z));
+        for (int64 x = 0; x < dstDim.x; ++x) {
+
+            // cache column data into temporary buffer
+            for (int64 z = 0; z < dstDim.z; ++z) {
+                buff[z] = dst[dstInd(x, y, z)];
+            }
 
-                for (int64 z = 0; z < dstDim.z; ++z) {
-                    auto d = buff[z];
-                    if (d != U(0)) {
-                        const auto rMax =
-                            static_cast<int64>(std::sqrt(d * invSquareVoxelSize.z)) + 1;
-                        const auto rStart = std::min(rMax, z - 1);
-                        const auto rEnd = std::min(rMax, dstDim.z - z);
-                        for (int64 n = -rStart; n < rEnd; ++n) {
-                            const auto w = buff[z + n] + squareVoxelSize.z * square(n);
-                            if (w < d) d = w;
-                        }
+            for (int64 z = 0; z < dstDim.z; ++z) {
+                auto d = buff[z];
+                if (d != U(0)) {
+                    const auto rMax = static_cast<int64>(std::sqrt(d * invSquareVoxelSize.z)) + 1;
+                    const auto rStart = std::min(rMax, z - 1);
+                    const auto rEnd = std::min(rMax, dstDim.z - z);
+                    for (int64 n = -rStart; n < rEnd; ++n) {
+                        const auto w = buff[z + n] + squareVoxelSize.z * square(n);
+                        if (w < d) d = w;
                     }
-                    dst[dstInd(x, y, z)] = d;
                 }
+                dst[dstInd(x, y, z)] = d;
             }
         }
-    }
+    });
 
     // scale data
     callback(0.9);
-    const int64 volSize = dstDim.x * dstDim.y * dstDim.z;
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64 i = 0; i < volSize; ++i) {
-        dst[i] = valueTransform(dst[i]);
-    }
+    const auto volSize = static_cast<size_t>(dstDim.x * dstDim.y * dstDim.z);
+    util::parallelFor(0, volSize, [&](size_t i) { dst[i] = valueTransform(dst[i]); });
     callback(1.0);
 }
 
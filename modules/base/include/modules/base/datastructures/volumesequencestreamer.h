@@ -0,0 +1,158 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace inviwo {
+
+/**
+ * \class VolumeSequenceStreamer
+ * \brief Keeps a bounded window of time steps of a VolumeSequence resident in RAM.
+ *
+ * Volumes of a sequence read from disk only hold a VolumeDisk representation until they are
+ * accessed. Once converted they keep the RAM representation forever, so stepping through a long
+ * sequence will eventually load all of it. The streamer tracks the time steps it has handed out,
+ * asynchronously prefetches the next time steps in the playback direction on the thread pool, and
+ * drops the time steps that fall outside of the resident window back to their disk representation.
+ * The window wraps around at the ends of the sequence since sequences are played in a loop.
+ *
+ * Volumes without a disk representation can not be released and are left untouched. Neither are
+ * volumes that are referenced outside of the sequence, e.g. by a downstream processor, they are
+ * released once they are no longer in use. Prefetches of time steps that leave the window before
+ * they have started are cancelled.
+ */
+class IVW_MODULE_BASE_API VolumeSequenceStreamer {
+public:
+    struct Stats {
+        size_t requests = 0;
+        /// The requested time step was already loaded
+        size_t hits = 0;
+        /// The requested time step was loaded by a prefetch that had finished
+        size_t prefetchHits = 0;
+        /// The request had to wait for an unfinished prefetch or a synchronous load
+        size_t stalls = 0;
+        /// Total time spent waiting in stalls
+        std::chrono::duration<double, std::milli> stallTime{0};
+        /// Number of time steps released back to disk
+        size_t evictions = 0;
+    };
+
+    VolumeSequenceStreamer(size_t residentWindow = 4, size_t prefetch = 2);
+    VolumeSequenceStreamer(const VolumeSequenceStreamer&) = delete;
+    VolumeSequenceStreamer& operator=(const VolumeSequenceStreamer&) = delete;
+    ~VolumeSequenceStreamer();
+
+    /**
+     * Set the sequence to stream from. Time steps of a previous sequence that were loaded by the
+     * streamer are released.
+     */
+    void setSequence(std::shared_ptr<const VolumeSequence> sequence);
+    const std::shared_ptr<const VolumeSequence>& getSequence() const;
+
+    /**
+     * Set the maximum number of time steps to keep in RAM, including the current one and the
+     * prefetched ones. Will be at least prefetch + 1.
+     */
+    void setResidentWindow(size_t window);
+    size_t getResidentWindow() const;
+
+    /**
+     * Set the number of time steps to load ahead of the current one in the playback direction.
+     */
+    void setPrefetch(size_t prefetch);
+    size_t getPrefetch() const;
+
+    /**
+     * Get time step \p index with its RAM representation loaded. The playback direction is
+     * derived from the previously requested index. Triggers prefetching of the following time
+     * steps and releases time steps outside of the window.
+     */
+    std::shared_ptr<Volume> get(size_t index);
+
+    /**
+     * Release all time steps loaded by the streamer back to disk. Time steps that are still in use
+     * are kept track of and released by later calls once they are no longer referenced.
+     */
+    void releaseAll();
+
+    /**
+     * Number of time steps of the current sequence held in RAM by the streamer, not counting
+     * unfinished prefetches
+     */
+    size_t getResidentCount() const;
+
+    const Stats& getStats() const;
+    void resetStats();
+
+private:
+    size_t wrap(std::ptrdiff_t index) const;
+    std::unordered_set<size_t> window(size_t index, int direction) const;
+    void prefetch(size_t index);
+    bool release(size_t index);
+    bool release(const std::shared_ptr<Volume>& volume);
+    void releaseRetired();
+    void drain();
+
+    struct Load {
+        std::future<void> future;
+        std::shared_ptr<std::atomic<bool>> cancelled;
+    };
+
+    std::shared_ptr<const VolumeSequence> sequence_;
+    size_t residentWindow_;
+    size_t prefetch_;
+
+    std::optional<size_t> previous_;
+    int direction_ = 1;
+
+    std::unordered_set<size_t> resident_;
+    std::unordered_map<size_t, Load> inFlight_;
+
+    /// Time steps of previous sequences that were still in use when the sequence was replaced
+    struct Retired {
+        std::shared_ptr<const VolumeSequence> sequence;
+        std::unordered_set<size_t> indices;
+    };
+    std::vector<Retired> retired_;
+    Stats stats_;
+};
+
+}  // namespace inviwo
@@ -64,6 +64,10 @@ namespace inviwo {
  *     + Datfile: sequence0.dat
  *     + Datfile: sequence1.dat
  *     + Datfile: sequence2.dat
+ *
+ * By default the volumes get a VolumeDisk representation and are read when first accessed. With
+ * the option "Compressed" set to true the raw files are instead read right away into
+ * VolumeCompressed representations, slab by slab, see util::readRawVolumeCompressed.
  */
 class IVW_MODULE_BASE_API DatVolumeSequenceReader
     : public DataReaderType<std::vector<std::shared_ptr<Volume>>> {
@@ -78,8 +82,12 @@ public:
 
     virtual std::shared_ptr<VolumeSequence> readData(const std::string& filePath) override;
 
+    virtual bool setOption(std::string_view key, std::any value) override;
+    virtual std::any getOption(std::string_view key) override;
+
 private:
     bool enableLogOutput_;
+    bool compressed_;
 };
 
 }  // namespace inviwo
@@ -0,0 +1,116 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+
+#include <string_view>
+#include <vector>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <algorithm>
+#include <utility>
+
+namespace inviwo {
+
+namespace util {
+
+namespace config {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+constexpr bool charconvFloat = true;
+#else
+constexpr bool charconvFloat = false;
+#endif
+}  // namespace config
+
+/**
+ * The number of chunks to split parsing work into, four times the size of the thread pool or one
+ * if there is no pool.
+ */
+IVW_MODULE_BASE_API size_t parseJobs();
+
+/**
+ * Split the index range [0, size) into at most \p chunks consecutive non-empty ranges
+ */
+IVW_MODULE_BASE_API std::vector<std::pair<size_t, size_t>> splitIntoRanges(size_t size,
+                                                                           size_t chunks);
+
+/**
+ * Split \p text into at most \p chunks pieces of roughly equal size. Each piece ends at a line
+ * break so that every line ends up completely inside one piece.
+ */
+IVW_MODULE_BASE_API std::vector<std::string_view> splitIntoLineChunks(std::string_view text,
+                                                                      size_t chunks);
+
+inline const char* skipSpace(const char* first, const char* last) {
+    while (first != last && (*first == ' ' || *first == '\t' || *first == '\r')) ++first;
+    return first;
+}
+
+inline const char* skipLine(const char* first, const char* last) {
+    first = static_cast<const char*>(std::memchr(first, '\n', last - first));
+    return first ? first + 1 : last;
+}
+
+inline const char* skipToken(const char* first, const char* last) {
+    while (first != last && *first != ' ' && *first != '\t' && *first != '\r' && *first != '\n') {
+        ++first;
+    }
+    return first;
+}
+
+/**
+ * Parse a number from the range [first, last) after skipping leading spaces.
+ * @return a pointer to the first character after the number, or nullptr if no number could be
+ * parsed
+ */
+template <typename T>
+const char* parseNumber(const char* first, const char* last, T& value) {
+    first = skipSpace(first, last);
+    if (first != last && *first == '+') ++first;
+    if constexpr (std::is_floating_point_v<T> && !config::charconvFloat) {
+        char buf[64];
+        const auto len = std::min<size_t>(skipToken(first, last) - first, sizeof(buf) - 1);
+        std::memcpy(buf, first, len);
+        buf[len] = '\0';
+        char* end = nullptr;
+        value = static_cast<T>(std::strtod(buf, &end));
+        return end == buf ? nullptr : first + (end - buf);
+    } else {
+        const auto [ptr, ec] = std::from_chars(first, last, value);
+        return ec == std::errc() ? ptr : nullptr;
+    }
+}
+
+}  // namespace util
+
+}  // namespace inviwo
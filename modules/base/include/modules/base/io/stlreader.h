@@ -0,0 +1,65 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/base/basemoduledefine.h>
+#include <modules/base/algorithm/mesh/vertexwelding.h>
+#include <inviwo/core/io/datareader.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+
+namespace inviwo {
+
+/**
+ * \class StlReader
+ * \brief Reader for binary and ASCII STL files
+ * Binary files are memory mapped and decoded in parallel directly into the vertex buffers, ASCII
+ * files are parsed in parallel chunks. STL stores each triangle separately, vertices can be merged
+ * by enabling the "WeldVertices" option. Welded meshes get smooth vertex normals computed from the
+ * triangles instead of the per-facet normals of the file.
+ * @see meshutil::WeldOptions
+ */
+class IVW_MODULE_BASE_API StlReader : public DataReaderType<Mesh> {
+public:
+    StlReader();
+    StlReader(const StlReader&) = default;
+    StlReader& operator=(const StlReader&) = default;
+    virtual StlReader* clone() const override;
+    virtual ~StlReader() = default;
+
+    virtual std::shared_ptr<Mesh> readData(const std::string& filePath) override;
+
+    virtual bool setOption(std::string_view key, std::any value) override;
+    virtual std::any getOption(std::string_view key) override;
+
+private:
+    meshutil::WeldOptions weld_;
+};
+
+}  // namespace inviwo
@@ -31,7 +31,7 @@
 
 #include <modules/base/basemoduledefine.h>
 #include <inviwo/core/common/inviwoapplication.h>
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/properties/fileproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
 #include <inviwo/core/io/datareaderfactory.h>
@@ -86,9 +86,14 @@ void updateFilenameFilters(const DataReaderFactory& rf, FileProperty& file,
 /**
  * A base class for simple source processors.
  * Two functions to customize the behavior are available, dataLoaded and dataDeserialized.
+ *
+ * The data is read in a background job on the thread pool using the DataReaderType::readData
+ * overload that takes a pool::Stop and a pool::Progress, the processor shows the progress of
+ * readers that report it. The previously loaded data stays on the outport until the new data is
+ * ready, and selecting another file while loading cancels the stale job.
  */
 template <typename DataType, typename PortType>
-class DataSource : public Processor {
+class DataSource : public PoolProcessor {
 public:
     /**
      * Construct a DataSource
@@ -103,6 +108,7 @@ public:
 
     virtual void process() override;
     virtual void deserialize(Deserializer& d) override;
+    virtual void handleError() override;
 
 protected:
     void load(bool deserialized);
@@ -127,7 +133,7 @@ private:
 template <typename DataType, typename PortType>
 DataSource<DataType, PortType>::DataSource(InviwoApplication* app, const std::string& file,
                                            const std::string& content)
-    : Processor()
+    : PoolProcessor(pool::Option::DelayInvalidation)
     , rf_(app->getDataReaderFactory())
     , port_("data")
     , file_("filename", "File", file, content)
@@ -151,6 +157,8 @@ DataSource<DataType, PortType>::DataSource(InviwoApplication* app, const std::st
     });
     file_.onChange([this]() {
         loadingFailed_ = false;
+        // Without a file the processor is not ready and will not process, cancel the stale load
+        if (file_.get().empty()) stopJobs();
         util::updateReaderFromFile(file_, reader_);
         isReady_.update();
     });
@@ -170,33 +178,55 @@ void DataSource<DataType, PortType>::process() {
 
 template <typename DataType, typename PortType>
 void DataSource<DataType, PortType>::load(bool deserialized) {
-    if (file_.get().empty()) return;
+    if (file_.get().empty()) {
+        stopJobs();
+        return;
+    }
 
     const auto sext = reader_.getSelectedValue();
     if (auto reader = rf_->template getReaderForTypeAndExtension<DataType>(sext, file_.get())) {
-        try {
-            auto data = reader->readData(file_.get());
-            port_.setData(data);
-            loadedData_ = data;
-            if (deserialized) {
-                dataDeserialized(data);
-            } else {
-                dataLoaded(data);
-            }
-        } catch (DataReaderException const& e) {
-            loadingFailed_ = true;
-            port_.detachData();
-            isReady_.update();
-            LogProcessorError("Could not load data: " << file_.get() << ", " << e.getMessage());
-        }
+        dispatchOne(
+            [reader = std::shared_ptr<DataReaderType<DataType>>{std::move(reader)},
+             file = file_.get()](pool::Stop stop,
+                                 pool::Progress progress) -> std::shared_ptr<DataType> {
+                return reader->readData(file, nullptr, stop, progress);
+            },
+            [this, deserialized](std::shared_ptr<DataType> data) {
+                if (!data) return;
+                port_.setData(data);
+                loadedData_ = data;
+                if (deserialized) {
+                    dataDeserialized(data);
+                } else {
+                    dataLoaded(data);
+                }
+                newResults();
+            });
     } else {
+        stopJobs();
         loadingFailed_ = true;
         port_.detachData();
         isReady_.update();
+        newResults();
         LogProcessorError("Could not find a data reader for file: " << file_.get());
     }
 }
 
+template <typename DataType, typename PortType>
+void DataSource<DataType, PortType>::handleError() {
+    loadingFailed_ = true;
+    port_.detachData();
+    isReady_.update();
+    try {
+        throw;
+    } catch (DataReaderException const& e) {
+        LogProcessorError("Could not load data: " << file_.get() << ", " << e.getMessage());
+    } catch (...) {
+        PoolProcessor::handleError();
+    }
+    newResults();
+}
+
 template <typename DataType, typename PortType>
 void DataSource<DataType, PortType>::deserialize(Deserializer& d) {
     Processor::deserialize(d);
@@ -31,10 +31,11 @@
 
 #include <modules/base/basemoduledefine.h>
 
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/ports/volumeport.h>
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/buttonproperty.h>
+#include <inviwo/core/properties/compositeproperty.h>
 #include <inviwo/core/properties/filepatternproperty.h>
 #include <inviwo/core/properties/optionproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
@@ -56,6 +57,9 @@ class DataReaderFactory;
  * will be equal to the size of the first image times the number of images. The physical size of the
  * volume is determined by the the voxel spacing property.
  *
+ * The images are read and converted in parallel in the background, with the progress shown in
+ * the processor's progress bar.
+ *
  * The input images are converted to a volume representation based on the input channel selection.
  * Single channels, i.e. red, green, blue, alpha, and grayscale, will result in a scalar volume
  * whereas rgb and rgba will yield a vec3 or vec4 volume, respectively.
@@ -68,12 +72,16 @@ class DataReaderFactory;
  *   * __Skip Unsupported Files__   If true, matching files with unsupported image formats are
  *                                not considered. Otherwise an empty volume slice will be inserted
  *                               for each file.
+ *   * __Subsample__              Only use every n'th voxel along each axis, i.e. every n'th image
+ *                                along z. Skipped images are not read at all.
+ *   * __Region of Interest__     Offset and extent of the part of the stack to load, in voxels of
+ *                                the full stack. Zero extents cover the rest of the stack.
  *   * __Voxel Spacing__          Used to match the sampling distance of the acquired data and
  *                                affects the physical size of the volume.
  *   * __Data Information__       Metadata of the generated volume data set.
  *
  */
-class IVW_MODULE_BASE_API ImageStackVolumeSource : public Processor {
+class IVW_MODULE_BASE_API ImageStackVolumeSource : public PoolProcessor {
 public:
     ImageStackVolumeSource(InviwoApplication* app);
     void addFileNameFilters();
@@ -85,7 +93,7 @@ public:
     static const ProcessorInfo processorInfo_;
 
 protected:
-    std::shared_ptr<Volume> load();
+    void load();
     bool isValidImageFile(std::string);
 
     virtual void deserialize(Deserializer& d) override;
@@ -95,6 +103,10 @@ private:
     FilePatternProperty filePattern_;
     ButtonProperty reload_;
     BoolProperty skipUnsupportedFiles_;
+    IntSize3Property subsample_;
+    CompositeProperty region_;
+    IntSize3Property regionOffset_;
+    IntSize3Property regionExtent_;
 
     BasisProperty basis_;
     VolumeInformationProperty information_;
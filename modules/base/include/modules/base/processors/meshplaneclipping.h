@@ -40,7 +40,8 @@ namespace inviwo {
 
 /** \docpage{org.inviwo.MeshPlaneClipping, Mesh Plane Clipping}
  * ![](org.inviwo.MeshPlaneClipping.png?classIdentifier=org.inviwo.MeshPlaneClipping)
- * Clips a mesh against multiple planes in world space.
+ * Clips a mesh against multiple planes in world space. The part inside all planes is kept, the
+ * mesh is clipped against all planes in a single pass.
  *
  * ### Inports
  *   * __inputMesh__ Mesh to clip.
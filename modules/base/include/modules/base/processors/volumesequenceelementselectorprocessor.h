@@ -33,6 +33,10 @@
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/ports/volumeport.h>
 #include <modules/base/processors/vectorelementselectorprocessor.h>
+#include <modules/base/datastructures/volumesequencestreamer.h>
+#include <inviwo/core/properties/boolcompositeproperty.h>
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/buttonproperty.h>
 
 namespace inviwo {
 
@@ -48,6 +52,12 @@ namespace inviwo {
  *
  * ### Properties
  *   * __Step__ The volume sequence index to extract
+ *   * __Streaming__ Only keep a window of time steps in RAM and prefetch the following ones in
+ *     the playback direction in the background. Time steps outside of the window are released
+ *     back to disk. Only affects volumes that were read from disk.
+ *      * __Resident Time Steps__ Maximum number of time steps kept in RAM
+ *      * __Prefetch__ Number of time steps to load ahead of the current one
+ *      * __Statistics__ Hits, prefetch hits, stalls, time spent stalling and evictions
  */
 class IVW_MODULE_BASE_API VolumeSequenceElementSelectorProcessor
     : public VectorElementSelectorProcessor<Volume> {
@@ -57,6 +67,24 @@ public:
 
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
+
+    virtual void process() override;
+
+private:
+    void updateStats();
+
+    BoolCompositeProperty streaming_;
+    IntSizeTProperty residentWindow_;
+    IntSizeTProperty prefetch_;
+    CompositeProperty stats_;
+    IntSizeTProperty hits_;
+    IntSizeTProperty prefetchHits_;
+    IntSizeTProperty stalls_;
+    DoubleProperty stallTime_;
+    IntSizeTProperty evictions_;
+    ButtonProperty resetStats_;
+
+    VolumeSequenceStreamer streamer_;
 };
 
 }  // namespace inviwo
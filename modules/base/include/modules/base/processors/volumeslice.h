@@ -37,6 +37,9 @@
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
 #include <inviwo/core/properties/eventproperty.h>
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
+#include <inviwo/core/util/timer.h>
 #include <inviwo/core/datastructures/geometry/geometrytype.h>
 #include <modules/base/datastructures/imagereusecache.h>
 
@@ -55,6 +58,10 @@ namespace inviwo {
  * ### Properties
  *   * __sliceAlongAxis_ Defines the volume axis for the output slice
  *   * __sliceNumber_ Defines the slice number for the output slice
+ *   * __Level of Detail__ Extract the slice from a coarser level of the VolumePyramid of the
+ *     input volume, either matching a target resolution or fitting within a time budget. In
+ *     time budget mode the full resolution slice is extracted once the slice has not changed for
+ *     a short while.
  */
 
 /**
@@ -62,6 +69,8 @@ namespace inviwo {
  */
 class IVW_MODULE_BASE_API VolumeSlice : public Processor {
 public:
+    enum class LevelOfDetail { Full, Footprint, TimeBudget };
+
     VolumeSlice();
     ~VolumeSlice();
 
@@ -80,6 +89,8 @@ private:
     void eventStepSliceUp(Event*);
     void eventStepSliceDown(Event*);
     void eventGestureShiftSlice(Event*);
+    /// Select the representation to extract the slice from according to the level of detail
+    const VolumeRAM* selectLevel(const Volume& volume);
 
     VolumeInport inport_;
     ImageOutport outport_;
@@ -89,6 +100,12 @@ private:
     TemplateOptionProperty<CartesianCoordinateAxis> sliceAlongAxis_;
     IntSizeTProperty sliceNumber_;
 
+    CompositeProperty lod_;
+    TemplateOptionProperty<LevelOfDetail> lodMode_;
+    TemplateOptionProperty<PyramidFilter> lodFilter_;
+    IntSize2Property targetResolution_;
+    FloatProperty timeBudget_;
+
     BoolProperty handleInteractionEvents_;
 
     EventProperty mouseShiftSlice_;
@@ -97,6 +114,13 @@ private:
     EventProperty stepSliceDown_;
 
     EventProperty gestureShiftSlice_;
+
+    std::shared_ptr<const VolumePyramid> pyramid_;
+    std::shared_ptr<VolumePyramidCalculationState> pyramidCalculation_;
+    VolumePyramidCalculationState::Handle pyramidDone_;
+    LevelOfDetailBudget budget_;
+    Delay refine_;
+    bool refining_ = false;
 };
 
 }  // namespace inviwo
@@ -34,6 +34,8 @@
 #include <inviwo/core/processors/poolprocessor.h>
 #include <inviwo/core/properties/boolproperty.h>
 #include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/properties/optionproperty.h>
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
 #include <modules/base/algorithm/volume/volumeramsubsample.h>
 #include <inviwo/core/processors/activityindicator.h>
 
@@ -53,6 +55,9 @@ namespace inviwo {
  * ### Properties
  *   * __Enable Operation__ ...
  *   * __Factors__ ...
+ *   * __Filter__ How the voxels of each block are combined, mean, min, max or max magnitude.
+ *     For equal power of two factors the level is taken from the cached VolumePyramid of the
+ *     input volume.
  *
  */
 class IVW_MODULE_BASE_API VolumeSubsample : public PoolProcessor {
@@ -66,7 +71,8 @@ public:
 protected:
     virtual void process() override;
 
-    static std::shared_ptr<Volume> subsample(std::shared_ptr<const Volume> volume, size3_t f);
+    static std::shared_ptr<Volume> subsample(std::shared_ptr<const Volume> volume, size3_t f,
+                                             PyramidFilter filter);
 
 private:
     VolumeInport inport_;
@@ -74,5 +80,6 @@ private:
 
     BoolProperty enabled_;
     IntVec3Property subSampleFactors_;
+    TemplateOptionProperty<PyramidFilter> filter_;
 };
 }  // namespace inviwo
@@ -31,8 +31,14 @@
 #include <inviwo/core/datastructures/geometry/mesh.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/hashcombine.h>
+#include <inviwo/core/util/threadutil.h>
 
 #include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
 
 namespace inviwo {
 
@@ -303,97 +309,379 @@ void capHoles(std::vector<glm::u32vec2>& edges, const Plane& plane,
     }
 }
 
-std::vector<glm::u32vec2> clipIndices(const Mesh::MeshInfo& meshInfo,
-                                      std::shared_ptr<Mesh>& clippedMesh,
-                                      const std::vector<uint32_t>& indices, const Plane& plane,
-                                      const std::vector<vec3>& positions,
-                                      const InterpolateFunctor& addInterpolatedVertex) {
+constexpr std::uint32_t invalidIndex = std::numeric_limits<std::uint32_t>::max();
+/// Marks a reference to a chunk local vertex, see ClipChunk
+constexpr std::uint32_t newVertexFlag = 1u << 31;
+/// Planes are tracked as bits in a std::uint32_t per vertex
+constexpr size_t maxClipPlanes = 32;
+constexpr size_t vertexChunkSize = 1 << 16;
+constexpr size_t triangleChunkSize = 1 << 14;
+
+/**
+ * A vertex created while clipping. Vertices on a mesh edge are interpolated between the edge end
+ * points, sources[0] < sources[1], and are identified by (sources[0], sources[1], plane). They
+ * are shared by all primitives using that edge. Vertices inside a triangle are interpolated
+ * between its three corners, have an invalid plane and are never shared.
+ */
+struct ClipVertex {
+    std::array<std::uint32_t, 3> sources;
+    vec3 weights;
+    std::uint32_t plane;
+};
+
+/**
+ * The result of clipping a chunk of primitives. Indices refer to existing vertices or, if
+ * newVertexFlag is set, to the chunk's vertices. Cuts are the segments of the cross section of
+ * the mesh with each capped plane.
+ */
+struct ClipChunk {
+    std::vector<std::uint32_t> indices;
+    std::vector<ClipVertex> vertices;
+    std::vector<std::pair<std::uint32_t, glm::u32vec2>> cuts;
+    std::vector<std::uint32_t> remap;
+};
+
+struct ClipPlanes {
+    const std::vector<Plane>& planes;
+    std::uint32_t active;  ///< Bit mask of planes to clip against
+    std::uint32_t capped;  ///< Bit mask of planes to gather cross sections for
+};
+
+/**
+ * Adds the vertices of clipped chunks to the output buffers, vertices on mesh edges are only
+ * added once.
+ */
+class ClipVertices {
+public:
+    explicit ClipVertices(const InterpolateFunctor& addInterpolatedVertex)
+        : addInterpolatedVertex_{addInterpolatedVertex} {}
+
+    std::uint32_t add(const ClipVertex& v) {
+        if (v.plane == invalidIndex) {
+            return addInterpolatedVertex_({v.sources[0], v.sources[1], v.sources[2]},
+                                          {v.weights[0], v.weights[1], v.weights[2]},
+                                          std::nullopt);
+        }
+        auto [it, inserted] = shared_.try_emplace(Key{v.sources[0], v.sources[1], v.plane}, 0);
+        if (inserted) {
+            it->second = addInterpolatedVertex_({v.sources[0], v.sources[1]},
+                                                {v.weights[0], v.weights[1]}, std::nullopt);
+        }
+        return it->second;
+    }
 
-    std::vector<glm::u32vec2> newEdges;
+    /**
+     * Add the vertices of all chunks in order and append their indices to \p out. The cuts are
+     * appended to the cuts of their plane.
+     */
+    void merge(std::vector<ClipChunk>& chunks, std::vector<std::uint32_t>& out,
+               std::vector<std::vector<glm::u32vec2>>& cuts) {
+        const auto resolve = [](const ClipChunk& chunk, std::uint32_t i) {
+            return i & newVertexFlag ? chunk.remap[i & ~newVertexFlag] : i;
+        };
+
+        // The interpolation functors append to the buffers, so this part has to be sequential
+        std::vector<size_t> offsets(chunks.size() + 1, out.size());
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            auto& chunk = chunks[c];
+            chunk.remap.resize(chunk.vertices.size());
+            std::transform(chunk.vertices.begin(), chunk.vertices.end(), chunk.remap.begin(),
+                           [&](const ClipVertex& v) { return add(v); });
+            for (const auto& [plane, cut] : chunk.cuts) {
+                cuts[plane].emplace_back(resolve(chunk, cut[0]), resolve(chunk, cut[1]));
+            }
+            offsets[c + 1] = offsets[c] + chunk.indices.size();
+        }
 
-    if (meshInfo.dt == DrawType::Points) {
-        auto outIndices = clippedMesh->addIndexBuffer(DrawType::Points, meshInfo.ct);
-        for (auto i : indices) {
-            if (plane.isInside(positions[i])) {
-                outIndices->add(i);
+        out.resize(offsets.back());
+        util::cooperativeFor(chunks.size(), [&](size_t c) {
+            const auto& chunk = chunks[c];
+            std::transform(chunk.indices.begin(), chunk.indices.end(), out.begin() + offsets[c],
+                           [&](std::uint32_t i) { return resolve(chunk, i); });
+        });
+    }
+
+private:
+    struct Key {
+        std::uint32_t a;
+        std::uint32_t b;
+        std::uint32_t plane;
+        bool operator==(const Key& rhs) const {
+            return a == rhs.a && b == rhs.b && plane == rhs.plane;
+        }
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t h = 0;
+            util::hash_combine(h, key.a);
+            util::hash_combine(h, key.b);
+            util::hash_combine(h, key.plane);
+            return h;
+        }
+    };
+
+    const InterpolateFunctor& addInterpolatedVertex_;
+    std::unordered_map<Key, std::uint32_t, KeyHash> shared_;
+};
+
+/**
+ * Extend \p masks to cover all \p positions. Bit k of a mask is set if the vertex is outside of
+ * plane k.
+ */
+void updateOutsideMasks(std::vector<std::uint32_t>& masks, const std::vector<vec3>& positions,
+                        const std::vector<Plane>& planes) {
+    const auto begin = masks.size();
+    masks.resize(positions.size());
+    const auto count = positions.size() - begin;
+    util::cooperativeFor((count + vertexChunkSize - 1) / vertexChunkSize, [&](size_t c) {
+        const auto end = std::min(positions.size(), begin + (c + 1) * vertexChunkSize);
+        for (auto i = begin + c * vertexChunkSize; i < end; ++i) {
+            std::uint32_t mask = 0;
+            for (size_t k = 0; k < planes.size(); ++k) {
+                if (!planes[k].isInside(positions[i])) mask |= 1u << k;
+            }
+            masks[i] = mask;
+        }
+    });
+}
+
+/**
+ * The vertex where the edge (a, b) crosses \p plane. The weight is always computed from the lower
+ * to the higher index to give bitwise identical results for all primitives sharing the edge.
+ */
+ClipVertex edgeVertex(std::uint32_t a, std::uint32_t b, std::uint32_t planeIndex,
+                      const Plane& plane, const std::vector<vec3>& positions) {
+    const auto lo = std::min(a, b);
+    const auto hi = std::max(a, b);
+    const auto dlo = plane.distance(positions[lo]);
+    const auto dhi = plane.distance(positions[hi]);
+    const auto t = dlo / (dlo - dhi);
+    return {{lo, hi, 0}, vec3{1.0f - t, t, 0.0f}, planeIndex};
+}
+
+/**
+ * Clip triangles [begin, end) of \p triangles against all active planes in turn using
+ * Sutherland-Hodgman on the triangle polygon. Vertices are tracked by their barycentric
+ * coordinates and the triangle edges they lie on, such that new vertices on a triangle edge can
+ * be shared with the neighboring triangle.
+ */
+void clipTriangles(const std::vector<std::uint32_t>& triangles, size_t begin, size_t end,
+                   const std::vector<vec3>& positions, const std::vector<std::uint32_t>& masks,
+                   const ClipPlanes& clip, ClipChunk& chunk) {
+    struct PolygonVertex {
+        vec3 pos;
+        vec3 bary;
+        ClipVertex vertex;
+        std::uint32_t ref;    ///< Index into positions or chunk vertices, invalid if not emitted
+        std::uint32_t edges;  ///< Bit e is set if the vertex is on triangle edge e -> e + 1
+    };
+
+    const auto emit = [&](PolygonVertex& v) {
+        if (v.ref == invalidIndex) {
+            v.ref = newVertexFlag | static_cast<std::uint32_t>(chunk.vertices.size());
+            chunk.vertices.push_back(v.vertex);
+        }
+        return v.ref;
+    };
+    const auto onEdge = [&](const glm::u32vec3& tri, int e, std::uint32_t k) {
+        const auto a = tri[e];
+        const auto b = tri[(e + 1) % 3];
+        PolygonVertex v;
+        v.vertex = edgeVertex(a, b, k, clip.planes[k], positions);
+        v.pos = positions[v.vertex.sources[0]] * v.vertex.weights[0] +
+                positions[v.vertex.sources[1]] * v.vertex.weights[1];
+        v.bary = vec3{0.0f};
+        v.bary[e] = a < b ? v.vertex.weights[0] : v.vertex.weights[1];
+        v.bary[(e + 1) % 3] = 1.0f - v.bary[e];
+        v.ref = invalidIndex;
+        v.edges = 1u << e;
+        return v;
+    };
+
+    std::vector<PolygonVertex> polygon;
+    std::vector<PolygonVertex> clipped;
+    for (auto t = begin; t < end; ++t) {
+        const glm::u32vec3 tri{triangles[3 * t], triangles[3 * t + 1], triangles[3 * t + 2]};
+        const std::array<std::uint32_t, 3> m{masks[tri[0]], masks[tri[1]], masks[tri[2]]};
+        const auto outside = m[0] | m[1] | m[2];
+        const auto culled = m[0] & m[1] & m[2];
+
+        // The cross sections use the whole triangle, they are clipped separately when capping
+        if (const auto crossed = outside & ~culled & clip.capped) {
+            for (std::uint32_t k = 0; k < clip.planes.size(); ++k) {
+                if (!(crossed >> k & 1u)) continue;
+                glm::u32vec2 cut{0};
+                for (int e = 0, n = 0; e < 3; ++e) {
+                    if ((m[e] ^ m[(e + 1) % 3]) >> k & 1u) {
+                        auto v = onEdge(tri, e, k);
+                        cut[n++] = emit(v);
+                    }
+                }
+                chunk.cuts.emplace_back(k, cut);
+            }
+        }
+
+        if ((outside & clip.active) == 0) {
+            chunk.indices.insert(chunk.indices.end(), {tri[0], tri[1], tri[2]});
+            continue;
+        } else if ((culled & clip.active) != 0) {
+            continue;
+        }
+
+        polygon.clear();
+        for (int c = 0; c < 3; ++c) {
+            vec3 bary{0.0f};
+            bary[c] = 1.0f;
+            polygon.push_back({positions[tri[c]], bary, ClipVertex{}, tri[c],
+                               (1u << c) | (1u << ((c + 2) % 3))});
+        }
+
+        for (std::uint32_t k = 0; k < clip.planes.size() && polygon.size() >= 3; ++k) {
+            if (!((outside & clip.active) >> k & 1u)) continue;
+            const auto& plane = clip.planes[k];
+
+            clipped.clear();
+            for (size_t i = 0; i < polygon.size(); ++i) {
+                const auto& p = polygon[i];
+                const auto& q = polygon[(i + 1) % polygon.size()];
+                const auto dp = plane.distance(p.pos);
+                const auto dq = plane.distance(q.pos);
+
+                if (dp >= 0.0f) clipped.push_back(p);
+                if ((dp >= 0.0f) == (dq >= 0.0f)) continue;
+
+                if (const auto common = p.edges & q.edges) {
+                    clipped.push_back(onEdge(tri, common & 1u ? 0 : (common & 2u ? 1 : 2), k));
+                } else {
+                    const auto s = dp / (dp - dq);
+                    PolygonVertex v;
+                    v.pos = glm::mix(p.pos, q.pos, s);
+                    v.bary = glm::mix(p.bary, q.bary, s);
+                    v.vertex = {{tri[0], tri[1], tri[2]}, v.bary, invalidIndex};
+                    v.ref = invalidIndex;
+                    v.edges = 0;
+                    clipped.push_back(v);
+                }
             }
+            std::swap(polygon, clipped);
+        }
+
+        for (size_t i = 1; i + 1 < polygon.size(); ++i) {
+            chunk.indices.push_back(emit(polygon[0]));
+            chunk.indices.push_back(emit(polygon[i]));
+            chunk.indices.push_back(emit(polygon[i + 1]));
         }
+    }
+}
+
+void clipTriangles(const std::vector<std::uint32_t>& triangles,
+                   const std::vector<vec3>& positions, const std::vector<std::uint32_t>& masks,
+                   const ClipPlanes& clip, ClipVertices& vertices, std::vector<std::uint32_t>& out,
+                   std::vector<std::vector<glm::u32vec2>>& cuts) {
+    const auto count = triangles.size() / 3;
+    std::vector<ClipChunk> chunks((count + triangleChunkSize - 1) / triangleChunkSize);
+    util::cooperativeFor(chunks.size(), [&](size_t c) {
+        clipTriangles(triangles, c * triangleChunkSize,
+                      std::min(count, (c + 1) * triangleChunkSize), positions, masks, clip,
+                      chunks[c]);
+    });
+    vertices.merge(chunks, out, cuts);
+}
+
+/**
+ * Clip the segment (a, b) against all active planes using the parametric form of the segment.
+ * Appends the end points of the remaining part to \p chunk and returns true if any part remains.
+ */
+bool clipSegment(std::uint32_t a, std::uint32_t b, const std::vector<vec3>& positions,
+                 const std::vector<std::uint32_t>& masks, const ClipPlanes& clip,
+                 ClipChunk& chunk) {
+    const auto outside = (masks[a] | masks[b]) & clip.active;
+    if ((masks[a] & masks[b] & clip.active) != 0) return false;
+
+    float t0 = 0.0f;
+    float t1 = 1.0f;
+    auto k0 = invalidIndex;
+    auto k1 = invalidIndex;
+    for (std::uint32_t k = 0; k < clip.planes.size(); ++k) {
+        if (!(outside >> k & 1u)) continue;
+        const auto da = clip.planes[k].distance(positions[a]);
+        const auto db = clip.planes[k].distance(positions[b]);
+        const auto t = da / (da - db);
+        if (masks[a] >> k & 1u) {
+            if (t > t0) {
+                t0 = t;
+                k0 = k;
+            }
+        } else if (t < t1) {
+            t1 = t;
+            k1 = k;
+        }
+    }
+    if (t0 > t1) return false;
+
+    const auto endPoint = [&](std::uint32_t i, std::uint32_t k) {
+        if (k == invalidIndex) return i;
+        chunk.vertices.push_back(edgeVertex(a, b, k, clip.planes[k], positions));
+        return newVertexFlag | static_cast<std::uint32_t>(chunk.vertices.size() - 1);
+    };
+    chunk.indices.push_back(endPoint(a, k0));
+    chunk.indices.push_back(endPoint(b, k1));
+    return true;
+}
+
+void clipIndices(const Mesh::MeshInfo& meshInfo, Mesh& clippedMesh,
+                 const std::vector<uint32_t>& indices, const std::vector<vec3>& positions,
+                 const std::vector<std::uint32_t>& masks, const ClipPlanes& clip,
+                 ClipVertices& vertices, std::vector<std::vector<glm::u32vec2>>& cuts) {
+
+    const auto isInside = [&](std::uint32_t i) { return (masks[i] & clip.active) == 0; };
+
+    if (meshInfo.dt == DrawType::Points) {
+        auto& outIndices =
+            clippedMesh.addIndexBuffer(DrawType::Points, meshInfo.ct)->getDataContainer();
+        std::copy_if(indices.begin(), indices.end(), std::back_inserter(outIndices), isInside);
 
     } else if (meshInfo.dt == DrawType::Lines) {
         if (meshInfo.ct == ConnectivityType::None) {
-            if (indices.size() < 2) return {};
-            auto outIndices = clippedMesh->addIndexBuffer(DrawType::Lines, ConnectivityType::None);
-            for (unsigned int l = 0; l < indices.size() - 1; l += 2) {
-                const auto i1 = indices[l];
-                const auto i2 = indices[l + 1];
-
-                const auto in1 = plane.isInside(positions[i1]);
-                const auto in2 = plane.isInside(positions[i2]);
-
-                if (in1 && in2) {
-                    outIndices->add(i1);
-                    outIndices->add(i2);
-                } else if (in1) {
-                    const auto weight = *plane.getIntersectionWeight(positions[i1], positions[i2]);
-                    outIndices->add(i1);
-                    outIndices->add(
-                        addInterpolatedVertex({i1, i2}, {1.0f - weight, weight}, std::nullopt));
-                } else if (in2) {
-                    const auto weight = *plane.getIntersectionWeight(positions[i1], positions[i2]);
-                    outIndices->add(
-                        addInterpolatedVertex({i1, i2}, {1.0f - weight, weight}, std::nullopt));
-                    outIndices->add(i2);
-                }
+            if (indices.size() < 2) return;
+            std::vector<ClipChunk> chunks(1);
+            for (size_t l = 0; l + 1 < indices.size(); l += 2) {
+                clipSegment(indices[l], indices[l + 1], positions, masks, clip, chunks[0]);
             }
+            auto& outIndices =
+                clippedMesh.addIndexBuffer(DrawType::Lines, ConnectivityType::None)
+                    ->getDataContainer();
+            vertices.merge(chunks, outIndices, cuts);
+
         } else if (meshInfo.ct == ConnectivityType::Adjacency) {
-            if (indices.size() < 4) return newEdges;
-            auto outIndices =
-                clippedMesh->addIndexBuffer(DrawType::Lines, ConnectivityType::Adjacency);
-            for (unsigned int l = 0; l < indices.size() - 3; l += 4) {
-
-                const auto i1 = indices[l];
-                const auto i2 = indices[l + 1];
-                const auto i3 = indices[l + 2];
-                const auto i4 = indices[l + 3];
-
-                const auto in2 = plane.isInside(positions[i2]);
-                const auto in3 = plane.isInside(positions[i3]);
-
-                if (in2 && in3) {
-                    outIndices->add(i1);
-                    outIndices->add(i2);
-                    outIndices->add(i3);
-                    outIndices->add(i4);
-                } else if (in2) {
-                    const auto weight = *plane.getIntersectionWeight(positions[i2], positions[i3]);
-                    outIndices->add(i1);
-                    outIndices->add(i2);
-                    outIndices->add(
-                        addInterpolatedVertex({i2, i3}, {1.0f - weight, weight}, std::nullopt));
-                    outIndices->add(i3);
-                } else if (in2) {
-                    const auto weight = *plane.getIntersectionWeight(positions[i2], positions[i3]);
-                    outIndices->add(i2);
-                    outIndices->add(
-                        addInterpolatedVertex({i2, i3}, {1.0f - weight, weight}, std::nullopt));
-                    outIndices->add(i3);
-                    outIndices->add(i4);
+            if (indices.size() < 4) return;
+            std::vector<ClipChunk> chunks(1);
+            auto& chunk = chunks[0];
+            for (size_t l = 0; l + 3 < indices.size(); l += 4) {
+                chunk.indices.push_back(indices[l]);
+                if (clipSegment(indices[l + 1], indices[l + 2], positions, masks, clip, chunk)) {
+                    chunk.indices.push_back(indices[l + 3]);
+                } else {
+                    chunk.indices.pop_back();
                 }
             }
+            auto& outIndices =
+                clippedMesh.addIndexBuffer(DrawType::Lines, ConnectivityType::Adjacency)
+                    ->getDataContainer();
+            vertices.merge(chunks, outIndices, cuts);
+
         } else if (meshInfo.ct == ConnectivityType::Strip) {
-            if (indices.size() < 2) return newEdges;
+            if (indices.size() < 2) return;
 
             auto start = indices.begin();
             const auto end = indices.end();
 
             while (start != end) {
-                start = std::find_if(start, end,
-                                     [&](uint32_t i) { return plane.isInside(positions[i]); });
-                const auto lineEnd = std::find_if(
-                    start, end, [&](uint32_t i) { return !plane.isInside(positions[i]); });
+                start = std::find_if(start, end, isInside);
+                const auto lineEnd = std::find_if_not(start, end, isInside);
                 if (start != end) {
                     auto& outIndices =
-                        clippedMesh->addIndexBuffer(DrawType::Lines, ConnectivityType::Strip)
+                        clippedMesh.addIndexBuffer(DrawType::Lines, ConnectivityType::Strip)
                             ->getDataContainer();
                     std::copy(start, lineEnd, std::back_inserter(outIndices));
                 }
@@ -401,19 +689,17 @@ std::vector<glm::u32vec2> clipIndices(const Mesh::MeshInfo& meshInfo,
             }
 
         } else if (meshInfo.ct == ConnectivityType::StripAdjacency) {
-            if (indices.size() < 4) return newEdges;
+            if (indices.size() < 4) return;
             auto start = indices.begin() + 1;
             const auto end = indices.end() - 1;
 
             while (start != end) {
-                start = std::find_if(start, end,
-                                     [&](uint32_t i) { return plane.isInside(positions[i]); });
-                const auto lineEnd = std::find_if(
-                    start, end, [&](uint32_t i) { return !plane.isInside(positions[i]); });
+                start = std::find_if(start, end, isInside);
+                const auto lineEnd = std::find_if_not(start, end, isInside);
                 if (start != end) {
                     auto& outIndices =
                         clippedMesh
-                            ->addIndexBuffer(DrawType::Lines, ConnectivityType::StripAdjacency)
+                            .addIndexBuffer(DrawType::Lines, ConnectivityType::StripAdjacency)
                             ->getDataContainer();
 
                     outIndices.push_back(*std::prev(start));
@@ -428,41 +714,49 @@ std::vector<glm::u32vec2> clipIndices(const Mesh::MeshInfo& meshInfo,
                             IVW_CONTEXT_CUSTOM("MeshClipping"));
         }
     } else if (meshInfo.dt == DrawType::Triangles) {
-        if (indices.size() < 3) return newEdges;
-        auto outIndices = clippedMesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
+        if (indices.size() < 3) return;
+        auto& outIndices = clippedMesh.addIndexBuffer(DrawType::Triangles, ConnectivityType::None)
+                               ->getDataContainer();
 
         if (meshInfo.ct == ConnectivityType::Strip) {
-            for (unsigned int t = 0; t < indices.size() - 2; ++t) {
-                const glm::u32vec3 triangle{indices[t], indices[t & 1 ? t + 2 : t + 1],
-                                            indices[t & 1 ? t + 1 : t + 2]};
-                auto newEdge = detail::sutherlandHodgman(triangle, plane, positions,
-                                                         outIndices->getDataContainer(),
-                                                         addInterpolatedVertex);
-                if (newEdge) newEdges.push_back(*newEdge);
+            std::vector<std::uint32_t> triangles;
+            triangles.reserve(3 * (indices.size() - 2));
+            for (size_t t = 0; t < indices.size() - 2; ++t) {
+                triangles.insert(triangles.end(), {indices[t], indices[t & 1 ? t + 2 : t + 1],
+                                                   indices[t & 1 ? t + 1 : t + 2]});
             }
+            clipTriangles(triangles, positions, masks, clip, vertices, outIndices, cuts);
         } else if (meshInfo.ct == ConnectivityType::None) {
-            for (unsigned int t = 0; t < indices.size() - 2; t += 3) {
-                const glm::u32vec3 triangle{indices[t], indices[t + 1], indices[t + 2]};
-                auto newEdge = detail::sutherlandHodgman(triangle, plane, positions,
-                                                         outIndices->getDataContainer(),
-                                                         addInterpolatedVertex);
-                if (newEdge) newEdges.push_back(*newEdge);
-            }
+            clipTriangles(indices, positions, masks, clip, vertices, outIndices, cuts);
         } else {
             throw Exception("Cannot clip, need triangle connectivity Strip or None",
                             IVW_CONTEXT_CUSTOM("MeshClipping"));
         }
     }
-    return newEdges;
 }
 
 }  // namespace detail
 
 std::shared_ptr<Mesh> clipMeshAgainstPlane(const Mesh& mesh, const Plane& worldSpacePlane,
                                            bool capClippedHoles) {
+    return clipMeshAgainstPlanes(mesh, {worldSpacePlane}, capClippedHoles);
+}
 
-    const auto plane =
-        worldSpacePlane.transform(mesh.getCoordinateTransformer().getWorldToDataMatrix());
+std::shared_ptr<Mesh> clipMeshAgainstPlanes(const Mesh& mesh,
+                                            const std::vector<Plane>& worldSpacePlanes,
+                                            bool capClippedHoles) {
+    if (worldSpacePlanes.size() > detail::maxClipPlanes) {
+        const auto split = worldSpacePlanes.begin() + detail::maxClipPlanes;
+        const auto clipped = clipMeshAgainstPlanes(
+            mesh, std::vector<Plane>(worldSpacePlanes.begin(), split), capClippedHoles);
+        return clipMeshAgainstPlanes(*clipped, std::vector<Plane>(split, worldSpacePlanes.end()),
+                                     capClippedHoles);
+    }
+
+    std::vector<Plane> planes;
+    const auto worldToData = mesh.getCoordinateTransformer().getWorldToDataMatrix();
+    std::transform(worldSpacePlanes.begin(), worldSpacePlanes.end(), std::back_inserter(planes),
+                   [&](const Plane& plane) { return plane.transform(worldToData); });
 
     auto clippedMesh = std::make_shared<Mesh>();
     clippedMesh->setModelMatrix(mesh.getModelMatrix());
@@ -547,30 +841,47 @@ std::shared_ptr<Mesh> clipMeshAgainstPlane(const Mesh& mesh, const Plane& worldS
     }
 
     const auto& positions = posBuffer->getDataContainer();
-    std::vector<glm::u32vec2> newEdges;
+    std::vector<std::uint32_t> masks;
+    detail::updateOutsideMasks(masks, positions, planes);
+
+    const auto allPlanes = static_cast<std::uint32_t>((std::uint64_t{1} << planes.size()) - 1);
+    const detail::ClipPlanes clip{planes, allPlanes, capClippedHoles ? allPlanes : 0u};
+    detail::ClipVertices vertices{addInterpolatedVertex};
+    std::vector<std::vector<glm::u32vec2>> cuts(planes.size());
 
     for (const auto& item : mesh.getIndexBuffers()) {
         const auto meshInfo = item.first;
         const auto indexBuffer = item.second;
         const auto& indices = indexBuffer->getRAMRepresentation()->getDataContainer();
 
-        auto edges = detail::clipIndices(meshInfo, clippedMesh, indices, plane, positions,
-                                         addInterpolatedVertex);
-        newEdges.insert(newEdges.end(), edges.begin(), edges.end());
+        detail::clipIndices(meshInfo, *clippedMesh, indices, positions, masks, clip, vertices,
+                            cuts);
     }
     if (mesh.getIndexBuffers().empty()) {
         const auto meshInfo = mesh.getDefaultMeshInfo();
         std::vector<uint32_t> indices(mesh.getBuffer(0)->getSize());
         std::iota(indices.begin(), indices.end(), 0);
-        auto edges = detail::clipIndices(meshInfo, clippedMesh, indices, plane, positions,
-                                         addInterpolatedVertex);
-        newEdges.insert(newEdges.end(), edges.begin(), edges.end());
+        detail::clipIndices(meshInfo, *clippedMesh, indices, positions, masks, clip, vertices,
+                            cuts);
     }
 
-    if (capClippedHoles && !newEdges.empty()) {
-        auto outIndices = clippedMesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None);
-        detail::capHoles(newEdges, plane, positions, outIndices->getDataContainer(),
-                         addInterpolatedVertex);
+    if (capClippedHoles) {
+        std::vector<std::uint32_t> capIndices;
+        for (std::uint32_t k = 0; k < planes.size(); ++k) {
+            if (cuts[k].empty()) continue;
+
+            // The cap lies in plane k and is built from the full cross section of the mesh, clip
+            // it against the remaining planes like any other triangles
+            std::vector<std::uint32_t> cap;
+            detail::capHoles(cuts[k], planes[k], positions, cap, addInterpolatedVertex);
+            detail::updateOutsideMasks(masks, positions, planes);
+            const detail::ClipPlanes capClip{planes, allPlanes & ~(1u << k), 0u};
+            detail::clipTriangles(cap, positions, masks, capClip, vertices, capIndices, cuts);
+        }
+        if (!capIndices.empty()) {
+            clippedMesh->addIndexBuffer(DrawType::Triangles, ConnectivityType::None)
+                ->getDataContainer() = std::move(capIndices);
+        }
     }
 
     return clippedMesh;
@@ -0,0 +1,176 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/algorithm/mesh/vertexwelding.h>
+
+#include <unordered_map>
+#include <cstring>
+#include <cmath>
+#include <limits>
+
+namespace inviwo {
+
+namespace meshutil {
+
+namespace {
+
+constexpr std::uint32_t invalid = std::numeric_limits<std::uint32_t>::max();
+
+std::uint64_t cellKey(std::int64_t x, std::int64_t y, std::int64_t z) {
+    // Collisions are harmless, candidates are always compared by position afterwards.
+    return static_cast<std::uint64_t>(x) * 73856093ull ^
+           static_cast<std::uint64_t>(y) * 19349663ull ^
+           static_cast<std::uint64_t>(z) * 83492791ull;
+}
+
+std::uint64_t bitKey(vec3 p) {
+    // -0 and 0 compare equal but differ in their bits, use the same key for both
+    for (int i = 0; i < 3; ++i) {
+        if (p[i] == 0.0f) p[i] = 0.0f;
+    }
+    std::uint32_t bits[3];
+    std::memcpy(bits, &p, sizeof(bits));
+    return cellKey(bits[0], bits[1], bits[2]);
+}
+
+}  // namespace
+
+bool WeldOptions::set(std::string_view key, const std::any& value) {
+    if (key == "WeldVertices") {
+        if (auto val = std::any_cast<bool>(&value)) {
+            enabled = *val;
+            return true;
+        }
+    } else if (key == "WeldEpsilon") {
+        if (auto val = std::any_cast<float>(&value)) {
+            epsilon = *val;
+            return true;
+        } else if (auto dval = std::any_cast<double>(&value)) {
+            epsilon = static_cast<float>(*dval);
+            return true;
+        }
+    }
+    return false;
+}
+
+std::any WeldOptions::get(std::string_view key) const {
+    if (key == "WeldVertices") {
+        return enabled;
+    } else if (key == "WeldEpsilon") {
+        return epsilon;
+    }
+    return std::any{};
+}
+
+WeldResult weldVertices(const std::vector<vec3>& positions, float epsilon) {
+    WeldResult res;
+    res.remap.resize(positions.size());
+    res.unique.reserve(positions.size() / 2);
+
+    // The grid stores a singly linked list of unique vertices per cell, the head in the map
+    // and the links in next.
+    std::unordered_map<std::uint64_t, std::uint32_t> heads;
+    heads.reserve(positions.size() / 2);
+    std::vector<std::uint32_t> next;
+    next.reserve(positions.size() / 2);
+
+    const auto insert = [&](std::uint64_t key, std::uint32_t vertex) {
+        const auto id = static_cast<std::uint32_t>(res.unique.size());
+        res.unique.push_back(vertex);
+        auto [it, inserted] = heads.try_emplace(key, id);
+        next.push_back(inserted ? invalid : it->second);
+        it->second = id;
+        return id;
+    };
+
+    const auto find = [&](std::uint64_t key, auto&& match) -> std::uint32_t {
+        if (auto it = heads.find(key); it != heads.end()) {
+            for (auto id = it->second; id != invalid; id = next[id]) {
+                if (match(positions[res.unique[id]])) return id;
+            }
+        }
+        return invalid;
+    };
+
+    if (epsilon <= 0.0f) {
+        for (std::uint32_t i = 0; i < positions.size(); ++i) {
+            const auto& p = positions[i];
+            const auto key = bitKey(p);
+            auto id = find(key, [&](const vec3& q) { return q == p; });
+            res.remap[i] = id != invalid ? id : insert(key, i);
+        }
+    } else {
+        const float eps2 = epsilon * epsilon;
+        for (std::uint32_t i = 0; i < positions.size(); ++i) {
+            const auto& p = positions[i];
+            const auto cell = glm::i64vec3(glm::floor(p / epsilon));
+            const auto match = [&](const vec3& q) {
+                const auto d = p - q;
+                return glm::dot(d, d) <= eps2;
+            };
+
+            auto id = invalid;
+            for (std::int64_t z = -1; z <= 1 && id == invalid; ++z) {
+                for (std::int64_t y = -1; y <= 1 && id == invalid; ++y) {
+                    for (std::int64_t x = -1; x <= 1 && id == invalid; ++x) {
+                        id = find(cellKey(cell.x + x, cell.y + y, cell.z + z), match);
+                    }
+                }
+            }
+            res.remap[i] = id != invalid ? id : insert(cellKey(cell.x, cell.y, cell.z), i);
+        }
+    }
+
+    return res;
+}
+
+void applyWeldToIndices(const WeldResult& weld, std::vector<std::uint32_t>& indices) {
+    for (auto& i : indices) i = weld.remap[i];
+}
+
+std::vector<vec3> smoothNormals(const std::vector<vec3>& positions,
+                                const std::vector<std::uint32_t>& indices) {
+    std::vector<vec3> normals(positions.size(), vec3{0.0f});
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const auto& a = positions[indices[i]];
+        const auto& b = positions[indices[i + 1]];
+        const auto& c = positions[indices[i + 2]];
+        // The length of the cross product is twice the area, which gives the area weighting
+        const auto n = glm::cross(b - a, c - a);
+        for (size_t j = 0; j < 3; ++j) normals[indices[i + j]] += n;
+    }
+    for (auto& n : normals) {
+        if (n != vec3{0.0f}) n = glm::normalize(n);
+    }
+    return normals;
+}
+
+}  // namespace meshutil
+
+}  // namespace inviwo
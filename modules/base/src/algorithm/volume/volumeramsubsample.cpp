@@ -31,10 +31,7 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/util/indexmapper.h>
-
-#ifdef IVW_USE_OPENMP
-#include <omp.h>
-#endif
+#include <inviwo/core/util/threadutil.h>
 
 namespace inviwo {
 
@@ -62,11 +59,7 @@ std::shared_ptr<VolumeRAM> util::volumeSubSample(const VolumeRAM* volume, size3_
 
             const double samplesInv = 1.0 / (f.x * f.y * f.z);
 
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-            for (long long z_ = 0; z_ < static_cast<long long>(destDims.z); ++z_) {
-                const size_t z = static_cast<size_t>(z_);  // OpenMP need signed integral type.
+            util::parallelFor(0, destDims.z, [&](size_t z) {
                 for (size_t y = 0; y < destDims.y; ++y) {
                     for (size_t x = 0; x < destDims.x; ++x) {
                         const size_t px{x * f.x};
@@ -88,7 +81,7 @@ std::shared_ptr<VolumeRAM> util::volumeSubSample(const VolumeRAM* volume, size3_
 #include <warn/pop>
                     }
                 }
-            }
+            });
 
             return destVol;
         });
@@ -28,10 +28,7 @@
  *********************************************************************************/
 
 #include <modules/base/algorithm/volume/volumeramsubset.h>
-
-#ifdef IVW_USE_OPENMP
-#include <omp.h>
-#endif
+#include <inviwo/core/util/threadutil.h>
 
 namespace inviwo {
 
@@ -98,12 +95,9 @@ std::shared_ptr<VolumeRAM> VolumeRAMSubSetDispatcher::operator()(const VolumeRep
 
     const T* src = static_cast<const T*>(volume->getData());
     T* dst = static_cast<T*>(newVolume->getData());
-    // memcpy each row for every slice to form sub volume
-
-    for (int i = 0; i < static_cast<int>(copyDimsWithoutBorder.z); i++) {
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
+    // memcpy each row for every slice to form sub volume, one task per slice
+    util::parallelFor(0, copyDimsWithoutBorder.z, [&](size_t slice) {
+        const auto i = static_cast<int>(slice);
         for (int j = 0; j < static_cast<int>(copyDimsWithoutBorder.y); j++) {
             size_t volumePos = (j * dataDims.x) + (i * dataDims.x * dataDims.y);
             size_t subVolumePos = ((j + trueBorder.llf.y) * dimsWithBorder.x) +
@@ -111,7 +105,7 @@ std::shared_ptr<VolumeRAM> VolumeRAMSubSetDispatcher::operator()(const VolumeRep
                                   trueBorder.llf.x;
             std::memcpy(dst + subVolumePos, (src + volumePos + initialStartPos), dataSize);
         }
-    }
+    });
 
     return newVolume;
 }
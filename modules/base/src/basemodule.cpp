@@ -114,7 +114,10 @@
 #include <modules/base/io/ivfvolumereader.h>
 #include <modules/base/io/ivfvolumewriter.h>
 #include <modules/base/io/ivfsequencevolumereader.h>
+#include <modules/base/io/plyreader.h>
+#include <modules/base/io/stlreader.h>
 #include <modules/base/io/stlwriter.h>
+#include <modules/base/io/wavefrontreader.h>
 #include <modules/base/io/wavefrontwriter.h>
 #include <modules/base/processors/meshconverterprocessor.h>
 #include <modules/base/processors/volumeinformation.h>
@@ -237,6 +240,9 @@ BaseModule::BaseModule(InviwoApplication* app) : InviwoModule(app, "Base") {
     registerDataReader(std::make_unique<DatVolumeSequenceReader>());
     registerDataReader(std::make_unique<IvfVolumeReader>());
     registerDataReader(std::make_unique<IvfSequenceVolumeReader>());
+    registerDataReader(std::make_unique<PlyReader>());
+    registerDataReader(std::make_unique<StlReader>());
+    registerDataReader(std::make_unique<WaveFrontReader>());
     // Register Data writers
     registerDataWriter(std::make_unique<DatVolumeWriter>());
     registerDataWriter(std::make_unique<IvfVolumeWriter>());
@@ -0,0 +1,254 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/datastructures/volumesequencestreamer.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+VolumeSequenceStreamer::VolumeSequenceStreamer(size_t residentWindow, size_t prefetch)
+    : residentWindow_{std::max(residentWindow, prefetch + 1)}, prefetch_{prefetch} {}
+
+VolumeSequenceStreamer::~VolumeSequenceStreamer() { drain(); }
+
+void VolumeSequenceStreamer::setSequence(std::shared_ptr<const VolumeSequence> sequence) {
+    if (sequence == sequence_) return;
+    releaseAll();
+    if (!resident_.empty()) {
+        // Time steps still in use are released once they are no longer referenced
+        retired_.push_back(Retired{std::move(sequence_), std::move(resident_)});
+        resident_.clear();
+    }
+    sequence_ = std::move(sequence);
+    previous_.reset();
+    direction_ = 1;
+}
+
+const std::shared_ptr<const VolumeSequence>& VolumeSequenceStreamer::getSequence() const {
+    return sequence_;
+}
+
+void VolumeSequenceStreamer::setResidentWindow(size_t window) {
+    residentWindow_ = std::max(window, prefetch_ + 1);
+}
+size_t VolumeSequenceStreamer::getResidentWindow() const { return residentWindow_; }
+
+void VolumeSequenceStreamer::setPrefetch(size_t prefetch) {
+    prefetch_ = prefetch;
+    residentWindow_ = std::max(residentWindow_, prefetch_ + 1);
+}
+size_t VolumeSequenceStreamer::getPrefetch() const { return prefetch_; }
+
+size_t VolumeSequenceStreamer::wrap(std::ptrdiff_t index) const {
+    const auto size = static_cast<std::ptrdiff_t>(sequence_->size());
+    return static_cast<size_t>(((index % size) + size) % size);
+}
+
+std::unordered_set<size_t> VolumeSequenceStreamer::window(size_t index, int direction) const {
+    std::unordered_set<size_t> res;
+    const auto behind = static_cast<std::ptrdiff_t>(residentWindow_ - 1 - prefetch_);
+    const auto ahead = static_cast<std::ptrdiff_t>(prefetch_);
+    const auto current = static_cast<std::ptrdiff_t>(index);
+    for (auto i = -behind; i <= ahead && res.size() < sequence_->size(); ++i) {
+        res.insert(wrap(current + direction * i));
+    }
+    return res;
+}
+
+std::shared_ptr<Volume> VolumeSequenceStreamer::get(size_t index) {
+    if (!sequence_ || index >= sequence_->size()) return nullptr;
+
+    if (previous_ && *previous_ != index) {
+        // Jumping more than half the sequence is treated as wrapping around the end
+        const auto delta =
+            static_cast<std::ptrdiff_t>(index) - static_cast<std::ptrdiff_t>(*previous_);
+        const auto half = static_cast<std::ptrdiff_t>(sequence_->size() / 2);
+        direction_ = (delta > 0) == (std::abs(delta) <= half) ? 1 : -1;
+    }
+    previous_ = index;
+
+    ++stats_.requests;
+    auto volume = (*sequence_)[index];
+    if (!util::contains(inFlight_, index) && volume->hasRepresentation<VolumeRAM>()) {
+        ++stats_.hits;
+    } else {
+        const auto start = std::chrono::steady_clock::now();
+        bool stalled = true;
+        if (auto it = inFlight_.find(index); it != inFlight_.end()) {
+            auto load = std::move(it->second);
+            inFlight_.erase(it);
+            stalled = !util::is_future_ready(load.future);
+            load.future.get();
+        }
+        // The prefetch might have been cancelled before it started
+        if (!volume->hasRepresentation<VolumeRAM>()) {
+            stalled = true;
+            volume->getRepresentation<VolumeRAM>();
+        }
+        if (stalled) {
+            ++stats_.stalls;
+            stats_.stallTime += std::chrono::steady_clock::now() - start;
+        } else {
+            ++stats_.prefetchHits;
+        }
+    }
+    resident_.insert(index);
+    releaseRetired();
+
+    const auto keep = window(index, direction_);
+    for (auto it = resident_.begin(); it != resident_.end();) {
+        if (keep.count(*it) == 0 && release(*it)) {
+            it = resident_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    for (size_t i = 1; i <= prefetch_ && i < sequence_->size(); ++i) {
+        prefetch(wrap(static_cast<std::ptrdiff_t>(index) +
+                      direction_ * static_cast<std::ptrdiff_t>(i)));
+    }
+
+    return volume;
+}
+
+void VolumeSequenceStreamer::prefetch(size_t index) {
+    if (auto it = inFlight_.find(index); it != inFlight_.end()) {
+        // Back in the window, load it after all unless the cancelled task already was skipped
+        *it->second.cancelled = false;
+        return;
+    }
+
+    const auto& volume = (*sequence_)[index];
+    resident_.insert(index);
+    if (volume->hasRepresentation<VolumeRAM>()) return;
+
+    if (InviwoApplication::isInitialized() && InviwoApplication::getPtr()->getPoolSize() > 0) {
+        auto cancelled = std::make_shared<std::atomic<bool>>(false);
+        // Only hold a weak reference to not interfere with the reference count used in release
+        auto future = dispatchPool([weak = std::weak_ptr<Volume>{volume}, cancelled]() {
+            if (*cancelled) return;
+            if (auto volume = weak.lock()) volume->getRepresentation<VolumeRAM>();
+        });
+        inFlight_[index] = Load{std::move(future), std::move(cancelled)};
+    }
+}
+
+bool VolumeSequenceStreamer::release(size_t index) {
+    if (auto it = inFlight_.find(index); it != inFlight_.end()) {
+        // The load has to finish before the volume can be released, skip it if it has not started
+        // yet and try again later.
+        if (!util::is_future_ready(it->second.future)) {
+            *it->second.cancelled = true;
+            return false;
+        }
+        try {
+            it->second.future.get();
+        } catch (const Exception&) {
+        }
+        inFlight_.erase(it);
+    }
+
+    return release((*sequence_)[index]);
+}
+
+bool VolumeSequenceStreamer::release(const std::shared_ptr<Volume>& volume) {
+    // The volume has been handed out and is still in use, removing its RAM representation would
+    // modify data that others are using. Try again later.
+    if (volume.use_count() > 1) return false;
+    if (!volume->hasRepresentation<VolumeDisk>()) return true;
+    try {
+        // Throws if the disk representation is no longer valid, i.e. the volume has been edited
+        if (auto disk = volume->getRepresentation<VolumeDisk>()) {
+            if (volume->hasRepresentation<VolumeRAM>()) ++stats_.evictions;
+            volume->removeOtherRepresentations(disk);
+        }
+    } catch (const Exception&) {
+    }
+    return true;
+}
+
+void VolumeSequenceStreamer::releaseAll() {
+    releaseRetired();
+    if (!sequence_) return;
+    drain();
+    // Volumes that are still in use stay resident and are released later
+    for (auto it = resident_.begin(); it != resident_.end();) {
+        if (release(*it)) {
+            it = resident_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    inFlight_.clear();
+}
+
+void VolumeSequenceStreamer::releaseRetired() {
+    for (auto& retired : retired_) {
+        for (auto it = retired.indices.begin(); it != retired.indices.end();) {
+            if (release((*retired.sequence)[*it])) {
+                it = retired.indices.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    util::erase_remove_if(retired_, [](const Retired& retired) { return retired.indices.empty(); });
+}
+
+void VolumeSequenceStreamer::drain() {
+    for (auto& item : inFlight_) *item.second.cancelled = true;
+    for (auto& item : inFlight_) {
+        if (item.second.future.valid()) item.second.future.wait();
+    }
+}
+
+size_t VolumeSequenceStreamer::getResidentCount() const {
+    if (!sequence_) return 0;
+    return std::count_if(resident_.begin(), resident_.end(), [&](size_t index) {
+        // Skip time steps that might still be converted on the thread pool
+        if (auto it = inFlight_.find(index);
+            it != inFlight_.end() && !util::is_future_ready(it->second.future)) {
+            return false;
+        }
+        return (*sequence_)[index]->hasRepresentation<VolumeRAM>();
+    });
+}
+
+const VolumeSequenceStreamer::Stats& VolumeSequenceStreamer::getStats() const { return stats_; }
+
+void VolumeSequenceStreamer::resetStats() { stats_ = Stats{}; }
+
+}  // namespace inviwo
@@ -154,7 +154,7 @@ void BinarySTLWriter::writeData(const Mesh* data, std::ostream& f) const {
     f.write(header.data(), header.size());
     std::uint32_t size = static_cast<std::uint32_t>(floatdata.size() / 4);
     f.write(reinterpret_cast<char*>(&size), sizeof(size));
-    for (size_t i = 0; i < floatdata.size() - 4u; i += 4) {
+    for (size_t i = 0; i + 4 <= floatdata.size(); i += 4) {
         f.write(reinterpret_cast<char*>(&floatdata[i + 0]), sizeof(vec3));
         f.write(reinterpret_cast<char*>(&floatdata[i + 1]), sizeof(vec3));
         f.write(reinterpret_cast<char*>(&floatdata[i + 2]), sizeof(vec3));
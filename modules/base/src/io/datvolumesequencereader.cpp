@@ -47,7 +47,7 @@
 namespace inviwo {
 
 DatVolumeSequenceReader::DatVolumeSequenceReader()
-    : DataReaderType<VolumeSequence>(), enableLogOutput_(true) {
+    : DataReaderType<VolumeSequence>(), enableLogOutput_(true), compressed_(false) {
     addExtension(FileExtension("dat", "Inviwo dat file format"));
 }
 
@@ -59,6 +59,21 @@ DatVolumeSequenceReader* DatVolumeSequenceReader::clone() const {
     return new DatVolumeSequenceReader(*this);
 }
 
+bool DatVolumeSequenceReader::setOption(std::string_view key, std::any value) {
+    if (key == "Compressed") {
+        if (auto compressed = std::any_cast<bool>(&value)) {
+            compressed_ = *compressed;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::any DatVolumeSequenceReader::getOption(std::string_view key) {
+    if (key == "Compressed") return compressed_;
+    return std::any{};
+}
+
 std::shared_ptr<DatVolumeSequenceReader::VolumeSequence> DatVolumeSequenceReader::readData(
     const std::string& filePath) {
     std::string fileName = filePath;
@@ -341,21 +356,47 @@ std::shared_ptr<DatVolumeSequenceReader::VolumeSequence> DatVolumeSequenceReader
             } else {
                 volumes->push_back(std::shared_ptr<Volume>(volumes->front()->clone()));
             }
-            auto diskRepr = std::make_shared<VolumeDisk>(fileName, state.dimensions, state.format,
-                                                         state.swizzleMask, state.interpolation,
-                                                         state.wrapping);
             const auto filePos = t * bytes + state.byteOffset;
-
-            auto loader = std::make_unique<RawVolumeRAMLoader>(fileDirectory + "/" + state.rawFile,
-                                                               filePos, state.littleEndian);
-            diskRepr->setLoader(loader.release());
-            volumes->back()->addRepresentation(diskRepr);
+            const auto rawFile = fileDirectory + "/" + state.rawFile;
+            // Use min/max value in data as data range if none is given
+            // Only consider first time step since it can be time consuming
+            // to compute for all time steps
+            const bool computeRange = t == 0 && !state.datarange;
+            std::pair<dvec4, dvec4> minmax{dvec4{0.0}, dvec4{0.0}};
+
+            if (compressed_) {
+                // The range is computed while reading, converting the compressed volume to RAM
+                // would defeat the purpose of compressing it
+                bool first = true;
+                auto compressed = util::readRawVolumeCompressed(
+                    rawFile, filePos, state.littleEndian, state.dimensions, state.format,
+                    VolumeCompressed::defaultBrickSize, [&](const VolumeRAM& slab) {
+                        if (!computeRange) return;
+                        const auto slabMinMax = util::volumeMinMax(&slab, IgnoreSpecialValues::No);
+                        minmax.first = first ? slabMinMax.first
+                                             : glm::min(minmax.first, slabMinMax.first);
+                        minmax.second = first ? slabMinMax.second
+                                              : glm::max(minmax.second, slabMinMax.second);
+                        first = false;
+                    });
+                compressed->setSwizzleMask(state.swizzleMask);
+                compressed->setInterpolation(state.interpolation);
+                compressed->setWrapping(state.wrapping);
+                volumes->back()->addRepresentation(compressed);
+            } else {
+                auto diskRepr = std::make_shared<VolumeDisk>(fileName, state.dimensions,
+                                                             state.format, state.swizzleMask,
+                                                             state.interpolation, state.wrapping);
+                auto loader =
+                    std::make_unique<RawVolumeRAMLoader>(rawFile, filePos, state.littleEndian);
+                diskRepr->setLoader(loader.release());
+                volumes->back()->addRepresentation(diskRepr);
+                if (computeRange) {
+                    minmax = util::volumeMinMax(volumes->front().get(), IgnoreSpecialValues::No);
+                }
+            }
             // Compute data range if not specified
-            if (t == 0 && !state.datarange) {
-                // Use min/max value in data as data range if none is given
-                // Only consider first time step since it can be time consuming
-                // to compute for all time steps
-                auto minmax = util::volumeMinMax(volumes->front().get(), IgnoreSpecialValues::No);
+            if (computeRange) {
                 // minmax always have four components, unused components are set to zero.
                 // Hence, only consider components used by the data format
                 dvec2 computedRange(minmax.first[0], minmax.second[0]);
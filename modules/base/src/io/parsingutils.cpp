@@ -0,0 +1,75 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/parsingutils.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+namespace inviwo {
+
+namespace util {
+
+size_t parseJobs() {
+    if (!InviwoApplication::isInitialized()) return 1;
+    return std::max<size_t>(4 * InviwoApplication::getPtr()->getPoolSize(), 1);
+}
+
+std::vector<std::pair<size_t, size_t>> splitIntoRanges(size_t size, size_t chunks) {
+    std::vector<std::pair<size_t, size_t>> res;
+    chunks = std::clamp<size_t>(chunks, 1, std::max<size_t>(size, 1));
+    for (size_t i = 0; i < chunks; ++i) {
+        const auto begin = (size * i) / chunks;
+        const auto end = (size * (i + 1)) / chunks;
+        if (begin != end) res.emplace_back(begin, end);
+    }
+    return res;
+}
+
+std::vector<std::string_view> splitIntoLineChunks(std::string_view text, size_t chunks) {
+    std::vector<std::string_view> res;
+    if (text.empty()) return res;
+    chunks = std::max<size_t>(chunks, 1);
+
+    const auto first = text.data();
+    const auto last = text.data() + text.size();
+    const auto chunkSize = std::max<size_t>(text.size() / chunks, 1);
+
+    auto begin = first;
+    while (begin != last) {
+        auto end = last - begin > static_cast<std::ptrdiff_t>(chunkSize)
+                       ? skipLine(begin + chunkSize, last)
+                       : last;
+        res.emplace_back(begin, static_cast<size_t>(end - begin));
+        begin = end;
+    }
+    return res;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
@@ -0,0 +1,699 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/plyreader.h>
+#include <modules/base/io/parsingutils.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/memorymappedfile.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include <sstream>
+
+namespace inviwo {
+
+namespace {
+
+enum class PlyType { Int8, UInt8, Int16, UInt16, Int32, UInt32, Float32, Float64 };
+enum class PlyFormat { Ascii, BinaryLittleEndian, BinaryBigEndian };
+
+std::optional<PlyType> parseType(std::string_view str) {
+    if (str == "char" || str == "int8") return PlyType::Int8;
+    if (str == "uchar" || str == "uint8") return PlyType::UInt8;
+    if (str == "short" || str == "int16") return PlyType::Int16;
+    if (str == "ushort" || str == "uint16") return PlyType::UInt16;
+    if (str == "int" || str == "int32") return PlyType::Int32;
+    if (str == "uint" || str == "uint32") return PlyType::UInt32;
+    if (str == "float" || str == "float32") return PlyType::Float32;
+    if (str == "double" || str == "float64") return PlyType::Float64;
+    return std::nullopt;
+}
+
+size_t typeSize(PlyType type) {
+    switch (type) {
+        case PlyType::Int8:
+        case PlyType::UInt8:
+            return 1;
+        case PlyType::Int16:
+        case PlyType::UInt16:
+            return 2;
+        case PlyType::Int32:
+        case PlyType::UInt32:
+        case PlyType::Float32:
+            return 4;
+        case PlyType::Float64:
+            return 8;
+    }
+    return 0;
+}
+
+template <typename T>
+T load(const char* data, bool swap) {
+    std::array<char, sizeof(T)> bytes;
+    std::memcpy(bytes.data(), data, sizeof(T));
+    if (swap) std::reverse(bytes.begin(), bytes.end());
+    T value;
+    std::memcpy(&value, bytes.data(), sizeof(T));
+    return value;
+}
+
+double loadValue(const char* data, PlyType type, bool swap) {
+    switch (type) {
+        case PlyType::Int8:
+            return load<std::int8_t>(data, swap);
+        case PlyType::UInt8:
+            return load<std::uint8_t>(data, swap);
+        case PlyType::Int16:
+            return load<std::int16_t>(data, swap);
+        case PlyType::UInt16:
+            return load<std::uint16_t>(data, swap);
+        case PlyType::Int32:
+            return load<std::int32_t>(data, swap);
+        case PlyType::UInt32:
+            return load<std::uint32_t>(data, swap);
+        case PlyType::Float32:
+            return load<float>(data, swap);
+        case PlyType::Float64:
+            return load<double>(data, swap);
+    }
+    return 0.0;
+}
+
+struct Property {
+    std::string name;
+    PlyType type;
+    std::optional<PlyType> countType;  // Only set for list properties
+};
+
+struct Element {
+    std::string name;
+    size_t count = 0;
+    std::vector<Property> properties;
+
+    bool hasLists() const {
+        return std::any_of(properties.begin(), properties.end(),
+                           [](const Property& p) { return p.countType.has_value(); });
+    }
+    // Only valid for elements without list properties
+    size_t stride() const {
+        size_t size = 0;
+        for (auto& p : properties) size += typeSize(p.type);
+        return size;
+    }
+    std::vector<size_t> offsets() const {
+        std::vector<size_t> res;
+        size_t offset = 0;
+        for (auto& p : properties) {
+            res.push_back(offset);
+            offset += typeSize(p.type);
+        }
+        return res;
+    }
+    int find(std::initializer_list<std::string_view> names) const {
+        for (auto name : names) {
+            auto it = std::find_if(properties.begin(), properties.end(),
+                                   [&](const Property& p) { return p.name == name; });
+            if (it != properties.end()) return static_cast<int>(it - properties.begin());
+        }
+        return -1;
+    }
+};
+
+struct Header {
+    PlyFormat format = PlyFormat::Ascii;
+    std::vector<Element> elements;
+    size_t size = 0;
+};
+
+Header parseHeader(const util::MemoryMappedFile& file) {
+    const std::string_view data{file.data(), file.size()};
+    if (data.substr(0, 3) != "ply") {
+        throw DataReaderException("Not a PLY file", IVW_CONTEXT_CUSTOM("PlyReader"));
+    }
+    const auto end = data.find("end_header");
+    if (end == std::string_view::npos) {
+        throw DataReaderException("Missing PLY end_header", IVW_CONTEXT_CUSTOM("PlyReader"));
+    }
+
+    Header header;
+    header.size =
+        static_cast<size_t>(util::skipLine(file.data() + end, file.end()) - file.data());
+
+    std::istringstream is{std::string{data.substr(0, end)}};
+    std::string line;
+    while (std::getline(is, line)) {
+        std::istringstream ls{line};
+        std::string keyword;
+        ls >> keyword;
+        if (keyword == "format") {
+            std::string format;
+            ls >> format;
+            if (format == "ascii") {
+                header.format = PlyFormat::Ascii;
+            } else if (format == "binary_little_endian") {
+                header.format = PlyFormat::BinaryLittleEndian;
+            } else if (format == "binary_big_endian") {
+                header.format = PlyFormat::BinaryBigEndian;
+            } else {
+                throw DataReaderException("Unknown PLY format: " + format,
+                                          IVW_CONTEXT_CUSTOM("PlyReader"));
+            }
+        } else if (keyword == "element") {
+            Element element;
+            ls >> element.name >> element.count;
+            header.elements.push_back(std::move(element));
+        } else if (keyword == "property") {
+            if (header.elements.empty()) {
+                throw DataReaderException("PLY property without element",
+                                          IVW_CONTEXT_CUSTOM("PlyReader"));
+            }
+            std::string type;
+            ls >> type;
+            Property property;
+            if (type == "list") {
+                std::string countType;
+                ls >> countType >> type;
+                property.countType = parseType(countType);
+                if (!property.countType) {
+                    throw DataReaderException("Unknown PLY type: " + countType,
+                                              IVW_CONTEXT_CUSTOM("PlyReader"));
+                }
+            }
+            if (auto t = parseType(type)) {
+                property.type = *t;
+            } else {
+                throw DataReaderException("Unknown PLY type: " + type,
+                                          IVW_CONTEXT_CUSTOM("PlyReader"));
+            }
+            ls >> property.name;
+            header.elements.back().properties.push_back(std::move(property));
+        }
+    }
+    return header;
+}
+
+struct VertexLayout {
+    explicit VertexLayout(const Element& vertex) {
+        position = {vertex.find({"x"}), vertex.find({"y"}), vertex.find({"z"})};
+        normal = {vertex.find({"nx"}), vertex.find({"ny"}), vertex.find({"nz"})};
+        color = {vertex.find({"red", "r", "diffuse_red"}),
+                 vertex.find({"green", "g", "diffuse_green"}),
+                 vertex.find({"blue", "b", "diffuse_blue"}),
+                 vertex.find({"alpha", "a", "diffuse_alpha"})};
+        texcoord = {vertex.find({"u", "s", "texture_u", "texture_s"}),
+                    vertex.find({"v", "t", "texture_v", "texture_t"})};
+        for (size_t i = 0; i < 4; ++i) {
+            if (color[i] < 0) continue;
+            switch (vertex.properties[color[i]].type) {
+                case PlyType::UInt8:
+                    colorScale[i] = 1.0f / 255.0f;
+                    break;
+                case PlyType::UInt16:
+                    colorScale[i] = 1.0f / 65535.0f;
+                    break;
+                default:
+                    colorScale[i] = 1.0f;
+            }
+        }
+
+        if (std::any_of(position.begin(), position.end(), [](int i) { return i < 0; })) {
+            throw DataReaderException("PLY vertex element is missing x, y, or z",
+                                      IVW_CONTEXT_CUSTOM("PlyReader"));
+        }
+    }
+    bool hasNormals() const {
+        return std::all_of(normal.begin(), normal.end(), [](int i) { return i >= 0; });
+    }
+    bool hasColors() const {
+        return std::all_of(color.begin(), color.begin() + 3, [](int i) { return i >= 0; });
+    }
+    bool hasTexCoords() const {
+        return std::all_of(texcoord.begin(), texcoord.end(), [](int i) { return i >= 0; });
+    }
+
+    std::array<int, 3> position;
+    std::array<int, 3> normal;
+    std::array<int, 4> color;
+    std::array<int, 2> texcoord;
+    std::array<float, 4> colorScale{1.0f, 1.0f, 1.0f, 1.0f};
+};
+
+struct Vertices {
+    void resize(size_t size, const VertexLayout& layout) {
+        positions.resize(size);
+        if (layout.hasNormals()) normals.resize(size);
+        if (layout.hasColors()) colors.resize(size);
+        if (layout.hasTexCoords()) texcoords.resize(size);
+    }
+
+    // Get is a functor returning the value of a property by index
+    template <typename Get>
+    void set(size_t i, const VertexLayout& l, Get&& get) {
+        positions[i] = vec3{get(l.position[0]), get(l.position[1]), get(l.position[2])};
+        if (!normals.empty()) {
+            normals[i] = vec3{get(l.normal[0]), get(l.normal[1]), get(l.normal[2])};
+        }
+        if (!colors.empty()) {
+            colors[i] = vec4{get(l.color[0]) * l.colorScale[0], get(l.color[1]) * l.colorScale[1],
+                             get(l.color[2]) * l.colorScale[2],
+                             l.color[3] >= 0 ? get(l.color[3]) * l.colorScale[3] : 1.0f};
+        }
+        if (!texcoords.empty()) {
+            texcoords[i] = vec2{get(l.texcoord[0]), get(l.texcoord[1])};
+        }
+    }
+
+    void append(const Vertices& other) {
+        positions.insert(positions.end(), other.positions.begin(), other.positions.end());
+        normals.insert(normals.end(), other.normals.begin(), other.normals.end());
+        colors.insert(colors.end(), other.colors.begin(), other.colors.end());
+        texcoords.insert(texcoords.end(), other.texcoords.begin(), other.texcoords.end());
+    }
+
+    std::vector<vec3> positions;
+    std::vector<vec3> normals;
+    std::vector<vec4> colors;
+    std::vector<vec2> texcoords;
+};
+
+void triangulate(std::vector<std::uint32_t>& indices, const std::uint32_t* polygon, size_t size) {
+    for (size_t i = 2; i < size; ++i) {
+        indices.push_back(polygon[0]);
+        indices.push_back(polygon[i - 1]);
+        indices.push_back(polygon[i]);
+    }
+}
+
+class BinaryParser {
+public:
+    BinaryParser(const util::MemoryMappedFile& file, size_t offset, bool swap)
+        : file_{file}, cursor_{file.data() + offset}, swap_{swap} {}
+
+    void skip(const Element& element) {
+        if (!element.hasLists()) {
+            advance(element.count * element.stride());
+        } else {
+            for (size_t i = 0; i < element.count; ++i) walk(element, [](size_t, const char*) {});
+        }
+    }
+
+    Vertices vertices(const Element& element, const VertexLayout& layout) {
+        Vertices vertices;
+        vertices.resize(element.count, layout);
+        const auto& props = element.properties;
+
+        if (!element.hasLists()) {
+            const auto stride = element.stride();
+            const auto offsets = element.offsets();
+            const char* start = cursor_;
+            advance(element.count * stride);
+
+            const auto ranges = util::splitIntoRanges(element.count, util::parseJobs());
+            util::forEachParallel(ranges, [&](const std::pair<size_t, size_t>& range) {
+                for (size_t i = range.first; i < range.second; ++i) {
+                    const char* data = start + i * stride;
+                    vertices.set(i, layout, [&](int p) {
+                        return static_cast<float>(
+                            loadValue(data + offsets[p], props[p].type, swap_));
+                    });
+                }
+            });
+        } else {
+            std::vector<const char*> values(props.size());
+            for (size_t i = 0; i < element.count; ++i) {
+                walk(element, [&](size_t p, const char* data) { values[p] = data; });
+                vertices.set(i, layout, [&](int p) {
+                    return static_cast<float>(loadValue(values[p], props[p].type, swap_));
+                });
+            }
+        }
+        return vertices;
+    }
+
+    std::vector<std::uint32_t> faces(const Element& element, int list) {
+        const auto& prop = element.properties[list];
+        if (element.properties.size() == 1) {
+            if (auto indices = triangles(element)) return std::move(*indices);
+        }
+
+        std::vector<std::uint32_t> indices;
+        indices.reserve(3 * element.count);
+        std::vector<std::uint32_t> polygon;
+        const auto size = typeSize(prop.type);
+        for (size_t i = 0; i < element.count; ++i) {
+            walk(element, [&](size_t p, const char* data) {
+                if (p != static_cast<size_t>(list)) return;
+                const auto n = static_cast<size_t>(loadValue(data, *prop.countType, swap_));
+                data += typeSize(*prop.countType);
+                polygon.clear();
+                for (size_t j = 0; j < n; ++j, data += size) {
+                    polygon.push_back(
+                        static_cast<std::uint32_t>(loadValue(data, prop.type, swap_)));
+                }
+                triangulate(indices, polygon.data(), polygon.size());
+            });
+        }
+        return indices;
+    }
+
+private:
+    // Fast path for the common case of a face element with only triangles, decoded in parallel.
+    std::optional<std::vector<std::uint32_t>> triangles(const Element& element) {
+        const auto& prop = element.properties.front();
+        const auto countSize = typeSize(*prop.countType);
+        const auto size = typeSize(prop.type);
+        const auto stride = countSize + 3 * size;
+        if (static_cast<size_t>(file_.end() - cursor_) < element.count * stride) {
+            return std::nullopt;
+        }
+
+        std::vector<std::uint32_t> indices(3 * element.count);
+        std::atomic<bool> allTriangles{true};
+        const auto ranges = util::splitIntoRanges(element.count, util::parseJobs());
+        util::forEachParallel(ranges, [&](const std::pair<size_t, size_t>& range) {
+            for (size_t i = range.first; i < range.second; ++i) {
+                const char* data = cursor_ + i * stride;
+                if (loadValue(data, *prop.countType, swap_) != 3.0) {
+                    allTriangles = false;
+                    return;
+                }
+                data += countSize;
+                for (size_t j = 0; j < 3; ++j, data += size) {
+                    indices[3 * i + j] =
+                        static_cast<std::uint32_t>(loadValue(data, prop.type, swap_));
+                }
+            }
+        });
+        if (!allTriangles) return std::nullopt;
+
+        advance(element.count * stride);
+        return indices;
+    }
+
+    // Call func with the start of each property of the element instance at the cursor, and move
+    // the cursor past the instance
+    template <typename Func>
+    void walk(const Element& element, Func&& func) {
+        for (size_t p = 0; p < element.properties.size(); ++p) {
+            const auto& prop = element.properties[p];
+            if (prop.countType) {
+                const auto countSize = typeSize(*prop.countType);
+                check(countSize);
+                const auto n = static_cast<size_t>(loadValue(cursor_, *prop.countType, swap_));
+                check(countSize + n * typeSize(prop.type));
+                func(p, cursor_);
+                cursor_ += countSize + n * typeSize(prop.type);
+            } else {
+                check(typeSize(prop.type));
+                func(p, cursor_);
+                cursor_ += typeSize(prop.type);
+            }
+        }
+    }
+
+    void check(size_t bytes) const {
+        if (static_cast<size_t>(file_.end() - cursor_) < bytes) {
+            throw DataReaderException("Unexpected end of PLY file",
+                                      IVW_CONTEXT_CUSTOM("PlyReader"));
+        }
+    }
+
+    void advance(size_t bytes) {
+        check(bytes);
+        cursor_ += bytes;
+    }
+
+    const util::MemoryMappedFile& file_;
+    const char* cursor_;
+    bool swap_;
+};
+
+class AsciiParser {
+public:
+    AsciiParser(const util::MemoryMappedFile& file, size_t offset)
+        : cursor_{file.data() + offset}, end_{file.end()} {}
+
+    void skip(const Element& element) { section(element); }
+
+    Vertices vertices(const Element& element, const VertexLayout& layout) {
+        const auto chunks = util::splitIntoLineChunks(section(element), util::parseJobs());
+        std::vector<Vertices> results(chunks.size());
+        std::vector<char> errors(chunks.size(), 0);
+
+        util::forEachParallel(chunks, [&](std::string_view chunk, size_t index) {
+            auto& res = results[index];
+            res.resize(std::count(chunk.begin(), chunk.end(), '\n') + 1, layout);
+            std::vector<float> values(element.properties.size(), 0.0f);
+            const char* it = chunk.data();
+            const char* last = chunk.data() + chunk.size();
+            size_t count = 0;
+            while ((it = util::skipSpace(it, last)) != last) {
+                if (*it == '\n') {
+                    ++it;
+                    continue;
+                }
+                for (size_t p = 0; p < element.properties.size() && it; ++p) {
+                    if (element.properties[p].countType) {
+                        it = skipList(it, last);
+                    } else {
+                        it = util::parseNumber(it, last, values[p]);
+                    }
+                }
+                if (!it) {
+                    errors[index] = 1;
+                    return;
+                }
+                res.set(count++, layout, [&](int p) { return values[p]; });
+                it = util::skipLine(it, last);
+            }
+            res.positions.resize(count);
+            if (!res.normals.empty()) res.normals.resize(count);
+            if (!res.colors.empty()) res.colors.resize(count);
+            if (!res.texcoords.empty()) res.texcoords.resize(count);
+        });
+        checkErrors(errors);
+
+        Vertices vertices;
+        for (auto& res : results) vertices.append(res);
+        if (vertices.positions.size() != element.count) {
+            throw DataReaderException("Unexpected number of PLY vertices",
+                                      IVW_CONTEXT_CUSTOM("PlyReader"));
+        }
+        return vertices;
+    }
+
+    std::vector<std::uint32_t> faces(const Element& element, int list) {
+        const auto chunks = util::splitIntoLineChunks(section(element), util::parseJobs());
+        std::vector<std::vector<std::uint32_t>> results(chunks.size());
+        std::vector<char> errors(chunks.size(), 0);
+
+        util::forEachParallel(chunks, [&](std::string_view chunk, size_t index) {
+            auto& res = results[index];
+            std::vector<std::uint32_t> polygon;
+            const char* it = chunk.data();
+            const char* last = chunk.data() + chunk.size();
+            while ((it = util::skipSpace(it, last)) != last) {
+                if (*it == '\n') {
+                    ++it;
+                    continue;
+                }
+                for (int p = 0; p < static_cast<int>(element.properties.size()) && it; ++p) {
+                    if (p != list) {
+                        it = element.properties[p].countType ? skipList(it, last)
+                                                             : skipValue(it, last);
+                        continue;
+                    }
+                    size_t n = 0;
+                    it = util::parseNumber(it, last, n);
+                    polygon.resize(n);
+                    for (size_t j = 0; j < n && it; ++j) {
+                        it = util::parseNumber(it, last, polygon[j]);
+                    }
+                }
+                if (!it) {
+                    errors[index] = 1;
+                    return;
+                }
+                triangulate(res, polygon.data(), polygon.size());
+                it = util::skipLine(it, last);
+            }
+        });
+        checkErrors(errors);
+
+        std::vector<std::uint32_t> indices;
+        size_t size = 0;
+        for (auto& res : results) size += res.size();
+        indices.reserve(size);
+        for (auto& res : results) indices.insert(indices.end(), res.begin(), res.end());
+        return indices;
+    }
+
+private:
+    // The text of all lines belonging to the element at the cursor
+    std::string_view section(const Element& element) {
+        const char* begin = cursor_;
+        for (size_t i = 0; i < element.count && cursor_ != end_; ++i) {
+            cursor_ = util::skipLine(cursor_, end_);
+        }
+        return std::string_view{begin, static_cast<size_t>(cursor_ - begin)};
+    }
+
+    static const char* skipValue(const char* it, const char* last) {
+        it = util::skipSpace(it, last);
+        auto next = util::skipToken(it, last);
+        return next == it ? nullptr : next;
+    }
+
+    static const char* skipList(const char* it, const char* last) {
+        size_t n = 0;
+        it = util::parseNumber(it, last, n);
+        for (size_t j = 0; j < n && it; ++j) it = skipValue(it, last);
+        return it;
+    }
+
+    static void checkErrors(const std::vector<char>& errors) {
+        if (std::any_of(errors.begin(), errors.end(), [](char e) { return e != 0; })) {
+            throw DataReaderException("Error parsing PLY file", IVW_CONTEXT_CUSTOM("PlyReader"));
+        }
+    }
+
+    const char* cursor_;
+    const char* end_;
+};
+
+template <typename Parser>
+std::pair<Vertices, std::vector<std::uint32_t>> parse(Parser& parser, const Header& header) {
+    Vertices vertices;
+    std::vector<std::uint32_t> indices;
+    bool foundVertices = false;
+    for (const auto& element : header.elements) {
+        if (element.name == "vertex") {
+            vertices = parser.vertices(element, VertexLayout{element});
+            foundVertices = true;
+        } else if (auto list = element.find({"vertex_indices", "vertex_index"});
+                   element.name == "face" && list >= 0 &&
+                   element.properties[list].countType.has_value()) {
+            indices = parser.faces(element, list);
+        } else {
+            parser.skip(element);
+        }
+    }
+    if (!foundVertices) {
+        throw DataReaderException("PLY file is missing a vertex element",
+                                  IVW_CONTEXT_CUSTOM("PlyReader"));
+    }
+    return {std::move(vertices), std::move(indices)};
+}
+
+bool isLittleEndian() {
+    const std::uint16_t value = 1;
+    std::uint8_t byte;
+    std::memcpy(&byte, &value, 1);
+    return byte == 1;
+}
+
+}  // namespace
+
+PlyReader::PlyReader() : DataReaderType<Mesh>() {
+    addExtension(FileExtension("ply", "Stanford Polygon file format"));
+    // Take precedence over generic importers, e.g. Assimp, registered for the same extension
+    setPriority(1);
+}
+
+PlyReader* PlyReader::clone() const { return new PlyReader(*this); }
+
+bool PlyReader::setOption(std::string_view key, std::any value) { return weld_.set(key, value); }
+
+std::any PlyReader::getOption(std::string_view key) { return weld_.get(key); }
+
+std::shared_ptr<Mesh> PlyReader::readData(const std::string& filePath) {
+    if (!filesystem::fileExists(filePath)) {
+        throw DataReaderException("Error could not find input file: " + filePath, IVW_CONTEXT);
+    }
+
+    auto [vertices, indices] = [&]() {
+        const util::MemoryMappedFile file{filePath};
+        const auto header = parseHeader(file);
+        if (header.format == PlyFormat::Ascii) {
+            AsciiParser parser{file, header.size};
+            return parse(parser, header);
+        } else {
+            const bool swap = (header.format == PlyFormat::BinaryLittleEndian) != isLittleEndian();
+            BinaryParser parser{file, header.size, swap};
+            return parse(parser, header);
+        }
+    }();
+
+    const auto nVertices = vertices.positions.size();
+    if (std::any_of(indices.begin(), indices.end(), [&](auto i) { return i >= nVertices; })) {
+        throw DataReaderException("PLY face refers to a non-existing vertex", IVW_CONTEXT);
+    }
+
+    const auto drawType = indices.empty() ? DrawType::Points : DrawType::Triangles;
+    if (indices.empty()) {
+        indices.resize(nVertices);
+        std::iota(indices.begin(), indices.end(), 0);
+    }
+
+    if (weld_.enabled) {
+        const auto weld = meshutil::weldVertices(vertices.positions, weld_.epsilon);
+        meshutil::applyWeld(weld, vertices.positions);
+        if (!vertices.normals.empty()) meshutil::applyWeld(weld, vertices.normals);
+        if (!vertices.colors.empty()) meshutil::applyWeld(weld, vertices.colors);
+        if (!vertices.texcoords.empty()) meshutil::applyWeld(weld, vertices.texcoords);
+        meshutil::applyWeldToIndices(weld, indices);
+    }
+
+    auto mesh = std::make_shared<Mesh>(drawType, ConnectivityType::None);
+    mesh->addBuffer(BufferType::PositionAttrib, util::makeBuffer(std::move(vertices.positions)));
+    if (!vertices.normals.empty()) {
+        mesh->addBuffer(BufferType::NormalAttrib, util::makeBuffer(std::move(vertices.normals)));
+    }
+    if (!vertices.colors.empty()) {
+        mesh->addBuffer(BufferType::ColorAttrib, util::makeBuffer(std::move(vertices.colors)));
+    }
+    if (!vertices.texcoords.empty()) {
+        mesh->addBuffer(BufferType::TexCoordAttrib,
+                        util::makeBuffer(std::move(vertices.texcoords)));
+    }
+    mesh->addIndices(Mesh::MeshInfo(drawType, ConnectivityType::None),
+                     util::makeIndexBuffer(std::move(indices)));
+    return mesh;
+}
+
+}  // namespace inviwo
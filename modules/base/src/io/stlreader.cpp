@@ -0,0 +1,196 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/stlreader.h>
+#include <modules/base/io/parsingutils.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/memorymappedfile.h>
+
+#include <numeric>
+#include <cstring>
+
+namespace inviwo {
+
+namespace {
+
+constexpr size_t headerSize = 80 + sizeof(std::uint32_t);
+constexpr size_t triangleSize = 12 * sizeof(float) + sizeof(std::uint16_t);
+
+size_t triangleCount(const util::MemoryMappedFile& file) {
+    std::uint32_t count = 0;
+    std::memcpy(&count, file.data() + 80, sizeof(count));
+    return count;
+}
+
+bool isBinary(const util::MemoryMappedFile& file) {
+    if (file.size() < headerSize) return false;
+    if (file.size() == headerSize + triangleSize * triangleCount(file)) return true;
+    // Binary files may also start with "solid", so only rely on it when the size does not match
+    const auto start = util::skipSpace(file.begin(), file.end());
+    const auto text = std::string_view{start, static_cast<size_t>(file.end() - start)};
+    return text.substr(0, 5) != "solid";
+}
+
+void readBinary(const util::MemoryMappedFile& file, std::vector<vec3>& positions,
+                std::vector<vec3>& normals) {
+    const auto count = std::min(triangleCount(file), (file.size() - headerSize) / triangleSize);
+
+    positions.resize(3 * count);
+    normals.resize(3 * count);
+
+    const auto ranges = util::splitIntoRanges(count, util::parseJobs());
+    util::forEachParallel(ranges, [&](const std::pair<size_t, size_t>& range) {
+        const char* data = file.data() + headerSize + range.first * triangleSize;
+        for (size_t i = range.first; i < range.second; ++i, data += triangleSize) {
+            vec3 tri[4];
+            std::memcpy(tri, data, sizeof(tri));
+            for (size_t j = 0; j < 3; ++j) {
+                normals[3 * i + j] = tri[0];
+                positions[3 * i + j] = tri[j + 1];
+            }
+        }
+    });
+}
+
+struct AsciiChunk {
+    std::vector<vec3> positions;
+    std::vector<vec3> normals;
+    bool error = false;
+};
+
+const char* parseVec3(const char* first, const char* last, vec3& v) {
+    for (int i = 0; i < 3 && first; ++i) first = util::parseNumber(first, last, v[i]);
+    return first;
+}
+
+void readAscii(const util::MemoryMappedFile& file, std::vector<vec3>& positions,
+               std::vector<vec3>& normals) {
+    using namespace std::string_view_literals;
+
+    const auto chunks =
+        util::splitIntoLineChunks(std::string_view{file.data(), file.size()}, util::parseJobs());
+    std::vector<AsciiChunk> results(chunks.size());
+
+    // A facet might be split between two chunks, but since the vertices and normals are collected
+    // in file order the concatenated result is still consistent.
+    util::forEachParallel(chunks, [&](std::string_view chunk, size_t index) {
+        auto& res = results[index];
+        const char* it = chunk.data();
+        const char* last = chunk.data() + chunk.size();
+        while (it != last) {
+            it = util::skipSpace(it, last);
+            const std::string_view line{it, static_cast<size_t>(last - it)};
+            vec3 v{0.0f};
+            if (line.substr(0, 7) == "vertex "sv || line.substr(0, 7) == "vertex\t"sv) {
+                res.error |= !parseVec3(it + 7, last, v);
+                res.positions.push_back(v);
+            } else if (line.substr(0, 12) == "facet normal"sv) {
+                res.error |= !parseVec3(it + 12, last, v);
+                res.normals.push_back(v);
+            }
+            it = util::skipLine(it, last);
+        }
+    });
+
+    size_t nPositions = 0;
+    size_t nNormals = 0;
+    for (auto& res : results) {
+        if (res.error) {
+            throw DataReaderException("Error parsing STL file", IVW_CONTEXT_CUSTOM("StlReader"));
+        }
+        nPositions += res.positions.size();
+        nNormals += res.normals.size();
+    }
+    if (nPositions != 3 * nNormals || nPositions % 3 != 0) {
+        throw DataReaderException("Malformed STL file, facets must have exactly three vertices",
+                                  IVW_CONTEXT_CUSTOM("StlReader"));
+    }
+
+    positions.reserve(nPositions);
+    normals.reserve(nPositions);
+    for (auto& res : results) {
+        positions.insert(positions.end(), res.positions.begin(), res.positions.end());
+        for (auto& n : res.normals) normals.insert(normals.end(), 3, n);
+    }
+}
+
+}  // namespace
+
+StlReader::StlReader() : DataReaderType<Mesh>() {
+    addExtension(FileExtension("stl", "STL file format"));
+    // Take precedence over generic importers, e.g. Assimp, registered for the same extension
+    setPriority(1);
+}
+
+StlReader* StlReader::clone() const { return new StlReader(*this); }
+
+bool StlReader::setOption(std::string_view key, std::any value) { return weld_.set(key, value); }
+
+std::any StlReader::getOption(std::string_view key) { return weld_.get(key); }
+
+std::shared_ptr<Mesh> StlReader::readData(const std::string& filePath) {
+    if (!filesystem::fileExists(filePath)) {
+        throw DataReaderException("Error could not find input file: " + filePath, IVW_CONTEXT);
+    }
+
+    std::vector<vec3> positions;
+    std::vector<vec3> normals;
+    {
+        const util::MemoryMappedFile file{filePath};
+        if (isBinary(file)) {
+            readBinary(file, positions, normals);
+        } else {
+            readAscii(file, positions, normals);
+        }
+    }
+
+    std::vector<std::uint32_t> indices(positions.size());
+    std::iota(indices.begin(), indices.end(), 0);
+
+    if (weld_.enabled) {
+        const auto weld = meshutil::weldVertices(positions, weld_.epsilon);
+        meshutil::applyWeld(weld, positions);
+        meshutil::applyWeldToIndices(weld, indices);
+        // Merged vertices belong to several facets, averaging keeps the shading consistent
+        normals = meshutil::smoothNormals(positions, indices);
+    }
+
+    auto mesh = std::make_shared<Mesh>(DrawType::Triangles, ConnectivityType::None);
+    mesh->addBuffer(BufferType::PositionAttrib, util::makeBuffer(std::move(positions)));
+    mesh->addBuffer(BufferType::NormalAttrib, util::makeBuffer(std::move(normals)));
+    mesh->addIndices(Mesh::MeshInfo(DrawType::Triangles, ConnectivityType::None),
+                     util::makeIndexBuffer(std::move(indices)));
+    return mesh;
+}
+
+}  // namespace inviwo
@@ -0,0 +1,315 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/base/io/wavefrontreader.h>
+#include <modules/base/io/parsingutils.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/memorymappedfile.h>
+#include <inviwo/core/util/stdextensions.h>
+
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <unordered_map>
+
+namespace inviwo {
+
+namespace {
+
+constexpr std::int64_t none = std::numeric_limits<std::int64_t>::min();
+
+struct Corner {
+    std::int64_t v = none;
+    std::int64_t t = none;
+    std::int64_t n = none;
+};
+
+struct Chunk {
+    std::vector<vec3> positions;
+    std::vector<vec4> colors;
+    std::vector<vec2> texcoords;
+    std::vector<vec3> normals;
+
+    // Triangle corners as zero based indices. Negative OBJ indices are relative to the end of the
+    // list at the point of use, they are stored relative to the start of this chunk and listed in
+    // the rel vectors until the global offsets are known.
+    std::vector<Corner> corners;
+    std::vector<size_t> relV;
+    std::vector<size_t> relT;
+    std::vector<size_t> relN;
+
+    std::vector<Corner> polygon;
+    bool error = false;
+
+    // Resolve a raw OBJ index, returns true if the index is relative to the start of the chunk
+    static bool resolve(std::int64_t& index, size_t count) {
+        if (index < 0) {
+            index += static_cast<std::int64_t>(count);
+            return true;
+        }
+        index -= 1;
+        return false;
+    }
+
+    const char* parseCorner(const char* it, const char* last) {
+        Corner c;
+        it = util::parseNumber(it, last, c.v);
+        if (!it || c.v == 0) return nullptr;
+        if (it != last && *it == '/') {
+            ++it;
+            if (it != last && *it != '/') {
+                it = util::parseNumber(it, last, c.t);
+                if (!it || c.t == 0) return nullptr;
+            }
+            if (it != last && *it == '/') {
+                ++it;
+                it = util::parseNumber(it, last, c.n);
+                if (!it || c.n == 0) return nullptr;
+            }
+        }
+        polygon.push_back(c);
+        return it;
+    }
+
+    void addCorner(Corner c) {
+        const auto pos = corners.size();
+        if (resolve(c.v, positions.size())) relV.push_back(pos);
+        if (c.t != none && resolve(c.t, texcoords.size())) relT.push_back(pos);
+        if (c.n != none && resolve(c.n, normals.size())) relN.push_back(pos);
+        corners.push_back(c);
+    }
+
+    void addPolygon() {
+        for (size_t i = 2; i < polygon.size(); ++i) {
+            addCorner(polygon[0]);
+            addCorner(polygon[i - 1]);
+            addCorner(polygon[i]);
+        }
+        polygon.clear();
+    }
+
+    void parse(std::string_view chunk) {
+        const char* it = chunk.data();
+        const char* last = chunk.data() + chunk.size();
+        while (it && (it = util::skipSpace(it, last)) != last) {
+            if (it + 1 < last && it[0] == 'v' && (it[1] == ' ' || it[1] == '\t')) {
+                vec3 p;
+                ++it;
+                for (int i = 0; i < 3 && it; ++i) it = util::parseNumber(it, last, p[i]);
+                if (!it) break;
+                positions.push_back(p);
+                // Optional vertex colors following the position
+                vec3 c;
+                const char* cit = it;
+                for (int i = 0; i < 3 && cit; ++i) cit = util::parseNumber(cit, last, c[i]);
+                if (cit) colors.emplace_back(c, 1.0f);
+            } else if (it + 2 < last && it[0] == 'v' && it[1] == 't') {
+                vec2 t;
+                it = util::parseNumber(it + 2, last, t.x);
+                if (it) it = util::parseNumber(it, last, t.y);
+                if (!it) break;
+                texcoords.push_back(t);
+            } else if (it + 2 < last && it[0] == 'v' && it[1] == 'n') {
+                vec3 n;
+                it += 2;
+                for (int i = 0; i < 3 && it; ++i) it = util::parseNumber(it, last, n[i]);
+                if (!it) break;
+                normals.push_back(n);
+            } else if (it + 1 < last && it[0] == 'f' && (it[1] == ' ' || it[1] == '\t')) {
+                ++it;
+                while (it && (it = util::skipSpace(it, last)) != last && *it != '\n' &&
+                       *it != '#') {
+                    it = parseCorner(it, last);
+                }
+                if (!it) break;
+                addPolygon();
+            }
+            it = util::skipLine(it, last);
+        }
+        error = it == nullptr;
+    }
+};
+
+}  // namespace
+
+WaveFrontReader::WaveFrontReader() : DataReaderType<Mesh>() {
+    addExtension(FileExtension("obj", "WaveFront Obj file format"));
+    // Take precedence over generic importers, e.g. Assimp, registered for the same extension
+    setPriority(1);
+}
+
+WaveFrontReader* WaveFrontReader::clone() const { return new WaveFrontReader(*this); }
+
+bool WaveFrontReader::setOption(std::string_view key, std::any value) {
+    return weld_.set(key, value);
+}
+
+std::any WaveFrontReader::getOption(std::string_view key) { return weld_.get(key); }
+
+std::shared_ptr<Mesh> WaveFrontReader::readData(const std::string& filePath) {
+    if (!filesystem::fileExists(filePath)) {
+        throw DataReaderException("Error could not find input file: " + filePath, IVW_CONTEXT);
+    }
+
+    std::vector<Chunk> chunks;
+    {
+        const util::MemoryMappedFile file{filePath};
+        const auto text = std::string_view{file.data(), file.size()};
+        const auto texts = util::splitIntoLineChunks(text, util::parseJobs());
+        chunks.resize(texts.size());
+        util::forEachParallel(texts,
+                              [&](std::string_view text, size_t i) { chunks[i].parse(text); });
+    }
+
+    size_t nPositions = 0;
+    size_t nColors = 0;
+    size_t nTexCoords = 0;
+    size_t nNormals = 0;
+    size_t nCorners = 0;
+    for (auto& chunk : chunks) {
+        if (chunk.error) {
+            throw DataReaderException("Error parsing OBJ file: " + filePath, IVW_CONTEXT);
+        }
+        // Make relative indices global
+        for (auto i : chunk.relV) chunk.corners[i].v += static_cast<std::int64_t>(nPositions);
+        for (auto i : chunk.relT) chunk.corners[i].t += static_cast<std::int64_t>(nTexCoords);
+        for (auto i : chunk.relN) chunk.corners[i].n += static_cast<std::int64_t>(nNormals);
+
+        nPositions += chunk.positions.size();
+        nColors += chunk.colors.size();
+        nTexCoords += chunk.texcoords.size();
+        nNormals += chunk.normals.size();
+        nCorners += chunk.corners.size();
+    }
+
+    std::vector<vec3> positions;
+    std::vector<vec4> colors;
+    std::vector<vec2> texcoords;
+    std::vector<vec3> normals;
+    std::vector<Corner> corners;
+    positions.reserve(nPositions);
+    colors.reserve(nColors == nPositions ? nColors : 0);
+    texcoords.reserve(nTexCoords);
+    normals.reserve(nNormals);
+    corners.reserve(nCorners);
+    for (auto& chunk : chunks) {
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        if (nColors == nPositions) {
+            colors.insert(colors.end(), chunk.colors.begin(), chunk.colors.end());
+        }
+        texcoords.insert(texcoords.end(), chunk.texcoords.begin(), chunk.texcoords.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+        corners.insert(corners.end(), chunk.corners.begin(), chunk.corners.end());
+        chunk = Chunk{};
+    }
+
+    const auto inRange = [](std::int64_t i, size_t size) {
+        return i >= 0 && static_cast<size_t>(i) < size;
+    };
+    bool hasTexCoords = !corners.empty() && !texcoords.empty();
+    bool hasNormals = !corners.empty() && !normals.empty();
+    bool shared = true;  // All attributes use the same index, no need to split vertices
+    for (const auto& c : corners) {
+        if (!inRange(c.v, nPositions)) {
+            throw DataReaderException("OBJ face refers to a non-existing vertex", IVW_CONTEXT);
+        }
+        hasTexCoords = hasTexCoords && inRange(c.t, nTexCoords);
+        hasNormals = hasNormals && inRange(c.n, nNormals);
+        shared = shared && (!hasTexCoords || c.t == c.v) && (!hasNormals || c.n == c.v);
+    }
+    shared = shared && (!hasTexCoords || nTexCoords == nPositions) &&
+             (!hasNormals || nNormals == nPositions);
+
+    std::vector<std::uint32_t> indices;
+    indices.reserve(corners.size());
+    if (corners.empty()) {
+        indices.resize(nPositions);
+        std::iota(indices.begin(), indices.end(), 0);
+    } else if (shared) {
+        for (const auto& c : corners) indices.push_back(static_cast<std::uint32_t>(c.v));
+    } else {
+        // Create one vertex per unique combination of position, texture coordinate, and normal
+        std::unordered_map<std::tuple<std::int64_t, std::int64_t, std::int64_t>, std::uint32_t>
+            vertices;
+        std::vector<vec3> newPositions;
+        std::vector<vec4> newColors;
+        std::vector<vec2> newTexCoords;
+        std::vector<vec3> newNormals;
+        for (const auto& c : corners) {
+            const auto key = std::make_tuple(c.v, hasTexCoords ? c.t : none,
+                                             hasNormals ? c.n : none);
+            auto [it, inserted] =
+                vertices.try_emplace(key, static_cast<std::uint32_t>(newPositions.size()));
+            if (inserted) {
+                newPositions.push_back(positions[c.v]);
+                if (!colors.empty()) newColors.push_back(colors[c.v]);
+                if (hasTexCoords) newTexCoords.push_back(texcoords[c.t]);
+                if (hasNormals) newNormals.push_back(normals[c.n]);
+            }
+            indices.push_back(it->second);
+        }
+        positions = std::move(newPositions);
+        colors = std::move(newColors);
+        texcoords = std::move(newTexCoords);
+        normals = std::move(newNormals);
+    }
+    if (!hasTexCoords) texcoords.clear();
+    if (!hasNormals) normals.clear();
+
+    if (weld_.enabled) {
+        const auto weld = meshutil::weldVertices(positions, weld_.epsilon);
+        meshutil::applyWeld(weld, positions);
+        if (!colors.empty()) meshutil::applyWeld(weld, colors);
+        if (!texcoords.empty()) meshutil::applyWeld(weld, texcoords);
+        if (!normals.empty()) meshutil::applyWeld(weld, normals);
+        meshutil::applyWeldToIndices(weld, indices);
+    }
+
+    const auto drawType = corners.empty() ? DrawType::Points : DrawType::Triangles;
+    auto mesh = std::make_shared<Mesh>(drawType, ConnectivityType::None);
+    mesh->addBuffer(BufferType::PositionAttrib, util::makeBuffer(std::move(positions)));
+    if (!colors.empty()) {
+        mesh->addBuffer(BufferType::ColorAttrib, util::makeBuffer(std::move(colors)));
+    }
+    if (!texcoords.empty()) {
+        mesh->addBuffer(BufferType::TexCoordAttrib, util::makeBuffer(std::move(texcoords)));
+    }
+    if (!normals.empty()) {
+        mesh->addBuffer(BufferType::NormalAttrib, util::makeBuffer(std::move(normals)));
+    }
+    mesh->addIndices(Mesh::MeshInfo(drawType, ConnectivityType::None),
+                     util::makeIndexBuffer(std::move(indices)));
+    return mesh;
+}
+
+}  // namespace inviwo
@@ -72,11 +72,18 @@ const ProcessorInfo ImageStackVolumeSource::processorInfo_{
 const ProcessorInfo ImageStackVolumeSource::getProcessorInfo() const { return processorInfo_; }
 
 ImageStackVolumeSource::ImageStackVolumeSource(InviwoApplication* app)
-    : Processor()
+    : PoolProcessor()
     , outport_("volume")
     , filePattern_("filePattern", "File Pattern", "####.jpeg", "")
     , reload_("reload", "Reload data")
     , skipUnsupportedFiles_("skipUnsupportedFiles", "Skip Unsupported Files", false)
+    , subsample_("subsample", "Subsample", size3_t{1}, {size3_t{1}, ConstraintBehavior::Immutable},
+                 {size3_t{16}, ConstraintBehavior::Ignore})
+    , region_("region", "Region of Interest")
+    , regionOffset_("offset", "Offset", size3_t{0}, {size3_t{0}, ConstraintBehavior::Immutable},
+                    {size3_t{4096}, ConstraintBehavior::Ignore})
+    , regionExtent_("extent", "Extent", size3_t{0}, {size3_t{0}, ConstraintBehavior::Immutable},
+                    {size3_t{4096}, ConstraintBehavior::Ignore})
     , basis_("Basis", "Basis and offset")
     , information_("Information", "Data information")
     , readerFactory_{app->getDataReaderFactory()} {
@@ -85,6 +92,10 @@ ImageStackVolumeSource::ImageStackVolumeSource(InviwoApplication* app)
     addProperty(filePattern_);
     addProperty(reload_);
     addProperty(skipUnsupportedFiles_);
+    addProperty(subsample_);
+    region_.addProperties(regionOffset_, regionExtent_);
+    region_.setCollapsed(true);
+    addProperty(region_);
     addProperty(basis_);
     addProperty(information_);
 
@@ -104,13 +115,13 @@ void ImageStackVolumeSource::addFileNameFilters() {
 void ImageStackVolumeSource::process() {
     util::OnScopeExit guard{[&]() { outport_.setData(nullptr); }};
 
-    if (filePattern_.isModified() || reload_.isModified() || skipUnsupportedFiles_.isModified()) {
-        volume_ = load();
-        if (volume_) {
-            basis_.updateForNewEntity(*volume_, deserialized_);
-            information_.updateForNewVolume(*volume_, deserialized_);
-        }
-        deserialized_ = false;
+    if (filePattern_.isModified() || reload_.isModified() || skipUnsupportedFiles_.isModified() ||
+        subsample_.isModified() || region_.isModified()) {
+        outport_.clear();
+        load();
+        // The outport is set once the background jobs are done
+        guard.release();
+        return;
     }
 
     if (volume_) {
@@ -125,31 +136,34 @@ bool ImageStackVolumeSource::isValidImageFile(std::string fileName) {
     return readerFactory_->hasReaderForTypeAndExtension<Layer>(fileName);
 }
 
-std::shared_ptr<Volume> ImageStackVolumeSource::load() {
+void ImageStackVolumeSource::load() {
+    volume_.reset();
     const auto files = filePattern_.getFileList();
     if (files.empty()) {
-        return nullptr;
+        return;
     }
 
-    std::vector<std::pair<std::string, std::unique_ptr<DataReaderType<Layer>>>> slices;
-    slices.reserve(files.size());
+    // Each slice gets its own reader, which lets the slices be read concurrently
+    using Slices = std::vector<std::pair<std::string, std::unique_ptr<DataReaderType<Layer>>>>;
+    auto slices = std::make_shared<Slices>();
+    slices->reserve(files.size());
 
     std::transform(
-        files.begin(), files.end(), std::back_inserter(slices),
+        files.begin(), files.end(), std::back_inserter(*slices),
         [&](const auto& file) -> std::pair<std::string, std::unique_ptr<DataReaderType<Layer>>> {
             return {file, std::move(readerFactory_->getReaderForTypeAndExtension<Layer>(
                               filePattern_.getSelectedExtension(), file))};
         });
     if (skipUnsupportedFiles_) {
-        slices.erase(std::remove_if(slices.begin(), slices.end(),
-                                    [](auto& elem) { return elem.second == nullptr; }),
-                     slices.end());
+        slices->erase(std::remove_if(slices->begin(), slices->end(),
+                                     [](auto& elem) { return elem.second == nullptr; }),
+                      slices->end());
     }
 
     // identify first slice with a reader
-    const auto first = std::find_if(slices.begin(), slices.end(),
+    const auto first = std::find_if(slices->begin(), slices->end(),
                                     [](auto& item) { return item.second != nullptr; });
-    if (first == slices.end()) {  // could not find any suitable data reader for the images
+    if (first == slices->end()) {  // could not find any suitable data reader for the images
         throw Exception(
             fmt::format("No supported images found in '{}'", filePattern_.getFilePatternPath()),
             IVW_CONTEXT);
@@ -174,71 +188,87 @@ std::shared_ptr<Volume> ImageStackVolumeSource::load() {
             IVW_CONTEXT);
     }
 
-    return referenceRAM->dispatch<std::shared_ptr<Volume>, FloatOrIntMax32>(
-        [&](auto reflayerprecision) {
-            using ValueType = util::PrecisionValueType<decltype(reflayerprecision)>;
-            using PrimitiveType = typename DataFormat<ValueType>::primitive;
-
-            const size2_t layerDims = reflayerprecision->getDimensions();
-            const size_t sliceOffset = glm::compMul(layerDims);
-
-            // create matching volume representation
-            auto volumeRAM =
-                std::make_shared<VolumeRAMPrecision<ValueType>>(size3_t{layerDims, slices.size()});
-            auto volData = volumeRAM->getDataTyped();
-
-            const auto fill = [&](size_t s) {
-                std::fill(volData + s * sliceOffset, volData + (s + 1) * sliceOffset, ValueType{0});
-            };
-
-            const auto read = [&](const auto& file, auto reader) -> std::shared_ptr<Layer> {
-                try {
-                    return reader->readData(file);
-                } catch (DataReaderException const& e) {
-                    LogProcessorWarn(
-                        fmt::format("Could not load image: {}, {}", file, e.getMessage()));
-                    return nullptr;
-                }
-            };
-
-            for (auto&& elem : util::enumerate(slices)) {
-                const auto slice = elem.first();
-                const auto file = elem.second().first;
-                const auto reader = elem.second().second.get();
-                if (!reader) {
-                    fill(slice);
-                    continue;
-                }
+    const size2_t layerDims = referenceRAM->getDimensions();
+    const size3_t stackDims{layerDims, slices->size()};
+    const size3_t stride = glm::max(subsample_.get(), size3_t{1});
+    const size3_t offset = glm::min(regionOffset_.get(), stackDims - size3_t{1});
+    size3_t extent = stackDims - offset;
+    for (int i = 0; i < 3; ++i) {
+        if (regionExtent_.get()[i] != 0) extent[i] = std::min(extent[i], regionExtent_.get()[i]);
+    }
+    const size3_t dims = (extent + stride - size3_t{1}) / stride;
+
+    referenceRAM->dispatch<void, FloatOrIntMax32>([&](auto reflayerprecision) {
+        using ValueType = util::PrecisionValueType<decltype(reflayerprecision)>;
+        using PrimitiveType = typename DataFormat<ValueType>::primitive;
+
+        // create matching volume representation, the slices are written directly into it
+        auto volumeRAM = std::make_shared<VolumeRAMPrecision<ValueType>>(dims);
+        const size_t sliceSize = dims.x * dims.y;
+
+        // Converts slice z of the output, returns a warning if the image could not be used
+        const auto readSlice = [slices, volumeRAM, layerDims, offset, stride, dims,
+                                sliceSize](size_t z) -> std::string {
+            auto volData = volumeRAM->getDataTyped() + z * sliceSize;
+            std::fill(volData, volData + sliceSize, ValueType{0});
+
+            const auto& [file, reader] = (*slices)[offset.z + z * stride.z];
+            if (!reader) return {};
+
+            std::shared_ptr<Layer> layer;
+            try {
+                layer = reader->readData(file);
+            } catch (DataReaderException const& e) {
+                return fmt::format("Could not load image: {}, {}", file, e.getMessage());
+            }
+            const auto layerRAM = layer->template getRepresentation<LayerRAM>();
 
-                const auto layer = read(file, reader);
-                if (!layer) {
-                    fill(slice);
-                    continue;
+            const auto format = layerRAM->getDataFormat();
+            if ((format->getNumericType() != NumericType::Float) &&
+                (format->getPrecision() > 32)) {
+                return fmt::format("Unsupported integer bit depth: {}, for image: {}",
+                                   format->getPrecision(), file);
+            }
+            if (layerRAM->getDimensions() != layerDims) {
+                return fmt::format("Unexpected dimensions: {} , expected: {}, for image: {}",
+                                   layerRAM->getDimensions(), layerDims, file);
+            }
+            layerRAM->template dispatch<void, FloatOrIntMax32>([&](auto layerpr) {
+                const auto data = layerpr->getDataTyped();
+                for (size_t y = 0; y < dims.y; ++y) {
+                    const auto row = data + (offset.y + y * stride.y) * layerDims.x + offset.x;
+                    for (size_t x = 0; x < dims.x; ++x) {
+                        volData[y * dims.x + x] =
+                            util::glm_convert_normalized<ValueType>(row[x * stride.x]);
+                    }
                 }
-                const auto layerRAM = layer->template getRepresentation<LayerRAM>();
-
-                const auto format = layerRAM->getDataFormat();
-                if ((format->getNumericType() != NumericType::Float) &&
-                    (format->getPrecision() > 32)) {
-                    LogProcessorWarn(fmt::format("Unsupported integer bit depth: {}, for image: {}",
-                                                 format->getPrecision(), file));
-                    fill(slice);
-                    continue;
+            });
+            return {};
+        };
+
+        using Job = std::function<std::vector<std::string>(pool::Stop, pool::Progress)>;
+        std::vector<Job> jobs;
+        const size_t nJobs = std::min(
+            dims.z, std::max(size_t{1}, 2 * InviwoApplication::getPtr()->getPoolSize()));
+        for (size_t job = 0; job < nJobs; ++job) {
+            jobs.push_back([readSlice, first = job * dims.z / nJobs,
+                            last = (job + 1) * dims.z / nJobs](pool::Stop stop,
+                                                               pool::Progress progress) {
+                std::vector<std::string> warnings;
+                for (size_t z = first; z < last; ++z) {
+                    if (stop) return warnings;
+                    auto warning = readSlice(z);
+                    if (!warning.empty()) warnings.push_back(std::move(warning));
+                    progress(z - first + 1, last - first);
                 }
+                return warnings;
+            });
+        }
 
-                if (layerRAM->getDimensions() != layerDims) {
-                    LogProcessorWarn(
-                        fmt::format("Unexpected dimensions: {} , expected: {}, for image: {}",
-                                    layer->getDimensions(), layerDims, file));
-                    fill(slice);
-                    continue;
-                }
-                layerRAM->template dispatch<void, FloatOrIntMax32>([&](auto layerpr) {
-                    const auto data = layerpr->getDataTyped();
-                    std::transform(
-                        data, data + sliceOffset, volData + slice * sliceOffset,
-                        [](auto value) { return util::glm_convert_normalized<ValueType>(value); });
-                });
+        dispatchMany(jobs, [this, volumeRAM,
+                            extent](std::vector<std::vector<std::string>> warnings) {
+            for (const auto& jobWarnings : warnings) {
+                for (const auto& warning : jobWarnings) LogProcessorWarn(warning);
             }
 
             auto volume = std::make_shared<Volume>(volumeRAM);
@@ -247,12 +277,18 @@ std::shared_ptr<Volume> ImageStackVolumeSource::load() {
             volume->dataMap_.valueRange =
                 dvec2{DataFormat<PrimitiveType>::lowest(), DataFormat<PrimitiveType>::max()};
 
-            const auto size = vec3(0.01f) * static_cast<vec3>(volumeRAM->getDimensions());
+            const auto size = vec3(0.01f) * static_cast<vec3>(extent);
             volume->setBasis(glm::diagonal3x3(size));
             volume->setOffset(-0.5 * size);
 
-            return volume;
+            volume_ = volume;
+            basis_.updateForNewEntity(*volume_, deserialized_);
+            information_.updateForNewVolume(*volume_, deserialized_);
+            deserialized_ = false;
+            // process applies the basis and information to the volume and sets the outport
+            invalidate(InvalidationLevel::InvalidOutput);
         });
+    });
 }
 
 void ImageStackVolumeSource::deserialize(Deserializer& d) {
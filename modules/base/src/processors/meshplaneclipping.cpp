@@ -57,12 +57,11 @@ MeshPlaneClipping::MeshPlaneClipping()
 }
 
 void MeshPlaneClipping::process() {
-    if (clippingEnabled_) {
-        std::shared_ptr<const Mesh> currentMesh = inputMesh_.getData();
-        for (const auto& plane : planes_) {
-            currentMesh = meshutil::clipMeshAgainstPlane(*currentMesh, *plane, capClippedHoles_);
-        }
-        outputMesh_.setData(currentMesh);
+    if (clippingEnabled_ && planes_.hasData()) {
+        std::vector<Plane> planes;
+        for (const auto& plane : planes_) planes.push_back(*plane);
+        outputMesh_.setData(
+            meshutil::clipMeshAgainstPlanes(*inputMesh_.getData(), planes, capClippedHoles_));
     } else {
         outputMesh_.setData(inputMesh_.getData());
     }
@@ -41,10 +41,78 @@ const ProcessorInfo VolumeSequenceElementSelectorProcessor::processorInfo_{
 const ProcessorInfo VolumeSequenceElementSelectorProcessor::getProcessorInfo() const {
     return processorInfo_;
 }
+
 VolumeSequenceElementSelectorProcessor::VolumeSequenceElementSelectorProcessor()
-    : VectorElementSelectorProcessor<Volume>() {
+    : VectorElementSelectorProcessor<Volume>()
+    , streaming_("streaming", "Streaming", false)
+    , residentWindow_("residentWindow", "Resident Time Steps", 4, 1, 64)
+    , prefetch_("prefetch", "Prefetch", 2, 0, 32)
+    , stats_("stats", "Statistics")
+    , hits_("hits", "Hits", 0, 0, std::numeric_limits<size_t>::max(), 1,
+            InvalidationLevel::Valid, PropertySemantics::Text)
+    , prefetchHits_("prefetchHits", "Prefetch Hits", 0, 0, std::numeric_limits<size_t>::max(), 1,
+                    InvalidationLevel::Valid, PropertySemantics::Text)
+    , stalls_("stalls", "Stalls", 0, 0, std::numeric_limits<size_t>::max(), 1,
+              InvalidationLevel::Valid, PropertySemantics::Text)
+    , stallTime_("stallTime", "Stall Time (ms)", 0.0, 0.0, std::numeric_limits<double>::max(), 0.1,
+                 InvalidationLevel::Valid, PropertySemantics::Text)
+    , evictions_("evictions", "Evictions", 0, 0, std::numeric_limits<size_t>::max(), 1,
+                 InvalidationLevel::Valid, PropertySemantics::Text)
+    , resetStats_("resetStats", "Reset Statistics", InvalidationLevel::Valid)
+    , streamer_{residentWindow_, prefetch_} {
+
     timeStep_.index_.autoLinkToProperty<VolumeSequenceElementSelectorProcessor>(
         "timeStep.selectedSequenceIndex");
+
+    for (Property* prop : std::initializer_list<Property*>{&hits_, &prefetchHits_, &stalls_,
+                                                           &stallTime_, &evictions_}) {
+        prop->setReadOnly(true);
+        prop->setSerializationMode(PropertySerializationMode::None);
+    }
+    stats_.addProperties(hits_, prefetchHits_, stalls_, stallTime_, evictions_, resetStats_);
+    stats_.setCollapsed(true);
+    streaming_.addProperties(residentWindow_, prefetch_, stats_);
+    addProperty(streaming_);
+
+    residentWindow_.onChange([this]() { streamer_.setResidentWindow(residentWindow_); });
+    prefetch_.onChange([this]() { streamer_.setPrefetch(prefetch_); });
+    streaming_.getBoolProperty()->onChange([this]() {
+        if (!streaming_.isChecked()) streamer_.releaseAll();
+    });
+    resetStats_.onChange([this]() {
+        streamer_.resetStats();
+        updateStats();
+    });
+    inport_.onChange([this]() {
+        if (streaming_.isChecked()) streamer_.setSequence(inport_.getData());
+    });
+}
+
+void VolumeSequenceElementSelectorProcessor::process() {
+    if (!streaming_.isChecked()) {
+        VectorElementSelectorProcessor<Volume>::process();
+        return;
+    }
+
+    const auto data = inport_.getData();
+    if (!data || data->empty()) {
+        outport_.detachData();
+        return;
+    }
+    streamer_.setSequence(data);
+    const auto index =
+        std::min(data->size() - 1, static_cast<size_t>(timeStep_.index_.get() - 1));
+    outport_.setData(streamer_.get(index));
+    updateStats();
+}
+
+void VolumeSequenceElementSelectorProcessor::updateStats() {
+    const auto& stats = streamer_.getStats();
+    hits_.set(stats.hits);
+    prefetchHits_.set(stats.prefetchHits);
+    stalls_.set(stats.stalls);
+    stallTime_.set(stats.stallTime.count());
+    evictions_.set(stats.evictions);
 }
 
 }  // namespace inviwo
@@ -39,6 +39,8 @@
 
 #include <inviwo/core/util/indexmapper.h>
 
+#include <chrono>
+
 namespace inviwo {
 
 const ProcessorInfo VolumeSlice::processorInfo_{
@@ -60,6 +62,21 @@ VolumeSlice::VolumeSlice()
                        {"z", "Z axis", CartesianCoordinateAxis::Z}},
                       0)
     , sliceNumber_("sliceNumber", "Slice Number", 4, 1, 8)
+    , lod_("levelOfDetail", "Level of Detail")
+    , lodMode_("mode", "Mode",
+               {{"full", "Full Resolution", LevelOfDetail::Full},
+                {"footprint", "Target Resolution", LevelOfDetail::Footprint},
+                {"timeBudget", "Time Budget", LevelOfDetail::TimeBudget}},
+               0)
+    , lodFilter_("filter", "Filter",
+                 {{"mean", "Mean", PyramidFilter::Mean},
+                  {"min", "Min", PyramidFilter::Min},
+                  {"max", "Max", PyramidFilter::Max},
+                  {"maxAbs", "Max Magnitude", PyramidFilter::MaxAbs}},
+                 0)
+    , targetResolution_("targetResolution", "Target Resolution", size2_t(512), size2_t(1),
+                        size2_t(8192))
+    , timeBudget_("timeBudget", "Time Budget (ms)", 10.0f, 0.1f, 1000.0f, 0.1f)
     , handleInteractionEvents_("handleEvents", "Handle interaction events", true,
                                InvalidationLevel::Valid)
     , mouseShiftSlice_(
@@ -77,12 +94,30 @@ VolumeSlice::VolumeSlice()
     , gestureShiftSlice_(
           "gestureShiftSlice", "Gesture Slice Shift",
           [this](Event* e) { eventGestureShiftSlice(e); },
-          std::make_unique<GestureEventMatcher>(GestureType::Pan, GestureStates(flags::any), 3)) {
+          std::make_unique<GestureEventMatcher>(GestureType::Pan, GestureStates(flags::any), 3))
+    , budget_{}
+    , refine_{std::chrono::milliseconds(300), [this]() {
+                  refining_ = true;
+                  invalidate(InvalidationLevel::InvalidOutput);
+              }} {
 
     addPort(inport_);
     addPort(outport_);
     addProperty(sliceAlongAxis_);
     addProperty(sliceNumber_);
+
+    lod_.addProperties(lodMode_, lodFilter_, targetResolution_, timeBudget_);
+    lodFilter_.visibilityDependsOn(lodMode_, [](const auto& p) {
+        return p.get() != LevelOfDetail::Full;
+    });
+    targetResolution_.visibilityDependsOn(lodMode_, [](const auto& p) {
+        return p.get() == LevelOfDetail::Footprint;
+    });
+    timeBudget_.visibilityDependsOn(lodMode_, [](const auto& p) {
+        return p.get() == LevelOfDetail::TimeBudget;
+    });
+    lod_.setCollapsed(true);
+    addProperty(lod_);
     addProperty(handleInteractionEvents_);
 
     addProperty(stepSliceUp_);
@@ -137,100 +172,164 @@ void VolumeSlice::process() {
             break;
     }
 
+    const auto axis = static_cast<CartesianCoordinateAxis>(sliceAlongAxis_.get());
+    const auto ram = selectLevel(*vol);
+    // map the slice number to the selected level, all levels span the same extent
+    const auto axisIndex = static_cast<size_t>(axis);
+    const auto slice = static_cast<size_t>(sliceNumber_.get() - 1) *
+                       ram->getDimensions()[axisIndex] / std::max(dims[axisIndex], size_t{1});
+
+    const auto start = std::chrono::steady_clock::now();
     auto image =
-        vol->getRepresentation<VolumeRAM>()
-            ->dispatch<std::shared_ptr<Image>, dispatching::filter::All>(
-                [axis = static_cast<CartesianCoordinateAxis>(sliceAlongAxis_.get()),
-                 slice = static_cast<size_t>(sliceNumber_.get() - 1),
-                 &cache = imageCache_](const auto vrprecision) {
-                    using T = util::PrecisionValueType<decltype(vrprecision)>;
-
-                    const T* voldata = vrprecision->getDataTyped();
-                    const auto voldim = vrprecision->getDimensions();
-
-                    const auto imgdim = [&]() {
-                        switch (axis) {
-                            default:
-                                return size2_t(voldim.z, voldim.y);
-                            case CartesianCoordinateAxis::X:
-                                return size2_t(voldim.z, voldim.y);
-                            case CartesianCoordinateAxis::Y:
-                                return size2_t(voldim.x, voldim.z);
-                            case CartesianCoordinateAxis::Z:
-                                return size2_t(voldim.x, voldim.y);
-                        }
-                    }();
-
-                    auto res = cache.getTypedUnused<T>(imgdim);
-                    auto sliceImage = res.first;
-                    auto layerrep = res.second;
-                    auto layerdata = layerrep->getDataTyped();
-
-                    switch (util::extent<T, 0>::value) {
-                        case 0:  // util::extent<T, 0>::value returns zero for non-glm types
-                        case 1:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Red,
-                                                       ImageChannel::Red, ImageChannel::One}});
-                            break;
-                        case 2:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
-                                                       ImageChannel::Zero, ImageChannel::One}});
-                            break;
-                        case 3:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
-                                                       ImageChannel::Blue, ImageChannel::One}});
-                            break;
+        ram->dispatch<std::shared_ptr<Image>, dispatching::filter::All>(
+            [axis, slice, &cache = imageCache_](const auto vrprecision) {
+                using T = util::PrecisionValueType<decltype(vrprecision)>;
+
+                const T* voldata = vrprecision->getDataTyped();
+                const auto voldim = vrprecision->getDimensions();
+
+                const auto imgdim = [&]() {
+                    switch (axis) {
                         default:
-                        case 4:
-                            layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
-                                                       ImageChannel::Blue, ImageChannel::Alpha}});
+                            return size2_t(voldim.z, voldim.y);
+                        case CartesianCoordinateAxis::X:
+                            return size2_t(voldim.z, voldim.y);
+                        case CartesianCoordinateAxis::Y:
+                            return size2_t(voldim.x, voldim.z);
+                        case CartesianCoordinateAxis::Z:
+                            return size2_t(voldim.x, voldim.y);
                     }
+                }();
 
-                    size_t offsetVolume;
-                    size_t offsetImage;
-                    switch (axis) {
-                        case CartesianCoordinateAxis::X: {
-                            util::IndexMapper3D vm(voldim);
-                            util::IndexMapper2D im(imgdim);
-                            auto x = glm::clamp(slice, size_t{0}, voldim.x - 1);
-                            for (size_t z = 0; z < voldim.z; z++) {
-                                for (size_t y = 0; y < voldim.y; y++) {
-                                    offsetVolume = vm(x, y, z);
-                                    offsetImage = im(z, y);
-                                    layerdata[offsetImage] = voldata[offsetVolume];
-                                }
-                            }
-                            break;
-                        }
-                        case CartesianCoordinateAxis::Y: {
-                            auto y = glm::clamp(slice, size_t{0}, voldim.y - 1);
-                            const size_t dataSize = voldim.x;
-                            const size_t initialStartPos = y * voldim.x;
-                            for (size_t j = 0; j < voldim.z; j++) {
-                                offsetVolume = (j * voldim.x * voldim.y) + initialStartPos;
-                                offsetImage = j * voldim.x;
-                                std::copy(voldata + offsetVolume, voldata + offsetVolume + dataSize,
-                                          layerdata + offsetImage);
+                auto res = cache.getTypedUnused<T>(imgdim);
+                auto sliceImage = res.first;
+                auto layerrep = res.second;
+                auto layerdata = layerrep->getDataTyped();
+
+                switch (util::extent<T, 0>::value) {
+                    case 0:  // util::extent<T, 0>::value returns zero for non-glm types
+                    case 1:
+                        layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Red,
+                                                   ImageChannel::Red, ImageChannel::One}});
+                        break;
+                    case 2:
+                        layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
+                                                   ImageChannel::Zero, ImageChannel::One}});
+                        break;
+                    case 3:
+                        layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
+                                                   ImageChannel::Blue, ImageChannel::One}});
+                        break;
+                    default:
+                    case 4:
+                        layerrep->setSwizzleMask({{ImageChannel::Red, ImageChannel::Green,
+                                                   ImageChannel::Blue, ImageChannel::Alpha}});
+                }
+
+                size_t offsetVolume;
+                size_t offsetImage;
+                switch (axis) {
+                    case CartesianCoordinateAxis::X: {
+                        util::IndexMapper3D vm(voldim);
+                        util::IndexMapper2D im(imgdim);
+                        auto x = glm::clamp(slice, size_t{0}, voldim.x - 1);
+                        for (size_t z = 0; z < voldim.z; z++) {
+                            for (size_t y = 0; y < voldim.y; y++) {
+                                offsetVolume = vm(x, y, z);
+                                offsetImage = im(z, y);
+                                layerdata[offsetImage] = voldata[offsetVolume];
                             }
-                            break;
                         }
-                        case CartesianCoordinateAxis::Z: {
-                            auto z = glm::clamp(slice, size_t{0}, voldim.z - 1);
-                            const size_t dataSize = voldim.x * voldim.y;
-                            const size_t initialStartPos = z * voldim.x * voldim.y;
-
-                            std::copy(voldata + initialStartPos,
-                                      voldata + initialStartPos + dataSize, layerdata);
-                            break;
+                        break;
+                    }
+                    case CartesianCoordinateAxis::Y: {
+                        auto y = glm::clamp(slice, size_t{0}, voldim.y - 1);
+                        const size_t dataSize = voldim.x;
+                        const size_t initialStartPos = y * voldim.x;
+                        for (size_t j = 0; j < voldim.z; j++) {
+                            offsetVolume = (j * voldim.x * voldim.y) + initialStartPos;
+                            offsetImage = j * voldim.x;
+                            std::copy(voldata + offsetVolume, voldata + offsetVolume + dataSize,
+                                      layerdata + offsetImage);
                         }
+                        break;
                     }
-                    cache.add(sliceImage);
-                    return sliceImage;
-                });
+                    case CartesianCoordinateAxis::Z: {
+                        auto z = glm::clamp(slice, size_t{0}, voldim.z - 1);
+                        const size_t dataSize = voldim.x * voldim.y;
+                        const size_t initialStartPos = z * voldim.x * voldim.y;
+
+                        std::copy(voldata + initialStartPos,
+                                  voldata + initialStartPos + dataSize, layerdata);
+                        break;
+                    }
+                }
+                cache.add(sliceImage);
+                return sliceImage;
+            });
+
+    if (lodMode_ == LevelOfDetail::TimeBudget) {
+        const auto sliceSize = image->getDimensions();
+        budget_.update(std::chrono::steady_clock::now() - start, sliceSize.x * sliceSize.y);
+        if (ram != vol->getRepresentation<VolumeRAM>()) {
+            refine_.start();
+        } else {
+            refine_.cancel();
+        }
+    }
+    refining_ = false;
 
     outport_.setData(image);
 }
 
+const VolumeRAM* VolumeSlice::selectLevel(const Volume& volume) {
+    if (lodMode_ == LevelOfDetail::Full) {
+        pyramid_.reset();
+        pyramidCalculation_.reset();
+        pyramidDone_.reset();
+        return volume.getRepresentation<VolumeRAM>();
+    }
+
+    auto calculation = volume.calculatePyramid(lodFilter_.get());
+    if (calculation != pyramidCalculation_) {
+        pyramidCalculation_ = calculation;
+        pyramidDone_.reset();
+        if (!calculation->isDone()) {
+            pyramidDone_ = calculation->whenDone([this](std::shared_ptr<const VolumePyramid>) {
+                invalidate(InvalidationLevel::InvalidOutput);
+            });
+        }
+    }
+    // Use the full resolution until the pyramid is built
+    pyramid_ = calculation->getPyramid();
+    if (!pyramid_) return volume.getRepresentation<VolumeRAM>();
+
+    const auto sliceDims = [axis = sliceAlongAxis_.get()](const size3_t& dims) {
+        switch (axis) {
+            case CartesianCoordinateAxis::X:
+                return size2_t(dims.z, dims.y);
+            case CartesianCoordinateAxis::Y:
+                return size2_t(dims.x, dims.z);
+            case CartesianCoordinateAxis::Z:
+            default:
+                return size2_t(dims.x, dims.y);
+        }
+    };
+
+    size_t level = 0;
+    if (lodMode_ == LevelOfDetail::Footprint) {
+        const auto voxelsPerPixel = dvec2(sliceDims(pyramid_->getDimensions(0))) /
+                                    dvec2(glm::max(targetResolution_.get(), size2_t(1)));
+        level = pyramid_->levelForFootprint(glm::compMax(voxelsPerPixel));
+    } else if (!refining_) {
+        budget_.setBudget(LevelOfDetailBudget::Milliseconds(timeBudget_.get()));
+        level = budget_.select(*pyramid_, [&](const size3_t& dims) {
+            return glm::compMul(sliceDims(dims));
+        });
+    }
+    return pyramid_->getLevel(level);
+}
+
 void VolumeSlice::eventShiftSlice(Event* event) {
     auto wheelEvent = static_cast<WheelEvent*>(event);
     int steps = static_cast<int>(wheelEvent->delta().y);
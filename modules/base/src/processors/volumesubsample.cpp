@@ -48,13 +48,20 @@ VolumeSubsample::VolumeSubsample()
     , inport_("inputVolume")
     , outport_("outputVolume")
     , enabled_("enabled", "Enable Operation", true)
-    , subSampleFactors_("subSampleFactors", "Factors", ivec3(1), ivec3(1), ivec3(8)) {
+    , subSampleFactors_("subSampleFactors", "Factors", ivec3(1), ivec3(1), ivec3(8))
+    , filter_("filter", "Filter",
+              {{"mean", "Mean", PyramidFilter::Mean},
+               {"min", "Min", PyramidFilter::Min},
+               {"max", "Max", PyramidFilter::Max},
+               {"maxAbs", "Max Magnitude", PyramidFilter::MaxAbs}},
+              0) {
 
     addPort(inport_);
     addPort(outport_);
 
     addProperty(enabled_);
     addProperty(subSampleFactors_);
+    addProperty(filter_);
 }
 
 void VolumeSubsample::process() {
@@ -64,8 +71,8 @@ void VolumeSubsample::process() {
 
     if (enabled_ && factors != size3_t(1, 1, 1)) {
         outport_.clear();
-        dispatchOne([volume = inport_.getData(),
-                     f = subSampleFactors_.get()]() { return subsample(volume, f); },
+        dispatchOne([volume = inport_.getData(), f = factors,
+                     filter = filter_.get()]() { return subsample(volume, f, filter); },
                     [this](std::shared_ptr<Volume> result) {
                         outport_.setData(result);
                         newResults();
@@ -76,9 +83,23 @@ void VolumeSubsample::process() {
 }
 
 std::shared_ptr<Volume> VolumeSubsample::subsample(std::shared_ptr<const Volume> volume,
-                                                   size3_t f) {
-    auto vol = volume->getRepresentation<VolumeRAM>();
-    auto sample = std::make_shared<Volume>(util::volumeSubSample(vol, f));
+                                                   size3_t f, PyramidFilter filter) {
+    const auto ram = [&]() -> std::shared_ptr<VolumeRAM> {
+        // Equal power of two factors correspond to a pyramid level, which is cached in the input
+        // volume and shared by all factors
+        if (f.x == f.y && f.x == f.z && (f.x & (f.x - 1)) == 0) {
+            const auto pyramid = volume->getPyramid(filter);
+            size_t level = 0;
+            while ((size_t{1} << (level + 1)) <= f.x) ++level;
+            level = std::min(level, pyramid->size() - 1);
+            return std::shared_ptr<VolumeRAM>(pyramid->getLevel(level)->clone());
+        } else if (filter == PyramidFilter::Mean) {
+            return util::volumeSubSample(volume->getRepresentation<VolumeRAM>(), f);
+        } else {
+            return util::volumeDownsample(*volume->getRepresentation<VolumeRAM>(), f, filter);
+        }
+    }();
+    auto sample = std::make_shared<Volume>(ram);
     sample->copyMetaDataFrom(*volume);
     sample->dataMap_ = volume->dataMap_;
     sample->setModelMatrix(volume->getModelMatrix());
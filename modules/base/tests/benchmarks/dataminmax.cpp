@@ -0,0 +1,89 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <modules/base/algorithm/dataminmax.h>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+using namespace inviwo;
+
+template <typename T>
+static std::shared_ptr<VolumeRAMPrecision<T>> makeVolume(size_t size) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(size3_t{size});
+    std::mt19937 rand{42};
+    std::uniform_real_distribution<double> dist{0.0, 100.0};
+    std::generate(ram->getDataTyped(), ram->getDataTyped() + glm::compMul(size3_t{size}),
+                  [&]() { return static_cast<T>(dist(rand)); });
+    return ram;
+}
+
+template <typename T>
+static void VolumeMinMax(benchmark::State& state, IgnoreSpecialValues ignore) {
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto ram = makeVolume<T>(size);
+    for (auto _ : state) {
+        auto minmax = util::volumeMinMax(ram.get(), ignore);
+        benchmark::DoNotOptimize(minmax);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size * size * size *
+                                                 sizeof(T)));
+}
+
+BENCHMARK_CAPTURE(VolumeMinMax<float>, float, IgnoreSpecialValues::No)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(VolumeMinMax<float>, floatIgnoreSpecial, IgnoreSpecialValues::Yes)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(VolumeMinMax<unsigned char>, uint8, IgnoreSpecialValues::No)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(VolumeMinMax<unsigned short>, uint16, IgnoreSpecialValues::No)
+    ->RangeMultiplier(2)
+    ->Range(64, 256)
+    ->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
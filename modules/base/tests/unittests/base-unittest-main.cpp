@@ -34,11 +34,11 @@
 #endif
 #endif
 
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/common/coremodulesharedlibrary.h>
+#include <inviwo/core/util/logcentral.h>
 #include <inviwo/testutil/configurablegtesteventlistener.h>
 
-#include <inviwo/core/datastructures/representationutil.h>
-#include <inviwo/core/datastructures/representationfactorymanager.h>
-
 #include <warn/push>
 #include <warn/ignore/all>
 #include <gtest/gtest.h>
@@ -47,8 +47,16 @@
 using namespace inviwo;
 
 int main(int argc, char** argv) {
-    RepresentationFactoryManager rfm;
-    util::registerCoreRepresentations(rfm);
+    LogCentral::init();
+
+    // The application provides the data representations and the thread pool used by the readers
+    // and the volume sequence streamer
+    InviwoApplication app(argc, argv, "Inviwo-Unittests-Base");
+    {
+        std::vector<std::unique_ptr<InviwoModuleFactoryObject>> modules;
+        modules.emplace_back(createInviwoCore());
+        app.registerModules(std::move(modules));
+    }
 
     int ret = -1;
     {
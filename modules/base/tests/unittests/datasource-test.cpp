@@ -0,0 +1,201 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/processors/datasource.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/util/settings/systemsettings.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace inviwo {
+
+namespace {
+
+// Shared by the clones of the reader. The file "<n>.dstest" is read as the number n, once the
+// gate of that file has been opened.
+struct ReaderState {
+    ReaderState() {
+        for (size_t i = 0; i < gates.size(); ++i) opened[i] = gates[i].get_future().share();
+    }
+    void open(size_t i) {
+        if (!isOpen[i].exchange(true)) gates[i].set_value();
+    }
+
+    std::array<std::promise<void>, 5> gates;
+    std::array<std::shared_future<void>, 5> opened;
+    std::array<std::atomic<bool>, 5> isOpen{};
+    std::array<std::atomic<bool>, 5> started{};
+    std::array<std::atomic<bool>, 5> stopped{};
+    std::array<std::atomic<bool>, 5> finished{};
+};
+
+class TestReader : public DataReaderType<int> {
+public:
+    TestReader(std::shared_ptr<ReaderState> state) : state_{std::move(state)} {
+        addExtension(FileExtension("dstest", "DataSource test"));
+    }
+    virtual TestReader* clone() const override { return new TestReader(*this); }
+
+    using DataReaderType<int>::readData;
+
+    virtual std::shared_ptr<int> readData(const std::string& filePath) override {
+        return std::make_shared<int>(index(filePath));
+    }
+    virtual std::shared_ptr<int> readData(const std::string& filePath, MetaDataOwner*,
+                                          const pool::Stop& stop,
+                                          const pool::Progress&) override {
+        const auto n = index(filePath);
+        const auto i = static_cast<size_t>(n);
+        state_->started[i] = true;
+        state_->opened[i].wait();
+        state_->stopped[i] = static_cast<bool>(stop);
+        state_->finished[i] = true;
+        return stop ? nullptr : std::make_shared<int>(n);
+    }
+
+private:
+    static int index(const std::string& filePath) {
+        return std::stoi(filesystem::getFileNameWithoutExtension(filePath));
+    }
+    std::shared_ptr<ReaderState> state_;
+};
+
+class TestSource : public DataSource<int, DataOutport<int>> {
+public:
+    TestSource() : DataSource<int, DataOutport<int>>() { setIdentifier("Source"); }
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    static const ProcessorInfo processorInfo_;
+
+    void load(const std::string& file) {
+        file_.set(file);
+        DataSource<int, DataOutport<int>>::load(false);
+    }
+    int data() const {
+        auto data = port_.getData();
+        return data ? *data : 0;
+    }
+    bool ready() const { return port_.isReady(); }
+};
+
+const ProcessorInfo TestSource::processorInfo_{
+    "org.inviwo.TestSource",  // Class identifier
+    "TestSource",             // Display name
+    "Testing",                // Category
+    CodeState::Stable,        // Code state
+    Tags::CPU,                // Tags
+};
+
+// Run the main thread tasks, where the loaded data is set, until pred is true
+template <typename Pred>
+bool waitFor(Pred pred) {
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!pred() && std::chrono::steady_clock::now() < timeout) {
+        InviwoApplication::getPtr()->processFront();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return pred();
+}
+
+// Let a stopped job finish and deliver anything it might have queued for the main thread
+void finish(ReaderState& state, size_t i) {
+    state.open(i);
+    EXPECT_TRUE(waitFor([&]() { return state.finished[i].load(); }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    InviwoApplication::getPtr()->processFront();
+}
+
+}  // namespace
+
+TEST(DataSource, NewLoadCancelsOldLoad) {
+    auto app = InviwoApplication::getPtr();
+    auto& settings = app->getSystemSettings();
+    const auto poolSize = settings.poolSize_.get();
+    settings.poolSize_.set(2);
+
+    auto state = std::make_shared<ReaderState>();
+    TestReader reader{state};
+    app->getDataReaderFactory()->registerObject(&reader);
+
+    util::OnScopeExit cleanup{[&]() {
+        // Never leave a job blocked in the pool
+        for (size_t i = 0; i < state->gates.size(); ++i) state->open(i);
+        app->getDataReaderFactory()->unRegisterObject(&reader);
+        settings.poolSize_.set(poolSize);
+    }};
+
+    ProcessorNetwork network{app};
+    auto source = static_cast<TestSource*>(network.addProcessor(std::make_unique<TestSource>()));
+
+    source->load("1.dstest");
+    state->open(1);
+    EXPECT_TRUE(waitFor([&]() { return source->data() == 1; }));
+
+    // The previous data stays valid on the outport while loading
+    source->load("2.dstest");
+    EXPECT_TRUE(waitFor([&]() { return state->started[2].load(); }));
+    EXPECT_EQ(source->data(), 1);
+    EXPECT_TRUE(source->ready());
+
+    // A second load stops the first one, which never reaches the outport
+    source->load("3.dstest");
+    finish(*state, 2);
+    EXPECT_TRUE(state->stopped[2].load());
+    EXPECT_EQ(source->data(), 1);
+
+    EXPECT_TRUE(waitFor([&]() { return state->started[3].load(); }));
+    EXPECT_EQ(source->data(), 1);
+    state->open(3);
+    EXPECT_TRUE(waitFor([&]() { return source->data() == 3; }));
+    EXPECT_FALSE(state->stopped[3].load());
+
+    // Clearing the file stops the ongoing load as well
+    source->load("4.dstest");
+    EXPECT_TRUE(waitFor([&]() { return state->started[4].load(); }));
+    source->load("");
+    finish(*state, 4);
+    EXPECT_TRUE(state->stopped[4].load());
+    EXPECT_EQ(source->data(), 3);
+}
+
+}  // namespace inviwo
@@ -184,4 +184,63 @@ TEST(MeshCutting, PlaneBasis) {
     }
 }
 
+namespace {
+
+const std::vector<vec3>& clippedPositions(const Mesh& mesh) {
+    return static_cast<const Buffer<vec3>*>(mesh.findBuffer(BufferType::PositionAttrib).first)
+        ->getRAMRepresentation()
+        ->getDataContainer();
+}
+
+float clippedArea(const Mesh& mesh) {
+    const auto& positions = clippedPositions(mesh);
+    float area = 0.0f;
+    for (const auto& [info, buffer] : mesh.getIndexBuffers()) {
+        const auto& indices = buffer->getRAMRepresentation()->getDataContainer();
+        for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+            const auto& p0 = positions[indices[t]];
+            const auto& p1 = positions[indices[t + 1]];
+            const auto& p2 = positions[indices[t + 2]];
+            area += 0.5f * glm::length(glm::cross(p1 - p0, p2 - p0));
+        }
+    }
+    return area;
+}
+
+}  // namespace
+
+TEST(MeshCutting, SharedEdgeVertices) {
+    const auto cube = meshutil::cube(mat4(1.0f));
+    const Plane plane{vec3{0.5f, 0.5f, 0.5f}, vec3{-1.0f, 0.0f, 0.0f}};
+
+    const auto clipped = meshutil::clipMeshAgainstPlane(*cube, plane, false);
+
+    // 4 of the 6 faces are cut, each face gets one vertex on each of its two cut borders and
+    // one on the diagonal that is shared by its triangles
+    EXPECT_EQ(clippedPositions(*clipped).size(), 24 + 4 * 3);
+    EXPECT_NEAR(clippedArea(*clipped), 3.0f, 1e-5f);
+}
+
+TEST(MeshCutting, MultiplePlanes) {
+    const auto cube = meshutil::cube(mat4(1.0f));
+    const std::vector<Plane> planes{Plane{vec3{0.5f, 0.5f, 0.5f}, vec3{-1.0f, 0.0f, 0.0f}},
+                                    Plane{vec3{0.5f, 0.5f, 0.5f}, vec3{0.0f, -1.0f, 0.0f}}};
+
+    const auto clipped = meshutil::clipMeshAgainstPlanes(*cube, planes, false);
+    EXPECT_NEAR(clippedArea(*clipped), 1.5f, 1e-5f);
+
+    // The caps of the two planes are clipped by each other
+    const auto capped = meshutil::clipMeshAgainstPlanes(*cube, planes, true);
+    EXPECT_NEAR(clippedArea(*capped), 2.5f, 1e-5f);
+
+    const auto& positions = clippedPositions(*capped);
+    for (const auto& [info, buffer] : capped->getIndexBuffers()) {
+        for (auto i : buffer->getRAMRepresentation()->getDataContainer()) {
+            for (const auto& plane : planes) {
+                EXPECT_GE(plane.distance(positions[i]), -1e-6f);
+            }
+        }
+    }
+}
+
 }  // namespace inviwo
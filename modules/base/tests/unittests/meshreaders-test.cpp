@@ -0,0 +1,300 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/io/plyreader.h>
+#include <modules/base/io/stlreader.h>
+#include <modules/base/io/wavefrontreader.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/io/datareaderfactory.h>
+#include <inviwo/core/io/tempfilehandle.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace inviwo {
+
+namespace {
+
+util::TempFileHandle makeFile(const std::string& suffix, std::string_view contents) {
+    util::TempFileHandle file{"meshreader", suffix};
+    {
+        std::ofstream stream(file.getFileName(), std::ios::binary);
+        stream.write(contents.data(), contents.size());
+    }
+    return file;
+}
+
+template <typename T>
+std::vector<T> getBufferData(const Mesh& mesh, BufferType type) {
+    if (auto buffer = mesh.findBuffer(type).first) {
+        return static_cast<const Buffer<T>*>(buffer)->getRAMRepresentation()->getDataContainer();
+    }
+    return {};
+}
+
+std::vector<std::uint32_t> getIndexData(const Mesh& mesh) {
+    return mesh.getIndices(0)->getRAMRepresentation()->getDataContainer();
+}
+
+// Append the bytes of value to data in the requested byte order
+template <typename T>
+void append(std::string& data, T value, bool bigEndian) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    const std::uint16_t one = 1;
+    const bool littleEndianHost = *reinterpret_cast<const std::uint8_t*>(&one) == 1;
+    if (bigEndian == littleEndianHost) std::reverse(std::begin(bytes), std::end(bytes));
+    data.append(bytes, sizeof(T));
+}
+
+constexpr std::string_view plyHeader =
+    "element vertex 4\n"
+    "property float x\n"
+    "property float y\n"
+    "property float z\n"
+    "property uchar red\n"
+    "property uchar green\n"
+    "property uchar blue\n"
+    "element face 2\n"
+    "property list uchar int vertex_indices\n"
+    "end_header\n";
+
+const std::vector<vec3> quad{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 0.0f},
+                             {0.0f, 1.0f, 0.0f}};
+
+std::string binaryPly(bool bigEndian) {
+    std::string data = "ply\nformat ";
+    data += bigEndian ? "binary_big_endian" : "binary_little_endian";
+    data += " 1.0\n";
+    data += plyHeader;
+    for (const auto& p : quad) {
+        for (int i = 0; i < 3; ++i) append(data, p[i], bigEndian);
+        for (int i = 0; i < 3; ++i) append(data, std::uint8_t{0}, bigEndian);
+    }
+    // One triangle and one quad, the quad is triangulated as a fan
+    append(data, std::uint8_t{3}, bigEndian);
+    for (std::int32_t i : {0, 1, 2}) append(data, i, bigEndian);
+    append(data, std::uint8_t{4}, bigEndian);
+    for (std::int32_t i : {0, 1, 2, 3}) append(data, i, bigEndian);
+    return data;
+}
+
+void checkPly(const Mesh& mesh) {
+    EXPECT_EQ(getBufferData<vec3>(mesh, BufferType::PositionAttrib), quad);
+    EXPECT_EQ(getBufferData<vec4>(mesh, BufferType::ColorAttrib),
+              std::vector<vec4>(4, vec4{0.0f, 0.0f, 0.0f, 1.0f}));
+    EXPECT_EQ(getIndexData(mesh), (std::vector<std::uint32_t>{0, 1, 2, 0, 1, 2, 0, 2, 3}));
+}
+
+}  // namespace
+
+TEST(PlyReader, Ascii) {
+    std::string data = "ply\nformat ascii 1.0\ncomment test\n";
+    data += plyHeader;
+    data +=
+        "0 0 0 0 0 0\n"
+        "1 0 0 0 0 0\n"
+        "1 1 0 0 0 0\n"
+        "0 1 0 0 0 0\n"
+        "3 0 1 2\n"
+        "4 0 1 2 3\n";
+    const auto file = makeFile(".ply", data);
+    checkPly(*PlyReader{}.readData(file.getFileName()));
+}
+
+TEST(PlyReader, BinaryLittleEndian) {
+    const auto file = makeFile(".ply", binaryPly(false));
+    checkPly(*PlyReader{}.readData(file.getFileName()));
+}
+
+TEST(PlyReader, BinaryBigEndian) {
+    const auto file = makeFile(".ply", binaryPly(true));
+    checkPly(*PlyReader{}.readData(file.getFileName()));
+}
+
+TEST(PlyReader, InvalidIndex) {
+    std::string data = "ply\nformat ascii 1.0\n";
+    data += plyHeader;
+    data += "0 0 0 0 0 0\n1 0 0 0 0 0\n1 1 0 0 0 0\n0 1 0 0 0 0\n3 0 1 2\n3 0 1 4\n";
+    const auto file = makeFile(".ply", data);
+    EXPECT_THROW(PlyReader{}.readData(file.getFileName()), DataReaderException);
+}
+
+TEST(StlReader, Ascii) {
+    const auto file = makeFile(".stl",
+                               "solid test\n"
+                               "  facet normal 0 0 1\n"
+                               "    outer loop\n"
+                               "      vertex 0 0 0\n"
+                               "      vertex 1 0 0\n"
+                               "      vertex 1 1 0\n"
+                               "    endloop\n"
+                               "  endfacet\n"
+                               "  facet normal 0 0 -1\n"
+                               "    outer loop\n"
+                               "      vertex 0 0 0\n"
+                               "      vertex 1 1 0\n"
+                               "      vertex 0 1 0\n"
+                               "    endloop\n"
+                               "  endfacet\n"
+                               "endsolid test\n");
+    const auto mesh = StlReader{}.readData(file.getFileName());
+    EXPECT_EQ(getBufferData<vec3>(*mesh, BufferType::PositionAttrib),
+              (std::vector<vec3>{quad[0], quad[1], quad[2], quad[0], quad[2], quad[3]}));
+    EXPECT_EQ(getBufferData<vec3>(*mesh, BufferType::NormalAttrib),
+              (std::vector<vec3>{{0, 0, 1}, {0, 0, 1}, {0, 0, 1}, {0, 0, -1}, {0, 0, -1},
+                                 {0, 0, -1}}));
+    EXPECT_EQ(getIndexData(*mesh), (std::vector<std::uint32_t>{0, 1, 2, 3, 4, 5}));
+}
+
+TEST(StlReader, Binary) {
+    // Binary files may start with "solid" as well, the size decides the format
+    std::string data = "solid binary";
+    data.resize(80, ' ');
+    append(data, std::uint32_t{2}, false);
+    const std::vector<vec3> triangles{{0, 0, 1}, quad[0], quad[1], quad[2],
+                                      {0, 0, 1}, quad[0], quad[2], quad[3]};
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        for (int j = 0; j < 3; ++j) append(data, triangles[i][j], false);
+        if (i % 4 == 3) append(data, std::uint16_t{0}, false);
+    }
+    const auto file = makeFile(".stl", data);
+
+    const auto mesh = StlReader{}.readData(file.getFileName());
+    EXPECT_EQ(getBufferData<vec3>(*mesh, BufferType::PositionAttrib),
+              (std::vector<vec3>{quad[0], quad[1], quad[2], quad[0], quad[2], quad[3]}));
+    EXPECT_EQ(getBufferData<vec3>(*mesh, BufferType::NormalAttrib),
+              std::vector<vec3>(6, vec3{0, 0, 1}));
+    EXPECT_EQ(getIndexData(*mesh), (std::vector<std::uint32_t>{0, 1, 2, 3, 4, 5}));
+}
+
+TEST(StlReader, Weld) {
+    // Two facets folded along a shared edge, the file normals are per facet
+    const auto file = makeFile(".stl",
+                               "solid fold\n"
+                               "  facet normal 0 0 1\n"
+                               "    outer loop\n"
+                               "      vertex 0 0 0\n"
+                               "      vertex 1 0 0\n"
+                               "      vertex 0 1 0\n"
+                               "    endloop\n"
+                               "  endfacet\n"
+                               "  facet normal 1 0 0\n"
+                               "    outer loop\n"
+                               "      vertex 0 0 0\n"
+                               "      vertex 0 1 0\n"
+                               "      vertex 0 0 1\n"
+                               "    endloop\n"
+                               "  endfacet\n"
+                               "endsolid fold\n");
+    StlReader reader;
+    ASSERT_TRUE(reader.setOption("WeldVertices", true));
+    const auto mesh = reader.readData(file.getFileName());
+
+    EXPECT_EQ(getBufferData<vec3>(*mesh, BufferType::PositionAttrib),
+              (std::vector<vec3>{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}}));
+    EXPECT_EQ(getIndexData(*mesh), (std::vector<std::uint32_t>{0, 1, 2, 0, 2, 3}));
+    // The shared vertices average the normals of both facets instead of keeping the first one
+    const auto shared = glm::normalize(vec3{1, 0, 1});
+    EXPECT_EQ(getBufferData<vec3>(*mesh, BufferType::NormalAttrib),
+              (std::vector<vec3>{shared, {0, 0, 1}, shared, {1, 0, 0}}));
+}
+
+TEST(WaveFrontReader, Indices) {
+    const auto file = makeFile(".obj",
+                               "# positive indices\n"
+                               "v 0 0 0\n"
+                               "v 1 0 0\n"
+                               "v 1 1 0\n"
+                               "f 1 2 3\n"
+                               "# negative indices are relative to the last vertex so far\n"
+                               "v 0 1 0\n"
+                               "f -4 -2 -1\n"
+                               "v 2 0 0\n"
+                               "f -1 -4 2\n");
+    const auto mesh = WaveFrontReader{}.readData(file.getFileName());
+    EXPECT_EQ(getBufferData<vec3>(*mesh, BufferType::PositionAttrib),
+              (std::vector<vec3>{quad[0], quad[1], quad[2], quad[3], {2, 0, 0}}));
+    EXPECT_EQ(getIndexData(*mesh), (std::vector<std::uint32_t>{0, 1, 2, 0, 2, 3, 4, 1, 1}));
+}
+
+TEST(WaveFrontReader, SplitVertices) {
+    // Corners with different normals for the same position result in separate vertices
+    const auto file = makeFile(".obj",
+                               "v 0 0 0\n"
+                               "v 1 0 0\n"
+                               "v 1 1 0\n"
+                               "vn 0 0 1\n"
+                               "vn 0 0 -1\n"
+                               "f 1//1 2//1 3//1\n"
+                               "f -3//-1 -1//-1 -2//-1\n");
+    const auto mesh = WaveFrontReader{}.readData(file.getFileName());
+    EXPECT_EQ(getBufferData<vec3>(*mesh, BufferType::PositionAttrib),
+              (std::vector<vec3>{quad[0], quad[1], quad[2], quad[0], quad[2], quad[1]}));
+    EXPECT_EQ(getBufferData<vec3>(*mesh, BufferType::NormalAttrib),
+              (std::vector<vec3>{{0, 0, 1}, {0, 0, 1}, {0, 0, 1}, {0, 0, -1}, {0, 0, -1},
+                                 {0, 0, -1}}));
+    EXPECT_EQ(getIndexData(*mesh), (std::vector<std::uint32_t>{0, 1, 2, 3, 4, 5}));
+}
+
+TEST(DataReaderFactory, Priority) {
+    // A generic reader registered for the same extension must not shadow the native reader,
+    // regardless of the extension descriptions
+    class GenericReader : public DataReaderType<Mesh> {
+    public:
+        GenericReader() { addExtension(FileExtension("ply", "A generic PLY importer")); }
+        virtual GenericReader* clone() const override { return new GenericReader(*this); }
+        virtual std::shared_ptr<Mesh> readData(const std::string&) override { return nullptr; }
+    };
+
+    PlyReader native;
+    GenericReader generic;
+    DataReaderFactory factory;
+    factory.registerObject(&generic);
+    factory.registerObject(&native);
+
+    auto reader = factory.getReaderForTypeAndExtension<Mesh>("/path/to/mesh.PLY");
+    ASSERT_TRUE(reader);
+    EXPECT_TRUE(dynamic_cast<PlyReader*>(reader.get()));
+    EXPECT_TRUE(dynamic_cast<PlyReader*>(factory.create(std::string_view{"ply"}).get()));
+
+    generic.setPriority(2);
+    EXPECT_TRUE(dynamic_cast<GenericReader*>(
+        factory.getReaderForTypeAndExtension<Mesh>("mesh.ply").get()));
+}
+
+}  // namespace inviwo
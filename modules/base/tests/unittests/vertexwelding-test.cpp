@@ -0,0 +1,94 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/algorithm/mesh/vertexwelding.h>
+
+namespace inviwo {
+
+TEST(VertexWelding, Exact) {
+    const std::vector<vec3> positions{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f},
+                                      {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}};
+
+    const auto weld = meshutil::weldVertices(positions, 0.0f);
+    ASSERT_EQ(weld.unique.size(), 3);
+    EXPECT_EQ(weld.unique, (std::vector<std::uint32_t>{0, 1, 4}));
+    EXPECT_EQ(weld.remap, (std::vector<std::uint32_t>{0, 1, 0, 1, 2}));
+}
+
+TEST(VertexWelding, NegativeZero) {
+    const std::vector<vec3> positions{{0.0f, -0.0f, 1.0f}, {-0.0f, 0.0f, 1.0f}};
+
+    const auto weld = meshutil::weldVertices(positions, 0.0f);
+    EXPECT_EQ(weld.remap, (std::vector<std::uint32_t>{0, 0}));
+}
+
+TEST(VertexWelding, Epsilon) {
+    // The points are in different grid cells but within epsilon of each other
+    const std::vector<vec3> positions{{0.099f, 0.0f, 0.0f}, {0.101f, 0.0f, 0.0f},
+                                      {0.5f, 0.5f, 0.5f}, {0.5f, 0.5f, 0.55f}};
+
+    const auto weld = meshutil::weldVertices(positions, 0.01f);
+    EXPECT_EQ(weld.remap, (std::vector<std::uint32_t>{0, 0, 1, 2}));
+
+    const auto coarse = meshutil::weldVertices(positions, 0.1f);
+    EXPECT_EQ(coarse.remap, (std::vector<std::uint32_t>{0, 0, 1, 1}));
+}
+
+TEST(VertexWelding, Apply) {
+    std::vector<vec3> positions{{0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f},
+                                {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}};
+    std::vector<std::uint32_t> indices{0, 1, 2, 3, 4, 5};
+
+    const auto weld = meshutil::weldVertices(positions, 0.0f);
+    meshutil::applyWeld(weld, positions);
+    meshutil::applyWeldToIndices(weld, indices);
+
+    ASSERT_EQ(positions.size(), 4);
+    EXPECT_EQ(indices, (std::vector<std::uint32_t>{0, 1, 2, 1, 2, 3}));
+    EXPECT_EQ(positions[3], vec3(1.0f, 1.0f, 0.0f));
+}
+
+TEST(VertexWelding, SmoothNormals) {
+    // Two triangles of equal area folded along the edge from (0,0,0) to (0,1,0)
+    const std::vector<vec3> positions{
+        {0.0f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+    const std::vector<std::uint32_t> indices{0, 1, 2, 0, 2, 3};
+
+    const auto normals = meshutil::smoothNormals(positions, indices);
+    const auto shared = glm::normalize(vec3{1.0f, 0.0f, 1.0f});
+    EXPECT_EQ(normals,
+              (std::vector<vec3>{shared, {0.0f, 0.0f, 1.0f}, shared, {1.0f, 0.0f, 0.0f}}));
+}
+
+}  // namespace inviwo
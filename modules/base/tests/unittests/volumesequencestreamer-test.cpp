@@ -0,0 +1,263 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/base/datastructures/volumesequencestreamer.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volumedisk.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/settings/systemsettings.h>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+namespace inviwo {
+
+namespace {
+
+// Creates a small RAM representation, counts the number of loads and runs an optional hook first
+class TestLoader : public DiskRepresentationLoader<VolumeRepresentation> {
+public:
+    TestLoader(std::shared_ptr<std::atomic<int>> loads, std::function<void()> onLoad)
+        : loads_{std::move(loads)}, onLoad_{std::move(onLoad)} {}
+    virtual TestLoader* clone() const override { return new TestLoader(*this); }
+
+    virtual std::shared_ptr<VolumeRepresentation> createRepresentation(
+        const VolumeRepresentation& src) const override {
+        if (onLoad_) onLoad_();
+        ++*loads_;
+        return std::make_shared<VolumeRAMPrecision<unsigned char>>(src.getDimensions());
+    }
+    virtual void updateRepresentation(std::shared_ptr<VolumeRepresentation>,
+                                      const VolumeRepresentation&) const override {
+        ++*loads_;
+    }
+
+private:
+    std::shared_ptr<std::atomic<int>> loads_;
+    std::function<void()> onLoad_;
+};
+
+class VolumeSequenceStreamerTest : public ::testing::Test {
+protected:
+    VolumeSequenceStreamerTest()
+        : settings_{InviwoApplication::getPtr()->getSystemSettings()}
+        , poolSize_{settings_.poolSize_.get()} {}
+    virtual ~VolumeSequenceStreamerTest() { settings_.poolSize_.set(poolSize_); }
+
+    std::shared_ptr<VolumeSequence> makeSequence(size_t size,
+                                                 std::function<void(size_t)> onLoad = {}) {
+        auto sequence = std::make_shared<VolumeSequence>();
+        for (size_t i = 0; i < size; ++i) {
+            loads_.push_back(std::make_shared<std::atomic<int>>(0));
+            auto disk = std::make_shared<VolumeDisk>(size3_t{4});
+            disk->setLoader(new TestLoader(
+                loads_.back(), onLoad ? std::function<void()>{[onLoad, i]() { onLoad(i); }}
+                                      : std::function<void()>{}));
+            sequence->push_back(std::make_shared<Volume>(disk));
+        }
+        return sequence;
+    }
+
+    int loads(size_t index) const { return *loads_[index]; }
+
+    // Wait for a load done by a prefetch on the thread pool
+    bool waitForLoad(size_t index) const {
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (loads(index) == 0 && std::chrono::steady_clock::now() < timeout) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return loads(index) > 0;
+    }
+
+    SystemSettings& settings_;
+    size_t poolSize_;
+    std::vector<std::shared_ptr<std::atomic<int>>> loads_;
+};
+
+}  // namespace
+
+TEST_F(VolumeSequenceStreamerTest, Prefetch) {
+    settings_.poolSize_.set(2);
+    auto sequence = makeSequence(8);
+
+    VolumeSequenceStreamer streamer{4, 2};
+    streamer.setSequence(sequence);
+
+    EXPECT_TRUE(streamer.get(0)->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(streamer.getStats().stalls, 1);
+
+    // The next two time steps in the playback direction are loaded in the background
+    EXPECT_TRUE(waitForLoad(1));
+    EXPECT_TRUE(waitForLoad(2));
+    EXPECT_EQ(loads(3), 0);
+
+    EXPECT_TRUE(streamer.get(1)->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE(streamer.get(2)->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(loads(1), 1);
+    EXPECT_EQ(loads(2), 1);
+    EXPECT_EQ(streamer.getStats().requests, 3);
+    EXPECT_EQ(streamer.getStats().prefetchHits + streamer.getStats().stalls, 3);
+
+    // Playing backwards prefetches the preceding time steps, wrapping around the start
+    streamer.get(1);
+    streamer.get(0);
+    EXPECT_TRUE(waitForLoad(7));
+    EXPECT_TRUE(waitForLoad(6));
+
+    streamer.releaseAll();
+    EXPECT_EQ(streamer.getResidentCount(), 0);
+    for (const auto& volume : *sequence) {
+        EXPECT_FALSE(volume->hasRepresentation<VolumeRAM>());
+    }
+}
+
+TEST_F(VolumeSequenceStreamerTest, Eviction) {
+    auto sequence = makeSequence(5);
+
+    // Only keep the current and the previous time step, without prefetching
+    VolumeSequenceStreamer streamer{2, 0};
+    streamer.setSequence(sequence);
+
+    streamer.get(0);
+    streamer.get(1);
+    EXPECT_EQ(streamer.getResidentCount(), 2);
+    streamer.get(2);
+    EXPECT_EQ(streamer.getResidentCount(), 2);
+    EXPECT_EQ(streamer.getStats().evictions, 1);
+    EXPECT_FALSE((*sequence)[0]->hasRepresentation<VolumeRAM>());
+    EXPECT_TRUE((*sequence)[0]->hasRepresentation<VolumeDisk>());
+
+    // A time step that is still in use is not released until the last reference is gone
+    auto held = streamer.get(3);
+    streamer.get(4);
+    streamer.get(0);
+    EXPECT_TRUE(held->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(streamer.getStats().evictions, 3);
+
+    held.reset();
+    streamer.get(1);
+    EXPECT_FALSE((*sequence)[3]->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(streamer.getStats().evictions, 5);
+    EXPECT_EQ(streamer.getResidentCount(), 2);
+
+    // Volumes are loaded again when revisited
+    EXPECT_TRUE(streamer.get(3)->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(loads(3), 2);
+}
+
+TEST_F(VolumeSequenceStreamerTest, ReleaseAllKeepsVolumesInUse) {
+    auto sequence = makeSequence(3);
+    VolumeSequenceStreamer streamer{2, 0};
+    streamer.setSequence(sequence);
+
+    auto held = streamer.get(0);
+    streamer.get(1);
+    streamer.releaseAll();
+    EXPECT_TRUE(held->hasRepresentation<VolumeRAM>());
+    EXPECT_FALSE((*sequence)[1]->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(streamer.getResidentCount(), 1);
+
+    held.reset();
+    streamer.releaseAll();
+    EXPECT_FALSE((*sequence)[0]->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(streamer.getResidentCount(), 0);
+
+    // Time steps of a replaced sequence are released once they are no longer in use
+    held = streamer.get(2);
+    streamer.setSequence(makeSequence(3));
+    EXPECT_TRUE(held->hasRepresentation<VolumeRAM>());
+    held.reset();
+    streamer.get(0);
+    EXPECT_FALSE((*sequence)[2]->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(streamer.getResidentCount(), 1);
+}
+
+TEST_F(VolumeSequenceStreamerTest, Cancellation) {
+    // A single worker that is kept busy by the first prefetch, the rest have to queue up
+    settings_.poolSize_.set(1);
+
+    std::promise<void> started;
+    std::promise<void> gate;
+    std::shared_future<void> open = gate.get_future().share();
+    auto sequence = makeSequence(6, [&, open](size_t index) {
+        if (index != 1) return;
+        started.set_value();
+        open.wait();
+    });
+    (*sequence)[0]->getRepresentation<VolumeRAM>();
+
+    std::thread opener;
+    {
+        VolumeSequenceStreamer streamer{4, 3};
+        streamer.setSequence(sequence);
+        streamer.get(0);
+        started.get_future().wait();
+
+        opener = std::thread{[&]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            gate.set_value();
+        }};
+        // Destroying the streamer cancels the queued loads and waits for the running one
+    }
+    opener.join();
+
+    EXPECT_EQ(loads(1), 1);
+    EXPECT_EQ(loads(2), 0);
+    EXPECT_EQ(loads(3), 0);
+    EXPECT_FALSE((*sequence)[2]->hasRepresentation<VolumeRAM>());
+    EXPECT_FALSE((*sequence)[3]->hasRepresentation<VolumeRAM>());
+}
+
+TEST_F(VolumeSequenceStreamerTest, CancelledPrefetchIsLoadedOnRequest) {
+    settings_.poolSize_.set(1);
+
+    std::promise<void> gate;
+    std::shared_future<void> open = gate.get_future().share();
+    auto sequence = makeSequence(6, [open](size_t index) {
+        if (index == 1) open.wait();
+    });
+
+    VolumeSequenceStreamer streamer{2, 1};
+    streamer.setSequence(sequence);
+    streamer.get(0);  // Prefetches 1, which blocks the worker
+    streamer.get(3);  // Prefetches 4, queued behind 1
+    streamer.get(0);  // 4 leaves the window and its queued prefetch is cancelled
+    gate.set_value();
+
+    EXPECT_TRUE(streamer.get(4)->hasRepresentation<VolumeRAM>());
+    EXPECT_EQ(loads(4), 1);
+}
+
+}  // namespace inviwo
@@ -34,6 +34,8 @@
 #include <inviwo/core/datastructures/image/layer.h>
 #include <inviwo/core/datastructures/image/layerram.h>
 
+#include <functional>
+
 namespace inviwo {
 
 class DataFormatBase;
@@ -63,6 +65,29 @@ struct IVW_MODULE_CIMG_API TIFFHeader {
 
 IVW_MODULE_CIMG_API TIFFHeader getTIFFHeader(const std::string& filename);
 
+/**
+ * Sub region of a TIFF stack, in voxels of the full stack where each page is one slice along z.
+ * Like for the loaded volumes the y axis points upwards, i.e. the first row of a page is the last
+ * row in the volume.
+ */
+struct IVW_MODULE_CIMG_API TIFFStackRegion {
+    size3_t offset{0};
+    /// Size of the region, components that are zero extend to the end of the stack
+    size3_t extent{0};
+    /// Only every stride'th voxel along each axis is loaded
+    size3_t stride{1};
+
+    /**
+     * Clamp the region to a stack of the given dimensions and replace zero extents and strides
+     */
+    TIFFStackRegion resolve(const size3_t& stackDimensions) const;
+    /**
+     * Dimensions of the volume that the region will result in, the region has to be resolved
+     */
+    size3_t dimensions() const;
+    bool covers(const size3_t& stackDimensions) const;
+};
+
 /**
  * Loads layer data from a specified filePath.
  **/
@@ -106,6 +131,24 @@ void* loadTIFFLayerData(void* dst, const std::string& filePath, TIFFHeader heade
  */
 void* loadTIFFVolumeData(void* dst, const std::string& filePath, TIFFHeader header);
 
+/**
+ * Load a region of a TIFF stack into \p dst, which has to be preallocated to hold
+ * region.dimensions() voxels of header.format. \p header has to describe the full stack, and
+ * \p region has to be resolved against it.
+ *
+ * Pages are decoded in parallel on the thread pool, and of each page only the strips or tiles
+ * that overlap the region are decoded. Files that libtiff can not decode into the voxel layout
+ * directly, i.e. planar multi channel data or bit depths that are not a multiple of 8, are loaded
+ * completely and cropped afterwards.
+ * @param progress optional callback for the fraction of loaded pages. Will be called from worker
+ *        threads.
+ * \see TIFFStackVolumeRAMLoader
+ */
+IVW_MODULE_CIMG_API void loadTIFFVolumeData(void* dst, const std::string& filePath,
+                                            const TIFFHeader& header,
+                                            const TIFFStackRegion& region,
+                                            const std::function<void(double)>& progress = {});
+
 /**
  * \brief Rescales Layer of given image data
  *
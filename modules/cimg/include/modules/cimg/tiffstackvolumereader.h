@@ -30,6 +30,7 @@
 #pragma once
 
 #include <modules/cimg/cimgmoduledefine.h>
+#include <modules/cimg/cimgutils.h>
 
 #include <inviwo/core/io/datareader.h>
 #include <inviwo/core/io/datareaderexception.h>
@@ -38,6 +39,9 @@
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumedisk.h>
 
+#include <functional>
+#include <optional>
+
 namespace inviwo {
 
 class IVW_MODULE_CIMG_API TIFFStackVolumeReaderException : public DataReaderException {
@@ -47,6 +51,18 @@ public:
     virtual ~TIFFStackVolumeReaderException() noexcept = default;
 };
 
+/**
+ * \class TIFFStackVolumeReader
+ * \brief Reader for multi-page TIFF files, each page becomes one slice of the volume.
+ * The pages are decoded in parallel when the volume data is first accessed. The following options
+ * restrict what is loaded:
+ *  * "RegionOffset" (size3_t) first voxel of the region to load, default (0,0,0)
+ *  * "RegionExtent" (size3_t) size of the region, zero components extend to the end of the stack
+ *  * "Subsample" (size3_t) only load every n'th voxel along each axis, default (1,1,1)
+ *  * "Progress" (std::function<void(double)>) called with the fraction of loaded pages, from
+ *    worker threads
+ * @see cimgutil::TIFFStackRegion
+ */
 class IVW_MODULE_CIMG_API TIFFStackVolumeReader : public DataReaderType<Volume> {
 public:
     TIFFStackVolumeReader();
@@ -54,12 +70,26 @@ public:
     virtual ~TIFFStackVolumeReader() = default;
 
     virtual std::shared_ptr<Volume> readData(const std::string& filePath) override;
+
+    virtual bool setOption(std::string_view key, std::any value) override;
+    virtual std::any getOption(std::string_view key) override;
+
+private:
+    cimgutil::TIFFStackRegion region_;
+    std::function<void(double)> progress_;
 };
 
 class IVW_MODULE_CIMG_API TIFFStackVolumeRAMLoader
     : public DiskRepresentationLoader<VolumeRepresentation> {
 public:
     TIFFStackVolumeRAMLoader(const std::string& sourceFile);
+    /**
+     * Load \p region of a stack of size \p stackDimensions. The region has to be resolved
+     * against the stack.
+     */
+    TIFFStackVolumeRAMLoader(const std::string& sourceFile, const size3_t& stackDimensions,
+                             const cimgutil::TIFFStackRegion& region,
+                             std::function<void(double)> progress = {});
     virtual TIFFStackVolumeRAMLoader* clone() const override;
     virtual ~TIFFStackVolumeRAMLoader() = default;
 
@@ -69,7 +99,12 @@ public:
                                       const VolumeRepresentation& src) const override;
 
 private:
+    void load(void* dst, const VolumeRepresentation& src) const;
+
     std::string sourceFile_;
+    std::optional<size3_t> stackDimensions_;
+    cimgutil::TIFFStackRegion region_;
+    std::function<void(double)> progress_;
 };
 
 }  // namespace inviwo
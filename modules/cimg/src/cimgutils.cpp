@@ -32,10 +32,14 @@
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/util/threadutil.h>
 #include <inviwo/core/io/datawriterexception.h>
 #include <inviwo/core/io/datareaderexception.h>
+#include <inviwo/core/common/inviwoapplication.h>
 #include <algorithm>
 #include <limits>
+#include <atomic>
+#include <cstring>
 
 #include <inviwo/core/util/glm.h>
 
@@ -697,6 +701,226 @@ TIFFHeader getTIFFHeader(const std::string& filename) {
 #endif
 }
 
+
+TIFFStackRegion TIFFStackRegion::resolve(const size3_t& stackDimensions) const {
+    TIFFStackRegion res;
+    res.offset = glm::min(offset, glm::max(stackDimensions, size3_t{1}) - size3_t{1});
+    const size3_t remaining = stackDimensions - res.offset;
+    for (int i = 0; i < 3; ++i) {
+        res.extent[i] = extent[i] == 0 ? remaining[i] : std::min(extent[i], remaining[i]);
+    }
+    res.stride = glm::max(stride, size3_t{1});
+    return res;
+}
+
+size3_t TIFFStackRegion::dimensions() const { return (extent + stride - size3_t{1}) / stride; }
+
+bool TIFFStackRegion::covers(const size3_t& stackDimensions) const {
+    return offset == size3_t{0} && extent == stackDimensions && stride == size3_t{1};
+}
+
+namespace {
+
+void copyRegion(const unsigned char* src, const size3_t& srcDims, unsigned char* dst,
+                const TIFFStackRegion& region, size_t bytesPerVoxel) {
+    const auto dims = region.dimensions();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            const auto srcRow = region.offset + size3_t{0, y, z} * region.stride;
+            const auto* in = src + ((srcRow.z * srcDims.y + srcRow.y) * srcDims.x + srcRow.x) *
+                                       bytesPerVoxel;
+            for (size_t x = 0; x < dims.x; ++x) {
+                std::memcpy(dst, in + x * region.stride.x * bytesPerVoxel, bytesPerVoxel);
+                dst += bytesPerVoxel;
+            }
+        }
+    }
+}
+
+#ifdef cimg_use_tiff
+struct TIFFCloser {
+    void operator()(TIFF* tif) const {
+        if (tif) TIFFClose(tif);
+    }
+};
+using TIFFHandle = std::unique_ptr<TIFF, TIFFCloser>;
+
+TIFFHandle openTIFF(const std::string& filePath) {
+    TIFFHandle tif{TIFFOpen(filePath.c_str(), "r")};
+    if (!tif) {
+        throw DataReaderException("Error could not open input file: " + filePath,
+                                  IVW_CONTEXT_CUSTOM("cimgutil::loadTIFFVolumeData"));
+    }
+    return tif;
+}
+
+/**
+ * Whether the decoded strips or tiles have the same layout as the voxels, i.e. interleaved
+ * channels of whole bytes.
+ */
+bool hasVoxelLayout(TIFF* tif, const TIFFHeader& header) {
+    uint16 planar = PLANARCONFIG_CONTIG, bitsPerSample = 8, samplesPerPixel = 1,
+           photometric = PHOTOMETRIC_MINISBLACK;
+    TIFFGetFieldDefaulted(tif, TIFFTAG_PLANARCONFIG, &planar);
+    TIFFGetFieldDefaulted(tif, TIFFTAG_BITSPERSAMPLE, &bitsPerSample);
+    TIFFGetFieldDefaulted(tif, TIFFTAG_SAMPLESPERPIXEL, &samplesPerPixel);
+    TIFFGetFieldDefaulted(tif, TIFFTAG_PHOTOMETRIC, &photometric);
+
+    return (planar == PLANARCONFIG_CONTIG || samplesPerPixel == 1) &&
+           photometric != PHOTOMETRIC_YCBCR && photometric != PHOTOMETRIC_PALETTE &&
+           bitsPerSample % 8 == 0 &&
+           bitsPerSample / 8 * samplesPerPixel == header.format->getSize();
+}
+
+/**
+ * Decode the part of the current page of \p tif that overlaps the region into \p dst, only
+ * strips or tiles that contain sampled voxels are decoded.
+ */
+void decodePage(TIFF* tif, const TIFFHeader& header, const TIFFStackRegion& region,
+                unsigned char* dst, std::vector<unsigned char>& buffer) {
+    uint32 width = 0, height = 0;
+    TIFFGetFieldDefaulted(tif, TIFFTAG_IMAGEWIDTH, &width);
+    TIFFGetFieldDefaulted(tif, TIFFTAG_IMAGELENGTH, &height);
+    if (width != header.dimensions.x || height != header.dimensions.y) {
+        throw DataReaderException("Inconsistent page dimensions in TIFF stack",
+                                  IVW_CONTEXT_CUSTOM("cimgutil::loadTIFFVolumeData"));
+    }
+
+    const auto bytesPerVoxel = header.format->getSize();
+    const auto dims = region.dimensions();
+    // The pages are stored top to bottom while the volume rows go bottom to top
+    const auto pageRow = [&](size_t y) -> size_t {
+        return height - 1 - (region.offset.y + y * region.stride.y);
+    };
+    const auto pageColumn = [&](size_t x) -> size_t {
+        return region.offset.x + x * region.stride.x;
+    };
+    // Copy the voxels [x0, x1) of row y from a decoded row starting at page column 'first'
+    const auto copyRow = [&](const unsigned char* row, size_t first, size_t y, size_t x0,
+                             size_t x1) {
+        auto* out = dst + (y * dims.x + x0) * bytesPerVoxel;
+        if (region.stride.x == 1) {
+            std::memcpy(out, row + (pageColumn(x0) - first) * bytesPerVoxel,
+                        (x1 - x0) * bytesPerVoxel);
+        } else {
+            for (size_t x = x0; x < x1; ++x, out += bytesPerVoxel) {
+                std::memcpy(out, row + (pageColumn(x) - first) * bytesPerVoxel, bytesPerVoxel);
+            }
+        }
+    };
+    const auto error = [&]() {
+        return DataReaderException("Error decoding TIFF page " +
+                                       std::to_string(TIFFCurrentDirectory(tif)),
+                                   IVW_CONTEXT_CUSTOM("cimgutil::loadTIFFVolumeData"));
+    };
+
+    if (TIFFIsTiled(tif)) {
+        uint32 tileWidth = 0, tileHeight = 0;
+        TIFFGetField(tif, TIFFTAG_TILEWIDTH, &tileWidth);
+        TIFFGetField(tif, TIFFTAG_TILELENGTH, &tileHeight);
+        const auto tileRowSize = static_cast<size_t>(TIFFTileRowSize(tif));
+        buffer.resize(static_cast<size_t>(TIFFTileSize(tif)));
+
+        // Rows and columns map monotonically to the page, group them into runs per tile
+        for (size_t y0 = 0, y1 = 0; y0 < dims.y; y0 = y1) {
+            const size_t tileY = pageRow(y0) / tileHeight * tileHeight;
+            while (y1 < dims.y && pageRow(y1) >= tileY) ++y1;
+
+            for (size_t x0 = 0, x1 = 0; x0 < dims.x; x0 = x1) {
+                const size_t tileX = pageColumn(x0) / tileWidth * tileWidth;
+                while (x1 < dims.x && pageColumn(x1) < tileX + tileWidth) ++x1;
+
+                if (TIFFReadTile(tif, buffer.data(), static_cast<uint32>(tileX),
+                                 static_cast<uint32>(tileY), 0, 0) < 0) {
+                    throw error();
+                }
+                for (size_t y = y0; y < y1; ++y) {
+                    copyRow(buffer.data() + (pageRow(y) - tileY) * tileRowSize, tileX, y, x0, x1);
+                }
+            }
+        }
+    } else {
+        uint32 rowsPerStrip = height;
+        TIFFGetFieldDefaulted(tif, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+        rowsPerStrip = std::clamp<uint32>(rowsPerStrip, 1, height);
+        const auto scanlineSize = static_cast<size_t>(TIFFScanlineSize(tif));
+        buffer.resize(static_cast<size_t>(TIFFStripSize(tif)));
+
+        auto current = std::numeric_limits<tstrip_t>::max();
+        for (size_t y = 0; y < dims.y; ++y) {
+            const auto row = pageRow(y);
+            const auto strip = static_cast<tstrip_t>(row / rowsPerStrip);
+            if (strip != current) {
+                if (TIFFReadEncodedStrip(tif, strip, buffer.data(), -1) < 0) throw error();
+                current = strip;
+            }
+            copyRow(buffer.data() + (row % rowsPerStrip) * scanlineSize, 0, y, 0, dims.x);
+        }
+    }
+}
+#endif
+
+}  // namespace
+
+void loadTIFFVolumeData(void* dst, const std::string& filePath, const TIFFHeader& header,
+                        const TIFFStackRegion& region,
+                        const std::function<void(double)>& progress) {
+    const auto dims = region.dimensions();
+    const auto bytesPerVoxel = header.format->getSize();
+    auto* out = static_cast<unsigned char*>(dst);
+    if (glm::compMul(dims) == 0) {
+        if (progress) progress(1.0);
+        return;
+    }
+
+#ifdef cimg_use_tiff
+    if (hasVoxelLayout(openTIFF(filePath).get(), header)) {
+        // Each task decodes a contiguous run of pages with its own handle, since a handle can
+        // only be used by one thread and seeking to a page has to walk all previous directories.
+        const size_t jobs =
+            InviwoApplication::isInitialized() ? 4 * InviwoApplication::getPtr()->getPoolSize() : 1;
+        const size_t tasks = std::clamp<size_t>(jobs, 1, dims.z);
+        const size_t sliceBytes = dims.x * dims.y * bytesPerVoxel;
+        std::atomic<size_t> pagesDone{0};
+
+        util::cooperativeFor(tasks, [&](size_t task) {
+            const size_t first = task * dims.z / tasks;
+            const size_t last = (task + 1) * dims.z / tasks;
+            if (first == last) return;
+
+            auto tif = openTIFF(filePath);
+            if (!TIFFSetDirectory(tif.get(),
+                                  static_cast<tdir_t>(region.offset.z + first * region.stride.z))) {
+                throw DataReaderException("Missing pages in TIFF stack",
+                                          IVW_CONTEXT_CUSTOM("cimgutil::loadTIFFVolumeData"));
+            }
+            std::vector<unsigned char> buffer;
+            for (size_t z = first; z < last; ++z) {
+                for (size_t skip = 0; z != first && skip < region.stride.z; ++skip) {
+                    if (!TIFFReadDirectory(tif.get())) {
+                        throw DataReaderException(
+                            "Missing pages in TIFF stack",
+                            IVW_CONTEXT_CUSTOM("cimgutil::loadTIFFVolumeData"));
+                    }
+                }
+                decodePage(tif.get(), header, region, out + z * sliceBytes, buffer);
+                if (progress) progress(static_cast<double>(++pagesDone) / dims.z);
+            }
+        });
+        return;
+    }
+#endif
+
+    if (region.covers(header.dimensions)) {
+        loadTIFFVolumeData(dst, filePath, header);
+    } else {
+        std::vector<unsigned char> stack(glm::compMul(header.dimensions) * bytesPerVoxel);
+        loadTIFFVolumeData(stack.data(), filePath, header);
+        copyRegion(stack.data(), header.dimensions, out, region, bytesPerVoxel);
+    }
+    if (progress) progress(1.0);
+}
+
 }  // namespace cimgutil
 
 }  // namespace inviwo
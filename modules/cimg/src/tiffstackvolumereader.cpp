@@ -59,8 +59,10 @@ std::shared_ptr<Volume> TIFFStackVolumeReader::readData(const std::string& fileP
     }
 
     auto header = cimgutil::getTIFFHeader(filePath);
-    auto volume = std::make_shared<Volume>(header.dimensions, header.format);
-    auto volumeDisk = std::make_shared<VolumeDisk>(filePath, header.dimensions, header.format);
+    const auto region = region_.resolve(header.dimensions);
+    const auto dims = region.dimensions();
+    auto volume = std::make_shared<Volume>(dims, header.format);
+    auto volumeDisk = std::make_shared<VolumeDisk>(filePath, dims, header.format);
     volume->dataMap_.dataRange = dvec2{header.format->getLowest(), header.format->getMax()};
     volume->dataMap_.valueRange = dvec2{header.format->getLowest(), header.format->getMax()};
 
@@ -68,52 +70,85 @@ std::shared_ptr<Volume> TIFFStackVolumeReader::readData(const std::string& fileP
     if (header.resolutionUnit == cimgutil::TIFFResolutionUnit::Centimeter) {
         extent *= 2.54f;
     }
-    volume->setBasis(glm::scale(extent));
-    volume->setOffset(-extent * 0.5f);
+    // A region covers the same space as in the full stack
+    const vec3 voxelSize = extent / vec3{header.dimensions};
+    volume->setBasis(glm::scale(voxelSize * vec3{region.extent}));
+    volume->setOffset(-extent * 0.5f + voxelSize * vec3{region.offset});
 
-    volumeDisk->setLoader(new TIFFStackVolumeRAMLoader(filePath));
+    volumeDisk->setLoader(
+        new TIFFStackVolumeRAMLoader(filePath, header.dimensions, region, progress_));
     volume->addRepresentation(volumeDisk);
 
     return volume;
 }
 
+bool TIFFStackVolumeReader::setOption(std::string_view key, std::any value) {
+    if (key == "Progress") {
+        if (auto progress = std::any_cast<std::function<void(double)>>(&value)) {
+            progress_ = *progress;
+            return true;
+        }
+        return false;
+    }
+    auto size = std::any_cast<size3_t>(&value);
+    if (!size) return false;
+    if (key == "RegionOffset") {
+        region_.offset = *size;
+    } else if (key == "RegionExtent") {
+        region_.extent = *size;
+    } else if (key == "Subsample") {
+        region_.stride = *size;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+std::any TIFFStackVolumeReader::getOption(std::string_view key) {
+    if (key == "RegionOffset") {
+        return region_.offset;
+    } else if (key == "RegionExtent") {
+        return region_.extent;
+    } else if (key == "Subsample") {
+        return region_.stride;
+    } else if (key == "Progress") {
+        return progress_;
+    }
+    return std::any{};
+}
+
 TIFFStackVolumeRAMLoader::TIFFStackVolumeRAMLoader(const std::string& sourceFile)
     : sourceFile_{sourceFile} {}
 
+TIFFStackVolumeRAMLoader::TIFFStackVolumeRAMLoader(const std::string& sourceFile,
+                                                   const size3_t& stackDimensions,
+                                                   const cimgutil::TIFFStackRegion& region,
+                                                   std::function<void(double)> progress)
+    : sourceFile_{sourceFile}
+    , stackDimensions_{stackDimensions}
+    , region_{region}
+    , progress_{std::move(progress)} {}
+
 TIFFStackVolumeRAMLoader* TIFFStackVolumeRAMLoader::clone() const {
     return new TIFFStackVolumeRAMLoader(*this);
 }
 
 std::shared_ptr<VolumeRepresentation> TIFFStackVolumeRAMLoader::createRepresentation(
     const VolumeRepresentation& src) const {
-    std::string fileName = sourceFile_;
-
-    if (!filesystem::fileExists(fileName)) {
-        const auto newPath = filesystem::addBasePath(fileName);
-
-        if (filesystem::fileExists(newPath)) {
-            fileName = newPath;
-        } else {
-            throw TIFFStackVolumeReaderException("Error could not find input file: " + fileName,
-                                                 IVW_CONTEXT);
-        }
-    }
-    cimgutil::TIFFHeader header;
-    header.format = src.getDataFormat();
-    header.dimensions = src.getDimensions();
-    auto data = cimgutil::loadTIFFVolumeData(nullptr, fileName, header);
-
-    auto volumeRAM =
-        createVolumeRAM(src.getDimensions(), src.getDataFormat(), data, src.getSwizzleMask(),
-                        src.getInterpolation(), src.getWrapping());
-
+    auto volumeRAM = createVolumeRAM(src.getDimensions(), src.getDataFormat(), nullptr,
+                                     src.getSwizzleMask(), src.getInterpolation(),
+                                     src.getWrapping());
+    load(volumeRAM->getData(), src);
     return volumeRAM;
 }
 
 void TIFFStackVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentation> dest,
                                                     const VolumeRepresentation& src) const {
     auto volumeDst = std::static_pointer_cast<VolumeRAM>(dest);
+    load(volumeDst->getData(), src);
+}
 
+void TIFFStackVolumeRAMLoader::load(void* dst, const VolumeRepresentation& src) const {
     std::string fileName = sourceFile_;
     if (!filesystem::fileExists(fileName)) {
         const auto newPath = filesystem::addBasePath(fileName);
@@ -128,8 +163,9 @@ void TIFFStackVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepres
 
     cimgutil::TIFFHeader header;
     header.format = src.getDataFormat();
-    header.dimensions = src.getDimensions();
-    cimgutil::loadTIFFVolumeData(volumeDst->getData(), fileName, header);
+    header.dimensions = stackDimensions_.value_or(src.getDimensions());
+    const auto region = stackDimensions_ ? region_ : region_.resolve(header.dimensions);
+    cimgutil::loadTIFFVolumeData(dst, fileName, header, region, progress_);
 }
 
 }  // namespace inviwo
@@ -0,0 +1,223 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/io/tempfilehandle.h>
+#include <inviwo/core/util/settings/systemsettings.h>
+#include <modules/cimg/cimgutils.h>
+#include <modules/cimg/tiffstackvolumereader.h>
+
+#include <atomic>
+#include <fstream>
+
+namespace inviwo {
+
+namespace {
+
+std::uint8_t voxel(size_t column, size_t row, size_t page) {
+    return static_cast<std::uint8_t>(column + 7 * row + 31 * page);
+}
+
+void put16(std::string& data, std::uint16_t value) {
+    data.push_back(static_cast<char>(value & 0xff));
+    data.push_back(static_cast<char>(value >> 8));
+}
+void put32(std::string& data, std::uint32_t value) {
+    put16(data, static_cast<std::uint16_t>(value & 0xffff));
+    put16(data, static_cast<std::uint16_t>(value >> 16));
+}
+void set32(std::string& data, size_t pos, std::uint32_t value) {
+    std::string bytes;
+    put32(bytes, value);
+    data.replace(pos, bytes.size(), bytes);
+}
+void entry(std::string& data, std::uint16_t tag, std::uint16_t type, std::uint32_t count,
+           std::uint32_t value) {
+    put16(data, tag);
+    put16(data, type);
+    put32(data, count);
+    put32(data, value);
+}
+
+/**
+ * Write an uncompressed 8-bit grayscale multi page TIFF, where each page consists of several
+ * strips of \p rowsPerStrip rows
+ */
+void writeTIFFStack(const std::string& path, const size3_t& dims, size_t rowsPerStrip) {
+    constexpr std::uint16_t shortType = 3;
+    constexpr std::uint16_t longType = 4;
+
+    std::string data = "II";
+    put16(data, 42);
+    size_t link = data.size();  // Position of the offset to the next page
+    put32(data, 0);
+
+    const auto strips = (dims.y + rowsPerStrip - 1) / rowsPerStrip;
+    for (size_t page = 0; page < dims.z; ++page) {
+        const auto pixels = data.size();
+        for (size_t row = 0; row < dims.y; ++row) {
+            for (size_t column = 0; column < dims.x; ++column) {
+                data.push_back(static_cast<char>(voxel(column, row, page)));
+            }
+        }
+        const auto offsets = data.size();
+        for (size_t i = 0; i < strips; ++i) {
+            put32(data, static_cast<std::uint32_t>(pixels + i * rowsPerStrip * dims.x));
+        }
+        const auto counts = data.size();
+        for (size_t i = 0; i < strips; ++i) {
+            put32(data, static_cast<std::uint32_t>(
+                            std::min(rowsPerStrip, dims.y - i * rowsPerStrip) * dims.x));
+        }
+
+        set32(data, link, static_cast<std::uint32_t>(data.size()));
+        put16(data, 10);
+        entry(data, 256, longType, 1, static_cast<std::uint32_t>(dims.x));
+        entry(data, 257, longType, 1, static_cast<std::uint32_t>(dims.y));
+        entry(data, 258, shortType, 1, 8);  // Bits per sample
+        entry(data, 259, shortType, 1, 1);  // No compression
+        entry(data, 262, shortType, 1, 1);  // Black is zero
+        entry(data, 273, longType, static_cast<std::uint32_t>(strips),
+              static_cast<std::uint32_t>(strips == 1 ? pixels : offsets));
+        entry(data, 277, shortType, 1, 1);  // Samples per pixel
+        entry(data, 278, longType, 1, static_cast<std::uint32_t>(rowsPerStrip));
+        entry(data, 279, longType, static_cast<std::uint32_t>(strips),
+              static_cast<std::uint32_t>(strips == 1 ? dims.x * dims.y : counts));
+        entry(data, 284, shortType, 1, 1);  // Contiguous planar configuration
+        link = data.size();
+        put32(data, 0);
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(data.data(), data.size());
+}
+
+// The voxels the region should result in, the y axis of the volume points upwards
+std::vector<std::uint8_t> expected(const size3_t& stack, const cimgutil::TIFFStackRegion& region) {
+    const auto dims = region.dimensions();
+    std::vector<std::uint8_t> res;
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const auto pos = region.offset + size3_t{x, y, z} * region.stride;
+                res.push_back(voxel(pos.x, stack.y - 1 - pos.y, pos.z));
+            }
+        }
+    }
+    return res;
+}
+
+class TIFFStackTest : public ::testing::Test {
+protected:
+    TIFFStackTest()
+        : settings_{InviwoApplication::getPtr()->getSystemSettings()}
+        , poolSize_{settings_.poolSize_.get()}
+        , file_{"tiffstack", ".tif"} {
+        writeTIFFStack(file_.getFileName(), stack_, 3);
+    }
+    virtual ~TIFFStackTest() { settings_.poolSize_.set(poolSize_); }
+
+    std::vector<std::uint8_t> load(const cimgutil::TIFFStackRegion& region) {
+        const auto header = cimgutil::getTIFFHeader(file_.getFileName());
+        std::vector<std::uint8_t> res(glm::compMul(region.dimensions()));
+        std::atomic<size_t> calls{0};
+        cimgutil::loadTIFFVolumeData(res.data(), file_.getFileName(), header, region,
+                                     [&](double) { ++calls; });
+        EXPECT_EQ(calls.load(), std::max<size_t>(region.dimensions().z, 1));
+        return res;
+    }
+
+    SystemSettings& settings_;
+    size_t poolSize_;
+    const size3_t stack_{9, 8, 13};
+    util::TempFileHandle file_;
+};
+
+}  // namespace
+
+TEST_F(TIFFStackTest, Header) {
+    const auto header = cimgutil::getTIFFHeader(file_.getFileName());
+    EXPECT_EQ(header.dimensions, stack_);
+    EXPECT_EQ(header.format, DataUInt8::get());
+}
+
+TEST_F(TIFFStackTest, Parallel) {
+    const auto region = cimgutil::TIFFStackRegion{}.resolve(stack_);
+    settings_.poolSize_.set(0);
+    const auto serial = load(region);
+    EXPECT_EQ(serial, expected(stack_, region));
+
+    // More tasks than pages, and uneven runs of pages per task
+    for (size_t poolSize : {1, 3, 4}) {
+        settings_.poolSize_.set(poolSize);
+        EXPECT_EQ(load(region), serial) << "pool size " << poolSize;
+    }
+}
+
+TEST_F(TIFFStackTest, Region) {
+    settings_.poolSize_.set(2);
+
+    cimgutil::TIFFStackRegion region;
+    region.offset = size3_t{1, 2, 3};
+    region.extent = size3_t{7, 5, 0};
+    region.stride = size3_t{2, 2, 3};
+    region = region.resolve(stack_);
+    EXPECT_EQ(region.dimensions(), size3_t(4, 3, 4));
+    EXPECT_EQ(load(region), expected(stack_, region));
+}
+
+TEST_F(TIFFStackTest, Empty) {
+    // An empty stack results in an empty region, nothing should be loaded
+    const auto region = cimgutil::TIFFStackRegion{}.resolve(size3_t{9, 8, 0});
+    EXPECT_EQ(region.dimensions().z, 0);
+    const auto header = cimgutil::getTIFFHeader(file_.getFileName());
+    EXPECT_NO_THROW(cimgutil::loadTIFFVolumeData(nullptr, file_.getFileName(), header, region));
+}
+
+TEST_F(TIFFStackTest, Reader) {
+    settings_.poolSize_.set(2);
+
+    TIFFStackVolumeReader reader;
+    auto volume = reader.readData(file_.getFileName());
+    ASSERT_TRUE(volume);
+    EXPECT_EQ(volume->getDimensions(), stack_);
+
+    const auto ram = volume->getRepresentation<VolumeRAM>();
+    const auto data = static_cast<const std::uint8_t*>(ram->getData());
+    EXPECT_EQ(std::vector<std::uint8_t>(data, data + glm::compMul(stack_)),
+              expected(stack_, cimgutil::TIFFStackRegion{}.resolve(stack_)));
+}
+
+}  // namespace inviwo
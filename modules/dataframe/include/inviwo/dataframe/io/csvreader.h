@@ -95,6 +95,17 @@ public:
      */
     virtual std::shared_ptr<DataFrame> readData(const std::string& fileName) override;
 
+    /**
+     * read a CSV file from a file in a background job. The parsing reports its progress and
+     * returns nullptr early if \p stop is set.
+     *
+     * @see readData(const std::string&)
+     */
+    virtual std::shared_ptr<DataFrame> readData(const std::string& fileName,
+                                                MetaDataOwner* metaDataOwner,
+                                                const pool::Stop& stop,
+                                                const pool::Progress& progress) override;
+
     /**
      * read a CSV file from a input stream, e.g. a std::ifstream. In case
      * file streams are used, the file must have be opened prior calling this function.
@@ -112,6 +123,11 @@ public:
     virtual std::any getOption(std::string_view key) override;
 
 private:
+    std::shared_ptr<DataFrame> readFile(const std::string& fileName, const pool::Stop* stop,
+                                        const pool::Progress* progress) const;
+    std::shared_ptr<DataFrame> readStream(std::istream& stream, const pool::Stop* stop,
+                                          const pool::Progress* progress) const;
+
     std::string delimiters_;
     bool firstRowHeader_;
     bool doublePrecision_;
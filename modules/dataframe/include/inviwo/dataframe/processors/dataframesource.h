@@ -57,7 +57,13 @@ public:
     virtual const ProcessorInfo getProcessorInfo() const override;
     static const ProcessorInfo processorInfo_;
 
+protected:
+    virtual void dataLoaded(std::shared_ptr<DataFrame> data) override;
+    virtual void dataDeserialized(std::shared_ptr<DataFrame> data) override;
+
 private:
+    void updateColumns(DataFrame& dataFrame);
+
     ColumnMetaDataListProperty columns_;
 };
 
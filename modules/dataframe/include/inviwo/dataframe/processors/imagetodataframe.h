@@ -58,6 +58,11 @@ namespace inviwo {
  *   * __Layer__ The image layer to use
  *   * __Color Index__ The color layer index
  *   * __Range__ range of rows/columns to use.
+ *   * __Sampling__ In Analytics mode, use all pixels, every n:th pixel along each axis (Strided),
+ *                  or a random subset of the pixels (Random).
+ *   * __Stride__ step between sampled pixels along each axis in strided sampling.
+ *   * __Sample Count__ number of pixels drawn in random sampling.
+ *   * __Seed__ seed for random sampling.
  */
 
 class IVW_MODULE_DATAFRAME_API ImageToDataFrame : public Processor {
@@ -72,6 +77,7 @@ public:
 
 private:
     enum class Mode { Analytics, Rows, Columns };
+    enum class Sampling { All, Strided, Random };
 
     ImageInport inport_;
     DataOutport<DataFrame> outport_;
@@ -80,6 +86,11 @@ private:
     IntSizeTProperty layerIndex_;
 
     IntSizeTMinMaxProperty range_;
+
+    TemplateOptionProperty<Sampling> sampling_;
+    IntSize2Property stride_;
+    IntSizeTProperty sampleCount_;
+    IntProperty seed_;
 };
 
 }  // namespace inviwo
@@ -61,6 +61,11 @@ namespace inviwo {
  *   * __X Range__ x range of voxels to use.
  *   * __Y Range__ y range of voxels to use.
  *   * __Z Range__ z range of voxels to use.
+ *   * __Sampling__ In Analytics mode, use all voxels in the range, every n:th voxel along each
+ *              axis (Strided), or a random subset of the voxels (Random).
+ *   * __Stride__ step between sampled voxels along each axis in strided sampling.
+ *   * __Sample Count__ number of voxels drawn in random sampling.
+ *   * __Seed__ seed for random sampling.
  */
 class IVW_MODULE_DATAFRAME_API VolumeToDataFrame : public Processor {
 public:
@@ -74,6 +79,7 @@ public:
 
 private:
     enum class Mode { Analytics, XDir, YDir, ZDir };
+    enum class Sampling { All, Strided, Random };
 
     DataInport<Volume> inport_;
     DataOutport<DataFrame> outport_;
@@ -82,6 +88,11 @@ private:
     IntSizeTMinMaxProperty rangeX_;
     IntSizeTMinMaxProperty rangeY_;
     IntSizeTMinMaxProperty rangeZ_;
+
+    TemplateOptionProperty<Sampling> sampling_;
+    IntSize3Property stride_;
+    IntSizeTProperty sampleCount_;
+    IntProperty seed_;
 };
 
 }  // namespace inviwo
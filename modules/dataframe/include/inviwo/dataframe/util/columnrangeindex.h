@@ -0,0 +1,117 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/dataframe/dataframemoduledefine.h>
+#include <inviwo/core/datastructures/bitset.h>
+#include <inviwo/core/util/glm.h>
+
+#include <vector>
+#include <cstdint>
+
+namespace inviwo {
+
+class Column;
+class IndexColumn;
+
+/**
+ * \brief Sorted index over the values of a Column for fast range queries, i.e. brushing.
+ *
+ * The values are sorted once when the index is built. A range query then finds the first and last
+ * matching value with binary searches and only has to collect the ids in between. To avoid adding
+ * those ids one at a time, the sorted ids are split into buckets of consecutive values, each with
+ * a precomputed BitSet. Buckets that are fully covered by the range are combined with a single
+ * bitset union and only the two partially covered buckets are added element wise. Results of
+ * queries on different columns can be combined with bitset operations, e.g. `&` for brushes on
+ * several axes.
+ *
+ * Missing values (NaN) are never part of any range.
+ */
+class IVW_MODULE_DATAFRAME_API ColumnRangeIndex {
+public:
+    static constexpr size_t defaultBucketSize = 1 << 14;
+
+    ColumnRangeIndex() = default;
+    /**
+     * Build an index for \p column.
+     * @param column the column to index
+     * @param ids the id of each row in the results, usually the index column of the DataFrame.
+     *      If nullptr, the row numbers are used.
+     * @param bucketSize number of sorted values per precomputed bitset
+     */
+    explicit ColumnRangeIndex(const Column& column, const IndexColumn* ids = nullptr,
+                              size_t bucketSize = defaultBucketSize);
+
+    /**
+     * Ids of all rows with values in the closed range [range.x, range.y]
+     */
+    BitSet inside(dvec2 range) const;
+    /**
+     * Ids of all rows with values outside of the closed range [range.x, range.y], excluding
+     * missing values.
+     */
+    BitSet outside(dvec2 range) const;
+
+    /**
+     * Number of values less than \p value
+     */
+    size_t countBelow(double value) const;
+    /**
+     * Number of values greater than \p value
+     */
+    size_t countAbove(double value) const;
+
+    /**
+     * Number of rows with a value, i.e. not missing
+     */
+    size_t size() const;
+    bool empty() const;
+
+    /**
+     * Ids of all rows with a value
+     */
+    const BitSet& getValid() const;
+    /**
+     * Ids of all rows with missing values
+     */
+    const BitSet& getMissing() const;
+
+private:
+    BitSet rankRange(size_t first, size_t last) const;
+
+    size_t bucketSize_ = defaultBucketSize;
+    std::vector<double> values_;      //! Sorted values
+    std::vector<std::uint32_t> ids_;  //! Ids in the order of values_
+    std::vector<BitSet> buckets_;     //! Ids of each bucket of bucketSize_ sorted values
+    BitSet valid_;
+    BitSet missing_;
+};
+
+}  // namespace inviwo
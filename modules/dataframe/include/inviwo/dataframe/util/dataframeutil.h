@@ -151,6 +151,17 @@ std::vector<size_t> filteredRows(std::shared_ptr<const Column> col, Pred pred);
 
 IVW_MODULE_DATAFRAME_API std::string createToolTipForRow(const DataFrame& dataframe, size_t rowId);
 
+/**
+ * \brief draw \p count distinct indices from [0, \p total) uniformly at random
+ *
+ * @param total  number of elements to sample from
+ * @param count  number of samples, all indices are returned if \p count >= \p total
+ * @param seed   seed of the random number generator
+ * @return the sampled indices in ascending order
+ */
+IVW_MODULE_DATAFRAME_API std::vector<size_t> randomSubset(size_t total, size_t count,
+                                                          std::uint32_t seed);
+
 #include <warn/push>
 #include <warn/ignore/conversion>
 template <typename Pred>
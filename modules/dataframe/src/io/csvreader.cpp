@@ -33,6 +33,7 @@
 #include <inviwo/dataframe/datastructures/dataframe.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/processors/poolprocessor.h>
 
 #include <fstream>
 #include <algorithm>
@@ -65,6 +66,17 @@ void CSVReader::setEnableDoublePrecision(bool doubleprec) { doublePrecision_ = d
 bool CSVReader::hasDoublePrecision() const { return doublePrecision_; }
 
 std::shared_ptr<DataFrame> CSVReader::readData(const std::string& fileName) {
+    return readFile(fileName, nullptr, nullptr);
+}
+
+std::shared_ptr<DataFrame> CSVReader::readData(const std::string& fileName, MetaDataOwner*,
+                                               const pool::Stop& stop,
+                                               const pool::Progress& progress) {
+    return readFile(fileName, &stop, &progress);
+}
+
+std::shared_ptr<DataFrame> CSVReader::readFile(const std::string& fileName, const pool::Stop* stop,
+                                               const pool::Progress* progress) const {
     auto file = filesystem::ifstream(fileName);
 
     if (!file.is_open()) {
@@ -79,7 +91,7 @@ std::shared_ptr<DataFrame> CSVReader::readData(const std::string& fileName) {
         throw CSVDataReaderException("Empty file, no data", IVW_CONTEXT);
     }
 
-    return readData(file);
+    return readStream(file, stop, progress);
 }
 
 bool CSVReader::setOption(std::string_view key, std::any value) {
@@ -126,6 +138,11 @@ bool isLineBreak(const char ch, std::istream& stream) {
 }  // namespace detail
 
 std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
+    return readStream(stream, nullptr, nullptr);
+}
+
+std::shared_ptr<DataFrame> CSVReader::readStream(std::istream& stream, const pool::Stop* stop,
+                                                 const pool::Progress* progress) const {
     // Skip BOM if it exists. Added by for example Excel when saving csv files.
     filesystem::skipByteOrderMark(stream);
 
@@ -139,6 +156,9 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
     if (in.fail()) {
         throw CSVDataReaderException("No data", IVW_CONTEXT);
     }
+    in.seekg(0, std::ios::end);
+    const auto totalSize = static_cast<size_t>(std::streamoff(in.tellg()));
+    in.seekg(0, std::ios::beg);
 
     // current line
     size_t lineNumber = 1u;
@@ -286,6 +306,13 @@ std::shared_ptr<DataFrame> CSVReader::readData(std::istream& stream) const {
         }
         row = extractRow(maxColCount);
         ++rowIndex;
+
+        if ((rowIndex % 4096) == 0) {
+            if (stop && *stop) return nullptr;
+            if (progress && in.good()) {
+                (*progress)(static_cast<size_t>(std::streamoff(in.tellg())), totalSize);
+            }
+        }
     }
     dataFrame->updateIndexBuffer();
     return dataFrame;
@@ -52,8 +52,17 @@ DataFrameSource::DataFrameSource(InviwoApplication* app, const std::string& file
 void DataFrameSource::process() {
     DataSource<DataFrame, DataFrameOutport>::process();
 
-    columns_.updateColumnProperties(*loadedData_);
-    for (auto&& [index, col] : util::enumerate(*loadedData_)) {
+    // The data is loaded in a background job, newly loaded data is handled in dataLoaded
+    if (loadedData_) updateColumns(*loadedData_);
+}
+
+void DataFrameSource::dataLoaded(std::shared_ptr<DataFrame> data) { updateColumns(*data); }
+
+void DataFrameSource::dataDeserialized(std::shared_ptr<DataFrame> data) { updateColumns(*data); }
+
+void DataFrameSource::updateColumns(DataFrame& dataFrame) {
+    columns_.updateColumnProperties(dataFrame);
+    for (auto&& [index, col] : util::enumerate(dataFrame)) {
         col->copyMetaDataFrom(columns_.getColumnMetaData(index));
     }
 }
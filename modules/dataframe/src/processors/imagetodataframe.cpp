@@ -37,9 +37,26 @@
 #include <inviwo/core/util/imageramutils.h>
 #include <inviwo/core/util/indexmapper.h>
 #include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/threadutil.h>
+#include <inviwo/dataframe/util/dataframeutil.h>
 
 namespace inviwo {
 
+namespace {
+
+// Number of rows filled by each task
+constexpr size_t slabSize = size_t{1} << 16;
+
+template <typename T>
+std::vector<T>& addColumn(DataFrame& dataFrame, std::string_view header, size_t size) {
+    return dataFrame.addColumn<T>(header, size)
+        ->getTypedBuffer()
+        ->getEditableRAMRepresentation()
+        ->getDataContainer();
+}
+
+}  // namespace
+
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
 const ProcessorInfo ImageToDataFrame::processorInfo_{
     "org.inviwo.ImageToDataFrame",  // Class identifier
@@ -67,7 +84,16 @@ ImageToDataFrame::ImageToDataFrame()
               {"picking", "Picking", LayerType::Picking}},
              0}
     , layerIndex_{"colorIndex", "Color Index", 0, 0, 0, 1}
-    , range_{"range", "Range", 0, 1, 0, 1, 1, 1} {
+    , range_{"range", "Range", 0, 1, 0, 1, 1, 1}
+    , sampling_{"sampling",
+                "Sampling",
+                {{"all", "All", Sampling::All},
+                 {"strided", "Strided", Sampling::Strided},
+                 {"random", "Random", Sampling::Random}},
+                0}
+    , stride_{"stride", "Stride", size2_t{2}, size2_t{1}, size2_t{64}}
+    , sampleCount_{"sampleCount", "Sample Count", 100000, 1, 10000000}
+    , seed_{"seed", "Seed", 1, 0, 1000} {
 
     addPort(inport_);
     addPort(outport_);
@@ -76,6 +102,14 @@ ImageToDataFrame::ImageToDataFrame()
     addProperty(layer_);
     addProperty(layerIndex_);
     addProperty(range_);
+    addProperties(sampling_, stride_, sampleCount_, seed_);
+
+    sampling_.visibilityDependsOn(mode_, [](const auto& p) { return p.get() == Mode::Analytics; });
+    stride_.visibilityDependsOn(sampling_,
+                                [](const auto& p) { return p.get() == Sampling::Strided; });
+    sampleCount_.visibilityDependsOn(sampling_,
+                                     [](const auto& p) { return p.get() == Sampling::Random; });
+    seed_.visibilityDependsOn(sampling_, [](const auto& p) { return p.get() == Sampling::Random; });
 
     auto updateRange = [this]() {
         if (inport_.hasData()) {
@@ -107,55 +141,41 @@ void ImageToDataFrame::process() {
 
     switch (mode_.get()) {
         case Mode::Analytics: {
+            const size2_t stride = sampling_ == Sampling::Strided ? stride_.get() : size2_t{1};
+            const size2_t counts = (dims + stride - size2_t{1}) / stride;
+            const auto random = sampling_ == Sampling::Random;
+            const auto subset =
+                random ? dataframe::randomSubset(glm::compMul(counts), sampleCount_.get(),
+                                                 static_cast<std::uint32_t>(seed_.get()))
+                       : std::vector<size_t>{};
+            const auto size = random ? subset.size() : glm::compMul(counts);
 
-            auto size = dims.x * dims.y;
             auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(size));
 
-            std::vector<std::vector<float>*> channelBuffer_;
+            std::vector<float*> channels;
             auto numCh = layer->getDataFormat()->getComponents();
             for (size_t c = 0; c < numCh; c++) {
-                auto col = dataFrame->addColumn<float>("Channel " + toString(c + 1), size);
-                channelBuffer_.push_back(
-                    &col->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer());
+                channels.push_back(
+                    addColumn<float>(*dataFrame, "Channel " + toString(c + 1), size).data());
             }
 
-            auto& magnitudes = dataFrame->addColumn<float>("Magnitude", size)
-                                   ->getTypedBuffer()
-                                   ->getEditableRAMRepresentation()
-                                   ->getDataContainer();
+            auto magnitudes = addColumn<float>(*dataFrame, "Magnitude", size).data();
 
-            std::vector<float>* grayscalePerceived = nullptr;
-            std::vector<float>* grayscaleRelative = nullptr;
-            std::vector<float>* averageRGB = nullptr;
+            float* grayscalePerceived = nullptr;
+            float* grayscaleRelative = nullptr;
+            float* averageRGB = nullptr;
             if (numCh >= 3) {
                 grayscalePerceived =
-                    &dataFrame->addColumn<float>("Luminance (perceived) (from RGB)", size)
-                         ->getTypedBuffer()
-                         ->getEditableRAMRepresentation()
-                         ->getDataContainer();
+                    addColumn<float>(*dataFrame, "Luminance (perceived) (from RGB)", size).data();
                 grayscaleRelative =
-                    &dataFrame->addColumn<float>("Luminance (relative) (from RGB)", size)
-                         ->getTypedBuffer()
-                         ->getEditableRAMRepresentation()
-                         ->getDataContainer();
-                averageRGB = &dataFrame->addColumn<float>("Luminance (average) (from RGB)", size)
-                                  ->getTypedBuffer()
-                                  ->getEditableRAMRepresentation()
-                                  ->getDataContainer();
+                    addColumn<float>(*dataFrame, "Luminance (relative) (from RGB)", size).data();
+                averageRGB =
+                    addColumn<float>(*dataFrame, "Luminance (average) (from RGB)", size).data();
             }
 
-            auto& averageAll = dataFrame->addColumn<float>("Average (all channels)", size)
-                                   ->getTypedBuffer()
-                                   ->getEditableRAMRepresentation()
-                                   ->getDataContainer();
-            auto& row = dataFrame->addColumn<int>("Row", size)
-                            ->getTypedBuffer()
-                            ->getEditableRAMRepresentation()
-                            ->getDataContainer();
-            auto& col = dataFrame->addColumn<int>("Column", size)
-                            ->getTypedBuffer()
-                            ->getEditableRAMRepresentation()
-                            ->getDataContainer();
+            auto averageAll = addColumn<float>(*dataFrame, "Average (all channels)", size).data();
+            auto row = addColumn<int>(*dataFrame, "Row", size).data();
+            auto col = addColumn<int>(*dataFrame, "Column", size).data();
 
             // Values copied from imagegrayscale.cpp
             static const vec3 perceivedLum(0.299f, 0.587f, 0.114f);
@@ -164,38 +184,41 @@ void ImageToDataFrame::process() {
 
             layer->dispatch<void>([&](const auto lr) {
                 using ValueType = util::PrecisionValueType<decltype(lr)>;
+                constexpr auto comp = DataFormat<ValueType>::comp;
                 const auto im = util::IndexMapper2D(dims);
+                const auto grid = util::IndexMapper2D(counts);
                 const auto data = lr->getDataTyped();
 
-                size2_t pos;
-                for (pos.y = 0; pos.y < dims.y; pos.y++) {
-                    for (pos.x = 0; pos.x < dims.x; pos.x++) {
-                        const auto idx = im(pos);
-                        const auto v = util::glm_convert<dvec4>(data[idx]);
+                // Fill the presized columns in parallel slabs of rows, reading the pixels in
+                // memory order directly from the typed data.
+                util::cooperativeFor((size + slabSize - 1) / slabSize, [&](size_t slab) {
+                    const auto slabEnd = std::min(size, (slab + 1) * slabSize);
+                    for (size_t i = slab * slabSize; i < slabEnd; ++i) {
+                        const size2_t pos = grid(random ? subset[i] : i) * stride;
+                        const auto& v = data[im(pos)];
 
+                        vec3 rgb{0.0f};
                         double m = 0.0;
                         double sum = 0.0;
-                        for (size_t c = 0; c < DataFormat<ValueType>::comp; c++) {
-                            (*channelBuffer_[c])[idx] = static_cast<float>(v[c]);
-                            m += v[c] * v[c];
-                            sum += v[c];
+                        for (size_t c = 0; c < comp; c++) {
+                            const auto vc = static_cast<double>(util::glmcomp(v, c));
+                            channels[c][i] = static_cast<float>(vc);
+                            if (c < 3) rgb[c] = static_cast<float>(vc);
+                            m += vc * vc;
+                            sum += vc;
                         }
                         if (grayscalePerceived) {
-                            (*grayscalePerceived)[idx] = glm::dot(perceivedLum, vec3(v));
-                        }
-                        if (grayscaleRelative) {
-                            (*grayscaleRelative)[idx] = glm::dot(relativeLum, vec3(v));
-                        }
-                        if (averageRGB) {
-                            (*averageRGB)[idx] = glm::dot(avgLum, vec3(v));
+                            grayscalePerceived[i] = glm::dot(perceivedLum, rgb);
+                            grayscaleRelative[i] = glm::dot(relativeLum, rgb);
+                            averageRGB[i] = glm::dot(avgLum, rgb);
                         }
 
-                        magnitudes[idx] = static_cast<float>(std::sqrt(m));
-                        averageAll[idx] = static_cast<float>(sum / DataFormat<ValueType>::comp);
-                        row[idx] = static_cast<int>(pos.y);
-                        col[idx] = static_cast<int>(pos.x);
+                        magnitudes[i] = static_cast<float>(std::sqrt(m));
+                        averageAll[i] = static_cast<float>(sum / comp);
+                        row[i] = static_cast<int>(pos.y);
+                        col[i] = static_cast<int>(pos.x);
                     }
-                }
+                });
             });
 
             outport_.setData(dataFrame);
@@ -205,18 +228,16 @@ void ImageToDataFrame::process() {
             auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(dims.x));
             layer->dispatch<void>([&](const auto lr) {
                 using ValueType = util::PrecisionValueType<decltype(lr)>;
-                const auto im = util::IndexMapper2D(dims);
                 const auto data = lr->getDataTyped();
+                std::vector<ValueType*> rows;
                 for (size_t j = range_.getStart(); j < range_.getEnd(); ++j) {
-                    auto& row = dataFrame->addColumn<ValueType>(toString(j), dims.x)
-                                    ->getTypedBuffer()
-                                    ->getEditableRAMRepresentation()
-                                    ->getDataContainer();
-
-                    for (size_t i = 0; i < dims.x; ++i) {
-                        row[i] = data[im(i, j)];
-                    }
+                    rows.push_back(addColumn<ValueType>(*dataFrame, toString(j), dims.x).data());
                 }
+                // Rows are contiguous in the layer
+                util::cooperativeFor(rows.size(), [&](size_t r) {
+                    const auto src = data + (range_.getStart() + r) * dims.x;
+                    std::copy(src, src + dims.x, rows[r]);
+                });
             });
 
             outport_.setData(dataFrame);
@@ -228,16 +249,16 @@ void ImageToDataFrame::process() {
                 using ValueType = util::PrecisionValueType<decltype(lr)>;
                 const auto im = util::IndexMapper2D(dims);
                 const auto data = lr->getDataTyped();
+                std::vector<ValueType*> cols;
                 for (size_t i = range_.getStart(); i < range_.getEnd(); ++i) {
-                    auto& col = dataFrame->addColumn<ValueType>(toString(i), dims.y)
-                                    ->getTypedBuffer()
-                                    ->getEditableRAMRepresentation()
-                                    ->getDataContainer();
-
-                    for (size_t j = 0; j < dims.y; ++i) {
-                        col[j] = data[im(i, j)];
-                    }
+                    cols.push_back(addColumn<ValueType>(*dataFrame, toString(i), dims.y).data());
                 }
+                util::cooperativeFor(cols.size(), [&](size_t c) {
+                    const auto i = range_.getStart() + c;
+                    for (size_t j = 0; j < dims.y; ++j) {
+                        cols[c][j] = data[im(i, j)];
+                    }
+                });
             });
             outport_.setData(dataFrame);
             break;
@@ -28,12 +28,31 @@
  *********************************************************************************/
 
 #include <inviwo/dataframe/processors/volumetodataframe.h>
+#include <inviwo/dataframe/util/dataframeutil.h>
 #include <inviwo/core/datastructures/volume/volumeram.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/threadutil.h>
+
+#include <fmt/format.h>
 
 namespace inviwo {
 
+namespace {
+
+// Number of rows filled by each task
+constexpr size_t slabSize = size_t{1} << 16;
+
+template <typename T>
+std::vector<T>& addColumn(DataFrame& dataFrame, std::string_view header, size_t size) {
+    return dataFrame.addColumn<T>(header, size)
+        ->getTypedBuffer()
+        ->getEditableRAMRepresentation()
+        ->getDataContainer();
+}
+
+}  // namespace
+
 // The Class Identifier has to be globally unique. Use a reverse DNS naming scheme
 const ProcessorInfo VolumeToDataFrame::processorInfo_{
     "org.inviwo.VolumeToDataFrame",  // Class identifier
@@ -58,7 +77,16 @@ VolumeToDataFrame::VolumeToDataFrame()
             0}
     , rangeX_{"xrange", "X Range", 0, 1, 0, 1, 1, 1}
     , rangeY_{"yrange", "Y Range", 0, 1, 0, 1, 1, 1}
-    , rangeZ_{"zrange", "Z Range", 0, 1, 0, 1, 1, 1} {
+    , rangeZ_{"zrange", "Z Range", 0, 1, 0, 1, 1, 1}
+    , sampling_{"sampling",
+                "Sampling",
+                {{"all", "All", Sampling::All},
+                 {"strided", "Strided", Sampling::Strided},
+                 {"random", "Random", Sampling::Random}},
+                0}
+    , stride_{"stride", "Stride", size3_t{2}, size3_t{1}, size3_t{64}}
+    , sampleCount_{"sampleCount", "Sample Count", 100000, 1, 10000000}
+    , seed_{"seed", "Seed", 1, 0, 1000} {
 
     addPort(inport_);
     addPort(outport_);
@@ -66,6 +94,14 @@ VolumeToDataFrame::VolumeToDataFrame()
     addProperty(rangeX_);
     addProperty(rangeY_);
     addProperty(rangeZ_);
+    addProperties(sampling_, stride_, sampleCount_, seed_);
+
+    sampling_.visibilityDependsOn(mode_, [](const auto& p) { return p.get() == Mode::Analytics; });
+    stride_.visibilityDependsOn(sampling_,
+                                [](const auto& p) { return p.get() == Sampling::Strided; });
+    sampleCount_.visibilityDependsOn(sampling_,
+                                     [](const auto& p) { return p.get() == Sampling::Random; });
+    seed_.visibilityDependsOn(sampling_, [](const auto& p) { return p.get() == Sampling::Random; });
 
     inport_.onChange([this]() {
         if (inport_.hasData()) {
@@ -79,165 +115,109 @@ VolumeToDataFrame::VolumeToDataFrame()
 
 void VolumeToDataFrame::process() {
     const auto volume = inport_.getData();
+    const size3_t start{rangeX_.getStart(), rangeY_.getStart(), rangeZ_.getStart()};
+    const size3_t end{rangeX_.getEnd(), rangeY_.getEnd(), rangeZ_.getEnd()};
+
     switch (mode_.get()) {
         case Mode::Analytics: {
-            const auto size = (rangeX_.getEnd() - rangeX_.getStart()) *
-                              (rangeY_.getEnd() - rangeY_.getStart()) *
-                              (rangeZ_.getEnd() - rangeZ_.getStart());
+            const size3_t stride = sampling_ == Sampling::Strided ? stride_.get() : size3_t{1};
+            const size3_t counts = (end - start + stride - size3_t{1}) / stride;
+            const auto random = sampling_ == Sampling::Random;
+            const auto subset =
+                random ? dataframe::randomSubset(glm::compMul(counts), sampleCount_.get(),
+                                                 static_cast<std::uint32_t>(seed_.get()))
+                       : std::vector<size_t>{};
+            const auto size = random ? subset.size() : glm::compMul(counts);
 
             auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(size));
-            std::vector<std::vector<float>*> channelBuffer_;
+            std::vector<float*> channels;
             const auto numCh = volume->getDataFormat()->getComponents();
             for (size_t c = 0; c < numCh; c++) {
-                auto col = dataFrame->addColumn<float>("Channel " + toString(c + 1), size);
-                channelBuffer_.push_back(
-                    &col->getTypedBuffer()->getEditableRAMRepresentation()->getDataContainer());
+                channels.push_back(
+                    addColumn<float>(*dataFrame, "Channel " + toString(c + 1), size).data());
             }
-            auto& magnitudes = dataFrame->addColumn<float>("Magnitude", size)
-                                   ->getTypedBuffer()
-                                   ->getEditableRAMRepresentation()
-                                   ->getDataContainer();
-            auto& indx = dataFrame->addColumn<int>("Index X", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& indy = dataFrame->addColumn<int>("Index Y", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& indz = dataFrame->addColumn<int>("Index Z", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& posx = dataFrame->addColumn<float>("Position X", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& posy = dataFrame->addColumn<float>("Position Y", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
-            auto& posz = dataFrame->addColumn<float>("Position Z", size)
-                             ->getTypedBuffer()
-                             ->getEditableRAMRepresentation()
-                             ->getDataContainer();
+            auto magnitudes = addColumn<float>(*dataFrame, "Magnitude", size).data();
+            auto indx = addColumn<int>(*dataFrame, "Index X", size).data();
+            auto indy = addColumn<int>(*dataFrame, "Index Y", size).data();
+            auto indz = addColumn<int>(*dataFrame, "Index Z", size).data();
+            auto posx = addColumn<float>(*dataFrame, "Position X", size).data();
+            auto posy = addColumn<float>(*dataFrame, "Position Y", size).data();
+            auto posz = addColumn<float>(*dataFrame, "Position Z", size).data();
 
             const auto indexToModel = volume->getCoordinateTransformer().getIndexToModelMatrix();
 
             volume->getRepresentation<VolumeRAM>()->dispatch<void>([&](auto vr) {
-                const auto im = util::IndexMapper3D(vr->getDimensions());
                 using ValueType = util::PrecisionValueType<decltype(vr)>;
+                const auto im = util::IndexMapper3D(vr->getDimensions());
+                const auto grid = util::IndexMapper3D(counts);
                 const auto data = vr->getDataTyped();
-                auto i = 0;
-                size3_t ind;
-                for (ind.z = rangeZ_.getStart(); ind.z < rangeZ_.getEnd(); ind.z++) {
-                    for (ind.y = rangeY_.getStart(); ind.y < rangeY_.getEnd(); ind.y++) {
-                        for (ind.x = rangeX_.getStart(); ind.x < rangeX_.getEnd(); ind.x++) {
-                            const auto v = util::glm_convert<dvec4>(data[im(ind)]);
-                            double m = 0.0;
-                            for (size_t c = 0; c < DataFormat<ValueType>::comp; c++) {
-                                (*channelBuffer_[c])[i] = static_cast<float>(v[c]);
-                                m += v[c] * v[c];
-                            }
-                            magnitudes[i] = static_cast<float>(std::sqrt(m));
-
-                            indx[i] = static_cast<int>(ind.x);
-                            indy[i] = static_cast<int>(ind.y);
-                            indz[i] = static_cast<int>(ind.z);
-
-                            const dvec3 pos{indexToModel * dvec4{ind, 1}};
-
-                            posx[i] = static_cast<float>(pos.x);
-                            posy[i] = static_cast<float>(pos.y);
-                            posz[i] = static_cast<float>(pos.z);
-                            ++i;
+
+                // Fill the presized columns in parallel slabs of rows, reading the voxels in
+                // memory order directly from the typed data.
+                util::cooperativeFor((size + slabSize - 1) / slabSize, [&](size_t slab) {
+                    const auto slabEnd = std::min(size, (slab + 1) * slabSize);
+                    for (size_t i = slab * slabSize; i < slabEnd; ++i) {
+                        const size3_t ind = start + grid(random ? subset[i] : i) * stride;
+                        const auto& v = data[im(ind)];
+                        double m = 0.0;
+                        for (size_t c = 0; c < DataFormat<ValueType>::comp; c++) {
+                            const auto vc = static_cast<double>(util::glmcomp(v, c));
+                            channels[c][i] = static_cast<float>(vc);
+                            m += vc * vc;
                         }
+                        magnitudes[i] = static_cast<float>(std::sqrt(m));
+
+                        indx[i] = static_cast<int>(ind.x);
+                        indy[i] = static_cast<int>(ind.y);
+                        indz[i] = static_cast<int>(ind.z);
+
+                        const dvec3 pos{indexToModel * dvec4{ind, 1}};
+                        posx[i] = static_cast<float>(pos.x);
+                        posy[i] = static_cast<float>(pos.y);
+                        posz[i] = static_cast<float>(pos.z);
                     }
-                }
+                });
             });
             outport_.setData(dataFrame);
             break;
         }
-        case Mode::XDir: {
-            const auto size = rangeX_.getEnd() - rangeY_.getStart();
+        case Mode::XDir:
+        case Mode::YDir:
+        case Mode::ZDir: {
+            // One column per line of voxels along the axis, ordered by the outer then the inner
+            // of the two remaining axes
+            const size_t axis = mode_ == Mode::XDir ? 0 : (mode_ == Mode::YDir ? 1 : 2);
+            const size_t outer = axis == 0 ? 2 : 0;
+            const size_t inner = axis == 1 ? 2 : 1;
+            const auto size = end[axis] - start[axis];
             auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(size));
 
-            volume->getRepresentation<VolumeRAM>()->dispatch<void>([this, dataFrame,
-                                                                    size](const auto vr) {
+            volume->getRepresentation<VolumeRAM>()->dispatch<void>([&](const auto vr) {
                 using ValueType = util::PrecisionValueType<decltype(vr)>;
                 const auto im = util::IndexMapper3D(vr->getDimensions());
                 const auto data = vr->getDataTyped();
-                size3_t ind;
-                for (ind.z = rangeZ_.getStart(); ind.z < rangeZ_.getEnd(); ind.z++) {
-                    for (ind.y = rangeY_.getStart(); ind.y < rangeY_.getEnd(); ind.y++) {
-                        const std::string name = "y:" + toString(ind.y) + " z:" + toString(ind.z);
-                        auto col = dataFrame->addColumn<ValueType>(name, size);
-                        auto& line = col->getTypedBuffer()
-                                         ->getEditableRAMRepresentation()
-                                         ->getDataContainer();
-                        size_t i = 0;
-                        for (ind.x = rangeX_.getStart(); ind.x < rangeX_.getEnd(); ind.x++) {
-                            line[i++] = data[im(ind)];
-                        }
-                    }
-                }
-            });
 
-            outport_.setData(dataFrame);
-            break;
-        }
-        case Mode::YDir: {
-            const auto size = rangeY_.getEnd() - rangeY_.getStart();
-            auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(size));
-
-            volume->getRepresentation<VolumeRAM>()->dispatch<void>(
-                [this, dataFrame, size](const auto vr) {
-                    using ValueType = util::PrecisionValueType<decltype(vr)>;
-                    const auto im = util::IndexMapper3D(vr->getDimensions());
-                    const auto data = vr->getDataTyped();
-                    size3_t ind;
-                    for (ind.x = rangeX_.getStart(); ind.x < rangeX_.getEnd(); ind.x++) {
-                        for (ind.z = rangeZ_.getStart(); ind.z < rangeZ_.getEnd(); ind.z++) {
-                            auto col = dataFrame->addColumn<ValueType>(
-                                "x:" + toString(ind.x) + " z:" + toString(ind.z), size);
-                            auto& line = col->getTypedBuffer()
-                                             ->getEditableRAMRepresentation()
-                                             ->getDataContainer();
-                            size_t i = 0;
-                            for (ind.y = rangeY_.getStart(); ind.y < rangeY_.getEnd(); ind.y++) {
-                                line[i++] = data[im(ind)];
-                            }
-                        }
+                const char names[] = {'x', 'y', 'z'};
+                std::vector<std::pair<size3_t, ValueType*>> lines;
+                const auto first = std::min(outer, inner);
+                const auto second = std::max(outer, inner);
+                size3_t ind{start};
+                for (ind[outer] = start[outer]; ind[outer] < end[outer]; ind[outer]++) {
+                    for (ind[inner] = start[inner]; ind[inner] < end[inner]; ind[inner]++) {
+                        const auto name = fmt::format("{}:{} {}:{}", names[first], ind[first],
+                                                      names[second], ind[second]);
+                        lines.emplace_back(ind,
+                                           addColumn<ValueType>(*dataFrame, name, size).data());
                     }
-                });
-
-            outport_.setData(dataFrame);
-            break;
-        }
-        case Mode::ZDir: {
-            const auto size = rangeZ_.getEnd() - rangeZ_.getStart();
-            auto dataFrame = std::make_shared<DataFrame>(static_cast<glm::u32>(size));
+                }
 
-            volume->getRepresentation<VolumeRAM>()->dispatch<void>(
-                [this, dataFrame, size](const auto vr) {
-                    using ValueType = util::PrecisionValueType<decltype(vr)>;
-                    const auto im = util::IndexMapper3D(vr->getDimensions());
-                    const auto data = vr->getDataTyped();
-                    size3_t ind;
-                    for (ind.x = rangeX_.getStart(); ind.x < rangeX_.getEnd(); ind.x++) {
-                        for (ind.y = rangeY_.getStart(); ind.y < rangeY_.getEnd(); ind.y++) {
-                            auto col = dataFrame->addColumn<ValueType>(
-                                "x:" + toString(ind.x) + " y:" + toString(ind.y), size);
-                            auto& line = col->getTypedBuffer()
-                                             ->getEditableRAMRepresentation()
-                                             ->getDataContainer();
-                            size_t i = 0;
-                            for (ind.z = rangeZ_.getStart(); ind.z < rangeZ_.getEnd(); ind.z++) {
-                                line[i++] = data[im(ind)];
-                            }
-                        }
+                util::cooperativeFor(lines.size(), [&](size_t line) {
+                    auto [pos, dst] = lines[line];
+                    for (pos[axis] = start[axis]; pos[axis] < end[axis]; pos[axis]++) {
+                        *dst++ = data[im(pos)];
                     }
                 });
+            });
 
             outport_.setData(dataFrame);
             break;
@@ -0,0 +1,140 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/dataframe/util/columnrangeindex.h>
+#include <inviwo/dataframe/datastructures/column.h>
+#include <inviwo/core/datastructures/buffer/bufferram.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace inviwo {
+
+ColumnRangeIndex::ColumnRangeIndex(const Column& column, const IndexColumn* ids, size_t bucketSize)
+    : bucketSize_{std::max(bucketSize, size_t{1})} {
+
+    const auto nRows = column.getSize();
+    if (ids && ids->getSize() != nRows) {
+        throw Exception("Size of id column does not match the indexed column",
+                        IVW_CONTEXT_CUSTOM("ColumnRangeIndex"));
+    }
+    const std::uint32_t* idData =
+        ids ? ids->getTypedBuffer()->getRAMRepresentation()->getDataContainer().data() : nullptr;
+    const auto idAt = [&](size_t row) {
+        return idData ? idData[row] : static_cast<std::uint32_t>(row);
+    };
+
+    // Sort (value, id) pairs together, this is more cache friendly than sorting a permutation
+    std::vector<std::pair<double, std::uint32_t>> sorted;
+    sorted.reserve(nRows);
+    const auto* ram = column.getBuffer()->getRepresentation<BufferRAM>();
+    ram->dispatch<void, dispatching::filter::Scalars>([&](auto typed) -> void {
+        const auto& data = typed->getDataContainer();
+        for (size_t row = 0; row < data.size(); ++row) {
+            const auto value = static_cast<double>(data[row]);
+            if (util::isnan(value)) {
+                missing_.add(idAt(row));
+            } else {
+                sorted.emplace_back(value, idAt(row));
+            }
+        }
+    });
+    std::sort(sorted.begin(), sorted.end());
+
+    values_.reserve(sorted.size());
+    ids_.reserve(sorted.size());
+    for (auto& [value, id] : sorted) {
+        values_.push_back(value);
+        ids_.push_back(id);
+    }
+
+    valid_.add(util::span<const std::uint32_t>(ids_.data(), ids_.size()));
+    buckets_.reserve((ids_.size() + bucketSize_ - 1) / bucketSize_);
+    for (size_t begin = 0; begin < ids_.size(); begin += bucketSize_) {
+        const auto count = std::min(bucketSize_, ids_.size() - begin);
+        buckets_.emplace_back(util::span<const std::uint32_t>(ids_.data() + begin, count));
+    }
+}
+
+BitSet ColumnRangeIndex::inside(dvec2 range) const {
+    if (range.x > range.y) return {};
+    const auto first = std::lower_bound(values_.begin(), values_.end(), range.x);
+    const auto last = std::upper_bound(first, values_.end(), range.y);
+    return rankRange(static_cast<size_t>(first - values_.begin()),
+                     static_cast<size_t>(last - values_.begin()));
+}
+
+BitSet ColumnRangeIndex::outside(dvec2 range) const {
+    if (range.x > range.y) return valid_;
+    return valid_ - inside(range);
+}
+
+size_t ColumnRangeIndex::countBelow(double value) const {
+    return static_cast<size_t>(std::lower_bound(values_.begin(), values_.end(), value) -
+                               values_.begin());
+}
+
+size_t ColumnRangeIndex::countAbove(double value) const {
+    return static_cast<size_t>(values_.end() -
+                               std::upper_bound(values_.begin(), values_.end(), value));
+}
+
+size_t ColumnRangeIndex::size() const { return values_.size(); }
+
+bool ColumnRangeIndex::empty() const { return values_.empty(); }
+
+const BitSet& ColumnRangeIndex::getValid() const { return valid_; }
+
+const BitSet& ColumnRangeIndex::getMissing() const { return missing_; }
+
+BitSet ColumnRangeIndex::rankRange(size_t first, size_t last) const {
+    if (first >= last) return {};
+
+    const auto span = [&](size_t begin, size_t end) {
+        return util::span<const std::uint32_t>(ids_.data() + begin, end - begin);
+    };
+
+    const auto firstBucket = (first + bucketSize_ - 1) / bucketSize_;
+    const auto lastBucket = last / bucketSize_;
+    if (firstBucket >= lastBucket) return BitSet(span(first, last));
+
+    // Whole buckets are combined in one union, the partial ones at the ends are added directly
+    std::vector<const BitSet*> whole;
+    whole.reserve(lastBucket - firstBucket);
+    for (auto i = firstBucket; i < lastBucket; ++i) whole.push_back(&buckets_[i]);
+    auto result = BitSet::fastUnion(whole);
+
+    result.add(span(first, firstBucket * bucketSize_));
+    result.add(span(lastBucket * bucketSize_, last));
+    return result;
+}
+
+}  // namespace inviwo
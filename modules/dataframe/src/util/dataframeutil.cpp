@@ -36,6 +36,10 @@
 #include <fmt/format.h>
 
 #include <optional>
+#include <random>
+#include <unordered_set>
+#include <numeric>
+#include <algorithm>
 
 namespace inviwo {
 
@@ -553,6 +557,39 @@ std::string createToolTipForRow(const DataFrame& dataframe, size_t rowId) {
     return doc;
 }
 
+std::vector<size_t> randomSubset(size_t total, size_t count, std::uint32_t seed) {
+    std::vector<size_t> subset;
+    if (count >= total) {
+        subset.resize(total);
+        std::iota(subset.begin(), subset.end(), size_t{0});
+        return subset;
+    }
+    subset.reserve(count);
+    std::mt19937_64 gen{seed};
+
+    if (count > total / 16) {
+        // Selection sampling, visits every index once but directly yields a sorted subset
+        std::uniform_real_distribution<double> dist{0.0, 1.0};
+        for (size_t i = 0; i < total && subset.size() < count; ++i) {
+            if (static_cast<double>(total - i) * dist(gen) <
+                static_cast<double>(count - subset.size())) {
+                subset.push_back(i);
+            }
+        }
+    } else {
+        // Floyd's algorithm, only touches count indices
+        std::unordered_set<size_t> selected;
+        selected.reserve(count);
+        for (size_t j = total - count; j < total; ++j) {
+            const auto i = std::uniform_int_distribution<size_t>{0, j}(gen);
+            if (!selected.insert(i).second) selected.insert(j);
+        }
+        subset.assign(selected.begin(), selected.end());
+        std::sort(subset.begin(), subset.end());
+    }
+    return subset;
+}
+
 }  // namespace dataframe
 
 }  // namespace inviwo
@@ -0,0 +1,108 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/util/dataframeutil.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace inviwo;
+
+// A data frame with a shuffled unique integer key column and two value columns
+static DataFrame makeDataFrame(size_t rows, unsigned int seed) {
+    std::vector<int> keys(rows);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::mt19937 rand{seed};
+    std::shuffle(keys.begin(), keys.end(), rand);
+
+    std::uniform_real_distribution<float> dist{0.0f, 1.0f};
+    std::vector<float> a(rows);
+    std::vector<float> b(rows);
+    std::generate(a.begin(), a.end(), [&]() { return dist(rand); });
+    std::generate(b.begin(), b.end(), [&]() { return dist(rand); });
+
+    DataFrame df;
+    df.addColumn("key", std::move(keys));
+    df.addColumn(seed == 1 ? "a" : "c", std::move(a));
+    df.addColumn(seed == 1 ? "b" : "d", std::move(b));
+    df.updateIndexBuffer();
+    return df;
+}
+
+static void InnerJoin(benchmark::State& state) {
+    const auto rows = static_cast<size_t>(state.range(0));
+    const auto left = makeDataFrame(rows, 1);
+    const auto right = makeDataFrame(rows, 2);
+    for (auto _ : state) {
+        auto joined = dataframe::innerJoin(left, right, "key");
+        benchmark::DoNotOptimize(joined);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rows));
+}
+
+static void LeftJoin(benchmark::State& state) {
+    const auto rows = static_cast<size_t>(state.range(0));
+    const auto left = makeDataFrame(rows, 1);
+    const auto right = makeDataFrame(rows / 2, 2);
+    for (auto _ : state) {
+        auto joined = dataframe::leftJoin(left, right, "key");
+        benchmark::DoNotOptimize(joined);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rows));
+}
+
+static void AppendRows(benchmark::State& state) {
+    const auto rows = static_cast<size_t>(state.range(0));
+    const auto top = makeDataFrame(rows, 1);
+    const auto bottom = makeDataFrame(rows, 1);
+    for (auto _ : state) {
+        auto appended = dataframe::appendRows(top, bottom, true);
+        benchmark::DoNotOptimize(appended);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rows));
+}
+
+BENCHMARK(InnerJoin)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->Unit(benchmark::kMillisecond);
+BENCHMARK(LeftJoin)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->Unit(benchmark::kMillisecond);
+BENCHMARK(AppendRows)->RangeMultiplier(8)->Range(1 << 10, 1 << 19)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/dataframe/datastructures/column.h>
+#include <inviwo/dataframe/util/columnrangeindex.h>
+
+#include <limits>
+#include <random>
+
+namespace inviwo {
+
+namespace {
+
+BitSet bruteForce(const std::vector<float>& data, const std::vector<std::uint32_t>& ids,
+                  dvec2 range, bool inside) {
+    BitSet result;
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (std::isnan(data[i])) continue;
+        const bool in = data[i] >= range.x && data[i] <= range.y;
+        if (in == inside) result.add(ids[i]);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(ColumnRangeIndex, Queries) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dist(-100.0f, 100.0f);
+
+    std::vector<float> data(10000);
+    for (auto& v : data) v = dist(gen);
+    data[17] = std::numeric_limits<float>::quiet_NaN();
+    data[42] = data[43];
+
+    std::vector<std::uint32_t> ids(data.size());
+    for (size_t i = 0; i < ids.size(); ++i) ids[i] = static_cast<std::uint32_t>(2 * i + 5);
+
+    TemplateColumn<float> column("values", data);
+    IndexColumn index("index", ids);
+    // Small buckets to exercise both whole and partial buckets
+    ColumnRangeIndex rangeIndex(column, &index, 64);
+
+    EXPECT_EQ(rangeIndex.size(), data.size() - 1);
+    EXPECT_TRUE(rangeIndex.getMissing().contains(ids[17]));
+    EXPECT_FALSE(rangeIndex.getValid().contains(ids[17]));
+
+    for (const auto& range : {dvec2{-10.0, 10.0}, dvec2{-200.0, 200.0}, dvec2{99.0, 300.0},
+                              dvec2{data[42], data[42]}, dvec2{5.0, 4.0}}) {
+        EXPECT_EQ(rangeIndex.inside(range), bruteForce(data, ids, range, true));
+        EXPECT_EQ(rangeIndex.outside(range), bruteForce(data, ids, range, false));
+    }
+
+    EXPECT_EQ(rangeIndex.countBelow(-200.0), size_t{0});
+    EXPECT_EQ(rangeIndex.countAbove(200.0), size_t{0});
+    EXPECT_EQ(rangeIndex.countBelow(200.0), rangeIndex.size());
+}
+
+TEST(ColumnRangeIndex, RowIds) {
+    TemplateColumn<int> column("values", std::vector<int>{5, 3, 9, 3, 1});
+    ColumnRangeIndex rangeIndex(column);
+
+    EXPECT_EQ(rangeIndex.inside({3.0, 5.0}), BitSet(0, 1, 3));
+    EXPECT_EQ(rangeIndex.outside({3.0, 5.0}), BitSet(2, 4));
+    EXPECT_EQ(rangeIndex.countBelow(3.0), size_t{1});
+    EXPECT_EQ(rangeIndex.countAbove(5.0), size_t{1});
+}
+
+}  // namespace inviwo
@@ -35,11 +35,14 @@
 #include <inviwo/dataframe/datastructures/datapoint.h>
 #include <inviwo/dataframe/datastructures/column.h>
 #include <inviwo/dataframe/datastructures/dataframe.h>
+#include <inviwo/dataframe/util/dataframeutil.h>
 
 #include <inviwo/core/datastructures/buffer/buffer.h>
 
 #include <fmt/format.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
 namespace {
@@ -186,4 +189,15 @@ TEST(DataFrameTests, RowAccess) {
     }
 }
 
+TEST(DataFrameUtil, RandomSubset) {
+    for (auto [total, count] : {std::pair<size_t, size_t>{1000, 10}, {1000, 900}, {10, 20}}) {
+        const auto subset = dataframe::randomSubset(total, count, 1);
+        EXPECT_EQ(std::min(total, count), subset.size());
+        EXPECT_TRUE(std::is_sorted(subset.begin(), subset.end()));
+        EXPECT_EQ(subset.end(), std::adjacent_find(subset.begin(), subset.end()));
+        EXPECT_LT(subset.back(), total);
+    }
+    EXPECT_EQ(dataframe::randomSubset(1000, 10, 1), dataframe::randomSubset(1000, 10, 1));
+}
+
 }  // namespace inviwo
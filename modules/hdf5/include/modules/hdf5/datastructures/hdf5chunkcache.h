@@ -0,0 +1,110 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <modules/hdf5/hdf5moduledefine.h>
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <H5Cpp.h>
+#include <warn/pop>
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace inviwo {
+
+namespace hdf5 {
+
+/**
+ * \class ChunkCache
+ * \brief A thread safe least recently used cache of decompressed dataset chunks.
+ *
+ * The chunks are identified by their offset in the dataset, and stored in the data type they were
+ * read as. A cache only holds chunks of one source, i.e. one dataset read as one type, at a time.
+ * Setting a new source clears the cache.
+ * \see Handle::getVolumeAtPathAsType
+ */
+class IVW_MODULE_HDF5_API ChunkCache {
+public:
+    using Chunk = std::vector<unsigned char>;
+
+    /**
+     * @param capacity the maximum number of bytes of chunk data to keep
+     */
+    explicit ChunkCache(size_t capacity = size_t{1} << 30);
+    ChunkCache(const ChunkCache&) = delete;
+    ChunkCache& operator=(const ChunkCache&) = delete;
+
+    /**
+     * Set the source identifier of the chunks, clears the cache if it differs from the current
+     * source.
+     */
+    void setSource(std::string_view source);
+
+    /**
+     * Get the chunk at \p offset, or nullptr if it is not in the cache
+     */
+    std::shared_ptr<const Chunk> get(const std::vector<hsize_t>& offset);
+    void add(const std::vector<hsize_t>& offset, std::shared_ptr<const Chunk> chunk);
+    void clear();
+
+    void setCapacity(size_t capacity);
+    size_t getCapacity() const;
+    /**
+     * The number of bytes of chunk data currently in the cache
+     */
+    size_t getSize() const;
+    size_t getHits() const;
+    size_t getMisses() const;
+
+private:
+    void evict();
+
+    using Entry = std::pair<std::vector<hsize_t>, std::shared_ptr<const Chunk>>;
+
+    mutable std::mutex mutex_;
+    std::string source_;
+    size_t capacity_;
+    size_t size_ = 0;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+    std::list<Entry> entries_;  ///< Most recently used first
+    std::map<std::vector<hsize_t>, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace hdf5
+
+}  // namespace inviwo
@@ -44,6 +44,7 @@
 #include <modules/hdf5/hdf5utils.h>
 #include <modules/hdf5/hdf5types.h>
 #include <modules/hdf5/hdf5exception.h>
+#include <modules/hdf5/datastructures/hdf5chunkcache.h>
 
 #include <limits>
 #include <functional>
@@ -83,9 +84,23 @@ public:
 
     Handle* getHandleForPath(const std::string& path) const;
 
-    std::shared_ptr<Volume> getVolumeAtPathAsType(const Path& path,
-                                                  std::vector<Selection> selection,
-                                                  const DataFormatBase* type) const;
+    /**
+     * Read a hyperslab of the dataset at \p path as a volume of format \p type, or in the format
+     * of the dataset if \p type is null.
+     *
+     * If a \p cache is given and the dataset is chunked, the selection is split into the chunks it
+     * touches which are read one by one. Chunks that are only gzip and shuffle filtered are read
+     * raw and decoded outside of the library lock if the library supports raw chunk reads, other
+     * chunks are decoded by the library.
+     * Decoded chunks are kept in the cache, so that subsequent reads of overlapping selections,
+     * i.e. when panning a subregion, only read the new chunks.
+     *
+     * Safe to call from a background thread, the library calls are guarded by libraryMutex().
+     * @param progress optional callback for the fraction of chunks read
+     */
+    std::shared_ptr<Volume> getVolumeAtPathAsType(
+        const Path& path, std::vector<Selection> selection, const DataFormatBase* type,
+        ChunkCache* cache = nullptr, const std::function<void(double)>& progress = {}) const;
 
     template <typename T>
     std::vector<T> getVectorAtPath(const Path& path) const;
@@ -39,6 +39,7 @@
 #include <H5Cpp.h>
 #include <warn/pop>
 
+#include <mutex>
 #include <vector>
 
 namespace inviwo {
@@ -59,6 +60,13 @@ IVW_MODULE_HDF5_API Paths findpaths(const H5::Group& grp, const Path& path,
 IVW_MODULE_HDF5_API bool isOfType(const H5::Group& grp, const std::string& type);
 IVW_MODULE_HDF5_API VolumeInfos getVolumeInfo(const H5::DataSet& ds, const Path& path);
 
+/**
+ * The HDF5 library is only thread safe if built with thread safety enabled, which the bundled
+ * build is not. Calls into the library that might run concurrently, i.e. from background jobs,
+ * have to hold this lock, including the destruction of any H5 objects.
+ */
+IVW_MODULE_HDF5_API std::mutex& libraryMutex();
+
 }  // namespace hdf5
 
 }  // namespace inviwo
@@ -30,9 +30,10 @@
 #pragma once
 
 #include <modules/hdf5/hdf5moduledefine.h>
-#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/poolprocessor.h>
 #include <modules/hdf5/ports/hdf5port.h>
 #include <modules/hdf5/datastructures/hdf5metadata.h>
+#include <modules/hdf5/datastructures/hdf5chunkcache.h>
 #include <modules/hdf5/hdf5utils.h>
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/ports/volumeport.h>
@@ -53,6 +54,9 @@ namespace hdf5 {
  *
  * Load a volume from a HTF5 file handle
  *
+ * The volume is read in the background. Chunked datasets are read chunk by chunk, and
+ * the decoded chunks are cached such that changing the selection only reads the new chunks.
+ *
  * ### Inports
  *   * __inport__ HDF5 file handle
  *
@@ -79,9 +83,10 @@ namespace hdf5 {
  *   * __Source__ ...
  *   * __Convert to type__ ...
  *   * __Volume__ ...
+ *   * __Chunk Cache (MB)__ Memory used to cache decoded chunks of chunked datasets
  *
  */
-class IVW_MODULE_HDF5_API HDF5ToVolume : public Processor {
+class IVW_MODULE_HDF5_API HDF5ToVolume : public PoolProcessor {
 public:
     HDF5ToVolume();
     virtual ~HDF5ToVolume();
@@ -129,6 +134,7 @@ private:
     };
 
     void makeVolume();
+    void updateVolume();
     void onDataChange();
 
     void onSelectionChange();
@@ -166,8 +172,10 @@ private:
     OptionPropertyInt datatype_;
 
     DimSelections selection_;
+    IntSizeTProperty cacheSize_;
 
     bool dirty_;
+    std::shared_ptr<ChunkCache> cache_;
 };
 
 }  // namespace hdf5
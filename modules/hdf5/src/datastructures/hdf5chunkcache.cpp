@@ -0,0 +1,117 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/hdf5/datastructures/hdf5chunkcache.h>
+
+namespace inviwo {
+
+namespace hdf5 {
+
+ChunkCache::ChunkCache(size_t capacity) : capacity_{capacity} {}
+
+void ChunkCache::setSource(std::string_view source) {
+    std::scoped_lock lock{mutex_};
+    if (source_ == source) return;
+    source_ = source;
+    entries_.clear();
+    index_.clear();
+    size_ = 0;
+}
+
+std::shared_ptr<const ChunkCache::Chunk> ChunkCache::get(const std::vector<hsize_t>& offset) {
+    std::scoped_lock lock{mutex_};
+    auto it = index_.find(offset);
+    if (it == index_.end()) {
+        ++misses_;
+        return nullptr;
+    }
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->second;
+}
+
+void ChunkCache::add(const std::vector<hsize_t>& offset, std::shared_ptr<const Chunk> chunk) {
+    if (!chunk || chunk->size() > capacity_) return;
+
+    std::scoped_lock lock{mutex_};
+    if (auto it = index_.find(offset); it != index_.end()) {
+        size_ -= it->second->second->size();
+        entries_.erase(it->second);
+        index_.erase(it);
+    }
+    size_ += chunk->size();
+    entries_.emplace_front(offset, std::move(chunk));
+    index_.emplace(offset, entries_.begin());
+    evict();
+}
+
+void ChunkCache::clear() {
+    std::scoped_lock lock{mutex_};
+    entries_.clear();
+    index_.clear();
+    size_ = 0;
+}
+
+void ChunkCache::setCapacity(size_t capacity) {
+    std::scoped_lock lock{mutex_};
+    capacity_ = capacity;
+    evict();
+}
+
+size_t ChunkCache::getCapacity() const {
+    std::scoped_lock lock{mutex_};
+    return capacity_;
+}
+
+size_t ChunkCache::getSize() const {
+    std::scoped_lock lock{mutex_};
+    return size_;
+}
+
+size_t ChunkCache::getHits() const {
+    std::scoped_lock lock{mutex_};
+    return hits_;
+}
+
+size_t ChunkCache::getMisses() const {
+    std::scoped_lock lock{mutex_};
+    return misses_;
+}
+
+void ChunkCache::evict() {
+    while (size_ > capacity_ && !entries_.empty()) {
+        size_ -= entries_.back().second->size();
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+}
+
+}  // namespace hdf5
+
+}  // namespace inviwo
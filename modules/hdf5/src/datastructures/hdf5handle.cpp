@@ -37,7 +37,15 @@
 
 #include <modules/base/algorithm/dataminmax.h>
 
+#include <warn/push>
+#include <warn/ignore/all>
+#include <hdf5_hl.h>
+#include <zlib.h>
+#include <warn/pop>
+
 #include <algorithm>
+#include <cstring>
+#include <numeric>
 
 namespace inviwo {
 
@@ -48,6 +56,267 @@ H5::Group load(const std::string& filename, const std::string& path) {
     H5::H5File hdfFile(filename, H5F_ACC_RDONLY);
     return hdfFile.openGroup(path);
 }
+
+/**
+ * A hyperslab selection in row major order, as used by HDF5
+ */
+struct Hyperslab {
+    std::vector<hsize_t> start;
+    std::vector<hsize_t> count;
+    std::vector<hsize_t> stride;
+};
+
+std::vector<H5Z_filter_t> getFilters(const H5::DSetCreatPropList& plist) {
+    std::vector<H5Z_filter_t> filters;
+    for (int i = 0; i < plist.getNfilters(); ++i) {
+        unsigned int flags = 0;
+        unsigned int config = 0;
+        size_t nValues = 0;
+        char name[1];
+        filters.push_back(plist.getFilter(i, flags, nValues, nullptr, 0, name, config));
+    }
+    return filters;
+}
+
+// Raw chunk reads need H5Dget_chunk_storage_size and H5DOread_chunk, older versions of the library
+// read all chunks through H5Dread
+#if H5_VERSION_GE(1, 10, 5)
+constexpr bool rawChunkReads = true;
+
+void unshuffle(const std::vector<unsigned char>& src, std::vector<unsigned char>& dst,
+               size_t elementSize) {
+    const size_t elements = src.size() / elementSize;
+    dst.resize(src.size());
+    for (size_t byte = 0; byte < elementSize; ++byte) {
+        const auto* in = src.data() + byte * elements;
+        for (size_t i = 0; i < elements; ++i) dst[i * elementSize + byte] = in[i];
+    }
+    // Trailing bytes that do not form a whole element are stored as is
+    std::copy(src.begin() + elements * elementSize, src.end(),
+              dst.begin() + elements * elementSize);
+}
+
+/**
+ * Read the chunk at \p offset raw and undo the gzip and shuffle filters. Only the read itself holds
+ * the library lock. Chunks that have not been written are filled with \p fillValue.
+ */
+std::vector<unsigned char> readRawChunk(hid_t dataset, const std::vector<hsize_t>& offset,
+                                        const std::vector<H5Z_filter_t>& filters,
+                                        const std::vector<unsigned char>& fillValue,
+                                        size_t chunkBytes) {
+    const auto elementSize = fillValue.size();
+    std::vector<unsigned char> raw;
+    uint32_t filterMask = 0;
+    {
+        std::scoped_lock lock{libraryMutex()};
+        hsize_t storageSize = 0;
+        if (H5Dget_chunk_storage_size(dataset, offset.data(), &storageSize) < 0 ||
+            storageSize == 0) {
+            // The chunk has not been written
+            std::vector<unsigned char> res(chunkBytes);
+            for (size_t i = 0; i + elementSize <= chunkBytes; i += elementSize) {
+                std::copy(fillValue.begin(), fillValue.end(), res.begin() + i);
+            }
+            return res;
+        }
+        raw.resize(storageSize);
+        if (H5DOread_chunk(dataset, H5P_DEFAULT, offset.data(), &filterMask, raw.data()) < 0) {
+            throw Exception("HDF: unable to read chunk",
+                            IVW_CONTEXT_CUSTOM("hdf5::Handle::getVolumeAtPathAsType"));
+        }
+    }
+
+    std::vector<unsigned char> decoded;
+    for (auto i = filters.size(); i-- > 0;) {
+        if (filterMask & (1u << i)) continue;  // The filter was skipped for this chunk
+
+        if (filters[i] == H5Z_FILTER_DEFLATE) {
+            decoded.resize(chunkBytes);
+            uLongf size = static_cast<uLongf>(decoded.size());
+            if (uncompress(decoded.data(), &size, raw.data(), static_cast<uLong>(raw.size())) !=
+                Z_OK) {
+                throw Exception("HDF: unable to inflate chunk",
+                                IVW_CONTEXT_CUSTOM("hdf5::Handle::getVolumeAtPathAsType"));
+            }
+            decoded.resize(size);
+        } else if (filters[i] == H5Z_FILTER_SHUFFLE) {
+            unshuffle(raw, decoded, elementSize);
+        }
+        std::swap(raw, decoded);
+    }
+    if (raw.size() != chunkBytes) {
+        throw Exception("HDF: unexpected chunk size",
+                        IVW_CONTEXT_CUSTOM("hdf5::Handle::getVolumeAtPathAsType"));
+    }
+    return raw;
+}
+#else
+constexpr bool rawChunkReads = false;
+
+std::vector<unsigned char> readRawChunk(hid_t, const std::vector<hsize_t>&,
+                                        const std::vector<H5Z_filter_t>&,
+                                        const std::vector<unsigned char>&, size_t) {
+    throw Exception("HDF: raw chunk reads are not supported by this version of the library",
+                    IVW_CONTEXT_CUSTOM("hdf5::Handle::getVolumeAtPathAsType"));
+}
+#endif
+
+/**
+ * Let the library read and decode the chunk at \p offset as type T, for chunks with filters or
+ * types that we can not decode ourselves.
+ */
+template <typename T>
+std::vector<unsigned char> readChunk(const H5::DataSet& dataset,
+                                     const std::vector<hsize_t>& dimensions,
+                                     const std::vector<hsize_t>& chunk,
+                                     const std::vector<hsize_t>& offset) {
+    const auto rank = chunk.size();
+    std::vector<unsigned char> res(
+        std::accumulate(chunk.begin(), chunk.end(), hsize_t{1}, std::multiplies<>{}) * sizeof(T),
+        0);
+
+    // Chunks at the border extend past the dataset
+    std::vector<hsize_t> count(rank);
+    for (size_t i = 0; i < rank; ++i) count[i] = std::min(chunk[i], dimensions[i] - offset[i]);
+    const std::vector<hsize_t> zero(rank, 0);
+
+    std::scoped_lock lock{libraryMutex()};
+    H5::DataSpace fileSpace = dataset.getSpace();
+    fileSpace.selectHyperslab(H5S_SELECT_SET, count.data(), offset.data());
+    H5::DataSpace memorySpace(static_cast<int>(rank), chunk.data());
+    memorySpace.selectHyperslab(H5S_SELECT_SET, count.data(), zero.data());
+    dataset.read(res.data(), TypeMap<T>::getType(), memorySpace, fileSpace);
+    return res;
+}
+
+/**
+ * Read \p slab chunk by chunk into \p dst, which is laid out as the row major count of the slab.
+ * The caller must not hold the library lock.
+ */
+template <typename T>
+void readChunked(const H5::DataSet& dataset, const std::vector<hsize_t>& dimensions,
+                 const Hyperslab& slab, T* dst, ChunkCache& cache,
+                 const std::function<void(double)>& progress) {
+    const auto rank = dimensions.size();
+
+    std::vector<hsize_t> chunk(rank);
+    std::vector<H5Z_filter_t> filters;
+    std::vector<unsigned char> fillValue(sizeof(T), 0);
+    bool raw = false;
+    {
+        std::scoped_lock lock{libraryMutex()};
+        const auto plist = dataset.getCreatePlist();
+        plist.getChunk(static_cast<int>(rank), chunk.data());
+        filters = getFilters(plist);
+        const auto fileType = dataset.getDataType();
+        raw = rawChunkReads && H5Tequal(fileType.getId(), TypeMap<T>::getType().getId()) > 0 &&
+              std::all_of(filters.begin(), filters.end(), [](H5Z_filter_t filter) {
+                  return filter == H5Z_FILTER_DEFLATE || filter == H5Z_FILTER_SHUFFLE;
+              });
+        if (raw && H5Pget_fill_value(plist.getId(), TypeMap<T>::getType().getId(),
+                                     fillValue.data()) < 0) {
+            raw = false;
+        }
+    }
+    const size_t chunkElements =
+        std::accumulate(chunk.begin(), chunk.end(), size_t{1}, std::multiplies<>{});
+
+    // The chunk indices along each dimension that contain selected elements
+    std::vector<std::vector<hsize_t>> chunkIndices(rank);
+    for (size_t d = 0; d < rank; ++d) {
+        for (hsize_t k = 0; k < slab.count[d]; ++k) {
+            const auto index = (slab.start[d] + k * slab.stride[d]) / chunk[d];
+            if (chunkIndices[d].empty() || chunkIndices[d].back() != index) {
+                chunkIndices[d].push_back(index);
+            }
+        }
+    }
+    std::vector<std::vector<hsize_t>> offsets;
+    std::vector<size_t> pos(rank, 0);
+    while (pos[0] < chunkIndices[0].size()) {
+        auto& offset = offsets.emplace_back(rank);
+        for (size_t d = 0; d < rank; ++d) offset[d] = chunkIndices[d][pos[d]] * chunk[d];
+        for (size_t d = rank; d-- > 0;) {
+            if (++pos[d] < chunkIndices[d].size() || d == 0) break;
+            pos[d] = 0;
+        }
+    }
+
+    // Row major strides of the destination
+    std::vector<size_t> dstStrides(rank, 1);
+    for (size_t d = rank - 1; d-- > 0;) dstStrides[d] = dstStrides[d + 1] * slab.count[d + 1];
+    std::vector<size_t> chunkStrides(rank, 1);
+    for (size_t d = rank - 1; d-- > 0;) chunkStrides[d] = chunkStrides[d + 1] * chunk[d + 1];
+
+    // The chunks are read one by one, this is called from a pool job and must not wait on other
+    // jobs of the pool
+    size_t done = 0;
+    std::string error;
+
+    const auto readOne = [&](const std::vector<hsize_t>& offset) {
+        try {
+            auto data = cache.get(offset);
+            if (!data) {
+                data = std::make_shared<const ChunkCache::Chunk>(
+                    raw ? readRawChunk(dataset.getId(), offset, filters, fillValue,
+                                       chunkElements * sizeof(T))
+                        : readChunk<T>(dataset, dimensions, chunk, offset));
+                cache.add(offset, data);
+            }
+            const auto* src = reinterpret_cast<const T*>(data->data());
+
+            // The range of selected elements [first, last) in this chunk along each dimension
+            std::vector<hsize_t> first(rank);
+            std::vector<hsize_t> last(rank);
+            for (size_t d = 0; d < rank; ++d) {
+                const auto begin = std::max(offset[d], slab.start[d]);
+                first[d] = (begin - slab.start[d] + slab.stride[d] - 1) / slab.stride[d];
+                const auto end = offset[d] + chunk[d];
+                last[d] = std::min<hsize_t>(
+                    slab.count[d], (end - slab.start[d] + slab.stride[d] - 1) / slab.stride[d]);
+                if (first[d] >= last[d]) return;
+            }
+
+            std::vector<hsize_t> k = first;
+            const auto inner = rank - 1;
+            while (true) {
+                size_t dstIndex = 0;
+                size_t srcIndex = 0;
+                for (size_t d = 0; d < inner; ++d) {
+                    dstIndex += k[d] * dstStrides[d];
+                    srcIndex += (slab.start[d] + k[d] * slab.stride[d] - offset[d]) *
+                                chunkStrides[d];
+                }
+                for (auto i = first[inner]; i < last[inner]; ++i) {
+                    dst[dstIndex + i] =
+                        src[srcIndex + slab.start[inner] + i * slab.stride[inner] - offset[inner]];
+                }
+
+                size_t d = inner;
+                while (d-- > 0) {
+                    if (++k[d] < last[d]) break;
+                    k[d] = first[d];
+                }
+                if (d == std::numeric_limits<size_t>::max()) break;
+            }
+        } catch (const std::exception& e) {
+            error = e.what();
+        } catch (const H5::Exception& e) {
+            error = e.getDetailMsg();
+        }
+        if (progress) progress(static_cast<double>(++done) / offsets.size());
+    };
+
+    for (const auto& offset : offsets) {
+        readOne(offset);
+        if (!error.empty()) break;
+    }
+    if (!error.empty()) {
+        throw Exception("HDF: unable to read data: " + error,
+                        IVW_CONTEXT_CUSTOM("hdf5::Handle::getVolumeAtPathAsType"));
+    }
+}
+
 }  // namespace
 
 Handle::Handle(std::string filename)
@@ -123,10 +392,11 @@ double Handle::getMax(const DataFormatBase* type) const {
     }
 }
 
-std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
-                                                      std::vector<Selection> selection,
-                                                      const DataFormatBase* type) const {
+std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(
+    const Path& path, std::vector<Selection> selection, const DataFormatBase* type,
+    ChunkCache* cache, const std::function<void(double)>& progress) const {
 
+    std::unique_lock lock{libraryMutex()};
     auto dataset = data_.openDataSet(path);
     ::inviwo::util::OnScopeExit closedataset{[&]() { dataset.close(); }};
 
@@ -192,23 +462,41 @@ std::shared_ptr<Volume> Handle::getVolumeAtPathAsType(const Path& path,
     std::reverse(&volumeDimensions[0], &volumeDimensions[0] + volumeDimensions.length());
     auto volumeram = createVolumeRAM(volumeDimensions, format);
 
+    const bool chunked =
+        cache && dataset.getCreatePlist().getLayout() == H5D_CHUNKED && rank > 0;
+    if (chunked) {
+        cache->setSource(filename_ + path.toString() + format->getString());
+    }
+
+    // Make sure the remaining H5 objects are destroyed with the lock held
+    ::inviwo::util::OnScopeExit relock{[&]() {
+        if (!lock.owns_lock()) lock.lock();
+    }};
     auto minmax = volumeram->dispatch<std::pair<dvec4, dvec4>, dispatching::filter::Scalars>(
         [&](auto vrprecision) {
             using ValueType = ::inviwo::util::PrecisionValueType<decltype(vrprecision)>;
 
             ValueType* data = vrprecision->getDataTyped();
 
-            try {
-                dataset.read(data, TypeMap<ValueType>::getType(), memorySpace, dataSpace);
-            } catch (H5::DataSetIException& e) {
-                throw Exception("HDF: unable to read data: " + e.getDetailMsg(), IVW_CONTEXT);
+            if (chunked) {
+                lock.unlock();
+                readChunked(dataset, dataDimensions, Hyperslab{start, count, stride}, data,
+                            *cache, progress);
+            } else {
+                try {
+                    dataset.read(data, TypeMap<ValueType>::getType(), memorySpace, dataSpace);
+                } catch (H5::DataSetIException& e) {
+                    throw Exception("HDF: unable to read data: " + e.getDetailMsg(), IVW_CONTEXT);
+                }
+                lock.unlock();
+                if (progress) progress(1.0);
             }
 
             auto res = ::inviwo::util::dataMinMax(data, selectionSize);
 
             LogInfo("Read HDF volume type: " << DataFormat<ValueType>::str()
                                              << " data range: " << res.first << ", " << res.second
-                                             << " file: " << dataset.getFileName());
+                                             << " file: " << filename_);
 
             return res;
         });
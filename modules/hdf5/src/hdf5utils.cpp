@@ -95,6 +95,11 @@ bool isOfType(const H5::Group& grp, const std::string& type) {
     return result;
 }
 
+std::mutex& libraryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
 }  // namespace hdf5
 
 }  // namespace inviwo
@@ -50,7 +50,7 @@ const ProcessorInfo HDF5ToVolume::processorInfo_{
 const ProcessorInfo HDF5ToVolume::getProcessorInfo() const { return processorInfo_; }
 
 HDF5ToVolume::HDF5ToVolume()
-    : Processor()
+    : PoolProcessor(pool::Option::QueuedDispatch)
     , inport_("inport")
     , outport_("outport")
 
@@ -89,7 +89,9 @@ HDF5ToVolume::HDF5ToVolume()
                  {"ushort", "Unsigned Short", 3}},
                 0)
     , selection_("selection", "Selection", 6)
-    , dirty_(false) {
+    , cacheSize_("cacheSize", "Chunk Cache (MB)", 1024, 0, 65536, 64, InvalidationLevel::Valid)
+    , dirty_(false)
+    , cache_{std::make_shared<ChunkCache>(cacheSize_ * 1024 * 1024)} {
 
     addPort(inport_);
     addPort(outport_);
@@ -120,8 +122,10 @@ HDF5ToVolume::HDF5ToVolume()
         }
     });
 
+    cacheSize_.onChange([this]() { cache_->setCapacity(cacheSize_ * 1024 * 1024); });
+
     addProperties(volumeSelection_, automaticEvaluation_, evaluate_, basisGroup_, information_,
-                  outputGroup_);
+                  outputGroup_, cacheSize_);
 }
 
 HDF5ToVolume::~HDF5ToVolume() = default;
@@ -130,8 +134,12 @@ void HDF5ToVolume::process() {
     if (dirty_) {
         dirty_ = false;
         makeVolume();
+    } else if (volume_) {
+        updateVolume();
     }
+}
 
+void HDF5ToVolume::updateVolume() {
     switch (basisSelection_.getSelectedIndex()) {
         case 0: {  // User defined basis
             break;
@@ -193,6 +201,7 @@ mat4 HDF5ToVolume::getBasisFromMeta(MetaData meta) {
 
     if (inport_.hasData()) {
         const auto data = inport_.getData();
+        std::scoped_lock lock{libraryMutex()};
         H5::DataSet dataset = data->getGroup().openDataSet(meta.path_);
         H5::DataSpace space = dataset.getSpace();
         int rank = space.getSimpleExtentNdims();
@@ -227,7 +236,10 @@ void HDF5ToVolume::onDataChange() {
     if (inport_.hasData()) {
         const auto data = inport_.getData();
 
-        std::vector<MetaData> metadata = util::getMetaData(data->getGroup());
+        const std::vector<MetaData> metadata = [&]() {
+            std::scoped_lock lock{libraryMutex()};
+            return util::getMetaData(data->getGroup());
+        }();
 
         volumeMatches_.clear();
         std::copy_if(metadata.begin(), metadata.end(), std::back_inserter(volumeMatches_),
@@ -316,32 +328,39 @@ void HDF5ToVolume::makeVolume() {
         const auto data = inport_.getData();
         MetaData volumeMeta = volumeMatches_[volumeSelection_.getSelectedIndex()];
 
-        try {
-            auto format = [&]() -> const DataFormatBase* {
-                switch (datatype_.getSelectedIndex()) {
-                    case 1:
-                        return DataFloat32::get();
-                    case 2:
-                        return DataFloat64::get();
-                    case 3:
-                        return DataUInt8::get();
-                    case 4:
-                        return DataUInt16::get();
-                    default:
-                        return nullptr;
-                }
-            }();
-
-            volume_ = std::shared_ptr<Volume>(
-                data->getVolumeAtPathAsType(Path(data->getGroup().getObjName()) + volumeMeta.path_,
-                                            selection_.getSelection(), format));
-
+        auto format = [&]() -> const DataFormatBase* {
+            switch (datatype_.getSelectedIndex()) {
+                case 1:
+                    return DataFloat32::get();
+                case 2:
+                    return DataFloat64::get();
+                case 3:
+                    return DataUInt8::get();
+                case 4:
+                    return DataUInt16::get();
+                default:
+                    return nullptr;
+            }
+        }();
+
+        const auto path = [&]() {
+            std::scoped_lock lock{libraryMutex()};
+            return Path(data->getGroup().getObjName()) + volumeMeta.path_;
+        }();
+
+        const auto load = [data, path, selection = selection_.getSelection(), format,
+                           cache = cache_](pool::Progress progress) {
+            return data->getVolumeAtPathAsType(path, selection, format, cache.get(),
+                                               [&](double p) { progress(p); });
+        };
+
+        dispatchOne(load, [this](std::shared_ptr<Volume> volume) {
+            volume_ = volume;
             dataRange_.set(volume_->dataMap_.dataRange);
+            updateVolume();
             outport_.setData(volume_);
-
-        } catch (const H5::GroupIException& e) {
-            LogInfo(e.getDetailMsg());
-        }
+            newResults();
+        });
     }
 }
 
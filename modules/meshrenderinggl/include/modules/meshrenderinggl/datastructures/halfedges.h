@@ -36,10 +36,12 @@
 
 #include <inviwo/core/util/transformiterator.h>
 #include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/zip.h>
+#include <inviwo/core/util/exception.h>
 
 #include <vector>
-#include <unordered_map>
 #include <optional>
+#include <limits>
 
 namespace inviwo {
 
@@ -62,6 +64,8 @@ namespace inviwo {
  *     ╱ ▼────e0─────▶ ╲ ╱
  *   v0────────────────v1
  *
+ * All topology is kept in flat arrays, the half edges of face f are 3f, 3f+1 and 3f+2. Twins are
+ * matched by sorting the half edges on their undirected vertex pair in parallel.
  */
 
 class IVW_MODULE_MESHRENDERINGGL_API HalfEdges {
@@ -76,6 +80,11 @@ public:
      */
     HalfEdges(const Mesh& mesh);
 
+    /**
+     * \brief Construct from a list of triangles, three vertex indices per face
+     */
+    explicit HalfEdges(const std::vector<std::uint32_t>& triangles);
+
     /**
      * \brief Creates a index buffer for triangles with connectivity 'None'
      */
@@ -132,8 +141,12 @@ public:
     auto faces() const;
     auto vertices() const;
 
+    std::uint32_t getNumberOfFaces() const;
+    std::uint32_t getNumberOfEdges() const;
+
 private:
     friend EdgeIter;
+    static constexpr std::uint32_t invalid = std::numeric_limits<std::uint32_t>::max();
 
     /**
      * \brief A single half edge
@@ -152,50 +165,64 @@ private:
          */
         std::uint32_t next;
         /**
-         * \brief Next half edge around the face
+         * \brief Previous half edge around the face
          */
         std::uint32_t prev;
 
         /**
          * \brief Twin half edge, opposite direction.
-         * nullopt if border.
+         * invalid if border.
          */
-        std::optional<std::uint32_t> twin = std::nullopt;
+        std::uint32_t twin = invalid;
     };
 
+    void build(const std::vector<std::uint32_t>& triangles);
+
     std::vector<HalfEdge> edges_;
-    std::unordered_map<std::uint32_t, std::uint32_t> vertexToEdge_;
-    std::unordered_map<std::uint32_t, std::uint32_t> faceToEdge_;
+    /**
+     * \brief First half edge pointing to each vertex, indexed by vertex, invalid if unused
+     */
+    std::vector<std::uint32_t> vertexToEdge_;
+    /**
+     * \brief The vertices used by any face
+     */
+    std::vector<std::uint32_t> vertices_;
 };
 
 inline auto HalfEdges::faceToEdge(std::uint32_t faceIndex) const -> EdgeIter {
-    return {this, faceToEdge_.at(faceIndex)};
+    if (faceIndex >= getNumberOfFaces()) throw RangeException("Invalid face", IVW_CONTEXT);
+    return {this, 3 * faceIndex};
 }
 
 inline auto HalfEdges::vertexToEdge(std::uint32_t vertexIndex) const -> EdgeIter {
-    return {this, vertexToEdge_.at(vertexIndex)};
+    if (vertexIndex >= vertexToEdge_.size() || vertexToEdge_[vertexIndex] == invalid) {
+        throw RangeException("Invalid vertex", IVW_CONTEXT);
+    }
+    return {this, vertexToEdge_[vertexIndex]};
 }
 
-inline auto HalfEdges::faces() const {
-    const auto transform =
-        [this](
-            const std::unordered_map<std::uint32_t, std::uint32_t>::value_type& item) -> EdgeIter {
-        return {this, item.second};
-    };
+inline std::uint32_t HalfEdges::getNumberOfFaces() const {
+    return static_cast<std::uint32_t>(edges_.size() / 3);
+}
+
+inline std::uint32_t HalfEdges::getNumberOfEdges() const {
+    return static_cast<std::uint32_t>(edges_.size());
+}
 
-    return util::as_range(util::makeTransformIterator(transform, faceToEdge_.begin()),
-                          util::makeTransformIterator(transform, faceToEdge_.end()));
+inline auto HalfEdges::faces() const {
+    const auto transform = [this](std::uint32_t edge) -> EdgeIter { return {this, edge}; };
+    auto seq = util::make_sequence<std::uint32_t>(0, getNumberOfEdges(), 3);
+    return util::as_range(util::makeTransformIterator(transform, seq.begin()),
+                          util::makeTransformIterator(transform, seq.end()));
 }
 
 inline auto HalfEdges::vertices() const {
-    const auto transform =
-        [this](
-            const std::unordered_map<std::uint32_t, std::uint32_t>::value_type& item) -> EdgeIter {
-        return {this, item.second};
+    const auto transform = [this](std::uint32_t vertex) -> EdgeIter {
+        return {this, vertexToEdge_[vertex]};
     };
 
-    return util::as_range(util::makeTransformIterator(transform, vertexToEdge_.begin()),
-                          util::makeTransformIterator(transform, vertexToEdge_.end()));
+    return util::as_range(util::makeTransformIterator(transform, vertices_.begin()),
+                          util::makeTransformIterator(transform, vertices_.end()));
 }
 
 inline std::uint32_t HalfEdges::EdgeIter::vertex() const {
@@ -212,8 +239,9 @@ inline auto HalfEdges::EdgeIter::prev() const -> EdgeIter {
 }
 
 inline auto HalfEdges::EdgeIter::twin() const -> std::optional<EdgeIter> {
-    if (auto twin = edges_->edges_[edgeIndex_].twin) {
-        return EdgeIter{edges_, *twin};
+    const auto twin = edges_->edges_[edgeIndex_].twin;
+    if (twin != invalid) {
+        return EdgeIter{edges_, twin};
     } else {
         return std::nullopt;
     }
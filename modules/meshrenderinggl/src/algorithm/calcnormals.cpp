@@ -34,13 +34,88 @@
 #include <inviwo/core/datastructures/buffer/bufferram.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
 
+#include <inviwo/core/util/threadutil.h>
+
 #include <modules/base/algorithm/meshutils.h>
 
+#include <fmt/format.h>
+
+#include <array>
+#include <numeric>
+#include <algorithm>
+
 namespace inviwo {
 
 namespace meshutil {
 using Mode = CalculateMeshNormalsMode;
 
+namespace {
+
+constexpr size_t chunkSize = size_t{1} << 14;
+
+template <typename Func>
+void forEachChunk(size_t count, Func func) {
+    util::cooperativeFor((count + chunkSize - 1) / chunkSize, [&](size_t chunk) {
+        func(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+    });
+}
+
+/**
+ * The weighted normal contribution of a triangle to each of its three corners
+ */
+std::array<vec3, 3> cornerNormals(const dvec3& v0, const dvec3& v1, const dvec3& v2, Mode mode) {
+    const dvec3 n = cross(v1 - v0, v2 - v0);
+    double l = glm::length(n);
+    if (l < std::numeric_limits<float>::epsilon()) {
+        // degenerated triangle
+        return {vec3{0.0f}, vec3{0.0f}, vec3{0.0f}};
+    }
+    // weighting factor
+    double weightA;
+    double weightB;
+    double weightC;
+    switch (mode) {
+        case Mode::WeightArea:
+            // area = norm of cross product
+            weightA = 1;
+            weightB = 1;
+            weightC = 1;
+            break;
+        case Mode::WeightAngle: {
+            // based on the angle between the edges
+            const dvec3 e0 = glm::normalize(v1 - v2);
+            const dvec3 e1 = glm::normalize(v2 - v0);
+            const dvec3 e2 = glm::normalize(v1 - v0);
+            weightA = acos(dot(e1, e2)) / l;
+            weightB = acos(dot(e0, e2)) / l;
+            weightC = acos(dot(e0, e1)) / l;
+            break;
+        }
+        case Mode::WeightNMax: {
+            const auto edge = [](auto a, auto b) {
+                auto e = a - b;
+                auto l = glm::length(e);
+                return std::make_pair(e / l, l);
+            };
+            const auto [e0, l0] = edge(v1, v2);
+            const auto [e1, l1] = edge(v2, v0);
+            const auto [e2, l2] = edge(v1, v0);
+            weightA = sin(acos(dot(e1, e2))) / (l * l1 * l2);
+            weightB = sin(acos(dot(e0, e2))) / (l * l0 * l2);
+            weightC = sin(acos(dot(e0, e1))) / (l * l0 * l1);
+            break;
+        }
+        case Mode::NoWeighting:
+        default:
+            weightA = 1.0 / l;
+            weightB = 1.0 / l;
+            weightC = 1.0 / l;
+    }
+    return {vec3(n * weightA), vec3(n * weightB), vec3(n * weightC)};
+}
+
+}  // namespace
+
 void calculateMeshNormals(Mesh& mesh, CalculateMeshNormalsMode mode) {
     if (mode == Mode::PassThrough) {
         return;
@@ -58,82 +133,60 @@ void calculateMeshNormals(Mesh& mesh, CalculateMeshNormalsMode mode) {
         mesh.removeBuffer(normals);
     }
 
-    auto vertices = positions->getRepresentation<BufferRAM>();
-    std::vector<vec3> normals(vertices->getSize(), vec3(0.0f));
-
-    // loop over index buffers
+    // gather the corners of all triangles
+    std::vector<std::uint32_t> corners;
     for (auto [meshInfo, buffer] : mesh.getIndexBuffers()) {
         if (meshInfo.dt != DrawType::Triangles) continue;
+        meshutil::forEachTriangle(meshInfo, *buffer, [&](auto i0, auto i1, auto i2) {
+            corners.push_back(i0);
+            corners.push_back(i1);
+            corners.push_back(i2);
+        });
+    }
 
-        vertices->dispatch<void, dispatching::filter::Floats>(
-            [&, mi = meshInfo, buf = buffer](auto ram) {
-                const auto& vert = ram->getDataContainer();
-
-                meshutil::forEachTriangle(mi, *buf, [&](auto i0, auto i1, auto i2) {
-                    const auto v0 = util::glm_convert<dvec3>(vert[i0]);
-                    const auto v1 = util::glm_convert<dvec3>(vert[i1]);
-                    const auto v2 = util::glm_convert<dvec3>(vert[i2]);
-
-                    const dvec3 n = cross(v1 - v0, v2 - v0);
-                    double l = glm::length(n);
-                    if (l < std::numeric_limits<float>::epsilon()) {
-                        // degenerated triangle
-                        return;
-                    }
-                    // weighting factor
-                    double weightA;
-                    double weightB;
-                    double weightC;
-                    switch (mode) {
-                        case Mode::WeightArea:
-                            // area = norm of cross product
-                            weightA = 1;
-                            weightB = 1;
-                            weightC = 1;
-                            break;
-                        case Mode::WeightAngle: {
-                            // based on the angle between the edges
-                            const dvec3 e0 = glm::normalize(v1 - v2);
-                            const dvec3 e1 = glm::normalize(v2 - v0);
-                            const dvec3 e2 = glm::normalize(v1 - v0);
-                            weightA = acos(dot(e1, e2)) / l;
-                            weightB = acos(dot(e0, e2)) / l;
-                            weightC = acos(dot(e0, e1)) / l;
-                            break;
-                        }
-                        case Mode::WeightNMax: {
-                            const auto edge = [](auto a, auto b) {
-                                auto e = a - b;
-                                auto l = glm::length(e);
-                                return std::make_pair(e / l, l);
-                            };
-                            const auto [e0, l0] = edge(v1, v2);
-                            const auto [e1, l1] = edge(v2, v0);
-                            const auto [e2, l2] = edge(v1, v0);
-                            weightA = sin(acos(dot(e1, e2))) / (l * l1 * l2);
-                            weightB = sin(acos(dot(e0, e2))) / (l * l0 * l2);
-                            weightC = sin(acos(dot(e0, e1))) / (l * l0 * l1);
-                            break;
-                        }
-                        case Mode::NoWeighting:
-                        default:
-                            weightA = 1.0 / l;
-                            weightB = 1.0 / l;
-                            weightC = 1.0 / l;
-                    }
-                    // add it to the vertices
-                    normals[i0] += vec3(n * weightA);
-                    normals[i1] += vec3(n * weightB);
-                    normals[i2] += vec3(n * weightC);
-                });
-            });
+    auto vertices = positions->getRepresentation<BufferRAM>();
+    const auto numVertices = vertices->getSize();
+    std::vector<vec3> normals(numVertices, vec3(0.0f));
+
+    // The contribution of each corner is computed in parallel per face. The contributions are
+    // then summed per vertex, in parallel over the vertices through a compressed list of the
+    // corners of each vertex. Hence no two threads ever write to the same normal.
+    std::vector<std::uint32_t> offsets(numVertices + 1, 0);
+    for (auto v : corners) {
+        if (v >= numVertices) {
+            throw Exception(fmt::format("Vertex index {} out of range", v),
+                            IVW_CONTEXT_CUSTOM("meshutil::calculateMeshNormals"));
+        }
+        ++offsets[v + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<std::uint32_t> vertexCorners(corners.size());
+    {
+        auto pos = offsets;
+        for (std::uint32_t i = 0; i < corners.size(); ++i) vertexCorners[pos[corners[i]]++] = i;
     }
 
-    // normalize normals
-    std::transform(normals.begin(), normals.end(), normals.begin(), [](auto n) {
-        const auto l = glm::length(n);
-        if (l < std::numeric_limits<float>::epsilon()) return n;
-        return n / l;
+    std::vector<vec3> contributions(corners.size());
+    vertices->dispatch<void, dispatching::filter::Floats>([&](auto ram) {
+        const auto& vert = ram->getDataContainer();
+        forEachChunk(corners.size() / 3, [&](size_t begin, size_t end) {
+            for (size_t f = begin; f < end; ++f) {
+                const auto c = cornerNormals(util::glm_convert<dvec3>(vert[corners[3 * f + 0]]),
+                                             util::glm_convert<dvec3>(vert[corners[3 * f + 1]]),
+                                             util::glm_convert<dvec3>(vert[corners[3 * f + 2]]),
+                                             mode);
+                std::copy(c.begin(), c.end(), contributions.begin() + 3 * f);
+            }
+        });
+    });
+
+    forEachChunk(numVertices, [&](size_t begin, size_t end) {
+        for (size_t v = begin; v < end; ++v) {
+            vec3 n{0.0f};
+            for (auto i = offsets[v]; i < offsets[v + 1]; ++i) n += contributions[vertexCorners[i]];
+            const auto l = glm::length(n);
+            normals[v] = l < std::numeric_limits<float>::epsilon() ? n : n / l;
+        }
     });
 
     auto bufferRAM = std::make_shared<BufferRAMPrecision<vec3>>(std::move(normals));
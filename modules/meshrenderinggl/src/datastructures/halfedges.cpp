@@ -29,86 +29,142 @@
 
 #include <modules/meshrenderinggl/datastructures/halfedges.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/util/threadutil.h>
 #include <modules/base/algorithm/meshutils.h>
 
-#include <iostream>
+#include <algorithm>
+#include <tuple>
 
 namespace inviwo {
 
-HalfEdges::HalfEdges(Mesh::MeshInfo info, const IndexBuffer& indexBuffer) {
-    // map to fill in the opposite direction
-    // (start_vertex, end_vertex) -> edge_index
-    std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> edgeMap;
-
-    std::uint32_t face = 0;
-    meshutil::forEachTriangle(info, indexBuffer,
-                              [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
-                                  // a-b, b-c, c-a
-                                  const auto count = static_cast<std::uint32_t>(edges_.size());
-                                  edges_.push_back(HalfEdge{a, face, count + 1, count + 2});
-                                  edgeMap.try_emplace({a, b}, count + 0);
-                                  vertexToEdge_.try_emplace(a, count + 0);
+namespace {
 
-                                  edges_.push_back(HalfEdge{b, face, count + 2, count + 0});
-                                  edgeMap.try_emplace({b, c}, count + 1);
-                                  vertexToEdge_.try_emplace(b, count + 1);
+constexpr size_t chunkSize = size_t{1} << 16;
 
-                                  edges_.push_back(HalfEdge{c, face, count + 0, count + 1});
-                                  edgeMap.try_emplace({c, a}, count + 2);
-                                  vertexToEdge_.try_emplace(c, count + 2);
+template <typename Func>
+void forEachChunk(size_t count, Func func) {
+    util::cooperativeFor((count + chunkSize - 1) / chunkSize, [&](size_t chunk) {
+        func(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+    });
+}
 
-                                  faceToEdge_.try_emplace(face, count);
+/**
+ * Sort the chunks of \p data in parallel and then merge them pairwise, also in parallel.
+ */
+template <typename T>
+void parallelSort(std::vector<T>& data) {
+    size_t chunks = 1;
+    while (chunks < 64 && chunks * 2 * chunkSize <= data.size()) chunks *= 2;
+
+    const auto bound = [&](size_t chunk) {
+        return data.begin() + static_cast<std::ptrdiff_t>(std::min(chunk, chunks) * data.size() /
+                                                          chunks);
+    };
+    util::cooperativeFor(chunks, [&](size_t i) { std::sort(bound(i), bound(i + 1)); });
+    for (size_t width = 1; width < chunks; width *= 2) {
+        util::cooperativeFor(chunks / (2 * width), [&](size_t i) {
+            const auto first = 2 * i * width;
+            std::inplace_merge(bound(first), bound(first + width), bound(first + 2 * width));
+        });
+    }
+}
 
-                                  ++face;
+std::vector<std::uint32_t> collectTriangles(const Mesh::MeshInfo& info,
+                                            const IndexBuffer& indexBuffer,
+                                            std::vector<std::uint32_t> triangles = {}) {
+    meshutil::forEachTriangle(info, indexBuffer,
+                              [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+                                  triangles.push_back(a);
+                                  triangles.push_back(b);
+                                  triangles.push_back(c);
                               });
+    return triangles;
+}
 
-    for (auto& edge : edges_) {
-        const auto a = edge.vertex;
-        const auto b = edges_[edge.next].vertex;
+}  // namespace
 
-        auto it = edgeMap.find(std::pair{b, a});
-        if (it != edgeMap.end()) {
-            edge.twin = it->second;
-        }
-    }
+HalfEdges::HalfEdges(Mesh::MeshInfo info, const IndexBuffer& indexBuffer) {
+    build(collectTriangles(info, indexBuffer));
 }
 
 HalfEdges::HalfEdges(const Mesh& mesh) {
-
-    std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> edgeMap;
-    std::uint32_t face = 0;
-
+    std::vector<std::uint32_t> triangles;
     for (auto [info, indexBuffer] : mesh.getIndexBuffers()) {
         if (info.dt != DrawType::Triangles) continue;
-        meshutil::forEachTriangle(info, *indexBuffer,
-                                  [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
-                                      // a-b, b-c, c-a
-                                      const auto count = static_cast<std::uint32_t>(edges_.size());
-                                      edges_.push_back(HalfEdge{a, face, count + 1, count + 2});
-                                      edgeMap.try_emplace({a, b}, count + 0);
-                                      vertexToEdge_.try_emplace(a, count + 0);
-
-                                      edges_.push_back(HalfEdge{b, face, count + 2, count + 0});
-                                      edgeMap.try_emplace({b, c}, count + 1);
-                                      vertexToEdge_.try_emplace(b, count + 1);
-
-                                      edges_.push_back(HalfEdge{c, face, count + 0, count + 1});
-                                      edgeMap.try_emplace({c, a}, count + 2);
-                                      vertexToEdge_.try_emplace(c, count + 2);
-
-                                      faceToEdge_.try_emplace(face, count);
-
-                                      ++face;
-                                  });
+        triangles = collectTriangles(info, *indexBuffer, std::move(triangles));
     }
+    build(triangles);
+}
+
+HalfEdges::HalfEdges(const std::vector<std::uint32_t>& triangles) { build(triangles); }
 
-    for (auto& edge : edges_) {
-        const auto a = edge.vertex;
-        const auto b = edges_[edge.next].vertex;
+void HalfEdges::build(const std::vector<std::uint32_t>& triangles) {
+    // The top bit of the edge index is used to encode the direction of the edge when sorting
+    if (triangles.size() >= (size_t{1} << 31)) {
+        throw Exception("Too many triangles for HalfEdges", IVW_CONTEXT);
+    }
+    const auto numEdges = triangles.size() / 3 * 3;
+
+    // a-b, b-c, c-a
+    edges_.resize(numEdges);
+    forEachChunk(numEdges, [&](size_t begin, size_t end) {
+        for (auto i = static_cast<std::uint32_t>(begin); i < end; ++i) {
+            const auto face = i / 3;
+            const auto first = 3 * face;
+            edges_[i] = HalfEdge{triangles[i], face, first + (i - first + 1) % 3,
+                                 first + (i - first + 2) % 3};
+        }
+    });
+
+    // Match twins by sorting all half edges on their undirected vertex pair. Within a pair the
+    // edges are ordered by direction then index, every edge a->b gets the first edge b->a as twin.
+    struct Key {
+        std::uint64_t pair;
+        std::uint32_t edge;
+        bool operator<(const Key& rhs) const {
+            return std::tie(pair, edge) < std::tie(rhs.pair, rhs.edge);
+        }
+    };
+    constexpr std::uint32_t flipped = std::uint32_t{1} << 31;
+    std::vector<Key> keys(numEdges);
+    forEachChunk(numEdges, [&](size_t begin, size_t end) {
+        for (auto i = static_cast<std::uint32_t>(begin); i < end; ++i) {
+            const auto a = edges_[i].vertex;
+            const auto b = edges_[edges_[i].next].vertex;
+            const auto [lo, hi] = std::minmax(a, b);
+            keys[i] = Key{(std::uint64_t{lo} << 32) | hi, a > b ? (i | flipped) : i};
+        }
+    });
+    parallelSort(keys);
+
+    for (size_t begin = 0; begin < keys.size();) {
+        auto end = begin + 1;
+        while (end < keys.size() && keys[end].pair == keys[begin].pair) ++end;
+        // keys[begin] is the first forward edge if there is one, otherwise the first flipped
+        auto firstFlipped = begin;
+        while (firstFlipped < end && !(keys[firstFlipped].edge & flipped)) ++firstFlipped;
+        const auto firstForward = firstFlipped != begin ? keys[begin].edge : invalid;
+        const auto firstBackward =
+            firstFlipped != end ? (keys[firstFlipped].edge & ~flipped) : invalid;
+        const bool loop = (keys[begin].pair >> 32) == (keys[begin].pair & 0xffffffff);
+
+        for (auto i = begin; i < end; ++i) {
+            const auto edge = keys[i].edge & ~flipped;
+            edges_[edge].twin =
+                loop ? firstForward : ((keys[i].edge & flipped) ? firstForward : firstBackward);
+        }
+        begin = end;
+    }
 
-        auto it = edgeMap.find(std::pair{b, a});
-        if (it != edgeMap.end()) {
-            edge.twin = it->second;
+    // The first half edge pointing to each vertex
+    const auto maxVertex = triangles.empty() ? 0 : *std::max_element(triangles.begin(),
+                                                                     triangles.begin() + numEdges);
+    vertexToEdge_.assign(triangles.empty() ? 0 : size_t{maxVertex} + 1, invalid);
+    for (std::uint32_t i = 0; i < numEdges; ++i) {
+        auto& edge = vertexToEdge_[edges_[i].vertex];
+        if (edge == invalid) {
+            edge = i;
+            vertices_.push_back(edges_[i].vertex);
         }
     }
 }
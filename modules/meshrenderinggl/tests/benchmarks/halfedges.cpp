@@ -0,0 +1,95 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <modules/base/algorithm/volume/volumegeneration.h>
+#include <modules/base/algorithm/volume/marchingcubesopt.h>
+#include <modules/meshrenderinggl/datastructures/halfedges.h>
+#include <modules/meshrenderinggl/algorithm/calcnormals.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace inviwo;
+
+namespace {
+
+// Both benchmarks run on the marching cubes surface of a ripple volume of the given size
+std::shared_ptr<Mesh> rippleMesh(int64_t size) {
+    auto volume =
+        std::shared_ptr<Volume>(util::makeRippleVolume(size3_t{static_cast<size_t>(size)}));
+    return util::marchingCubesOpt(volume, 0.5, {0.5f, 0.0f, 0.0f, 1.0f}, false, false);
+}
+
+void setCounters(benchmark::State& state, const Mesh& mesh) {
+    state.counters["Vertices"] = static_cast<double>(mesh.getBuffer(0)->getSize());
+    state.counters["Triangles"] =
+        static_cast<double>(mesh.getIndexBuffers().front().second->getSize() / 3);
+}
+
+void BuildHalfEdges(benchmark::State& state) {
+    const auto mesh = rippleMesh(state.range(0));
+    for (auto _ : state) {
+        HalfEdges edges(*mesh);
+        benchmark::DoNotOptimize(edges.getNumberOfEdges());
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, *mesh);
+}
+
+void CalculateNormals(benchmark::State& state) {
+    const auto mesh = rippleMesh(state.range(0));
+    const auto mode = static_cast<meshutil::CalculateMeshNormalsMode>(state.range(1));
+    for (auto _ : state) {
+        auto result = meshutil::calculateMeshNormals(*mesh, mode);
+        benchmark::DoNotOptimize(result.get());
+        benchmark::ClobberMemory();
+    }
+    setCounters(state, *mesh);
+}
+
+// Volume sizes times the modes 1 NoWeighting, 2 WeightArea, 3 WeightAngle, 4 WeightNMax
+void normalsArgs(benchmark::internal::Benchmark* b) {
+    for (int64_t size : {64, 256, 512}) {
+        for (int64_t mode = 1; mode <= 4; ++mode) b->Args({size, mode});
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BuildHalfEdges)->RangeMultiplier(2)->Range(32, 512)->Unit(benchmark::kMillisecond);
+BENCHMARK(CalculateNormals)->Apply(normalsArgs)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -331,4 +331,37 @@ TEST(HalfEdges, indexbufferAdjacency) {
     }
 }
 
+TEST(HalfEdges, largePlane) {
+    // Large enough for the twin matching to sort and merge several chunks
+    constexpr int width = 300;
+    constexpr int height = 200;
+    const IndexBuffer plane = createPlane(width, height);
+    const auto& index = plane.getRAMRepresentation()->getDataContainer();
+
+    HalfEdges edges(std::vector<std::uint32_t>(index.begin(), index.end()));
+    EXPECT_EQ(edges.getNumberOfFaces(), 2 * width * height);
+    EXPECT_EQ(edges.getNumberOfEdges(), 6 * width * height);
+    EXPECT_EQ(std::distance(edges.vertices().begin(), edges.vertices().end()),
+              (width + 1) * (height + 1));
+
+    size_t border = 0;
+    for (auto face : edges.faces()) {
+        auto edge = face;
+        do {
+            if (auto twin = edge.twin()) {
+                EXPECT_EQ(*twin->twin(), edge);
+                EXPECT_EQ(twin->vertex(), edge.next().vertex());
+                EXPECT_EQ(twin->next().vertex(), edge.vertex());
+            } else {
+                ++border;
+            }
+        } while (++edge != face);
+    }
+    EXPECT_EQ(border, 2 * (width + height));
+
+    for (auto vertex : edges.vertices()) {
+        EXPECT_EQ(edges.vertexToEdge(vertex.vertex()), vertex);
+    }
+}
+
 }  // namespace inviwo
@@ -55,7 +55,8 @@ std::shared_ptr<LayerRAM> LayerGL2RAMConverter::createFrom(
     std::shared_ptr<const LayerGL> layerGL) const {
     auto layerRAM = createLayerRAM(layerGL->getDimensions(), layerGL->getLayerType(),
                                    layerGL->getDataFormat(), layerGL->getSwizzleMask(),
-                                   layerGL->getInterpolation(), layerGL->getWrapping());
+                                   layerGL->getInterpolation(), layerGL->getWrapping(),
+                                   DataInitialization::Uninitialized);
 
     if (layerRAM) {
         layerGL->getTexture()->download(layerRAM->getData());
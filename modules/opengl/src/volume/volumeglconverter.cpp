@@ -55,7 +55,7 @@ std::shared_ptr<VolumeRAM> VolumeGL2RAMConverter::createFrom(
     std::shared_ptr<const VolumeGL> volumeGL) const {
     auto volume = createVolumeRAM(volumeGL->getDimensions(), volumeGL->getDataFormat(), nullptr,
                                   volumeGL->getSwizzleMask(), volumeGL->getInterpolation(),
-                                  volumeGL->getWrapping());
+                                  volumeGL->getWrapping(), DataInitialization::Uninitialized);
 
     if (volume) {
         volumeGL->getTexture()->download(volume->getData());
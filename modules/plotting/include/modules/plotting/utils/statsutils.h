@@ -32,7 +32,12 @@
 #include <modules/plotting/plottingmoduledefine.h>
 #include <inviwo/core/datastructures/buffer/buffer.h>
 #include <inviwo/core/util/formatdispatching.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <ostream>
+#include <utility>
+#include <vector>
 
 namespace inviwo {
 
@@ -54,9 +59,51 @@ std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& o
     return os;
 }
 
+namespace detail {
+
+/**
+ * Select the elements of nearest rank ceil(percentile * N) in [first, last) using
+ * std::nth_element. The requested ranks are visited in increasing order and each selection only
+ * partitions the part of the range above the previous one, so the cost is linear in N for a
+ * handful of percentiles instead of the N log N of a full sort. The range is reordered.
+ */
+template <typename Iter>
+std::vector<typename std::iterator_traits<Iter>::value_type> selectPercentiles(
+    Iter first, Iter last, const std::vector<double>& percentiles) {
+    const auto nElements = static_cast<size_t>(std::distance(first, last));
+    std::vector<std::pair<size_t, size_t>> ranks;  // rank, index in result
+    ranks.reserve(percentiles.size());
+    for (size_t i = 0; i < percentiles.size(); ++i) {
+        // Take care of percentile == 0 using std::max
+        ranks.emplace_back(static_cast<size_t>(std::max(
+                               std::ceil(static_cast<double>(nElements) * percentiles[i]) - 1.,
+                               0.)),
+                           i);
+    }
+    std::sort(ranks.begin(), ranks.end());
+
+    std::vector<typename std::iterator_traits<Iter>::value_type> result(percentiles.size());
+    if (first == last) return result;
+    auto lower = first;
+    for (auto [rank, index] : ranks) {
+        const auto nth = first + rank;
+        if (nth >= lower) {
+            std::nth_element(lower, nth, last);
+            lower = nth + 1;
+        }
+        result[index] = *nth;
+    }
+    return result;
+}
+
+}  // namespace detail
+
 /**
  * \brief Compute value below a percentage of observations in the data.
  * Uses the nearest rank method, i.e. ceil(percentile * N), where N = number of elements in data.
+ * The values are found by selection (std::nth_element) rather than by sorting the data, pass
+ * the data as an rvalue to avoid the copy. For data that does not fit in memory twice use a
+ * util::QuantileSketch instead.
  *
  * NaNs (Not a Numbers) are excluded from the computation.
  * The following example will return {1,2}
@@ -72,40 +119,26 @@ std::basic_ostream<Elem, Traits>& operator<<(std::basic_ostream<Elem, Traits>& o
  */
 template <typename T, typename std::enable_if<!util::is_floating_point<T>::value, int>::type = 0>
 std::vector<T> percentiles(std::vector<T> data, const std::vector<double>& percentiles) {
-    std::sort(data.begin(), data.end());
-    std::vector<T> result;
-    result.reserve(percentiles.size());
-    auto nElements = data.size();
     for (auto percentile : percentiles) {
         if (percentile < 0.f || percentile > 1.f) {
             throw Exception("Percentile must be between 0 and 1",
                             IVW_CONTEXT_CUSTOM("statsutil::percentiles"));
         }
-        // Take care of percentile == 1 using std::min
-        result.push_back(
-            data[static_cast<size_t>(std::max(std::ceil(nElements * percentile) - 1., 0.))]);
     }
-    return result;
+    return detail::selectPercentiles(data.begin(), data.end(), percentiles);
 }
 
 // Float/double types have special values
 template <typename T, typename std::enable_if<util::is_floating_point<T>::value, int>::type = 0>
 std::vector<T> percentiles(std::vector<T> data, const std::vector<double>& percentiles) {
-    auto noNaN =
-        std::partition(data.begin(), data.end(), [](const auto& a) { return util::isnan(a); });
-    std::sort(noNaN, data.end());
-    std::vector<T> result;
-    result.reserve(percentiles.size());
-    size_t nElements = std::distance(noNaN, data.end());
     for (auto percentile : percentiles) {
         if (percentile < 0.f || percentile > 1.f) {
             throw std::invalid_argument("Percentile must be between 0 and 1");
         }
-        // Take care of percentile == 1 using std::min
-        result.push_back(
-            data[static_cast<size_t>(std::max(std::ceil(nElements * percentile) - 1., 0.))]);
     }
-    return result;
+    auto noNaN =
+        std::partition(data.begin(), data.end(), [](const auto& a) { return util::isnan(a); });
+    return detail::selectPercentiles(noNaN, data.end(), percentiles);
 }
 
 }  // namespace statsutil
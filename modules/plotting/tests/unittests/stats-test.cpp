@@ -34,6 +34,9 @@
 
 #include <modules/plotting/utils/statsutils.h>
 
+#include <limits>
+#include <vector>
+
 namespace inviwo {
 
 TEST(StatsUtilsTest, init) {
@@ -68,4 +71,19 @@ TEST(StatsUtilsTest, init) {
     EXPECT_DOUBLE_EQ(50., percentiles[4]) << " 100 percentile";
 }
 
+TEST(StatsUtilsTest, percentilesUnorderedWithNaN) {
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    auto data = std::vector<double>({nan, 20., 15., nan, 50., 40., 35.});
+    auto percentiles = statsutil::percentiles(data, {1.0, 0.5, 0.0, 0.30, 0.5});
+    EXPECT_DOUBLE_EQ(50., percentiles[0]) << " 100 percentile";
+    EXPECT_DOUBLE_EQ(35., percentiles[1]) << " 50 percentile";
+    EXPECT_DOUBLE_EQ(15., percentiles[2]) << " 0 percentile";
+    EXPECT_DOUBLE_EQ(20., percentiles[3]) << " 30 percentile";
+    EXPECT_DOUBLE_EQ(35., percentiles[4]) << " 50 percentile";
+
+    auto ints = std::vector<int>({3, 1, 2, 0});
+    EXPECT_EQ(std::vector<int>({0, 1, 3}), statsutil::percentiles(ints, {0.0, 0.25, 1.0}));
+    EXPECT_THROW(statsutil::percentiles(ints, {1.5}), Exception);
+}
+
 }  // namespace inviwo
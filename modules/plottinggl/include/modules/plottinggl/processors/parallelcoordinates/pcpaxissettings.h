@@ -34,6 +34,8 @@
 #include <inviwo/core/properties/boolproperty.h>
 #include <modules/opengl/texture/texture2d.h>
 #include <modules/plotting/datastructures/axissettings.h>
+#include <inviwo/dataframe/util/columnrangeindex.h>
+#include <inviwo/core/datastructures/bitset.h>
 
 namespace inviwo {
 
@@ -162,7 +164,10 @@ public:
 
     void setParallelCoordinates(ParallelCoordinates* pcp);
 
-    const std::vector<bool>& getBrushed() const { return brushed_; }
+    /**
+     * Ids, from the index column of the DataFrame, of the rows brushed away by this axis.
+     */
+    const BitSet& getBrushed() const { return brushed_; }
 
     bool isFiltering() const { return upperBrushed_ || lowerBrushed_; }
 
@@ -211,7 +216,8 @@ private:
     bool lowerBrushed_ = false;  //! Flag to indicated if the lower handle is brushing away data
 
     uint32_t columnId_;
-    std::vector<bool> brushed_;
+    ColumnRangeIndex index_;
+    BitSet brushed_;
 };
 
 }  // namespace plot
@@ -786,25 +786,9 @@ void ParallelCoordinates::updateBrushing() {
 
     brushingDirty_ = false;
 
-    auto iCol = dataFrame_.getData()->getIndexColumn();
-    auto& indexCol = iCol->getTypedBuffer()->getRAMRepresentation()->getDataContainer();
-
-    const auto nRows = indexCol.size();
-
-    std::vector<bool> brushed(nRows, false);
-
-    auto brushAxis = [&](const std::vector<bool>& filtered, std::string_view axisName) {
-        BitSet b;
-        for (size_t i = 0; i < filtered.size(); ++i) {
-            if (filtered[i]) {
-                b.add(indexCol[i]);
-            }
-        }
-        brushingAndLinking_.filter(axisName, b);
-    };
-
+    // The axes keep their brushed ids up to date using a sorted index of their column
     for (auto& axis : axes_) {
-        brushAxis(axis.pcp->getBrushed(), axis.pcp->getCaption());
+        brushingAndLinking_.filter(axis.pcp->getCaption(), axis.pcp->getBrushed());
     }
 }
 
@@ -41,28 +41,6 @@
 namespace inviwo {
 namespace plot {
 
-namespace detail {
-enum class FilterResult { Upper, Lower, None };
-/**
- * Helper for brushing data
- * @param value to filter
- * @param range to use for filtering
- * @return true if value is outside range and not missing data.
- */
-FilterResult filterValue(const double& value, const dvec2& range) {
-    // Do not filter missing data (NaN)
-    if (util::isnan(value)) return FilterResult::None;
-    if (value < range.x) {
-        return FilterResult::Lower;
-    }
-    if (value > range.y) {
-        return FilterResult::Upper;
-    }
-    return FilterResult::None;
-}
-
-}  // namespace detail
-
 const std::string PCPAxisSettings::classIdentifier =
     "org.inviwo.parallelcoordinates.axissettingsproperty";
 std::string PCPAxisSettings::getClassIdentifier() const { return classIdentifier; }
@@ -123,6 +101,7 @@ PCPAxisSettings* PCPAxisSettings::clone() const { return new PCPAxisSettings(*th
 void PCPAxisSettings::update(std::shared_ptr<const DataFrame> frame) {
     col_ = frame->getColumn(columnId_);
     catCol_ = dynamic_cast<const CategoricalColumn*>(col_.get());
+    index_ = ColumnRangeIndex(*col_, frame->getIndexColumn().get());
 
     col_->getBuffer()->getRepresentation<BufferRAM>()->dispatch<void, dispatching::filter::Scalars>(
         [&](auto ram) -> void {
@@ -209,23 +188,10 @@ void PCPAxisSettings::updateBrushing() {
     // Increase range to avoid conversion issues
     const dvec2 off{-std::numeric_limits<float>::epsilon(), std::numeric_limits<float>::epsilon()};
     const auto rangeTmp = range.get() + off;
-    const auto nRows = col_->getSize();
-
-    upperBrushed_ = false;
-    lowerBrushed_ = false;
-
-    brushed_.resize(nRows, false);
-
-    for (size_t i = 0; i < nRows; i++) {
-        const auto filtered = detail::filterValue(at(i), rangeTmp);
-        if (filtered == detail::FilterResult::None) {
-            brushed_[i] = false;
-            continue;
-        }
-        brushed_[i] = true;
-        if (filtered == detail::FilterResult::Upper) upperBrushed_ = true;
-        if (filtered == detail::FilterResult::Lower) lowerBrushed_ = true;
-    }
+
+    brushed_ = index_.outside(rangeTmp);
+    lowerBrushed_ = index_.countBelow(rangeTmp.x) > 0;
+    upperBrushed_ = index_.countAbove(rangeTmp.y) > 0;
 }
 
 void PCPAxisSettings::updateLabels() {
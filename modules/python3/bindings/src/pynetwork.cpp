@@ -35,17 +35,44 @@
 #include <inviwo/core/network/portconnection.h>
 #include <inviwo/core/links/propertylink.h>
 #include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/network/processormetrics.h>
 #include <inviwo/core/ports/port.h>
 #include <inviwo/core/ports/inport.h>
 #include <inviwo/core/common/inviwoapplication.h>
 
 #include <inviwopy/vectoridentifierwrapper.h>
 
+#include <sstream>
+
 namespace py = pybind11;
 
 namespace inviwo {
 
+namespace {
+
+// Context manager for ProcessorNetwork::beginBatch/endBatch
+struct PyNetworkBatch {
+    ProcessorNetwork* network;
+};
+
+}  // namespace
+
 void exposeNetwork(py::module& m) {
+    py::class_<PyNetworkBatch>(m, "NetworkBatch")
+        .def("__enter__",
+             [](PyNetworkBatch& batch) {
+                 batch.network->lock();
+                 batch.network->beginBatch();
+                 return &batch;
+             },
+             py::return_value_policy::reference)
+        .def("__exit__", [](PyNetworkBatch& batch, py::object, py::object, py::object) {
+            batch.network->endBatch();
+            batch.network->unlock();
+        });
+
     py::class_<PortConnection>(m, "PortConnection")
         .def(py::init<Outport*, Inport*>())
         .def_property_readonly("inport", &PortConnection::getInport,
@@ -60,6 +87,45 @@ void exposeNetwork(py::module& m) {
         .def_property_readonly("destination", &PropertyLink::getDestination,
                                py::return_value_policy::reference);
 
+    py::class_<ProcessorMetrics::Entry>(m, "ProcessorMetricsEntry")
+        .def_readonly("identifier", &ProcessorMetrics::Entry::identifier)
+        .def_readonly("classIdentifier", &ProcessorMetrics::Entry::classIdentifier)
+        .def_readonly("invalidations", &ProcessorMetrics::Entry::invalidations)
+        .def_readonly("evaluations", &ProcessorMetrics::Entry::evaluations)
+        .def_readonly("conversions", &ProcessorMetrics::Entry::conversions)
+        .def_readonly("bytesAllocated", &ProcessorMetrics::Entry::bytesAllocated)
+        .def_readonly("lastMs", &ProcessorMetrics::Entry::lastMs)
+        .def_readonly("totalMs", &ProcessorMetrics::Entry::totalMs)
+        .def_readonly("lastConversions", &ProcessorMetrics::Entry::lastConversions)
+        .def_readonly("lastBytesAllocated", &ProcessorMetrics::Entry::lastBytesAllocated)
+        .def_readonly("lastEvaluation", &ProcessorMetrics::Entry::lastEvaluation)
+        .def_property_readonly("meanMs", &ProcessorMetrics::Entry::meanMs)
+        .def_property_readonly("p95Ms", &ProcessorMetrics::Entry::p95Ms);
+
+    py::class_<ProcessorMetrics>(m, "ProcessorMetrics")
+        .def("get", &ProcessorMetrics::get, py::return_value_policy::copy)
+        .def_property_readonly("entries", &ProcessorMetrics::getEntries)
+        .def_property_readonly("evaluations", &ProcessorMetrics::getEvaluationCount)
+        .def("reset", &ProcessorMetrics::reset)
+        .def(
+            "toCSV",
+            [](const ProcessorMetrics& metrics, bool header) {
+                std::stringstream ss;
+                metrics.writeCSV(ss, header);
+                return ss.str();
+            },
+            py::arg("header") = true)
+        .def("toJSON",
+             [](const ProcessorMetrics& metrics) {
+                 std::stringstream ss;
+                 metrics.writeJSON(ss);
+                 return ss.str();
+             })
+        .def_property("evaluationLog", &ProcessorMetrics::getEvaluationLog,
+                      [](ProcessorMetrics& metrics, const std::string& filename) {
+                          metrics.setEvaluationLog(filename);
+                      });
+
     py::class_<ProcessorNetwork>(m, "ProcessorNetwork")
         .def_property_readonly("processors", &ProcessorNetwork::getProcessors,
                                py::return_value_policy::reference)
@@ -141,7 +207,18 @@ void exposeNetwork(py::module& m) {
         .def("unlock", &ProcessorNetwork::unlock)
         .def("isLocked", &ProcessorNetwork::islocked)
         .def_property_readonly("locked", &ProcessorNetwork::islocked)
+        // with network.batch(): ... handles links and invalidations once at the end of the block
+        .def("batch", [](ProcessorNetwork* pn) { return PyNetworkBatch{pn}; })
+        .def("beginBatch", &ProcessorNetwork::beginBatch)
+        .def("endBatch", &ProcessorNetwork::endBatch)
+        .def_property_readonly("batching", &ProcessorNetwork::isBatching)
         .def_property_readonly("deserializing", &ProcessorNetwork::isDeserializing)
+        .def_property_readonly(
+            "metrics",
+            [](ProcessorNetwork* pn) -> ProcessorMetrics& {
+                return pn->getApplication()->getProcessorNetworkEvaluator()->getMetrics();
+            },
+            py::return_value_policy::reference)
 
         .def("clear",
              [&](ProcessorNetwork* pn) { pn->getApplication()->getWorkspaceManager()->clear(); })
@@ -29,6 +29,7 @@
 
 #include <inviwopy/pypropertyowner.h>
 #include <inviwo/core/properties/propertyowner.h>
+#include <inviwo/core/network/networklock.h>
 
 #include <inviwopy/inviwopy.h>
 #include <inviwopy/vectoridentifierwrapper.h>
@@ -96,7 +97,10 @@ void exposePropertyOwner(pybind11::module& m) {
             py::return_value_policy::reference)
         .def("setAllPropertiesCurrentStateAsDefault",
              &PropertyOwner::setAllPropertiesCurrentStateAsDefault)
-        .def("resetAllPoperties", &PropertyOwner::resetAllPoperties);
+        .def("resetAllPoperties", [](PropertyOwner& po) {
+            NetworkBatch batch(po.getProcessor());
+            po.resetAllPoperties();
+        });
 }
 
 }  // namespace inviwo
@@ -36,6 +36,9 @@
 #include <modules/vectorfieldvisualization/properties/integrallineproperties.h>
 #include <modules/vectorfieldvisualization/datastructures/integralline.h>
 
+#include <algorithm>
+#include <array>
+#include <tuple>
 #include <unordered_map>
 
 namespace inviwo {
@@ -69,15 +72,58 @@ public:
 
     Result traceFrom(const SpatialVector& pIn) const;
 
+    /// Number of lines traced in lockstep by traceFrom(seeds, begin, end, callback)
+    static constexpr size_t PacketSize = 8;
+
+    /**
+     * Trace from the seeds [begin, end) of \p seeds in packets of PacketSize lines that are
+     * advanced in lockstep. Every stage of a step samples all lines of a packet with one batched
+     * sampler call, lines that terminate are masked out of the packet. The lines are identical
+     * to tracing each seed with traceFrom(const SpatialVector&).
+     * @param seeds random access container of seed points
+     * @param begin first seed to trace
+     * @param end one past the last seed to trace
+     * @param callback called as callback(Result&&, size_t seedIndex) for each seed
+     */
+    template <typename Seeds, typename Callback>
+    void traceFrom(const Seeds& seeds, size_t begin, size_t end, Callback&& callback) const;
+
     void addMetaDataSampler(const std::string& name, std::shared_ptr<const Sampler> sampler);
 
     const DataHomogenouSpatialMatrixrix& getSeedTransformationMatrix() const;
 
 private:
+    using SampleVector = typename Sampler::ReturnType;
+
+    /// The active lines of a packet, lane[i] is the index of the line at pos[i]
+    struct Lanes {
+        std::array<size_t, PacketSize> lane;
+        std::array<SpatialVector, PacketSize> pos;
+        size_t count = 0;
+    };
+    using Results = std::array<Result, PacketSize>;
+    using Reasons = std::array<IntegralLine::TerminationReason, PacketSize>;
+
     inline SpatialVector seedTransform(const SpatialVector& seed) const;
 
+    /**
+     * Set the termination reason of a direction that is not traced and reserve space, returns
+     * the number of backward and forward steps.
+     */
+    std::pair<size_t, size_t> prepare(IntegralLine& line) const;
+
+    template <typename V>
+    SpatialVector move(const SpatialVector& pos, V v, double stepSize) const;
+    template <typename V>
+    V combine(const V& k1, const V& k2, const V& k3, const V& k4) const;
+
     std::pair<SpatialVector, DataVector> step(const SpatialVector& oldPos,
                                               const double stepSize) const;
+    void step(const SpatialVector* oldPos, size_t count, double stepSize, SpatialVector* newPos,
+              SampleVector* velocity) const;
+
+    void tracePacket(Lanes lanes, Results& results) const;
+    void integrate(size_t steps, Lanes lanes, Results& results, bool fwd, Reasons& reasons) const;
 
     bool addPoint(IntegralLine& line, const SpatialVector& pos) const;
     bool addPoint(IntegralLine& line, const SpatialVector& pos,
@@ -120,32 +166,7 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(const SpatialVector
     Result res;
     IntegralLine& line = res.line;
 
-    const auto [stepsBWD, stepsFWD] = [dir = dir_, steps = steps_,
-                                       &line]() -> std::pair<size_t, size_t> {
-        switch (dir) {
-            case inviwo::IntegralLineProperties::Direction::FWD:
-                line.setBackwardTerminationReason(IntegralLine::TerminationReason::StartPoint);
-                return {1, steps + 1};
-            case inviwo::IntegralLineProperties::Direction::BWD:
-                line.setForwardTerminationReason(IntegralLine::TerminationReason::StartPoint);
-                return {steps + 1, 1};
-            default:
-            case inviwo::IntegralLineProperties::Direction::BOTH: {
-                return {steps / 2 + 1, steps - (steps / 2) + 1};
-            }
-        }
-    }();
-
-    line.getPositions().reserve(steps_ + 2);
-    line.getMetaData<dvec3>("velocity", true).reserve(steps_ + 2);
-
-    if constexpr (TimeDependent) {
-        line.getMetaData<double>("timestamp", true).reserve(steps_ + 2);
-    }
-
-    for (auto& m : metaSamplers_) {
-        line.getMetaData<typename Sampler::ReturnType>(m.first, true).reserve(steps_ + 2);
-    }
+    const auto [stepsBWD, stepsFWD] = prepare(line);
 
     if (!addPoint(line, p)) {
         return res;  // Zero velocity at seed point
@@ -162,6 +183,65 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(const SpatialVector
     return res;
 }
 
+template <typename SpatialSampler, bool TimeDependent>
+template <typename Seeds, typename Callback>
+void IntegralLineTracer<SpatialSampler, TimeDependent>::traceFrom(const Seeds& seeds, size_t begin,
+                                                                  size_t end,
+                                                                  Callback&& callback) const {
+    Results results;
+    Lanes lanes;
+    for (size_t first = begin; first < end; first += PacketSize) {
+        lanes.count = std::min(PacketSize, end - first);
+        for (size_t i = 0; i < lanes.count; ++i) {
+            lanes.lane[i] = i;
+            lanes.pos[i] = seedTransform(SpatialVector(seeds[first + i]));
+        }
+        tracePacket(lanes, results);
+        for (size_t i = 0; i < lanes.count; ++i) {
+            callback(std::move(results[i]), first + i);
+        }
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+void IntegralLineTracer<SpatialSampler, TimeDependent>::tracePacket(Lanes lanes,
+                                                                    Results& results) const {
+    size_t stepsBWD = 0;
+    size_t stepsFWD = 0;
+    for (size_t i = 0; i < lanes.count; ++i) {
+        results[i] = Result{};
+        std::tie(stepsBWD, stepsFWD) = prepare(results[i].line);
+    }
+
+    std::array<SampleVector, PacketSize> velocity;
+    sampler_->sample(lanes.pos.data(), velocity.data(), lanes.count);
+    size_t started = 0;
+    for (size_t i = 0; i < lanes.count; ++i) {
+        if (addPoint(results[i].line, lanes.pos[i], velocity[i])) {  // Zero velocity at seed point
+            lanes.lane[started] = lanes.lane[i];
+            lanes.pos[started] = lanes.pos[i];
+            ++started;
+        }
+    }
+    lanes.count = started;
+
+    Reasons reasons;
+    integrate(stepsBWD, lanes, results, false, reasons);
+    for (size_t i = 0; i < lanes.count; ++i) {
+        auto& res = results[lanes.lane[i]];
+        res.line.setBackwardTerminationReason(reasons[lanes.lane[i]]);
+        if (res.line.getPositions().size() > 1) {
+            res.line.reverse();
+            res.seedIndex = res.line.getPositions().size() - 1;
+        }
+    }
+
+    integrate(stepsFWD, lanes, results, true, reasons);
+    for (size_t i = 0; i < lanes.count; ++i) {
+        results[lanes.lane[i]].line.setForwardTerminationReason(reasons[lanes.lane[i]]);
+    }
+}
+
 template <typename SpatialSampler, bool TimeDependent>
 void IntegralLineTracer<SpatialSampler, TimeDependent>::addMetaDataSampler(
     const std::string& name, std::shared_ptr<const Sampler> sampler) {
@@ -189,30 +269,74 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::seedTransform(const SpatialVe
     }
 }
 
+template <typename SpatialSampler, bool TimeDependent>
+std::pair<size_t, size_t> IntegralLineTracer<SpatialSampler, TimeDependent>::prepare(
+    IntegralLine& line) const {
+    const auto [stepsBWD, stepsFWD] = [dir = dir_, steps = steps_,
+                                       &line]() -> std::pair<size_t, size_t> {
+        switch (dir) {
+            case inviwo::IntegralLineProperties::Direction::FWD:
+                line.setBackwardTerminationReason(IntegralLine::TerminationReason::StartPoint);
+                return {1, steps + 1};
+            case inviwo::IntegralLineProperties::Direction::BWD:
+                line.setForwardTerminationReason(IntegralLine::TerminationReason::StartPoint);
+                return {steps + 1, 1};
+            default:
+            case inviwo::IntegralLineProperties::Direction::BOTH: {
+                return {steps / 2 + 1, steps - (steps / 2) + 1};
+            }
+        }
+    }();
+
+    line.getPositions().reserve(steps_ + 2);
+    line.getMetaData<dvec3>("velocity", true).reserve(steps_ + 2);
+
+    if constexpr (TimeDependent) {
+        line.getMetaData<double>("timestamp", true).reserve(steps_ + 2);
+    }
+
+    for (auto& m : metaSamplers_) {
+        line.getMetaData<typename Sampler::ReturnType>(m.first, true).reserve(steps_ + 2);
+    }
+    return {stepsBWD, stepsFWD};
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+template <typename V>
+typename IntegralLineTracer<SpatialSampler, TimeDependent>::SpatialVector
+IntegralLineTracer<SpatialSampler, TimeDependent>::move(const SpatialVector& pos, V v,
+                                                        double stepSize) const {
+    if (normalizeSamples_) {
+        const auto l = glm::length(v);
+        if (l != 0) v /= l;
+    }
+    const auto offset = (invBasis_ * (v * stepSize));
+    if constexpr (TimeDependent) {
+        return pos + SpatialVector(offset, stepSize);
+    } else {
+        return pos + offset;
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+template <typename V>
+V IntegralLineTracer<SpatialSampler, TimeDependent>::combine(const V& k1, const V& k2,
+                                                             const V& k3, const V& k4) const {
+    if (normalizeSamples_) {
+        const auto k = k1 + k2 + k2 + k3 + k3 + k4;
+        const auto l = glm::length(k);
+        return l == 0 ? k : k / l;
+    } else {
+        return (k1 + k2 + k2 + k3 + k3 + k4) * (1.0 / 6.0);
+    }
+}
+
 template <typename SpatialSampler, bool TimeDependent>
 std::pair<typename IntegralLineTracer<SpatialSampler, TimeDependent>::SpatialVector,
           typename IntegralLineTracer<SpatialSampler, TimeDependent>::DataVector>
 IntegralLineTracer<SpatialSampler, TimeDependent>::step(const SpatialVector& oldPos,
                                                         const double stepSize) const {
-    auto normalize = [](const auto v) {
-        auto l = glm::length(v);
-        if (l == 0) return v;
-        return v / l;
-    };
-
-    auto move = [&](const auto& pos, auto v, const auto stepsize) {
-        if (normalizeSamples_) {
-            v = normalize(v);
-        }
-        auto offset = (invBasis_ * (v * stepsize));
-        if constexpr (TimeDependent) {
-            return pos + SpatialVector(offset, stepsize);
-        } else {
-            return pos + offset;
-        }
-    };
-
-    auto k1 = sampler_->sample(oldPos);
+    const auto k1 = sampler_->sample(oldPos);
 
     switch (integrationScheme_) {
         case inviwo::IntegralLineProperties::IntegrationScheme::Euler:
@@ -223,14 +347,47 @@ IntegralLineTracer<SpatialSampler, TimeDependent>::step(const SpatialVector& old
             const auto k2 = sampler_->sample(move(oldPos, k1, stepSize / 2));
             const auto k3 = sampler_->sample(move(oldPos, k2, stepSize / 2));
             const auto k4 = sampler_->sample(move(oldPos, k3, stepSize));
-            const auto&& K = [n = normalizeSamples_, normalize, &k1, &k2, &k3, &k4]() {
-                if (n) {
-                    return normalize(k1 + k2 + k2 + k3 + k3 + k4);
-                } else {
-                    return (k1 + k2 + k2 + k3 + k3 + k4) * (1.0 / 6.0);
-                }
-            };
-            return {move(oldPos, K(), stepSize), k1};
+            return {move(oldPos, combine(k1, k2, k3, k4), stepSize), k1};
+        }
+    }
+}
+
+template <typename SpatialSampler, bool TimeDependent>
+void IntegralLineTracer<SpatialSampler, TimeDependent>::step(const SpatialVector* oldPos,
+                                                             size_t count, double stepSize,
+                                                             SpatialVector* newPos,
+                                                             SampleVector* velocity) const {
+    // Same arithmetic as the single line step, one batched sample call per stage
+    sampler_->sample(oldPos, velocity, count);
+
+    switch (integrationScheme_) {
+        case inviwo::IntegralLineProperties::IntegrationScheme::Euler:
+            for (size_t i = 0; i < count; ++i) {
+                newPos[i] = move(oldPos[i], velocity[i], stepSize);
+            }
+            return;
+        default:
+            [[fallthrough]];
+        case inviwo::IntegralLineProperties::IntegrationScheme::RK4: {
+            std::array<SampleVector, PacketSize> k2;
+            std::array<SampleVector, PacketSize> k3;
+            std::array<SampleVector, PacketSize> k4;
+            for (size_t i = 0; i < count; ++i) {
+                newPos[i] = move(oldPos[i], velocity[i], stepSize / 2);
+            }
+            sampler_->sample(newPos, k2.data(), count);
+            for (size_t i = 0; i < count; ++i) {
+                newPos[i] = move(oldPos[i], k2[i], stepSize / 2);
+            }
+            sampler_->sample(newPos, k3.data(), count);
+            for (size_t i = 0; i < count; ++i) {
+                newPos[i] = move(oldPos[i], k3[i], stepSize);
+            }
+            sampler_->sample(newPos, k4.data(), count);
+            for (size_t i = 0; i < count; ++i) {
+                newPos[i] = move(oldPos[i], combine(velocity[i], k2[i], k3[i], k4[i]), stepSize);
+            }
+            return;
         }
     }
 }
@@ -281,6 +438,54 @@ IntegralLine::TerminationReason IntegralLineTracer<SpatialSampler, TimeDependent
     return IntegralLine::TerminationReason::Steps;
 }
 
+template <typename SpatialSampler, bool TimeDependent>
+void IntegralLineTracer<SpatialSampler, TimeDependent>::integrate(size_t steps, Lanes lanes,
+                                                                  Results& results, bool fwd,
+                                                                  Reasons& reasons) const {
+    if (steps == 0) {
+        for (size_t i = 0; i < lanes.count; ++i) {
+            reasons[lanes.lane[i]] = IntegralLine::TerminationReason::StartPoint;
+        }
+        return;
+    }
+
+    std::array<bool, PacketSize> inside;
+    std::array<SpatialVector, PacketSize> newPos;
+    std::array<SampleVector, PacketSize> velocity;
+    for (size_t n = 0; n < steps && lanes.count > 0; ++n) {
+        sampler_->withinBounds(lanes.pos.data(), inside.data(), lanes.count);
+        size_t active = 0;
+        for (size_t i = 0; i < lanes.count; ++i) {
+            if (inside[i]) {
+                lanes.lane[active] = lanes.lane[i];
+                lanes.pos[active] = lanes.pos[i];
+                ++active;
+            } else {
+                reasons[lanes.lane[i]] = IntegralLine::TerminationReason::OutOfBounds;
+            }
+        }
+        lanes.count = active;
+
+        step(lanes.pos.data(), lanes.count, stepSize_ * (fwd ? 1.0 : -1.0), newPos.data(),
+             velocity.data());
+
+        active = 0;
+        for (size_t i = 0; i < lanes.count; ++i) {
+            if (addPoint(results[lanes.lane[i]].line, newPos[i], velocity[i])) {
+                lanes.lane[active] = lanes.lane[i];
+                lanes.pos[active] = newPos[i];
+                ++active;
+            } else {
+                reasons[lanes.lane[i]] = IntegralLine::TerminationReason::ZeroVelocity;
+            }
+        }
+        lanes.count = active;
+    }
+    for (size_t i = 0; i < lanes.count; ++i) {
+        reasons[lanes.lane[i]] = IntegralLine::TerminationReason::Steps;
+    }
+}
+
 using StreamLine2DTracer = IntegralLineTracer<SpatialSampler<2, 2, double>>;
 using StreamLine3DTracer = IntegralLineTracer<SpatialSampler<3, 3, double>>;
 using PathLine3DTracer = IntegralLineTracer<Spatial4DSampler<3, double>>;
@@ -39,6 +39,7 @@
 #include <inviwo/core/ports/imageport.h>
 #include <inviwo/core/util/utilities.h>
 #include <inviwo/core/util/foreach.h>
+#include <inviwo/core/util/threadutil.h>
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
 #include <modules/vectorfieldvisualization/ports/seedpointsport.h>
@@ -116,13 +117,17 @@ void IntegralLineTracerProcessor<Tracer>::process() {
     std::mutex mutex;
     size_t startID = 0;
     for (const auto& seeds : seeds_) {
-        util::forEachParallel(*seeds, [&](const auto& p, size_t i) {
-            IntegralLine line = tracer.traceFrom(p);
-            auto size = line.getPositions().size();
-            if (size > 1) {
-                std::lock_guard<std::mutex> lock(mutex);
-                lines->push_back(std::move(line), startID + i);
-            }
+        const auto packets = (seeds->size() + Tracer::PacketSize - 1) / Tracer::PacketSize;
+        util::cooperativeFor(packets, [&](size_t packet) {
+            const auto begin = packet * Tracer::PacketSize;
+            const auto end = std::min(seeds->size(), begin + Tracer::PacketSize);
+            tracer.traceFrom(*seeds, begin, end, [&](auto&& res, size_t i) {
+                auto size = res.line.getPositions().size();
+                if (size > 1) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    lines->push_back(std::move(res.line), startID + i);
+                }
+            });
         });
         startID += seeds->size();
     }
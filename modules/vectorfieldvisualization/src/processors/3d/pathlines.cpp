@@ -35,10 +35,9 @@
 #include <modules/vectorfieldvisualization/algorithms/integrallineoperations.h>
 #include <inviwo/core/util/zip.h>
 #include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <inviwo/core/util/threadutil.h>
 
-#ifdef IVW_USE_OPENMP
-#include <omp.h>
-#endif
+#include <mutex>
 
 namespace inviwo {
 
@@ -150,24 +149,19 @@ void PathLinesDeprecated::process() {
     auto lines = std::make_shared<IntegralLineSet>(sampler->getModelMatrix());
     std::vector<BasicMesh::Vertex> vertices;
     size_t startID = 0;
+    std::mutex linesMutex;
     for (const auto& seeds : seedPoints_) {
-
-#ifdef IVW_USE_OPENMP
-#pragma omp parallel for
-#endif
-        for (long long j = 0; j < static_cast<long long>(seeds->size()); j++) {
+        util::parallelFor(0, seeds->size(), [&](size_t j) {
             const auto& p = (*seeds)[j];
             vec4 P = m * vec4(p, 1.0f);
             IntegralLine line = tracer.traceFrom(vec4(vec3(P), pathLineProperties_.getStartT()));
             auto size = line.getPositions().size();
             if (size > 1) {
-#ifdef IVW_USE_OPENMP
-#pragma omp critical
-#endif
+                std::scoped_lock lock{linesMutex};
                 // lines->push_back(line, startID + j);
                 lines->push_back(line, lines->size());
             };
-        }
+        });
         startID += seeds->size();
     }
 
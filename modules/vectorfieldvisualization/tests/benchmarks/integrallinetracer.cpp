@@ -0,0 +1,135 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumesampler.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace inviwo;
+
+constexpr size_t seedCount = 4096;
+
+// A spiral around the z-axis drifting upwards, sampled into a volume of size^3 voxels
+std::shared_ptr<Volume> makeVolume(size_t size) {
+    const size3_t dims{size};
+    auto ram = std::make_shared<VolumeRAMPrecision<dvec3>>(dims);
+    auto data = ram->getDataTyped();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const auto p = dvec3{x, y, z} / dvec3{dims - size3_t{1}} - dvec3{0.5};
+                data[VolumeRAM::posToIndex(size3_t{x, y, z}, dims)] =
+                    dvec3{-p.y + 0.1 * p.x, p.x + 0.1 * p.y, 0.2};
+            }
+        }
+    }
+    return std::make_shared<Volume>(ram);
+}
+
+std::vector<dvec3> randomSeeds() {
+    std::vector<dvec3> seeds(seedCount);
+    std::mt19937 rand{7};
+    std::uniform_real_distribution<double> dist{0.0, 1.0};
+    std::generate(seeds.begin(), seeds.end(),
+                  [&]() { return dvec3{dist(rand), dist(rand), dist(rand)}; });
+    return seeds;
+}
+
+std::unique_ptr<StreamLine3DTracer> makeTracer(const benchmark::State& state,
+                                               std::shared_ptr<const Volume> volume) {
+    IntegralLineProperties props("props", "Props");
+    props.numberOfSteps_.set(200);
+    props.stepSize_.set(0.005f);
+    props.stepDirection_.set(IntegralLineProperties::Direction::BOTH);
+    props.integrationScheme_.set(state.range(0) == 0
+                                     ? IntegralLineProperties::IntegrationScheme::Euler
+                                     : IntegralLineProperties::IntegrationScheme::RK4);
+    props.seedPointsSpace_.set(CoordinateSpace::Data);
+    return std::make_unique<StreamLine3DTracer>(std::make_shared<VolumeDoubleSampler<3>>(volume),
+                                                props);
+}
+
+void TracerScalar(benchmark::State& state) {
+    const auto volume = makeVolume(64);
+    const auto tracer = makeTracer(state, volume);
+    const auto seeds = randomSeeds();
+    size_t points = 0;
+    for (auto _ : state) {
+        for (auto& seed : seeds) {
+            auto res = tracer->traceFrom(seed);
+            points += res.line.getPositions().size();
+            benchmark::DoNotOptimize(res);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * seedCount));
+    state.counters["points"] = benchmark::Counter(static_cast<double>(points),
+                                                  benchmark::Counter::kIsRate);
+}
+
+void TracerPacket(benchmark::State& state) {
+    const auto volume = makeVolume(64);
+    const auto tracer = makeTracer(state, volume);
+    const auto seeds = randomSeeds();
+    size_t points = 0;
+    for (auto _ : state) {
+        tracer->traceFrom(seeds, 0, seeds.size(), [&](StreamLine3DTracer::Result&& res, size_t) {
+            points += res.line.getPositions().size();
+            benchmark::DoNotOptimize(res);
+        });
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * seedCount));
+    state.counters["points"] = benchmark::Counter(static_cast<double>(points),
+                                                  benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+// Argument 0 traces with Euler, 1 with RK4. 4096 random seeds per iteration
+BENCHMARK(TracerScalar)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(TracerPacket)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
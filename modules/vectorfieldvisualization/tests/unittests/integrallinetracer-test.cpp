@@ -0,0 +1,189 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <modules/vectorfieldvisualization/integrallinetracer.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumesampler.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+using Reason = IntegralLine::TerminationReason;
+
+// A spiral around the z-axis that slowly moves outwards and drifts upwards, with zero velocity
+// for z < 0.1 and z > 0.9. Lines leave the unit cube through the sides or stop in the slabs.
+dvec3 field(const dvec3& p) {
+    if (p.z < 0.1 || p.z > 0.9) return dvec3{0.0};
+    const auto x = p.x - 0.5;
+    const auto y = p.y - 0.5;
+    return dvec3{-y + 0.2 * x, x + 0.2 * y, 0.3};
+}
+
+class AnalyticSampler : public SpatialSampler<3, 3, double> {
+public:
+    AnalyticSampler(const Volume& volume) : SpatialSampler<3, 3, double>(volume) {}
+
+protected:
+    virtual dvec3 sampleDataSpace(const dvec3& pos) const override { return field(pos); }
+    virtual bool withinBoundsDataSpace(const dvec3& pos) const override {
+        return glm::all(glm::greaterThanEqual(pos, dvec3{0.0})) &&
+               glm::all(glm::lessThanEqual(pos, dvec3{1.0}));
+    }
+};
+
+std::shared_ptr<Volume> makeVolume() {
+    const size3_t dims{16};
+    auto ram = std::make_shared<VolumeRAMPrecision<dvec3>>(dims);
+    auto data = ram->getDataTyped();
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            for (size_t x = 0; x < dims.x; ++x) {
+                const auto p = dvec3{x, y, z} / dvec3{dims - size3_t{1}};
+                data[VolumeRAM::posToIndex(size3_t{x, y, z}, dims)] = field(p);
+            }
+        }
+    }
+    auto volume = std::make_shared<Volume>(ram);
+    volume->setBasis(mat3{1.0f});
+    volume->setOffset(vec3{0.0f});
+    return volume;
+}
+
+// Seeds spread over the cube, including seeds in the zero velocity slabs and outside the
+// cube. The count is not a multiple of the packet size.
+std::vector<dvec3> makeSeeds() {
+    std::vector<dvec3> seeds;
+    for (auto z : {0.05, 0.15, 0.5, 0.85, 0.95}) {
+        for (auto y : {0.1, 0.3, 0.5, 0.7, 0.9}) {
+            for (auto x : {0.05, 0.35, 0.5, 0.65, 0.95}) {
+                seeds.emplace_back(x, y, z);
+            }
+        }
+    }
+    seeds.emplace_back(1.1, 0.5, 0.5);
+    seeds.emplace_back(0.5, -0.1, 0.5);
+    return seeds;
+}
+
+// Trace all seeds with both paths and check that the lines are identical, returns the number
+// of lines per termination reason
+std::map<Reason, size_t> compare(std::shared_ptr<const SpatialSampler<3, 3, double>> sampler,
+                                 IntegralLineProperties::IntegrationScheme scheme,
+                                 IntegralLineProperties::Direction dir) {
+    IntegralLineProperties props("props", "Props");
+    props.numberOfSteps_.set(100);
+    props.stepSize_.set(0.02f);
+    props.normalizeSamples_.set(false);
+    props.integrationScheme_.set(scheme);
+    props.stepDirection_.set(dir);
+    props.seedPointsSpace_.set(CoordinateSpace::Data);
+
+    const StreamLine3DTracer tracer(sampler, props);
+    const auto seeds = makeSeeds();
+
+    std::vector<StreamLine3DTracer::Result> packet(seeds.size());
+    std::vector<bool> traced(seeds.size(), false);
+    tracer.traceFrom(seeds, 0, seeds.size(), [&](StreamLine3DTracer::Result&& res, size_t i) {
+        packet[i] = std::move(res);
+        traced[i] = true;
+    });
+
+    std::map<Reason, size_t> reasons;
+    for (size_t i = 0; i < seeds.size(); ++i) {
+        SCOPED_TRACE("Seed " + std::to_string(i));
+        EXPECT_TRUE(traced[i]);
+        const auto scalar = tracer.traceFrom(seeds[i]);
+        const auto& line = packet[i].line;
+
+        EXPECT_EQ(packet[i].seedIndex, scalar.seedIndex);
+        EXPECT_EQ(line.getForwardTerminationReason(), scalar.line.getForwardTerminationReason());
+        EXPECT_EQ(line.getBackwardTerminationReason(),
+                  scalar.line.getBackwardTerminationReason());
+        EXPECT_EQ(line.getPositions(), scalar.line.getPositions());
+        EXPECT_EQ(line.getMetaData<dvec3>("velocity"),
+                  scalar.line.getMetaData<dvec3>("velocity"));
+
+        ++reasons[line.getForwardTerminationReason()];
+        ++reasons[line.getBackwardTerminationReason()];
+    }
+    return reasons;
+}
+
+const std::vector<IntegralLineProperties::IntegrationScheme> schemes{
+    IntegralLineProperties::IntegrationScheme::Euler,
+    IntegralLineProperties::IntegrationScheme::RK4};
+
+const std::vector<IntegralLineProperties::Direction> directions{
+    IntegralLineProperties::Direction::FWD, IntegralLineProperties::Direction::BWD,
+    IntegralLineProperties::Direction::BOTH};
+
+}  // namespace
+
+TEST(IntegralLineTracer, PacketMatchesScalarAnalytic) {
+    const auto volume = makeVolume();
+    const auto sampler = std::make_shared<AnalyticSampler>(*volume);
+
+    for (auto scheme : schemes) {
+        for (auto dir : directions) {
+            SCOPED_TRACE("Scheme " + std::to_string(static_cast<int>(scheme)) + ", direction " +
+                         std::to_string(static_cast<int>(dir)));
+            const auto reasons = compare(sampler, scheme, dir);
+            // Lines have to stop in the middle of a packet for the masking to be tested
+            EXPECT_GT(reasons.count(Reason::OutOfBounds), 0u);
+            EXPECT_GT(reasons.count(Reason::ZeroVelocity), 0u);
+        }
+    }
+}
+
+TEST(IntegralLineTracer, PacketMatchesScalarVolume) {
+    // The volume sampler overrides the batched sampling
+    const auto volume = makeVolume();
+    const auto sampler = std::make_shared<VolumeDoubleSampler<3>>(volume);
+
+    for (auto scheme : schemes) {
+        for (auto dir : directions) {
+            SCOPED_TRACE("Scheme " + std::to_string(static_cast<int>(scheme)) + ", direction " +
+                         std::to_string(static_cast<int>(dir)));
+            compare(sampler, scheme, dir);
+        }
+    }
+}
+
+}  // namespace inviwo
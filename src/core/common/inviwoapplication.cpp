@@ -69,11 +69,34 @@
 #include <inviwo/core/util/timer.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/util/commandlineparser.h>
+#include <inviwo/core/util/tracer.h>
 
 #include <inviwo/core/resourcemanager/resourcemanagerobserver.h>
 
 namespace inviwo {
 
+namespace {
+
+// Relative paths given on the command line are relative to the output path if given, otherwise
+// to the working directory. Creates the directory of the file if needed.
+std::string commandLineOutputFile(const CommandLineParser& parser, std::string filename) {
+    if (!filesystem::isAbsolutePath(filename)) {
+        auto outputDir = parser.getOutputPath();
+        if (!outputDir.empty()) {
+            filename = outputDir + "/" + filename;
+        } else {
+            filename = filesystem::getWorkingDirectory() + "/" + filename;
+        }
+    }
+    auto dir = filesystem::getFileDirectory(filename);
+    if (!filesystem::directoryExists(dir)) {
+        filesystem::createDirectoryRecursively(dir);
+    }
+    return filename;
+}
+
+}  // namespace
+
 struct AppResourceManagerObserver : ResourceManagerObserver {
     AppResourceManagerObserver(SystemSettings* settings, ResourceManager* manager)
         : settings{settings}, manager{manager} {
@@ -105,19 +128,8 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
     }()}
     , filelogger_{[&]() {
         if (commandLineParser_->getLogToFile()) {
-            auto filename = commandLineParser_->getLogToFileFileName();
-            if (!filesystem::isAbsolutePath(filename)) {
-                auto outputDir = commandLineParser_->getOutputPath();
-                if (!outputDir.empty()) {
-                    filename = outputDir + "/" + filename;
-                } else {
-                    filename = filesystem::getWorkingDirectory() + "/" + filename;
-                }
-            }
-            auto dir = filesystem::getFileDirectory(filename);
-            if (!filesystem::directoryExists(dir)) {
-                filesystem::createDirectoryRecursively(dir);
-            }
+            auto filename = commandLineOutputFile(*commandLineParser_,
+                                                  commandLineParser_->getLogToFileFileName());
             auto flog = std::make_shared<FileLogger>(filename);
             LogCentral::getPtr()->registerLogger(flog);
             return flog;
@@ -125,6 +137,10 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
             return std::shared_ptr<FileLogger>{};
         }
     }()}
+    , traceFile_{commandLineParser_->getTrace()
+                     ? commandLineOutputFile(*commandLineParser_,
+                                             commandLineParser_->getTraceFileName())
+                     : std::string{}}
     , progressCallback_()
     , pool_(
           0, []() {}, []() { RenderContext::getPtr()->clearContext(); })
@@ -164,6 +180,18 @@ InviwoApplication::InviwoApplication(int argc, char** argv, std::string displayN
     , propertyPresetManager_{std::make_unique<PropertyPresetManager>(this)}
     , portInspectorManager_{std::make_unique<PortInspectorManager>(this)} {
 
+    Tracer::setThreadName("Main Thread");
+    if (!traceFile_.empty()) Tracer::setEnabled(true);
+
+    if (commandLineParser_->getMetrics()) {
+        try {
+            processorNetworkEvaluator_->getMetrics().setEvaluationLog(commandLineOutputFile(
+                *commandLineParser_, commandLineParser_->getMetricsFileName()));
+        } catch (const Exception& e) {
+            LogError(e.getMessage());
+        }
+    }
+
     // Keep the pool at size 0 if are quiting directly to make sure that we don't have
     // unfinished results in the worker threads
     if (!commandLineParser_->getQuitApplicationAfterStartup()) {
@@ -231,7 +259,18 @@ InviwoApplication::InviwoApplication() : InviwoApplication(0, nullptr, "Inviwo")
 InviwoApplication::InviwoApplication(std::string displayName)
     : InviwoApplication(0, nullptr, displayName) {}
 
-InviwoApplication::~InviwoApplication() { resizePool(0); }
+InviwoApplication::~InviwoApplication() {
+    resizePool(0);
+
+    if (!traceFile_.empty()) {
+        Tracer::setEnabled(false);
+        try {
+            Tracer::exportChromeTrace(traceFile_);
+        } catch (const Exception& e) {
+            LogError(e.getMessage());
+        }
+    }
+}
 
 void InviwoApplication::registerModules(
     std::vector<std::unique_ptr<InviwoModuleFactoryObject>> moduleFactories) {
@@ -318,7 +357,7 @@ void InviwoApplication::postProgress(std::string progress) {
 size_t InviwoApplication::getPoolSize() const { return pool_.getSize(); }
 
 void InviwoApplication::setPostEnqueueFront(std::function<void()> func) {
-    queue_.postEnqueue = std::move(func);
+    postEnqueue_ = std::move(func);
 }
 
 const std::string& InviwoApplication::getDisplayName() const { return displayName_; }
@@ -376,29 +415,33 @@ void InviwoApplication::setApplicationUsageMode(UsageMode mode) {
 std::locale InviwoApplication::getUILocale() const { return std::locale(); }
 
 void InviwoApplication::dispatchFrontAndForget(std::function<void()> fun) {
-    {
-        std::unique_lock<std::mutex> lock(queue_.mutex);
-        queue_.tasks.push(std::move(fun));
-    }
-    if (queue_.postEnqueue) queue_.postEnqueue();
+    if (queue_.push(std::move(fun)) && postEnqueue_) postEnqueue_();
+}
+
+void InviwoApplication::dispatchFrontCoalesced(const FrontQueue::Token& token,
+                                               std::function<void()> fun) {
+    if (queue_.push(token, std::move(fun)) && postEnqueue_) postEnqueue_();
 }
 
 size_t InviwoApplication::processFront() {
-    {
+    NetworkLock netlock(processorNetwork_.get());
+    IVW_TRACE_SCOPE("core", "Process front queue");
+    return queue_.process();
+}
+
+size_t InviwoApplication::processFrontFor(std::chrono::microseconds budget) {
+    const auto left = [&]() {
         NetworkLock netlock(processorNetwork_.get());
-        std::function<void()> task;
-        while (true) {
-            {
-                std::unique_lock<std::mutex> lock{queue_.mutex};
-                if (queue_.tasks.empty()) break;
-                task = std::move(queue_.tasks.front());
-                queue_.tasks.pop();
-            }
-            task();
-        }
-    }
-    std::unique_lock<std::mutex> lock{queue_.mutex};
-    return queue_.tasks.size();
+        IVW_TRACE_SCOPE("core", "Process front queue");
+        return queue_.process(budget);
+    }();
+    // Give the event loop a chance to paint before running the rest
+    if (left != 0 && postEnqueue_) postEnqueue_();
+    return left;
+}
+
+FrontQueue::Metrics InviwoApplication::getFrontQueueMetrics() const {
+    return queue_.getMetrics();
 }
 
 void InviwoApplication::setProgressCallback(std::function<void(std::string)> progressCallback) {
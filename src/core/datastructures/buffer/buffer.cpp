@@ -60,8 +60,7 @@ void BufferBase::setSize(size_t size) {
 
     if (lastValidRepresentation_) {
         // Resize last valid representation
-        lastValidRepresentation_->setSize(size);
-        invalidateAllOther(lastValidRepresentation_.get());
+        editRepresentation(lastValidRepresentation_.get())->setSize(size);
     }
 }
 
@@ -92,6 +92,19 @@ NormalizedHistogram::NormalizedHistogram(dvec2 dataRange, std::vector<double> co
     }
 }
 
+NormalizedHistogram::NormalizedHistogram(dvec2 dataRange, std::vector<double> counts, double min,
+                                         double max, double mean, double standardDeviation,
+                                         const util::QuantileSketch& sketch)
+    : NormalizedHistogram(dataRange, std::move(counts), min, max, mean, standardDeviation) {
+    if (!sketch.empty()) {
+        std::vector<double> fractions(stats_.percentiles.size());
+        for (size_t i = 0; i < fractions.size(); ++i) {
+            fractions[i] = static_cast<double>(i) / static_cast<double>(fractions.size() - 1);
+        }
+        stats_.percentiles = sketch.quantiles(fractions);
+    }
+}
+
 double NormalizedHistogram::getMaximumBinValue() const { return maximumBinCount_; }
 
 std::vector<double>& NormalizedHistogram::getData() { return data_; }
@@ -75,8 +75,7 @@ void Layer::setDimensions(const size2_t& dim) {
     defaultDimensions_ = dim;
     if (lastValidRepresentation_) {
         // Resize last valid representation
-        lastValidRepresentation_->setDimensions(dim);
-        invalidateAllOther(lastValidRepresentation_.get());
+        editRepresentation(lastValidRepresentation_.get())->setDimensions(dim);
     }
 }
 
@@ -100,8 +99,7 @@ const DataFormatBase* Layer::getDataFormat() const {
 void Layer::setSwizzleMask(const SwizzleMask& mask) {
     defaultSwizzleMask_ = mask;
     if (lastValidRepresentation_) {
-        lastValidRepresentation_->setSwizzleMask(mask);
-        invalidateAllOther(lastValidRepresentation_.get());
+        editRepresentation(lastValidRepresentation_.get())->setSwizzleMask(mask);
     }
 }
 
@@ -115,8 +113,7 @@ SwizzleMask Layer::getSwizzleMask() const {
 void Layer::setInterpolation(InterpolationType interpolation) {
     defaultInterpolation_ = interpolation;
     if (lastValidRepresentation_) {
-        lastValidRepresentation_->setInterpolation(interpolation);
-        invalidateAllOther(lastValidRepresentation_.get());
+        editRepresentation(lastValidRepresentation_.get())->setInterpolation(interpolation);
     }
 }
 
@@ -130,8 +127,7 @@ InterpolationType Layer::getInterpolation() const {
 void Layer::setWrapping(const Wrapping2D& wrapping) {
     defaultWrapping_ = wrapping;
     if (lastValidRepresentation_) {
-        lastValidRepresentation_->setWrapping(wrapping);
-        invalidateAllOther(lastValidRepresentation_.get());
+        editRepresentation(lastValidRepresentation_.get())->setWrapping(wrapping);
     }
 }
 
@@ -145,16 +141,16 @@ Wrapping2D Layer::getWrapping() const {
 void Layer::copyRepresentationsTo(Layer* targetLayer) {
     for (auto& source : representations_) {
         auto sourceRepr = source.second.get();
-        if (sourceRepr->isValid()) {
-            for (auto& target : targetLayer->representations_) {
-                auto targetRepr = target.second.get();
-                if (typeid(*sourceRepr) == typeid(*targetRepr)) {
-                    if (sourceRepr->copyRepresentationsTo(targetRepr)) {
-                        targetLayer->invalidateAllOther(targetRepr);
-                        return;
-                    }
-                }
-            }
+        if (!sourceRepr->isValid()) continue;
+
+        auto& targets = targetLayer->representations_;
+        auto it = std::find_if(targets.begin(), targets.end(), [&](const auto& target) {
+            return typeid(*sourceRepr) == typeid(*target.second);
+        });
+        if (it != targets.end()) {
+            // The target might share the representation with another layer, detach it first
+            auto targetRepr = targetLayer->editRepresentation(it->second.get());
+            if (sourceRepr->copyRepresentationsTo(targetRepr)) return;
         }
     }
 
@@ -37,10 +37,10 @@ struct LayerRAMCreationDispatcher {
     std::shared_ptr<LayerRAM> operator()(const size2_t& dimensions, LayerType type,
                                          const SwizzleMask& swizzleMask,
                                          InterpolationType interpolation,
-                                         const Wrapping2D& wrapping) {
+                                         const Wrapping2D& wrapping, DataInitialization init) {
         using F = typename T::type;
         return std::make_shared<LayerRAMPrecision<F>>(dimensions, type, swizzleMask, interpolation,
-                                                      wrapping);
+                                                      wrapping, init);
     }
 };
 
@@ -48,10 +48,10 @@ std::shared_ptr<LayerRAM> createLayerRAM(const size2_t& dimensions, LayerType ty
                                          const DataFormatBase* format,
                                          const SwizzleMask& swizzleMask,
                                          InterpolationType interpolation,
-                                         const Wrapping2D& wrapping) {
+                                         const Wrapping2D& wrapping, DataInitialization init) {
     LayerRAMCreationDispatcher disp;
     return dispatching::dispatch<std::shared_ptr<LayerRAM>, dispatching::filter::All>(
-        format->getId(), disp, dimensions, type, swizzleMask, interpolation, wrapping);
+        format->getId(), disp, dimensions, type, swizzleMask, interpolation, wrapping, init);
 }
 
 }  // namespace inviwo
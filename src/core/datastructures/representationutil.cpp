@@ -34,6 +34,7 @@
 #include <inviwo/core/datastructures/volume/volume.h>
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 #include <inviwo/core/datastructures/volume/volumeramconverter.h>
+#include <inviwo/core/datastructures/volume/volumecompressedconverter.h>
 #include <inviwo/core/datastructures/image/layerramprecision.h>
 #include <inviwo/core/datastructures/image/layerramconverter.h>
 #include <inviwo/core/datastructures/buffer/bufferramprecision.h>
@@ -153,6 +154,10 @@ void registerCoreRepresentationsHelper(T& obj) {
     // Register Converters
     obj.template registerRepresentationConverter<VolumeRepresentation>(
         std::make_unique<VolumeDisk2RAMConverter>());
+    obj.template registerRepresentationConverter<VolumeRepresentation>(
+        std::make_unique<VolumeRAM2CompressedConverter>());
+    obj.template registerRepresentationConverter<VolumeRepresentation>(
+        std::make_unique<VolumeCompressed2RAMConverter>());
     obj.template registerRepresentationConverter<LayerRepresentation>(
         std::make_unique<LayerDisk2RAMConverter>());
 }
@@ -256,6 +256,13 @@ std::vector<TFPrimitiveData> TransferFunction::simplify(const std::vector<TFPrim
 void TransferFunction::calcTransferValues() const {
     IVW_ASSERT(std::is_sorted(sorted_.begin(), sorted_.end(), comparePtr{}), "Should be sorted");
 
+    // The layer might have been copied and share our representation, detach before modifying it.
+    if (data_->isShared(dataRepr_.get())) {
+        dataRepr_ = std::shared_ptr<LayerRAMPrecision<vec4>>(dataRepr_->clone());
+        data_->addRepresentation(dataRepr_);
+        data_->removeOtherRepresentations(dataRepr_.get());
+    }
+
     // We assume the the points a sorted here.
     auto dataArray = dataRepr_->getDataTyped();
     const auto size = dataRepr_->getDimensions().x;
@@ -40,6 +40,7 @@ Volume::Volume(size3_t defaultDimensions, const DataFormatBase* defaultFormat,
     , StructuredGridEntity<3>{}
     , MetaDataOwner{}
     , HistogramSupplier{}
+    , VolumePyramidSupplier{}
     , dataMap_{defaultFormat}
     , defaultDimensions_{defaultDimensions}
     , defaultDataFormat_{defaultFormat}
@@ -52,6 +53,7 @@ Volume::Volume(std::shared_ptr<VolumeRepresentation> in)
     , StructuredGridEntity<3>{}
     , MetaDataOwner{}
     , HistogramSupplier{}
+    , VolumePyramidSupplier{}
     , dataMap_{in->getDataFormat()}
     , defaultDimensions_{in->getDimensions()}
     , defaultDataFormat_{in->getDataFormat()}
@@ -70,8 +72,7 @@ void Volume::setDimensions(const size3_t& dim) {
 
     if (lastValidRepresentation_) {
         // Resize last valid representation
-        lastValidRepresentation_->setDimensions(dim);
-        invalidateAllOther(lastValidRepresentation_.get());
+        editRepresentation(lastValidRepresentation_.get())->setDimensions(dim);
     }
 }
 
@@ -94,8 +95,7 @@ const DataFormatBase* Volume::getDataFormat() const {
 void Volume::setSwizzleMask(const SwizzleMask& mask) {
     defaultSwizzleMask_ = mask;
     if (lastValidRepresentation_) {
-        lastValidRepresentation_->setSwizzleMask(mask);
-        invalidateAllOther(lastValidRepresentation_.get());
+        editRepresentation(lastValidRepresentation_.get())->setSwizzleMask(mask);
     }
 }
 
@@ -109,8 +109,7 @@ SwizzleMask Volume::getSwizzleMask() const {
 void Volume::setInterpolation(InterpolationType interpolation) {
     defaultInterpolation_ = interpolation;
     if (lastValidRepresentation_) {
-        lastValidRepresentation_->setInterpolation(interpolation);
-        invalidateAllOther(lastValidRepresentation_.get());
+        editRepresentation(lastValidRepresentation_.get())->setInterpolation(interpolation);
     }
 }
 
@@ -124,8 +123,7 @@ InterpolationType Volume::getInterpolation() const {
 void Volume::setWrapping(const Wrapping3D& wrapping) {
     defaultWrapping_ = wrapping;
     if (lastValidRepresentation_) {
-        lastValidRepresentation_->setWrapping(wrapping);
-        invalidateAllOther(lastValidRepresentation_.get());
+        editRepresentation(lastValidRepresentation_.get())->setWrapping(wrapping);
     }
 }
 
@@ -227,6 +225,21 @@ std::shared_ptr<HistogramCalculationState> Volume::calculateHistograms(size_t bi
         std::static_pointer_cast<VolumeRAM>(lastValidRepresentation_), dataMap_.dataRange, bins);
 }
 
+std::shared_ptr<const VolumePyramid> Volume::getPyramid(PyramidFilter filter) const {
+    getRepresentation<VolumeRAM>();  // make sure lastValidRepresentation_ is VolumeRAM
+    return VolumePyramidSupplier::getPyramid(
+        std::static_pointer_cast<VolumeRAM>(lastValidRepresentation_), filter);
+}
+
+std::shared_ptr<VolumePyramidCalculationState> Volume::calculatePyramid(
+    PyramidFilter filter) const {
+    getRepresentation<VolumeRAM>();  // make sure lastValidRepresentation_ is VolumeRAM
+    return VolumePyramidSupplier::startPyramidCalculation(
+        std::static_pointer_cast<VolumeRAM>(lastValidRepresentation_), filter);
+}
+
+void Volume::representationModified(const VolumeRepresentation*) { invalidatePyramids(); }
+
 template class IVW_CORE_TMPL_INST DataReaderType<Volume>;
 template class IVW_CORE_TMPL_INST DataWriterType<Volume>;
 template class IVW_CORE_TMPL_INST DataReaderType<VolumeSequence>;
@@ -0,0 +1,527 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volumecompressed.h>
+#include <inviwo/core/datastructures/volume/volumeram.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/threadutil.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+namespace inviwo {
+
+namespace {
+
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<unsigned char>& out) : out_{out} {}
+
+    // At most 7 bits are pending, and values are at most 33 bits wide, so the accumulator
+    // never overflows.
+    void write(std::uint64_t value, int bits) {
+        acc_ |= value << pending_;
+        pending_ += bits;
+        while (pending_ >= 8) {
+            out_.push_back(static_cast<unsigned char>(acc_));
+            acc_ >>= 8;
+            pending_ -= 8;
+        }
+    }
+    void flush() {
+        if (pending_ > 0) out_.push_back(static_cast<unsigned char>(acc_));
+        acc_ = 0;
+        pending_ = 0;
+    }
+
+private:
+    std::vector<unsigned char>& out_;
+    std::uint64_t acc_ = 0;
+    int pending_ = 0;
+};
+
+class BitReader {
+public:
+    BitReader(const unsigned char* data, const unsigned char* end) : data_{data}, end_{end} {}
+
+    std::uint64_t read(int bits) {
+        while (available_ < bits) {
+            acc_ |= static_cast<std::uint64_t>(data_ < end_ ? *data_++ : 0) << available_;
+            available_ += 8;
+        }
+        const auto value = acc_ & ((std::uint64_t{1} << bits) - 1);
+        acc_ >>= bits;
+        available_ -= bits;
+        return value;
+    }
+
+private:
+    const unsigned char* data_;
+    const unsigned char* end_;
+    std::uint64_t acc_ = 0;
+    int available_ = 0;
+};
+
+int bitWidth(std::uint64_t value) {
+    int bits = 0;
+    while (value) {
+        ++bits;
+        value >>= 1;
+    }
+    return bits;
+}
+
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+void append(std::vector<unsigned char>& out, std::int64_t value) {
+    const auto size = out.size();
+    out.resize(size + sizeof(value));
+    std::memcpy(out.data() + size, &value, sizeof(value));
+}
+
+std::int64_t extract(const unsigned char*& data) {
+    std::int64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    data += sizeof(value);
+    return value;
+}
+
+size_t packedSize(size_t count, int bits) { return (count * bits + 7) / 8; }
+
+/**
+ * Call func with a null pointer of the primitive type of format, if it is an integer type of at
+ * most 32 bits. Returns false for all other formats.
+ */
+template <typename Func>
+bool withIntegerPrimitive(const DataFormatBase* format, Func&& func) {
+    const auto precision = format->getPrecision();
+    switch (format->getNumericType()) {
+        case NumericType::SignedInteger:
+            if (precision == 8) return func(static_cast<std::int8_t*>(nullptr)), true;
+            if (precision == 16) return func(static_cast<std::int16_t*>(nullptr)), true;
+            if (precision == 32) return func(static_cast<std::int32_t*>(nullptr)), true;
+            return false;
+        case NumericType::UnsignedInteger:
+            if (precision == 8) return func(static_cast<std::uint8_t*>(nullptr)), true;
+            if (precision == 16) return func(static_cast<std::uint16_t*>(nullptr)), true;
+            if (precision == 32) return func(static_cast<std::uint32_t*>(nullptr)), true;
+            return false;
+        case NumericType::Float:
+        case NumericType::NotSpecialized:
+        default:
+            return false;
+    }
+}
+
+}  // namespace
+
+VolumeCompressed::VolumeCompressed(size3_t dimensions, const DataFormatBase* format,
+                                   const SwizzleMask& swizzleMask, InterpolationType interpolation,
+                                   const Wrapping3D& wrapping, size3_t brickSize)
+    : VolumeRepresentation(format)
+    , dimensions_{dimensions}
+    , brickSize_{brickSize}
+    , swizzleMask_{swizzleMask}
+    , interpolation_{interpolation}
+    , wrapping_{wrapping}
+    , bricks_{}
+    , cacheMutex_{}
+    , cacheSize_{defaultCacheSize}
+    , cache_{} {
+
+    if (glm::compMul(brickSize_) == 0) {
+        throw Exception("Invalid brick size for compressed volume", IVW_CONTEXT);
+    }
+    // Start out with all voxels zero, all bricks share the same constant brick.
+    auto zero = std::make_shared<Brick>(
+        Brick{Codec::Constant, std::vector<unsigned char>(format->getSize(), 0)});
+    bricks_.assign(getNumberOfBricks(), zero);
+}
+
+VolumeCompressed::VolumeCompressed(const VolumeRAM& ram, size3_t brickSize)
+    : VolumeCompressed(ram.getDimensions(), ram.getDataFormat(), ram.getSwizzleMask(),
+                       ram.getInterpolation(), ram.getWrapping(), brickSize) {
+    setData(ram.getData());
+}
+
+VolumeCompressed::VolumeCompressed(const VolumeCompressed& rhs)
+    : VolumeRepresentation(rhs)
+    , dimensions_{rhs.dimensions_}
+    , brickSize_{rhs.brickSize_}
+    , swizzleMask_{rhs.swizzleMask_}
+    , interpolation_{rhs.interpolation_}
+    , wrapping_{rhs.wrapping_}
+    , bricks_{rhs.bricks_}
+    , cacheMutex_{}
+    , cacheSize_{rhs.cacheSize_}
+    , cache_{} {}
+
+VolumeCompressed& VolumeCompressed::operator=(const VolumeCompressed& that) {
+    if (this != &that) {
+        VolumeRepresentation::operator=(that);
+        dimensions_ = that.dimensions_;
+        brickSize_ = that.brickSize_;
+        swizzleMask_ = that.swizzleMask_;
+        interpolation_ = that.interpolation_;
+        wrapping_ = that.wrapping_;
+        bricks_ = that.bricks_;
+        std::scoped_lock lock{cacheMutex_};
+        cacheSize_ = that.cacheSize_;
+        cache_.clear();
+    }
+    return *this;
+}
+
+VolumeCompressed* VolumeCompressed::clone() const { return new VolumeCompressed(*this); }
+
+std::type_index VolumeCompressed::getTypeIndex() const {
+    return std::type_index(typeid(VolumeCompressed));
+}
+
+void VolumeCompressed::setDimensions(size3_t) {
+    throw Exception("Can not set dimension of a compressed volume", IVW_CONTEXT);
+}
+
+const size3_t& VolumeCompressed::getDimensions() const { return dimensions_; }
+
+void VolumeCompressed::setSwizzleMask(const SwizzleMask& mask) { swizzleMask_ = mask; }
+
+SwizzleMask VolumeCompressed::getSwizzleMask() const { return swizzleMask_; }
+
+void VolumeCompressed::setInterpolation(InterpolationType interpolation) {
+    interpolation_ = interpolation;
+}
+
+InterpolationType VolumeCompressed::getInterpolation() const { return interpolation_; }
+
+void VolumeCompressed::setWrapping(const Wrapping3D& wrapping) { wrapping_ = wrapping; }
+
+Wrapping3D VolumeCompressed::getWrapping() const { return wrapping_; }
+
+const size3_t& VolumeCompressed::getBrickSize() const { return brickSize_; }
+
+size3_t VolumeCompressed::getBrickCounts() const {
+    return (dimensions_ + brickSize_ - size3_t{1}) / brickSize_;
+}
+
+size_t VolumeCompressed::getNumberOfBricks() const { return glm::compMul(getBrickCounts()); }
+
+size3_t VolumeCompressed::getBrickOffset(size_t brickIndex) const {
+    return util::IndexMapper3D(getBrickCounts())(brickIndex) * brickSize_;
+}
+
+size3_t VolumeCompressed::getBrickDimensions(size_t brickIndex) const {
+    return glm::min(brickSize_, dimensions_ - getBrickOffset(brickIndex));
+}
+
+size_t VolumeCompressed::getBrickIndex(const size3_t& voxel) const {
+    return util::IndexMapper3D(getBrickCounts())(voxel / brickSize_);
+}
+
+VolumeCompressed::Codec VolumeCompressed::getCodec(size_t brickIndex) const {
+    return bricks_[brickIndex]->codec;
+}
+
+template <typename Func>
+void VolumeCompressed::forEachVoxelRow(size_t brickIndex, Func&& func) const {
+    const auto offset = getBrickOffset(brickIndex);
+    const auto dims = getBrickDimensions(brickIndex);
+    size_t brickVoxel = 0;
+    for (size_t z = 0; z < dims.z; ++z) {
+        for (size_t y = 0; y < dims.y; ++y) {
+            func(offset + size3_t{0, y, z}, brickVoxel, dims.x);
+            brickVoxel += dims.x;
+        }
+    }
+}
+
+std::shared_ptr<const VolumeCompressed::Brick> VolumeCompressed::compress(
+    const unsigned char* data, size_t voxels) const {
+    const auto voxelSize = getDataFormat()->getSize();
+
+    bool constant = true;
+    for (size_t i = 1; i < voxels && constant; ++i) {
+        constant = std::memcmp(data, data + i * voxelSize, voxelSize) == 0;
+    }
+    if (constant) {
+        return std::make_shared<Brick>(
+            Brick{Codec::Constant, std::vector<unsigned char>(data, data + voxelSize)});
+    }
+
+    auto brick = std::make_shared<Brick>();
+    const bool packed = withIntegerPrimitive(getDataFormat(), [&](auto* tag) {
+        using T = std::remove_pointer_t<decltype(tag)>;
+        const auto comps = getDataFormat()->getComponents();
+        const auto count = voxels * comps;
+        std::vector<T> values(count);
+        std::memcpy(values.data(), data, count * sizeof(T));
+
+        const auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end());
+        const std::int64_t min = *minIt;
+        const int forBits = bitWidth(static_cast<std::uint64_t>(std::int64_t{*maxIt} - min));
+        const auto forSize = sizeof(std::int64_t) + 1 + packedSize(count, forBits);
+
+        std::uint64_t maxDelta = 0;
+        for (size_t i = comps; i < count; ++i) {
+            maxDelta = std::max(maxDelta,
+                                zigzag(std::int64_t{values[i]} - std::int64_t{values[i - comps]}));
+        }
+        const int deltaBits = bitWidth(maxDelta);
+        const auto deltaSize =
+            comps * sizeof(std::int64_t) + 1 + packedSize(count - comps, deltaBits);
+
+        const auto rawSize = count * sizeof(T);
+        if (rawSize <= std::min(forSize, deltaSize)) return;
+
+        auto& out = brick->data;
+        BitWriter writer{out};
+        if (forSize <= deltaSize) {
+            brick->codec = Codec::FrameOfReference;
+            out.reserve(forSize);
+            append(out, min);
+            out.push_back(static_cast<unsigned char>(forBits));
+            for (auto v : values) writer.write(static_cast<std::uint64_t>(v - min), forBits);
+        } else {
+            brick->codec = Codec::Delta;
+            out.reserve(deltaSize);
+            for (size_t c = 0; c < comps; ++c) append(out, values[c]);
+            out.push_back(static_cast<unsigned char>(deltaBits));
+            for (size_t i = comps; i < count; ++i) {
+                writer.write(zigzag(std::int64_t{values[i]} - std::int64_t{values[i - comps]}),
+                             deltaBits);
+            }
+        }
+        writer.flush();
+    });
+
+    if (!packed || brick->data.empty()) {
+        brick->codec = Codec::Raw;
+        brick->data.assign(data, data + voxels * voxelSize);
+    }
+    brick->data.shrink_to_fit();
+    return brick;
+}
+
+void VolumeCompressed::decompress(const Brick& brick, unsigned char* dst, size_t voxels) const {
+    const auto voxelSize = getDataFormat()->getSize();
+    switch (brick.codec) {
+        case Codec::Constant:
+            for (size_t i = 0; i < voxels; ++i) {
+                std::memcpy(dst + i * voxelSize, brick.data.data(), voxelSize);
+            }
+            return;
+        case Codec::Raw:
+            std::memcpy(dst, brick.data.data(), voxels * voxelSize);
+            return;
+        case Codec::FrameOfReference:
+        case Codec::Delta:
+            withIntegerPrimitive(getDataFormat(), [&](auto* tag) {
+                using T = std::remove_pointer_t<decltype(tag)>;
+                const auto comps = getDataFormat()->getComponents();
+                const auto count = voxels * comps;
+                auto* values = reinterpret_cast<T*>(dst);
+                const unsigned char* in = brick.data.data();
+                const unsigned char* end = in + brick.data.size();
+
+                if (brick.codec == Codec::FrameOfReference) {
+                    const auto min = extract(in);
+                    const int bits = *in++;
+                    BitReader reader{in, end};
+                    for (size_t i = 0; i < count; ++i) {
+                        values[i] =
+                            static_cast<T>(min + static_cast<std::int64_t>(reader.read(bits)));
+                    }
+                } else {
+                    for (size_t c = 0; c < comps; ++c) values[c] = static_cast<T>(extract(in));
+                    const int bits = *in++;
+                    BitReader reader{in, end};
+                    for (size_t i = comps; i < count; ++i) {
+                        values[i] = static_cast<T>(std::int64_t{values[i - comps]} +
+                                                   unzigzag(reader.read(bits)));
+                    }
+                }
+            });
+            return;
+    }
+}
+
+void VolumeCompressed::invalidate(size_t brickIndex) {
+    std::scoped_lock lock{cacheMutex_};
+    cache_.erase(std::remove_if(cache_.begin(), cache_.end(),
+                                [&](const auto& item) { return item.first == brickIndex; }),
+                 cache_.end());
+}
+
+void VolumeCompressed::setBrick(size_t brickIndex, const void* data) {
+    bricks_[brickIndex] = compress(static_cast<const unsigned char*>(data),
+                                   glm::compMul(getBrickDimensions(brickIndex)));
+    invalidate(brickIndex);
+}
+
+void VolumeCompressed::setSlab(size_t slab, const void* data) {
+    const auto counts = getBrickCounts();
+    const auto voxelSize = getDataFormat()->getSize();
+    const auto z0 = slab * brickSize_.z;
+    const auto* src = static_cast<const unsigned char*>(data);
+
+    util::cooperativeFor(counts.x * counts.y, [&](size_t i) {
+        const auto brickIndex = slab * counts.x * counts.y + i;
+        std::vector<unsigned char> buffer(glm::compMul(getBrickDimensions(brickIndex)) * voxelSize);
+        forEachVoxelRow(brickIndex, [&](const size3_t& voxel, size_t brickVoxel, size_t length) {
+            const auto srcVoxel =
+                ((voxel.z - z0) * dimensions_.y + voxel.y) * dimensions_.x + voxel.x;
+            std::memcpy(buffer.data() + brickVoxel * voxelSize, src + srcVoxel * voxelSize,
+                        length * voxelSize);
+        });
+        bricks_[brickIndex] = compress(buffer.data(), buffer.size() / voxelSize);
+        invalidate(brickIndex);
+    });
+}
+
+void VolumeCompressed::setData(const void* data) {
+    const auto voxelSize = getDataFormat()->getSize();
+    const auto* src = static_cast<const unsigned char*>(data);
+    const util::IndexMapper3D im(dimensions_);
+
+    util::cooperativeFor(getNumberOfBricks(), [&](size_t brickIndex) {
+        std::vector<unsigned char> buffer(glm::compMul(getBrickDimensions(brickIndex)) * voxelSize);
+        forEachVoxelRow(brickIndex, [&](const size3_t& voxel, size_t brickVoxel, size_t length) {
+            std::memcpy(buffer.data() + brickVoxel * voxelSize, src + im(voxel) * voxelSize,
+                        length * voxelSize);
+        });
+        bricks_[brickIndex] = compress(buffer.data(), buffer.size() / voxelSize);
+    });
+    clearCache();
+}
+
+void VolumeCompressed::decompressBrick(size_t brickIndex, void* dst) const {
+    decompress(*bricks_[brickIndex], static_cast<unsigned char*>(dst),
+               glm::compMul(getBrickDimensions(brickIndex)));
+}
+
+void VolumeCompressed::decompress(void* dst) const {
+    const auto voxelSize = getDataFormat()->getSize();
+    auto* out = static_cast<unsigned char*>(dst);
+    const util::IndexMapper3D im(dimensions_);
+
+    util::cooperativeFor(getNumberOfBricks(), [&](size_t brickIndex) {
+        std::vector<unsigned char> buffer(glm::compMul(getBrickDimensions(brickIndex)) * voxelSize);
+        decompressBrick(brickIndex, buffer.data());
+        forEachVoxelRow(brickIndex, [&](const size3_t& voxel, size_t brickVoxel, size_t length) {
+            std::memcpy(out + im(voxel) * voxelSize, buffer.data() + brickVoxel * voxelSize,
+                        length * voxelSize);
+        });
+    });
+}
+
+auto VolumeCompressed::getBrick(size_t brickIndex) const -> Decompressed {
+    {
+        std::scoped_lock lock{cacheMutex_};
+        auto it = std::find_if(cache_.begin(), cache_.end(),
+                               [&](const auto& item) { return item.first == brickIndex; });
+        if (it != cache_.end()) {
+            std::rotate(cache_.begin(), it, std::next(it));
+            return cache_.front().second;
+        }
+    }
+
+    // Decompress outside of the lock, other threads might be doing the same.
+    const auto voxelSize = getDataFormat()->getSize();
+    auto brick = std::make_shared<std::vector<unsigned char>>(
+        glm::compMul(getBrickDimensions(brickIndex)) * voxelSize);
+    decompressBrick(brickIndex, brick->data());
+
+    std::scoped_lock lock{cacheMutex_};
+    if (cacheSize_ == 0) return brick;
+    if (std::none_of(cache_.begin(), cache_.end(),
+                     [&](const auto& item) { return item.first == brickIndex; })) {
+        cache_.emplace(cache_.begin(), brickIndex, brick);
+        if (cache_.size() > cacheSize_) cache_.resize(cacheSize_);
+    }
+    return brick;
+}
+
+dvec4 VolumeCompressed::getAsDVec4(const size3_t& pos) const {
+    const auto brickIndex = getBrickIndex(pos);
+    const auto brick = getBrick(brickIndex);
+    const util::IndexMapper3D im(getBrickDimensions(brickIndex));
+    auto* voxel = brick->data() + im(pos - getBrickOffset(brickIndex)) * getDataFormat()->getSize();
+    return getDataFormat()->valueToVec4Double(const_cast<unsigned char*>(voxel));
+}
+
+dvec4 VolumeCompressed::getAsNormalizedDVec4(const size3_t& pos) const {
+    const auto brickIndex = getBrickIndex(pos);
+    const auto brick = getBrick(brickIndex);
+    const util::IndexMapper3D im(getBrickDimensions(brickIndex));
+    auto* voxel = brick->data() + im(pos - getBrickOffset(brickIndex)) * getDataFormat()->getSize();
+    return getDataFormat()->valueToNormalizedVec4Double(const_cast<unsigned char*>(voxel));
+}
+
+size_t VolumeCompressed::getCompressedSize() const {
+    size_t size = 0;
+    for (const auto& brick : bricks_) size += brick->data.size();
+    return size;
+}
+
+size_t VolumeCompressed::getUncompressedSize() const {
+    return glm::compMul(dimensions_) * getDataFormat()->getSize();
+}
+
+double VolumeCompressed::getCompressionRatio() const {
+    const auto compressed = getCompressedSize();
+    return compressed == 0 ? 0.0
+                           : static_cast<double>(getUncompressedSize()) /
+                                 static_cast<double>(compressed);
+}
+
+void VolumeCompressed::setCacheSize(size_t bricks) {
+    std::scoped_lock lock{cacheMutex_};
+    cacheSize_ = bricks;
+    if (cache_.size() > cacheSize_) cache_.resize(cacheSize_);
+}
+
+size_t VolumeCompressed::getCacheSize() const {
+    std::scoped_lock lock{cacheMutex_};
+    return cacheSize_;
+}
+
+void VolumeCompressed::clearCache() const {
+    std::scoped_lock lock{cacheMutex_};
+    cache_.clear();
+}
+
+}  // namespace inviwo
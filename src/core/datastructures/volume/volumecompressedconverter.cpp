@@ -0,0 +1,73 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volumecompressedconverter.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+namespace inviwo {
+
+std::shared_ptr<VolumeCompressed> VolumeRAM2CompressedConverter::createFrom(
+    std::shared_ptr<const VolumeRAM> source) const {
+    return std::make_shared<VolumeCompressed>(*source);
+}
+
+void VolumeRAM2CompressedConverter::update(std::shared_ptr<const VolumeRAM> source,
+                                           std::shared_ptr<VolumeCompressed> destination) const {
+    if (source->getDimensions() != destination->getDimensions() ||
+        source->getDataFormat() != destination->getDataFormat()) {
+        *destination = VolumeCompressed(*source, destination->getBrickSize());
+        return;
+    }
+    destination->setData(source->getData());
+    destination->setSwizzleMask(source->getSwizzleMask());
+    destination->setInterpolation(source->getInterpolation());
+    destination->setWrapping(source->getWrapping());
+}
+
+std::shared_ptr<VolumeRAM> VolumeCompressed2RAMConverter::createFrom(
+    std::shared_ptr<const VolumeCompressed> source) const {
+    auto ram = createVolumeRAM(source->getDimensions(), source->getDataFormat(), nullptr,
+                               source->getSwizzleMask(), source->getInterpolation(),
+                               source->getWrapping(), DataInitialization::Uninitialized);
+    source->decompress(ram->getData());
+    return ram;
+}
+
+void VolumeCompressed2RAMConverter::update(std::shared_ptr<const VolumeCompressed> source,
+                                           std::shared_ptr<VolumeRAM> destination) const {
+    if (destination->getDimensions() != source->getDimensions()) {
+        destination->setDimensions(source->getDimensions());
+    }
+    source->decompress(destination->getData());
+    destination->setSwizzleMask(source->getSwizzleMask());
+    destination->setInterpolation(source->getInterpolation());
+    destination->setWrapping(source->getWrapping());
+}
+
+}  // namespace inviwo
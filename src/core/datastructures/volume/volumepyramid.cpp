@@ -0,0 +1,313 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/util/indexmapper.h>
+#include <inviwo/core/util/threadutil.h>
+#include <inviwo/core/util/exception.h>
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace inviwo {
+
+namespace {
+
+template <typename T>
+T maxAbs(T a, T b) {
+    // numeric_limits, unlike std::is_signed, is also specialized for half floats
+    if constexpr (std::numeric_limits<util::value_type_t<T>>::is_signed) {
+        using std::abs;
+        for (size_t i = 0; i < util::extent<T>::value; ++i) {
+            if (abs(util::glmcomp(b, i)) > abs(util::glmcomp(a, i))) {
+                util::glmcomp(a, i) = util::glmcomp(b, i);
+            }
+        }
+        return a;
+    } else {
+        return glm::max(a, b);
+    }
+}
+
+template <typename T>
+std::shared_ptr<VolumeRAM> downsample(const VolumeRAMPrecision<T>& srcVol, size3_t f,
+                                      PyramidFilter filter) {
+    // use a double type to perform the summation
+    using P = typename util::same_extent<T, double>::type;
+
+    const size3_t srcDims{srcVol.getDimensions()};
+    const size3_t dstDims{(srcDims + f - size3_t{1}) / f};
+
+    auto dstVol = std::make_shared<VolumeRAMPrecision<T>>(
+        dstDims, srcVol.getSwizzleMask(), srcVol.getInterpolation(), srcVol.getWrapping(),
+        DataInitialization::Uninitialized);
+
+    const auto src = srcVol.getDataTyped();
+    auto dst = dstVol->getDataTyped();
+
+    const util::IndexMapper3D o(srcDims);
+    const util::IndexMapper3D n(dstDims);
+
+    util::parallelFor(0, dstDims.z, [&](size_t z) {
+        for (size_t y = 0; y < dstDims.y; ++y) {
+            for (size_t x = 0; x < dstDims.x; ++x) {
+                const size3_t first{x * f.x, y * f.y, z * f.z};
+                const size3_t last{glm::min(first + f, srcDims)};
+
+                if (filter == PyramidFilter::Mean) {
+                    P val{0.0};
+                    for (size_t oz = first.z; oz < last.z; ++oz) {
+                        for (size_t oy = first.y; oy < last.y; ++oy) {
+                            for (size_t ox = first.x; ox < last.x; ++ox) {
+                                val += src[o(ox, oy, oz)];
+                            }
+                        }
+                    }
+                    val /= static_cast<double>(glm::compMul(last - first));
+                    if constexpr (std::is_integral_v<util::value_type_t<T>>) {
+                        val = glm::round(val);
+                    }
+#include <warn/push>
+#include <warn/ignore/conversion>
+                    dst[n(x, y, z)] = static_cast<T>(val);
+#include <warn/pop>
+                } else {
+                    T val{src[o(first)]};
+                    for (size_t oz = first.z; oz < last.z; ++oz) {
+                        for (size_t oy = first.y; oy < last.y; ++oy) {
+                            for (size_t ox = first.x; ox < last.x; ++ox) {
+                                const T& v = src[o(ox, oy, oz)];
+                                switch (filter) {
+                                    case PyramidFilter::Min:
+                                        val = glm::min(val, v);
+                                        break;
+                                    case PyramidFilter::Max:
+                                        val = glm::max(val, v);
+                                        break;
+                                    default:
+                                        val = maxAbs(val, v);
+                                        break;
+                                }
+                            }
+                        }
+                    }
+                    dst[n(x, y, z)] = val;
+                }
+            }
+        }
+    });
+
+    return dstVol;
+}
+
+}  // namespace
+
+std::shared_ptr<VolumeRAM> util::volumeDownsample(const VolumeRAM& volume, size3_t factors,
+                                                  PyramidFilter filter) {
+    const auto f = glm::max(factors, size3_t{1});
+    return volume.dispatch<std::shared_ptr<VolumeRAM>>(
+        [&](auto srcVol) { return downsample(*srcVol, f, filter); });
+}
+
+VolumePyramid::VolumePyramid(std::shared_ptr<const VolumeRAM> source, PyramidFilter filter,
+                             const std::atomic<bool>* stop)
+    : filter_{filter}, levels_{} {
+    if (!source) {
+        throw Exception("Can not build a volume pyramid without a source volume",
+                        IVW_CONTEXT_CUSTOM("VolumePyramid"));
+    }
+    levels_.push_back(std::move(source));
+    while (glm::compMax(levels_.back()->getDimensions()) > 1) {
+        if (stop && *stop) return;
+        levels_.push_back(util::volumeDownsample(*levels_.back(), size3_t{2}, filter));
+    }
+}
+
+VolumePyramid::VolumePyramid(PyramidFilter filter, Levels levels)
+    : filter_{filter}, levels_{std::move(levels)} {}
+
+const VolumeRAM* VolumePyramid::getLevel(size_t level) const { return levels_.at(level).get(); }
+
+std::shared_ptr<const VolumeRAM> VolumePyramid::getSharedLevel(size_t level) const {
+    return levels_.at(level);
+}
+
+size3_t VolumePyramid::getDimensions(size_t level) const {
+    return levels_.at(level)->getDimensions();
+}
+
+bool VolumePyramid::isBuiltFrom(const VolumeRAM* ram) const {
+    return ram != nullptr && levels_.front().get() == ram;
+}
+
+size_t VolumePyramid::levelForFootprint(double voxelsPerPixel) const {
+    if (!(voxelsPerPixel > 1.0)) return 0;
+    const auto level = static_cast<size_t>(std::floor(std::log2(voxelsPerPixel)));
+    return std::min(level, levels_.size() - 1);
+}
+
+size_t VolumePyramid::levelForVoxelBudget(size_t maxVoxels) const {
+    return levelWithin(static_cast<double>(maxVoxels),
+                       [](const size3_t& dims) { return glm::compMul(dims); });
+}
+
+LevelOfDetailBudget::LevelOfDetailBudget(Milliseconds budget) : budget_{budget} {}
+
+void LevelOfDetailBudget::setBudget(Milliseconds budget) { budget_ = budget; }
+
+LevelOfDetailBudget::Milliseconds LevelOfDetailBudget::getBudget() const { return budget_; }
+
+void LevelOfDetailBudget::update(Milliseconds elapsed, size_t voxels) {
+    if (voxels == 0) return;
+    const auto measured = elapsed.count() / static_cast<double>(voxels);
+    // Exponential moving average, to smooth out individual slow frames
+    msPerVoxel_ = msPerVoxel_ <= 0.0 ? measured : 0.7 * msPerVoxel_ + 0.3 * measured;
+}
+
+void LevelOfDetailBudget::reset() { msPerVoxel_ = 0.0; }
+
+VolumePyramidCalculationState::VolumePyramidCalculationState(PyramidFilter filter)
+    : filter_{filter}, stop_{std::make_shared<std::atomic<bool>>(false)} {}
+
+VolumePyramidCalculationState::~VolumePyramidCalculationState() { *stop_ = true; }
+
+auto VolumePyramidCalculationState::whenDone(Callback callback) -> Handle {
+    if (pyramid_) {
+        callback(pyramid_);
+        return std::make_shared<Callback>(std::move(callback));
+    } else {
+        return callbacks_.add(std::move(callback));
+    }
+}
+
+VolumePyramidSupplier::VolumePyramidSupplier() : cache_{std::make_shared<Cache>()} {}
+
+VolumePyramidSupplier::VolumePyramidSupplier(const VolumePyramidSupplier&)
+    : cache_{std::make_shared<Cache>()} {}
+
+VolumePyramidSupplier& VolumePyramidSupplier::operator=(const VolumePyramidSupplier& that) {
+    if (this != &that) cache_ = std::make_shared<Cache>();
+    return *this;
+}
+
+void VolumePyramidSupplier::invalidatePyramids() {
+    std::scoped_lock lock{cache_->mutex};
+    ++cache_->generation;
+    cache_->pyramids.fill(Entry{});
+    cache_->calculations.fill({});
+}
+
+std::shared_ptr<const VolumePyramid> VolumePyramidSupplier::lookup(
+    Entry& entry, const std::shared_ptr<const VolumeRAM>& source, PyramidFilter filter) {
+    // Compare against the locked source, an expired source might share its address with a new one
+    const auto cachedSource = entry.source.lock();
+    if (!source || cachedSource != source) return nullptr;
+
+    auto pyramid = entry.pyramid.lock();
+    if (!pyramid) {
+        VolumePyramid::Levels levels{source};
+        levels.insert(levels.end(), entry.coarse.begin(), entry.coarse.end());
+        pyramid =
+            std::shared_ptr<const VolumePyramid>(new VolumePyramid(filter, std::move(levels)));
+        entry.pyramid = pyramid;
+    }
+    return pyramid;
+}
+
+void VolumePyramidSupplier::store(Entry& entry,
+                                  const std::shared_ptr<const VolumePyramid>& pyramid) {
+    entry.source = pyramid->levels_.front();
+    entry.coarse.assign(std::next(pyramid->levels_.begin()), pyramid->levels_.end());
+    entry.pyramid = pyramid;
+}
+
+std::shared_ptr<const VolumePyramid> VolumePyramidSupplier::getPyramid(
+    std::shared_ptr<const VolumeRAM> source, PyramidFilter filter) const {
+    const auto index = static_cast<size_t>(filter);
+    auto cache = cache_;
+    size_t generation = 0;
+    {
+        std::scoped_lock lock{cache->mutex};
+        if (auto pyramid = lookup(cache->pyramids[index], source, filter)) return pyramid;
+        generation = cache->generation;
+    }
+
+    auto pyramid = std::make_shared<const VolumePyramid>(source, filter);
+
+    std::scoped_lock lock{cache->mutex};
+    if (cache->generation == generation) store(cache->pyramids[index], pyramid);
+    return pyramid;
+}
+
+std::shared_ptr<VolumePyramidCalculationState> VolumePyramidSupplier::startPyramidCalculation(
+    std::shared_ptr<const VolumeRAM> source, PyramidFilter filter) const {
+    const auto index = static_cast<size_t>(filter);
+
+    std::scoped_lock lock{cache_->mutex};
+    auto calculation = cache_->calculations[index].lock();
+
+    // The result might already be cached while it is still on its way to the front thread
+    if (calculation && !calculation->isDone() && calculation->source_.lock() == source) {
+        return calculation;
+    }
+    if (auto pyramid = lookup(cache_->pyramids[index], source, filter)) {
+        if (!calculation || calculation->getPyramid() != pyramid) {
+            calculation = std::make_shared<VolumePyramidCalculationState>(filter);
+            calculation->pyramid_ = pyramid;
+            cache_->calculations[index] = calculation;
+        }
+        return calculation;
+    }
+
+    calculation = std::make_shared<VolumePyramidCalculationState>(filter);
+    calculation->source_ = source;
+    cache_->calculations[index] = calculation;
+    dispatchPool([weakState = std::weak_ptr<VolumePyramidCalculationState>(calculation),
+                  weakCache = std::weak_ptr<Cache>(cache_), generation = cache_->generation,
+                  stop = calculation->stop_, source, filter, index]() {
+        auto result = std::make_shared<const VolumePyramid>(source, filter, stop.get());
+        if (*stop) return;
+        if (auto cache = weakCache.lock()) {
+            std::scoped_lock lock{cache->mutex};
+            if (cache->generation == generation) store(cache->pyramids[index], result);
+        }
+        dispatchFrontAndForget([result, weakState]() {
+            if (auto state = weakState.lock()) {
+                state->pyramid_ = result;
+                state->callbacks_.invoke(result);
+            }
+        });
+    });
+    return calculation;
+}
+
+}  // namespace inviwo
@@ -37,20 +37,20 @@ struct VolumeRamCreationDispatcher {
     std::shared_ptr<VolumeRAM> operator()(void* dataPtr, const size3_t& dimensions,
                                           const SwizzleMask& swizzleMask,
                                           InterpolationType interpolation,
-                                          const Wrapping3D& wrapping) {
+                                          const Wrapping3D& wrapping, DataInitialization init) {
         using F = typename T::type;
         return std::make_shared<VolumeRAMPrecision<F>>(static_cast<F*>(dataPtr), dimensions,
-                                                       swizzleMask, interpolation, wrapping);
+                                                       swizzleMask, interpolation, wrapping, init);
     }
 };
 
 std::shared_ptr<VolumeRAM> createVolumeRAM(const size3_t& dimensions, const DataFormatBase* format,
                                            void* dataPtr, const SwizzleMask& swizzleMask,
                                            InterpolationType interpolation,
-                                           const Wrapping3D& wrapping) {
+                                           const Wrapping3D& wrapping, DataInitialization init) {
     VolumeRamCreationDispatcher disp;
     return dispatching::dispatch<std::shared_ptr<VolumeRAM>, dispatching::filter::All>(
-        format->getId(), disp, dataPtr, dimensions, swizzleMask, interpolation, wrapping);
+        format->getId(), disp, dataPtr, dimensions, swizzleMask, interpolation, wrapping, init);
 }
 
 }  // namespace inviwo
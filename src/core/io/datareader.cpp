@@ -34,4 +34,7 @@ namespace inviwo {
 const std::vector<FileExtension>& DataReader::getExtensions() const { return extensions_; }
 void DataReader::addExtension(FileExtension ext) { extensions_.push_back(ext); }
 
+int DataReader::getPriority() const { return priority_; }
+void DataReader::setPriority(int priority) { priority_ = priority; }
+
 }  // namespace inviwo
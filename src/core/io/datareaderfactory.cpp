@@ -52,12 +52,13 @@ std::unique_ptr<DataReader> DataReaderFactory::create(const FileExtension& key)
 }
 
 std::unique_ptr<DataReader> DataReaderFactory::create(std::string_view key) const {
+    DataReader* best = nullptr;
     for (auto& elem : map_) {
         if (iCaseCmp(elem.first.extension_, key)) {
-            return std::unique_ptr<DataReader>(elem.second->clone());
+            if (!best || elem.second->getPriority() > best->getPriority()) best = elem.second;
         }
     }
-    return nullptr;
+    return std::unique_ptr<DataReader>(best ? best->clone() : nullptr);
 }
 
 bool DataReaderFactory::hasKey(std::string_view key) const {
@@ -31,6 +31,8 @@
 
 #include <inviwo/core/datastructures/volume/volumeramprecision.h>
 
+#include <algorithm>
+
 namespace inviwo {
 
 RawVolumeRAMLoader::RawVolumeRAMLoader(const std::string& rawFile, size_t offset, bool littleEndian)
@@ -70,4 +72,27 @@ void RawVolumeRAMLoader::updateRepresentation(std::shared_ptr<VolumeRepresentati
     volumeDst->setInterpolation(src.getInterpolation());
     volumeDst->setWrapping(src.getWrapping());
 }
+
+std::shared_ptr<VolumeCompressed> util::readRawVolumeCompressed(
+    const std::string& rawFile, size_t offset, bool littleEndian, const size3_t& dimensions,
+    const DataFormatBase* format, const size3_t& brickSize,
+    const std::function<void(const VolumeRAM&)>& onSlab) {
+
+    auto compressed = std::make_shared<VolumeCompressed>(dimensions, format, swizzlemasks::rgba,
+                                                         InterpolationType::Linear,
+                                                         wrapping3d::clampAll, brickSize);
+    const auto depth = compressed->getBrickSize().z;
+    const auto sliceBytes = dimensions.x * dimensions.y * format->getSize();
+    for (size_t slab = 0; slab < compressed->getBrickCounts().z; ++slab) {
+        const auto z = slab * depth;
+        const auto slices = std::min(depth, dimensions.z - z);
+        auto ram = createVolumeRAM(size3_t{dimensions.x, dimensions.y, slices}, format);
+        util::readBytesIntoBuffer(rawFile, offset + z * sliceBytes, slices * sliceBytes,
+                                  littleEndian, format->getSize(), ram->getData());
+        compressed->setSlab(slab, ram->getData());
+        if (onSlab) onSlab(*ram);
+    }
+    return compressed;
+}
+
 }  // namespace inviwo
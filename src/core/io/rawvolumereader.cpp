@@ -46,7 +46,8 @@ RawVolumeReader::RawVolumeReader()
     , spacing_(0.01f)
     , format_(nullptr)
     , byteOffset_(0u)
-    , parametersSet_(false) {
+    , parametersSet_(false)
+    , compressed_(false) {
     addExtension(FileExtension("raw", "Raw binary file"));
 }
 
@@ -58,7 +59,8 @@ RawVolumeReader::RawVolumeReader(const RawVolumeReader& rhs)
     , spacing_(rhs.spacing_)
     , format_(rhs.format_)
     , byteOffset_(rhs.byteOffset_)
-    , parametersSet_(false) {}
+    , parametersSet_(false)
+    , compressed_(rhs.compressed_) {}
 
 RawVolumeReader& RawVolumeReader::operator=(const RawVolumeReader& that) {
     if (this != &that) {
@@ -69,6 +71,7 @@ RawVolumeReader& RawVolumeReader::operator=(const RawVolumeReader& that) {
         format_ = that.format_;
         dataMapper_ = that.dataMapper_;
         byteOffset_ = that.byteOffset_;
+        compressed_ = that.compressed_;
         DataReaderType<Volume>::operator=(that);
     }
 
@@ -87,6 +90,21 @@ void RawVolumeReader::setParameters(const DataFormatBase* format, ivec3 dimensio
     byteOffset_ = byteOffset;
 }
 
+bool RawVolumeReader::setOption(std::string_view key, std::any value) {
+    if (key == "Compressed") {
+        if (auto compressed = std::any_cast<bool>(&value)) {
+            compressed_ = *compressed;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::any RawVolumeReader::getOption(std::string_view key) {
+    if (key == "Compressed") return compressed_;
+    return std::any{};
+}
+
 std::shared_ptr<Volume> RawVolumeReader::readData(const std::string& filePath) {
     return readData(filePath, nullptr);
 }
@@ -173,10 +191,16 @@ std::shared_ptr<Volume> RawVolumeReader::readData(const std::string& filePath,
         volume->setBasis(basis);
         volume->setOffset(offset);
         volume->setWorldMatrix(wtm);
-        auto vd = std::make_shared<VolumeDisk>(filePath, dimensions_, format_);
-        auto loader = std::make_unique<RawVolumeRAMLoader>(rawFile_, byteOffset_, littleEndian_);
-        vd->setLoader(loader.release());
-        volume->addRepresentation(vd);
+        if (compressed_) {
+            volume->addRepresentation(util::readRawVolumeCompressed(
+                rawFile_, byteOffset_, littleEndian_, dimensions_, format_));
+        } else {
+            auto vd = std::make_shared<VolumeDisk>(filePath, dimensions_, format_);
+            auto loader =
+                std::make_unique<RawVolumeRAMLoader>(rawFile_, byteOffset_, littleEndian_);
+            vd->setLoader(loader.release());
+            volume->addRepresentation(vd);
+        }
 
         volume->dataMap_ = dataMapper_;
         std::string size = util::formatBytesToString(dimensions_.x * dimensions_.y * dimensions_.z *
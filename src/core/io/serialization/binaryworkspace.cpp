@@ -0,0 +1,645 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/io/serialization/binaryworkspace.h>
+#include <inviwo/core/io/serialization/ticpp.h>
+#include <inviwo/core/util/threadutil.h>
+
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <iterator>
+#include <memory>
+#include <limits>
+#include <variant>
+
+namespace inviwo {
+
+namespace binaryworkspace {
+
+namespace {
+
+enum class ValueType : std::uint8_t { String = 0, Int, Float, Double };
+
+// Subtrees larger than this with several children are decoded in parallel
+constexpr size_t parallelThreshold = 64 * 1024;
+
+template <typename T>
+bool parse(std::string_view str, T& value) {
+    const auto end = str.data() + str.size();
+    auto [p, ec] = std::from_chars(str.data(), end, value);
+    return ec == std::errc() && p == end;
+}
+
+class Encoder {
+public:
+    void write(const TiXmlNode& doc, std::ostream& stream) {
+        children(doc);
+        const auto nodes = std::move(buffer_);
+
+        // The string table is only complete after encoding the nodes, but is written first.
+        buffer_.assign(magic);
+        byte(version);
+        varint(strings_.size());
+        for (auto& str : strings_) {
+            varint(str.size());
+            buffer_.append(str);
+        }
+        stream.write(buffer_.data(), buffer_.size());
+        stream.write(nodes.data(), nodes.size());
+    }
+
+private:
+    void children(const TiXmlNode& parent) {
+        size_t count = 0;
+        for (auto* n = parent.FirstChild(); n; n = n->NextSibling()) ++count;
+        varint(count);
+        for (auto* n = parent.FirstChild(); n; n = n->NextSibling()) node(*n);
+    }
+
+    void node(const TiXmlNode& n) {
+        switch (n.Type()) {
+            case TiXmlNode::ELEMENT: {
+                const auto& elem = *n.ToElement();
+                byte(NodeType::Element);
+                string(elem.ValueStr());
+                size_t count = 0;
+                for (auto* a = elem.FirstAttribute(); a; a = a->Next()) ++count;
+                varint(count);
+                for (auto* a = elem.FirstAttribute(); a; a = a->Next()) {
+                    string(a->NameTStr());
+                    value(a->ValueStr());
+                }
+                // Reserve space for the size of the children, patched when known
+                const auto pos = buffer_.size();
+                buffer_.append(4, '\0');
+                children(elem);
+                const auto size = buffer_.size() - pos - 4;
+                if (size > std::numeric_limits<std::uint32_t>::max()) {
+                    throw SerializationException("Element too large for binary workspace",
+                                                 IVW_CONTEXT_CUSTOM("binaryworkspace::write"));
+                }
+                for (size_t i = 0; i < 4; ++i) {
+                    buffer_[pos + i] = static_cast<char>((size >> (8 * i)) & 0xff);
+                }
+                break;
+            }
+            case TiXmlNode::TEXT:
+                byte(n.ToText()->CDATA() ? NodeType::CData : NodeType::Text);
+                string(n.ValueStr());
+                break;
+            case TiXmlNode::COMMENT:
+                byte(NodeType::Comment);
+                string(n.ValueStr());
+                break;
+            case TiXmlNode::DECLARATION: {
+                const auto& decl = *n.ToDeclaration();
+                byte(NodeType::Declaration);
+                string(decl.Version());
+                string(decl.Encoding());
+                string(decl.Standalone());
+                break;
+            }
+            default:
+                throw SerializationException("Unsupported node in binary workspace",
+                                             IVW_CONTEXT_CUSTOM("binaryworkspace::write"));
+        }
+    }
+
+    void value(const std::string& str) {
+        // Only store numbers in binary form if the text can be restored exactly
+        if (std::int64_t i; parse(str, i) && detail::toStr(i) == str) {
+            byte(ValueType::Int);
+            varint((static_cast<std::uint64_t>(i) << 1) ^ static_cast<std::uint64_t>(i >> 63));
+            return;
+        }
+        if constexpr (config::charconv) {
+            if (float f; parse(str, f) && detail::toStr(f) == str) {
+                std::uint32_t bits;
+                std::memcpy(&bits, &f, sizeof(bits));
+                byte(ValueType::Float);
+                fixed(bits, 4);
+                return;
+            }
+            if (double d; parse(str, d) && detail::toStr(d) == str) {
+                std::uint64_t bits;
+                std::memcpy(&bits, &d, sizeof(bits));
+                byte(ValueType::Double);
+                fixed(bits, 8);
+                return;
+            }
+        }
+        byte(ValueType::String);
+        string(str);
+    }
+
+    template <typename E>
+    void byte(E e) {
+        buffer_.push_back(static_cast<char>(e));
+    }
+    void varint(std::uint64_t v) {
+        while (v >= 0x80) {
+            buffer_.push_back(static_cast<char>((v & 0x7f) | 0x80));
+            v >>= 7;
+        }
+        buffer_.push_back(static_cast<char>(v));
+    }
+    void fixed(std::uint64_t v, size_t bytes) {
+        for (size_t i = 0; i < bytes; ++i) buffer_.push_back(static_cast<char>(v >> (8 * i)));
+    }
+    void string(const std::string& str) {
+        auto [it, inserted] = index_.try_emplace(str, strings_.size());
+        if (inserted) strings_.push_back(str);
+        varint(it->second);
+    }
+
+    std::string buffer_;
+    std::vector<std::string> strings_;
+    std::unordered_map<std::string, size_t> index_;
+};
+
+constexpr size_t none = std::numeric_limits<size_t>::max();
+
+// Nodes refer to each other by index while decoding, which lets subtrees decoded in parallel be
+// merged by appending. The indices are turned into pointers once all nodes are in place.
+struct IndexedNode {
+    NodeType type;
+    std::string_view value;
+    size_t attributes;
+    size_t attributeCount;
+    size_t parent;
+    size_t firstChild;
+    size_t next;
+};
+
+struct Arena {
+    std::vector<IndexedNode> nodes;
+    std::vector<Attribute> attributes;
+};
+
+class Decoder {
+public:
+    explicit Decoder(std::string_view data) : data_{data}, pos_{0} {
+        if (data_.substr(0, magic.size()) != magic) {
+            error("Not a binary workspace");
+        }
+        pos_ = magic.size();
+        if (static_cast<std::uint8_t>(next()) != version) {
+            error("Unsupported binary workspace version");
+        }
+        const auto count = varint();
+        if (count > data_.size()) error("Invalid string table");
+        strings_.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto size = varint();
+            if (size > data_.size() - pos_) error("Invalid string table");
+            strings_.push_back(data_.substr(pos_, size));
+            pos_ += size;
+        }
+    }
+
+    Arena read() const {
+        Arena arena;
+        Cursor cursor{pos_, data_.size()};
+        children(cursor, arena, none);
+        return arena;
+    }
+
+private:
+    struct Cursor {
+        size_t pos;
+        size_t end;
+    };
+
+    [[noreturn]] static void error(std::string_view message) {
+        throw SerializationException(std::string{message},
+                                     IVW_CONTEXT_CUSTOM("binaryworkspace::read"));
+    }
+
+    void children(Cursor& c, Arena& arena, size_t parent) const {
+        const auto count = varint(c);
+        if (count > c.end - c.pos) error("Invalid child count");
+
+        size_t prev = none;
+        const auto link = [&](size_t index) {
+            if (prev != none) {
+                arena.nodes[prev].next = index;
+            } else if (parent != none) {
+                arena.nodes[parent].firstChild = index;
+            }
+            prev = index;
+        };
+
+        if (count > 1 && c.end - c.pos > parallelThreshold) {
+            // Locate each child using the stored sizes and decode them concurrently.
+            std::vector<Cursor> cursors;
+            cursors.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                const auto start = c.pos;
+                skip(c);
+                cursors.push_back({start, c.pos});
+            }
+            std::vector<Arena> arenas(count);
+            util::cooperativeFor(count, [&](size_t i) { node(cursors[i], arenas[i], none); });
+            for (auto& sub : arenas) {
+                const auto nodeOffset = arena.nodes.size();
+                const auto attributeOffset = arena.attributes.size();
+                for (auto n : sub.nodes) {
+                    n.attributes += attributeOffset;
+                    n.parent = n.parent == none ? parent : n.parent + nodeOffset;
+                    if (n.firstChild != none) n.firstChild += nodeOffset;
+                    if (n.next != none) n.next += nodeOffset;
+                    arena.nodes.push_back(n);
+                }
+                arena.attributes.insert(arena.attributes.end(), sub.attributes.begin(),
+                                        sub.attributes.end());
+                link(nodeOffset);
+            }
+        } else {
+            for (size_t i = 0; i < count; ++i) link(node(c, arena, parent));
+        }
+    }
+
+    size_t node(Cursor& c, Arena& arena, size_t parent) const {
+        const auto type = static_cast<NodeType>(byte(c));
+        const auto index = arena.nodes.size();
+        arena.nodes.push_back({type, {}, arena.attributes.size(), 0, parent, none, none});
+        switch (type) {
+            case NodeType::Element: {
+                arena.nodes[index].value = string(c);
+                const auto attributes = varint(c);
+                for (size_t i = 0; i < attributes; ++i) {
+                    const auto name = string(c);
+                    arena.attributes.push_back({name, value(c)});
+                }
+                arena.nodes[index].attributeCount = attributes;
+                const auto size = fixed(c, 4);
+                if (size > c.end - c.pos) error("Invalid element size");
+                Cursor sub{c.pos, c.pos + size};
+                children(sub, arena, index);
+                if (sub.pos != sub.end) error("Invalid element size");
+                c.pos = sub.end;
+                break;
+            }
+            case NodeType::Text:
+            case NodeType::CData:
+            case NodeType::Comment:
+                arena.nodes[index].value = string(c);
+                break;
+            case NodeType::Declaration:
+                for (auto name : {"version", "encoding", "standalone"}) {
+                    arena.attributes.push_back({name, string(c)});
+                }
+                arena.nodes[index].attributeCount = 3;
+                break;
+            default:
+                error("Invalid node type");
+        }
+        return index;
+    }
+
+    void skip(Cursor& c) const {
+        switch (static_cast<NodeType>(byte(c))) {
+            case NodeType::Element: {
+                varint(c);
+                const auto attributes = varint(c);
+                for (size_t i = 0; i < attributes; ++i) {
+                    varint(c);
+                    switch (static_cast<ValueType>(byte(c))) {
+                        case ValueType::Float:
+                            fixed(c, 4);
+                            break;
+                        case ValueType::Double:
+                            fixed(c, 8);
+                            break;
+                        default:
+                            varint(c);
+                    }
+                }
+                const auto size = fixed(c, 4);
+                if (size > c.end - c.pos) error("Invalid element size");
+                c.pos += size;
+                break;
+            }
+            case NodeType::Text:
+            case NodeType::CData:
+            case NodeType::Comment:
+                varint(c);
+                break;
+            case NodeType::Declaration:
+                varint(c);
+                varint(c);
+                varint(c);
+                break;
+            default:
+                error("Invalid node type");
+        }
+    }
+
+    Value value(Cursor& c) const {
+        switch (static_cast<ValueType>(byte(c))) {
+            case ValueType::String:
+                return string(c);
+            case ValueType::Int: {
+                const auto v = varint(c);
+                return static_cast<std::int64_t>((v >> 1) ^ (~(v & 1) + 1));
+            }
+            case ValueType::Float: {
+                const auto bits = static_cast<std::uint32_t>(fixed(c, 4));
+                float f;
+                std::memcpy(&f, &bits, sizeof(f));
+                return f;
+            }
+            case ValueType::Double: {
+                const auto bits = fixed(c, 8);
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                return d;
+            }
+            default:
+                error("Invalid value type");
+        }
+    }
+
+    char next() {
+        if (pos_ >= data_.size()) error("Unexpected end of data");
+        return data_[pos_++];
+    }
+    std::uint64_t varint() {
+        Cursor c{pos_, data_.size()};
+        const auto v = varint(c);
+        pos_ = c.pos;
+        return v;
+    }
+
+    std::uint8_t byte(Cursor& c) const {
+        if (c.pos >= c.end) error("Unexpected end of data");
+        return static_cast<std::uint8_t>(data_[c.pos++]);
+    }
+    std::uint64_t varint(Cursor& c) const {
+        std::uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const auto b = byte(c);
+            v |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+            if ((b & 0x80) == 0) return v;
+        }
+        error("Invalid varint");
+    }
+    std::uint64_t fixed(Cursor& c, size_t bytes) const {
+        if (bytes > c.end - c.pos) error("Unexpected end of data");
+        std::uint64_t v = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            v |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(data_[c.pos++])) << (8 * i);
+        }
+        return v;
+    }
+    std::string_view string(Cursor& c) const {
+        const auto i = varint(c);
+        if (i >= strings_.size()) error("Invalid string index");
+        return strings_[i];
+    }
+
+    std::string_view data_;
+    size_t pos_;
+    std::vector<std::string_view> strings_;
+};
+
+// ticpp does not expose the wrapped document, get to it through a visitor.
+template <typename F>
+void withDocument(const TxDocument& doc, F&& func) {
+    struct Visitor : TiXmlVisitor {
+        Visitor(F& f) : func{f} {}
+        virtual bool VisitEnter(const TiXmlDocument& d) override {
+            func(d);
+            return false;
+        }
+        F& func;
+    } visitor{func};
+    doc.Accept(&visitor);
+}
+
+void copyAttributes(const Node& node, TxElement& elem) {
+    for (size_t i = 0; i < node.attributeCount; ++i) {
+        elem.SetAttribute(std::string{node.attributes[i].name},
+                          toString(node.attributes[i].value));
+    }
+}
+
+void copyChildren(const Node& node, TxElement& elem) {
+    for (auto* n = node.firstChild; n; n = n->next) {
+        switch (n->type) {
+            case NodeType::Element: {
+                auto child = std::make_unique<TxElement>(std::string{n->value});
+                elem.LinkEndChild(child.get());
+                copyAttributes(*n, *child);
+                copyChildren(*n, *child);
+                break;
+            }
+            case NodeType::Text:
+            case NodeType::CData: {
+                auto text = std::make_unique<ticpp::Text>(std::string{n->value});
+                elem.LinkEndChild(text.get());
+                break;
+            }
+            case NodeType::Comment: {
+                auto comment = std::make_unique<TxComment>(std::string{n->value});
+                elem.LinkEndChild(comment.get());
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
+
+// Build a plain TinyXML tree, which unlike ticpp can represent CDATA sections
+void toTiXml(const Node* first, TiXmlNode& parent) {
+    for (auto* n = first; n; n = n->next) {
+        switch (n->type) {
+            case NodeType::Element: {
+                auto elem = std::make_unique<TiXmlElement>(std::string{n->value});
+                for (size_t i = 0; i < n->attributeCount; ++i) {
+                    elem->SetAttribute(std::string{n->attributes[i].name},
+                                       toString(n->attributes[i].value));
+                }
+                toTiXml(n->firstChild, *elem);
+                parent.LinkEndChild(elem.release());
+                break;
+            }
+            case NodeType::Text:
+            case NodeType::CData: {
+                auto text = std::make_unique<TiXmlText>(std::string{n->value});
+                text->SetCDATA(n->type == NodeType::CData);
+                parent.LinkEndChild(text.release());
+                break;
+            }
+            case NodeType::Comment: {
+                auto comment = std::make_unique<TiXmlComment>();
+                comment->SetValue(std::string{n->value});
+                parent.LinkEndChild(comment.release());
+                break;
+            }
+            case NodeType::Declaration:
+                parent.LinkEndChild(new TiXmlDeclaration(n->getAttribute("version"),
+                                                         n->getAttribute("encoding"),
+                                                         n->getAttribute("standalone")));
+                break;
+        }
+    }
+}
+
+}  // namespace
+
+std::string toString(const Value& value) {
+    return std::visit(
+        [](const auto& v) -> std::string {
+            if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::string_view>) {
+                return std::string{v};
+            } else {
+                return detail::toStr(v);
+            }
+        },
+        value);
+}
+
+const Node* Node::firstChildElement(std::string_view name) const {
+    for (auto* n = firstChild; n; n = n->next) {
+        if (n->type == NodeType::Element && (name.empty() || n->value == name)) return n;
+    }
+    return nullptr;
+}
+
+const Node* Node::nextSiblingElement(std::string_view name) const {
+    for (auto* n = next; n; n = n->next) {
+        if (n->type == NodeType::Element && (name.empty() || n->value == name)) return n;
+    }
+    return nullptr;
+}
+
+const Attribute* Node::attribute(std::string_view name) const {
+    for (size_t i = 0; i < attributeCount; ++i) {
+        if (attributes[i].name == name) return &attributes[i];
+    }
+    return nullptr;
+}
+
+std::string Node::getAttribute(std::string_view name) const {
+    if (const auto* attr = attribute(name)) return toString(attr->value);
+    return {};
+}
+
+Document::Document(std::istream& stream)
+    : data_{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()} {
+
+    auto arena = Decoder{std::string_view{data_.data(), data_.size()}}.read();
+
+    attributes_ = std::move(arena.attributes);
+    nodes_.reserve(arena.nodes.size());
+    const auto ptr = [&](size_t i) { return i == none ? nullptr : nodes_.data() + i; };
+    for (const auto& n : arena.nodes) {
+        nodes_.push_back({n.type, n.value, attributes_.data() + n.attributes, n.attributeCount,
+                          ptr(n.parent), ptr(n.firstChild), ptr(n.next)});
+    }
+}
+
+Document::~Document() = default;
+
+const Node* Document::firstChild() const { return nodes_.empty() ? nullptr : nodes_.data(); }
+
+const Node* Document::root() const {
+    for (auto* n = firstChild(); n; n = n->next) {
+        if (n->type == NodeType::Element) return n;
+    }
+    return nullptr;
+}
+
+bool isBinary(std::istream& stream) {
+    const auto pos = stream.tellg();
+    char buff[magic.size()] = {};
+    stream.read(buff, magic.size());
+    const bool binary = stream.gcount() == static_cast<std::streamsize>(magic.size()) &&
+                        std::string_view(buff, magic.size()) == magic;
+    stream.clear();
+    stream.seekg(pos);
+    return binary;
+}
+
+void write(const TxDocument& doc, std::ostream& stream) {
+    withDocument(doc, [&](const TiXmlDocument& d) { Encoder{}.write(d, stream); });
+}
+
+TxElement* toXml(const Node& element, TxDocument& doc) {
+    std::vector<const Node*> path;
+    for (auto* n = &element; n; n = n->parent) path.push_back(n);
+
+    // The wrappers have to outlive the linking of their children
+    std::vector<std::unique_ptr<TxElement>> elements;
+    TxNode* parent = &doc;
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        auto elem = std::make_unique<TxElement>(std::string{(*it)->value});
+        parent->LinkEndChild(elem.get());
+        copyAttributes(**it, *elem);
+        parent = elem.get();
+        elements.push_back(std::move(elem));
+    }
+    copyChildren(element, *elements.back());
+    // A wrapper owned by the document
+    return elements.back()->ToElement();
+}
+
+void xmlToBinary(std::istream& xml, std::ostream& binary) {
+    TxDocument doc;
+    try {
+        xml >> doc;
+    } catch (TxException& e) {
+        throw SerializationException(e.what(), IVW_CONTEXT_CUSTOM("binaryworkspace::xmlToBinary"));
+    }
+    write(doc, binary);
+}
+
+void binaryToXml(std::istream& binary, std::ostream& xml, bool format) {
+    const Document doc{binary};
+    TiXmlDocument tidoc;
+    toTiXml(doc.firstChild(), tidoc);
+    if (format) {
+        TiXmlPrinter printer;
+        printer.SetIndent("    ");
+        tidoc.Accept(&printer);
+        xml << printer.Str();
+    } else {
+        xml << tidoc;
+    }
+}
+
+}  // namespace binaryworkspace
+
+}  // namespace inviwo
@@ -30,6 +30,7 @@
 #include <inviwo/core/io/serialization/deserializer.h>
 #include <inviwo/core/io/serialization/serializable.h>
 #include <inviwo/core/io/serialization/versionconverter.h>
+#include <inviwo/core/io/serialization/binaryworkspace.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/processors/processorfactory.h>
 #include <inviwo/core/metadata/metadatafactory.h>
@@ -39,6 +40,7 @@
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/stringconversion.h>
 #include <inviwo/core/util/safecstr.h>
+#include <inviwo/core/util/filesystem.h>
 
 #include <inviwo/core/io/serialization/ticpp.h>
 
@@ -46,20 +48,34 @@ namespace inviwo {
 
 Deserializer::Deserializer(std::string_view fileName) : SerializeBase(fileName) {
     try {
-        doc_->LoadFile();
-        rootElement_ = doc_->FirstChildElement();
-        rootElement_->GetAttribute(std::string{SerializeConstants::VersionAttribute},
-                                   &inviwoWorkspaceVersion_, false);
+        auto stream = filesystem::ifstream(fileName_, std::ios_base::in | std::ios_base::binary);
+        if (stream && binaryworkspace::isBinary(stream)) {
+            binary_ = std::make_unique<binaryworkspace::Document>(stream);
+        } else {
+            doc_->LoadFile();
+        }
     } catch (TxException& e) {
         throw AbortException(e.what(), IVW_CONTEXT);
     }
+    setRootElement();
+    detail::getNodeAttribute(currentElement(), SerializeConstants::VersionAttribute,
+                             inviwoWorkspaceVersion_);
 }
 
 Deserializer::Deserializer(std::istream& stream, std::string_view path)
     : SerializeBase(stream, path) {
+    // Base streamed in the xml or binary data.
+    setRootElement();
+}
+
+void Deserializer::setRootElement() {
     try {
-        // Base streamed in the xml data. Get the first node.
-        rootElement_ = doc_->FirstChildElement();
+        if (binary_) {
+            binaryElement_ = binary_->root();
+            if (!binaryElement_) throw AbortException("Empty binary workspace", IVW_CONTEXT);
+        } else {
+            rootElement_ = doc_->FirstChildElement();
+        }
     } catch (TxException& e) {
         throw AbortException(e.what(), IVW_CONTEXT);
     }
@@ -90,7 +106,17 @@ void Deserializer::deserialize(std::string_view key, unsigned char& data,
 
 void Deserializer::setExceptionHandler(ExceptionHandler handler) { exceptionHandler_ = handler; }
 
-void Deserializer::convertVersion(VersionConverter* converter) { converter->convert(rootElement_); }
+bool Deserializer::isBinary() const { return binaryElement_ != nullptr; }
+
+void Deserializer::convertVersion(VersionConverter* converter) {
+    if (binaryElement_) {
+        // Converters edit the xml tree, continue with an xml copy of the current element. The
+        // previous element is restored when the current NodeSwitch goes out of scope.
+        rootElement_ = binaryworkspace::toXml(*binaryElement_, *doc_);
+        binaryElement_ = nullptr;
+    }
+    converter->convert(rootElement_);
+}
 
 void Deserializer::handleError(const ExceptionContext& context) {
     if (exceptionHandler_) {
@@ -104,7 +130,10 @@ void Deserializer::handleError(const ExceptionContext& context) {
     }
 }
 
-TxElement* Deserializer::retrieveChild(std::string_view key) {
+ElementRef Deserializer::retrieveChild(std::string_view key) {
+    if (binaryElement_) {
+        return retrieveChild_ ? binaryElement_->firstChildElement(key) : binaryElement_;
+    }
     return retrieveChild_ ? rootElement_->FirstChildElement(SafeCStr{key}, false) : rootElement_;
 }
 
@@ -114,16 +143,24 @@ void Deserializer::registerFactory(FactoryBase* factory) {
 
 int Deserializer::getInviwoWorkspaceVersion() const { return inviwoWorkspaceVersion_; }
 
-std::string detail::getNodeAttribute(TxElement* node, std::string_view key) {
-    return node->GetAttribute(SafeCStr{key});
+std::string detail::getNodeAttribute(ElementRef node, std::string_view key) {
+    if (node.binary) return node.binary->getAttribute(key);
+    return node.xml->GetAttribute(SafeCStr{key});
 }
 
-void detail::forEachChild(TxElement* node, std::string_view key,
-                          std::function<void(TxElement*)> func) {
+void detail::forEachChild(ElementRef node, std::string_view key,
+                          std::function<void(ElementRef)> func) {
+    if (node.binary) {
+        for (auto* child = node.binary->firstChildElement(key); child;
+             child = child->nextSiblingElement(key)) {
+            func(child);
+        }
+        return;
+    }
 
     TxEIt child(std::string{key});
 
-    for (child = child.begin(node); child != child.end(); ++child) {
+    for (child = child.begin(node.xml); child != child.end(); ++child) {
         func(&(*child));
     }
 }
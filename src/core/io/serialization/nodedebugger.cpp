@@ -29,13 +29,20 @@
 
 #include <inviwo/core/io/serialization/nodedebugger.h>
 #include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/io/serialization/binaryworkspace.h>
 #include <inviwo/core/io/serialization/ticpp.h>
 
 #include <sstream>
 
 namespace inviwo {
 
-NodeDebugger::NodeDebugger(TxElement* elem) {
+NodeDebugger::NodeDebugger(ElementRef element) {
+    // Binary workspaces do not keep line numbers
+    for (auto* elem = element.binary; elem; elem = elem->parent) {
+        nodes_.push_back(Node(std::string{elem->value}, elem->getAttribute("identifier"),
+                              elem->getAttribute("type"), 0));
+    }
+    auto* elem = element.xml;
     while (elem) {
         nodes_.push_back(Node(elem->Value(), elem->GetAttributeOrDefault("identifier", ""),
                               elem->GetAttributeOrDefault("type", ""), elem->Row()));
@@ -34,7 +34,7 @@ namespace inviwo {
 
 SerializationException::SerializationException(std::string_view message, ExceptionContext context,
                                                std::string_view key, std::string_view type,
-                                               std::string_view id, TxElement* node)
+                                               std::string_view id, ElementRef node)
     : Exception(message, context), data_(key, type, id, node) {}
 
 const std::string& SerializationException::getKey() const noexcept { return data_.key; }
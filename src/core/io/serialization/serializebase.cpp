@@ -29,24 +29,34 @@
 
 #include <inviwo/core/io/serialization/serializebase.h>
 #include <inviwo/core/io/serialization/ticpp.h>
+#include <inviwo/core/io/serialization/binaryworkspace.h>
 
 namespace inviwo {
 
 SerializeBase::SerializeBase()
-    : doc_{std::make_unique<TxDocument>()}, rootElement_{nullptr}, retrieveChild_{true} {}
+    : doc_{std::make_unique<TxDocument>()}
+    , rootElement_{nullptr}
+    , binaryElement_{nullptr}
+    , retrieveChild_{true} {}
 
 SerializeBase::SerializeBase(std::string_view fileName)
     : fileName_{fileName}
     , doc_{std::make_unique<TxDocument>(fileName.data())}
     , rootElement_{nullptr}
+    , binaryElement_{nullptr}
     , retrieveChild_{true} {}
 
 SerializeBase::SerializeBase(std::istream& stream, std::string_view path)
     : fileName_{path}
     , doc_{std::make_unique<TxDocument>()}
     , rootElement_{nullptr}
+    , binaryElement_{nullptr}
     , retrieveChild_{true} {
-    stream >> *doc_;
+    if (binaryworkspace::isBinary(stream)) {
+        binary_ = std::make_unique<binaryworkspace::Document>(stream);
+    } else {
+        stream >> *doc_;
+    }
 }
 
 SerializeBase::~SerializeBase() = default;
@@ -55,6 +65,11 @@ SerializeBase& SerializeBase::operator=(SerializeBase&&) noexcept = default;
 
 const std::string& SerializeBase::getFileName() const { return fileName_; }
 
+ElementRef SerializeBase::currentElement() const {
+    if (binaryElement_) return binaryElement_;
+    return rootElement_;
+}
+
 std::string SerializeBase::nodeToString(const TxElement& node) {
     try {
         TiXmlPrinter printer;
@@ -69,7 +84,7 @@ std::string SerializeBase::nodeToString(const TxElement& node) {
 NodeSwitch::NodeSwitch(NodeSwitch&& rhs) noexcept
     : node_{std::move(rhs.node_)}
     , serializer_{rhs.serializer_}
-    , storedNode_{nullptr}
+    , storedNode_{}
     , storedRetrieveChild_{rhs.storedRetrieveChild_} {
 
     std::swap(storedNode_, rhs.storedNode_);
@@ -78,7 +93,8 @@ NodeSwitch::NodeSwitch(NodeSwitch&& rhs) noexcept
 NodeSwitch& NodeSwitch::operator=(NodeSwitch&& rhs) noexcept {
     if (this != &rhs) {
         if (storedNode_) {
-            serializer_->rootElement_ = storedNode_;
+            serializer_->rootElement_ = storedNode_.xml;
+            serializer_->binaryElement_ = storedNode_.binary;
             serializer_->retrieveChild_ = storedRetrieveChild_;
         }
         node_ = std::move(rhs.node_);
@@ -86,17 +102,18 @@ NodeSwitch& NodeSwitch::operator=(NodeSwitch&& rhs) noexcept {
         storedNode_ = rhs.storedNode_;
         storedRetrieveChild_ = rhs.storedRetrieveChild_;
 
-        rhs.storedNode_ = nullptr;
+        rhs.storedNode_ = {};
     }
     return *this;
 }
 
-NodeSwitch::NodeSwitch(SerializeBase& serializer, TxElement* node, bool retrieveChild)
+NodeSwitch::NodeSwitch(SerializeBase& serializer, ElementRef node, bool retrieveChild)
     : serializer_(&serializer)
-    , storedNode_(serializer_->rootElement_)
+    , storedNode_(serializer_->currentElement())
     , storedRetrieveChild_(serializer_->retrieveChild_) {
 
-    serializer_->rootElement_ = node;
+    serializer_->rootElement_ = node.xml;
+    serializer_->binaryElement_ = node.binary;
     serializer_->retrieveChild_ = retrieveChild;
 }
 
@@ -104,37 +121,47 @@ NodeSwitch::NodeSwitch(SerializeBase& serializer, std::unique_ptr<TxElement> nod
                        bool retrieveChild)
     : node_(std::move(node))
     , serializer_(&serializer)
-    , storedNode_(serializer_->rootElement_)
+    , storedNode_(serializer_->currentElement())
     , storedRetrieveChild_(serializer_->retrieveChild_) {
 
     serializer_->rootElement_ = node_.get();
+    serializer_->binaryElement_ = nullptr;
     serializer_->retrieveChild_ = retrieveChild;
 }
 NodeSwitch::NodeSwitch(SerializeBase& serializer, std::string_view key, bool retrieveChild)
     : serializer_(&serializer)
-    , storedNode_(serializer_->rootElement_)
+    , storedNode_(serializer_->currentElement())
     , storedRetrieveChild_(serializer_->retrieveChild_) {
 
-    serializer_->rootElement_ =
-        serializer_->retrieveChild_
-            ? serializer_->rootElement_->FirstChildElement(key.data(), false)
-            : serializer_->rootElement_;
+    if (serializer_->retrieveChild_) {
+        if (auto* binary = serializer_->binaryElement_) {
+            serializer_->binaryElement_ = binary->firstChildElement(key);
+        } else {
+            serializer_->rootElement_ =
+                serializer_->rootElement_->FirstChildElement(key.data(), false);
+        }
+    }
 
     serializer_->retrieveChild_ = retrieveChild;
 }
 
 NodeSwitch::~NodeSwitch() {
     if (storedNode_) {
-        serializer_->rootElement_ = storedNode_;
+        serializer_->rootElement_ = storedNode_.xml;
+        serializer_->binaryElement_ = storedNode_.binary;
         serializer_->retrieveChild_ = storedRetrieveChild_;
     }
 }
 
-NodeSwitch::operator bool() const { return serializer_->rootElement_ != nullptr; }
+NodeSwitch::operator bool() const { return static_cast<bool>(serializer_->currentElement()); }
 
-std::string detail::getNodeAttributeOrDefault(TxElement* node, const std::string& key,
+std::string detail::getNodeAttributeOrDefault(ElementRef node, const std::string& key,
                                               const std::string& defaultValue) {
-    return node->GetAttributeOrDefault(key, defaultValue);
+    if (node.binary) {
+        const auto* attribute = node.binary->attribute(key);
+        return attribute ? binaryworkspace::toString(attribute->value) : defaultValue;
+    }
+    return node.xml->GetAttributeOrDefault(key, defaultValue);
 }
 
 }  // namespace inviwo
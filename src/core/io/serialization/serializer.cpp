@@ -32,6 +32,7 @@
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/util/safecstr.h>
 #include <inviwo/core/io/serialization/ticpp.h>
+#include <inviwo/core/io/serialization/binaryworkspace.h>
 
 namespace inviwo {
 
@@ -113,4 +114,6 @@ void Serializer::writeFile(std::ostream& stream, bool format) {
     }
 }
 
+void Serializer::writeBinaryFile(std::ostream& stream) { binaryworkspace::write(*doc_, stream); }
+
 }  // namespace inviwo
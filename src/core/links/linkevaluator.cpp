@@ -33,12 +33,15 @@
 #include <inviwo/core/properties/propertyconverter.h>
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/stdextensions.h>
+#include <inviwo/core/util/tracer.h>
 #include <inviwo/core/properties/property.h>
 #include <inviwo/core/processors/processor.h>
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/properties/compositeproperty.h>
 
+#include <set>
+
 namespace inviwo {
 
 namespace {
@@ -197,9 +200,54 @@ void LinkEvaluator::evaluateLinksFromProperty(Property* modifiedProperty) {
     auto& links = getTriggerdLinksForProperty(modifiedProperty);
     VisitedHelper helper(visited_, links);
 
+    IVW_TRACE_SCOPE_NAMED("link", modifiedProperty->getIdentifier());
+
     for (auto& link : links) {
         link.converter_->convert(link.src_, link.dst_);
     }
 }
 
+void LinkEvaluator::evaluateLinksFromProperties(const std::vector<Property*>& modified,
+                                                std::unordered_set<Property*>& evaluated) {
+    NetworkLock lock(network_);
+
+    std::unordered_map<Property*, size_t> order;
+    for (size_t i = 0; i < modified.size(); ++i) order[modified[i]] = i;
+
+    std::vector<ConvertableLink> links;
+    for (size_t i = 0; i < modified.size(); ++i) {
+        auto* src = modified[i];
+        if (util::contains(visited_, src) || evaluated.count(src) != 0) continue;
+        for (auto& link : getTriggerdLinksForProperty(src)) {
+            // The destination was set after the source, keep that value.
+            auto it = order.find(link.dst_);
+            if (it != order.end() && it->second > i) continue;
+            links.push_back(link);
+        }
+    }
+
+    // Only the last conversion along each link matters, it sees the final value of the source.
+    std::set<std::pair<Property*, Property*>> seen;
+    std::vector<ConvertableLink> unique;
+    unique.reserve(links.size());
+    for (auto it = links.rbegin(); it != links.rend(); ++it) {
+        if (seen.emplace(it->src_, it->dst_).second) unique.push_back(*it);
+    }
+    std::reverse(unique.begin(), unique.end());
+
+    for (auto* p : modified) evaluated.insert(p);
+    for (auto& link : unique) {
+        evaluated.insert(link.src_);
+        evaluated.insert(link.dst_);
+    }
+    if (unique.empty()) return;
+
+    VisitedHelper helper(visited_, unique);
+    IVW_TRACE_SCOPE("link", "Batch");
+
+    for (auto& link : unique) {
+        link.converter_->convert(link.src_, link.dst_);
+    }
+}
+
 }  // namespace inviwo
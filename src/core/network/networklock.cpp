@@ -43,4 +43,13 @@ NetworkLock& NetworkLock::operator=(NetworkLock&& that) {
     return *this;
 }
 
+NetworkBatch::NetworkBatch() : NetworkBatch(InviwoApplication::getPtr()->getProcessorNetwork()) {}
+
+NetworkBatch::NetworkBatch(NetworkBatch&& rhs) : network_(rhs.network_) { rhs.network_ = nullptr; }
+NetworkBatch& NetworkBatch::operator=(NetworkBatch&& that) {
+    NetworkBatch batch(std::move(that));
+    std::swap(network_, batch.network_);
+    return *this;
+}
+
 }  // namespace inviwo
@@ -86,13 +86,13 @@ std::unordered_set<Processor*> getSuccessors(Processor* processor) {
 std::vector<Processor*> topologicalSort(ProcessorNetwork* network) {
     // perform topological sorting and store processor order in sorted
 
-    std::vector<Processor*> sinkProcessors;
-    util::copy_if(network->getProcessors(), std::back_inserter(sinkProcessors),
-                  [](Processor* p) { return p->isSink(); });
-
+    const auto processors = network->getProcessors();
     std::unordered_set<Processor*> state;
+    state.reserve(processors.size());
     std::vector<Processor*> sorted;
-    for (auto processor : sinkProcessors) {
+    sorted.reserve(processors.size());
+    for (auto processor : processors) {
+        if (!processor->isSink()) continue;
         traverseNetwork<TraversalDirection::Up, VisitPattern::Post>(
             state, processor, [&sorted](Processor* p) { sorted.push_back(p); });
     }
@@ -102,13 +102,13 @@ std::vector<Processor*> topologicalSort(ProcessorNetwork* network) {
 std::vector<Processor*> topologicalSortFiltered(ProcessorNetwork* network) {
     // perform topological sorting and store processor order in sorted
 
-    std::vector<Processor*> sinkProcessors;
-    util::copy_if(network->getProcessors(), std::back_inserter(sinkProcessors),
-                  [](Processor* p) { return p->isSink(); });
-
+    const auto processors = network->getProcessors();
     std::unordered_set<Processor*> state;
+    state.reserve(processors.size());
     std::vector<Processor*> sorted;
-    for (auto processor : sinkProcessors) {
+    sorted.reserve(processors.size());
+    for (auto processor : processors) {
+        if (!processor->isSink()) continue;
         traverseNetwork<TraversalDirection::Up, VisitPattern::Post>(
             state, processor, [&sorted](Processor* p) { sorted.push_back(p); },
             [](Processor* p, Inport* from, Outport* to) {
@@ -0,0 +1,198 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/network/processormetrics.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <ostream>
+
+namespace inviwo {
+
+namespace {
+
+void writeCSVHeader(std::ostream& os, bool withEvaluation) {
+    if (withEvaluation) os << "evaluation,";
+    os << "identifier,classIdentifier,invalidations,evaluations,lastMs,meanMs,p95Ms,"
+          "conversions,bytesAllocated,lastConversions,lastBytesAllocated\n";
+}
+
+void writeCSVRow(std::ostream& os, const ProcessorMetrics::Entry& e) {
+    os << e.identifier << ',' << e.classIdentifier << ',' << e.invalidations << ','
+       << e.evaluations << ',' << e.lastMs << ',' << e.meanMs() << ',' << e.p95Ms() << ','
+       << e.conversions << ',' << e.bytesAllocated << ',' << e.lastConversions << ','
+       << e.lastBytesAllocated << '\n';
+}
+
+void writeJSONEntry(std::ostream& os, const ProcessorMetrics::Entry& e) {
+    os << "{\"identifier\":";
+    util::writeJSONString(os, e.identifier);
+    os << ",\"classIdentifier\":";
+    util::writeJSONString(os, e.classIdentifier);
+    os << ",\"invalidations\":" << e.invalidations << ",\"evaluations\":" << e.evaluations
+       << ",\"lastMs\":" << e.lastMs << ",\"meanMs\":" << e.meanMs() << ",\"p95Ms\":" << e.p95Ms()
+       << ",\"conversions\":" << e.conversions << ",\"bytesAllocated\":" << e.bytesAllocated
+       << ",\"lastConversions\":" << e.lastConversions
+       << ",\"lastBytesAllocated\":" << e.lastBytesAllocated << "}";
+}
+
+}  // namespace
+
+double ProcessorMetrics::Entry::meanMs() const {
+    return evaluations == 0 ? 0.0 : totalMs / static_cast<double>(evaluations);
+}
+
+double ProcessorMetrics::Entry::p95Ms() const {
+    const auto count = std::min(evaluations, historySize);
+    if (count == 0) return 0.0;
+    auto times = history;
+    const auto nth = times.begin() + (count * 95 + 99) / 100 - 1;
+    std::nth_element(times.begin(), nth, times.begin() + count);
+    return *nth;
+}
+
+ProcessorMetrics::ProcessorMetrics() = default;
+ProcessorMetrics::~ProcessorMetrics() = default;
+
+const ProcessorMetrics::Entry* ProcessorMetrics::get(const Processor* processor) const {
+    auto it = entries_.find(processor);
+    return it != entries_.end() ? &it->second : nullptr;
+}
+
+std::vector<ProcessorMetrics::Entry> ProcessorMetrics::getEntries() const {
+    std::vector<Entry> res;
+    res.reserve(entries_.size());
+    for (auto& item : entries_) res.push_back(item.second);
+    std::sort(res.begin(), res.end(),
+              [](const Entry& a, const Entry& b) { return a.identifier < b.identifier; });
+    return res;
+}
+
+size_t ProcessorMetrics::getEvaluationCount() const { return evaluations_; }
+
+void ProcessorMetrics::reset() {
+    entries_.clear();
+    evaluations_ = 0;
+}
+
+void ProcessorMetrics::writeCSV(std::ostream& os, bool header) const {
+    if (header) writeCSVHeader(os, false);
+    for (auto& e : getEntries()) writeCSVRow(os, e);
+}
+
+void ProcessorMetrics::writeJSON(std::ostream& os) const {
+    os << "{\"evaluations\":" << evaluations_ << ",\"processors\":[";
+    bool first = true;
+    for (auto& e : getEntries()) {
+        if (!first) os << ",";
+        first = false;
+        writeJSONEntry(os, e);
+    }
+    os << "]}";
+}
+
+void ProcessorMetrics::setEvaluationLog(std::string_view filename) {
+    log_.reset();
+    logFile_ = filename;
+    if (logFile_.empty()) return;
+
+    auto file = std::make_unique<std::ofstream>(filesystem::ofstream(logFile_));
+    if (!*file) {
+        logFile_.clear();
+        throw FileException("Could not open file \"" + std::string{filename} + "\" for writing",
+                            IVW_CONTEXT_CUSTOM("ProcessorMetrics"));
+    }
+    log_ = std::move(file);
+    logCSV_ = iCaseCmp(filesystem::getFileExtension(logFile_), "csv");
+    logHeader_ = logCSV_;
+}
+
+const std::string& ProcessorMetrics::getEvaluationLog() const { return logFile_; }
+
+void ProcessorMetrics::evaluationBegin() { ++evaluations_; }
+
+void ProcessorMetrics::evaluationEnd() {
+    if (!log_) return;
+
+    auto& os = *log_;
+    if (logHeader_) {
+        writeCSVHeader(os, true);
+        logHeader_ = false;
+    }
+    if (!logCSV_) os << "{\"evaluation\":" << evaluations_ << ",\"processors\":[";
+    bool first = true;
+    for (auto& e : getEntries()) {
+        if (e.lastEvaluation != evaluations_) continue;
+        if (logCSV_) {
+            os << evaluations_ << ',';
+            writeCSVRow(os, e);
+        } else {
+            if (!first) os << ",";
+            first = false;
+            writeJSONEntry(os, e);
+        }
+    }
+    if (!logCSV_) os << "]}\n";
+    os.flush();
+}
+
+void ProcessorMetrics::invalidated(const Processor* processor) { ++entry(processor).invalidations; }
+
+void ProcessorMetrics::processed(const Processor* processor, duration time,
+                                 const util::MetricCounters& before,
+                                 const util::MetricCounters& after) {
+    auto& e = entry(processor);
+    e.identifier = processor->getIdentifier();
+    e.classIdentifier = processor->getClassIdentifier();
+    e.lastMs = std::chrono::duration<double, std::milli>(time).count();
+    e.totalMs += e.lastMs;
+    e.history[e.evaluations % historySize] = e.lastMs;
+    ++e.evaluations;
+    e.lastConversions = after.conversions - before.conversions;
+    e.lastBytesAllocated = after.bytesAllocated - before.bytesAllocated;
+    e.conversions += e.lastConversions;
+    e.bytesAllocated += e.lastBytesAllocated;
+    e.lastEvaluation = evaluations_;
+}
+
+void ProcessorMetrics::remove(const Processor* processor) { entries_.erase(processor); }
+
+ProcessorMetrics::Entry& ProcessorMetrics::entry(const Processor* processor) {
+    auto [it, inserted] = entries_.try_emplace(processor);
+    if (inserted) {
+        it->second.identifier = processor->getIdentifier();
+        it->second.classIdentifier = processor->getClassIdentifier();
+    }
+    return it->second;
+}
+
+}  // namespace inviwo
@@ -41,6 +41,7 @@
 #include <inviwo/core/metadata/processormetadata.h>
 #include <inviwo/core/network/networkvisitor.h>
 #include <inviwo/core/network/networkedge.h>
+#include <inviwo/core/util/tracer.h>
 
 #include <fmt/format.h>
 
@@ -120,6 +121,14 @@ void ProcessorNetwork::removeProcessorHelper(Processor* processor) {
     for (auto& link : toDelete) {
         removeLink(link.getSource(), link.getDestination());
     }
+
+    // Forget batched changes of this processor
+    util::map_erase_remove_if(batchedProperties_, [&](const auto& item) {
+        return item.first->getOwner() && item.first->getOwner()->getProcessor() == processor;
+    });
+    util::map_erase_remove_if(batchedInvalidations_, [&](const auto& item) {
+        return item.first->getProcessor() == processor;
+    });
 }
 
 void ProcessorNetwork::removeProcessor(Processor* processor) {
@@ -287,7 +296,9 @@ void ProcessorNetwork::onWillRemoveProperty(Property* property, size_t /*index*/
             onWillRemoveProperty(p, i);
             i++;
         }
+        batchedInvalidations_.erase(comp);
     }
+    batchedProperties_.erase(property);
 
     auto toDelete =
         util::copy_if(links_, [&](const PropertyLink& link) { return link.involves(property); });
@@ -322,6 +333,95 @@ void ProcessorNetwork::evaluateLinksFromProperty(Property* source) {
     linkEvaluator_.evaluateLinksFromProperty(source);
 }
 
+void ProcessorNetwork::beginBatch() { ++batching_; }
+
+void ProcessorNetwork::endBatch() {
+    if (batching_ == 0) return;
+    if (batching_ > 1) {
+        --batching_;
+        return;
+    }
+    util::OnScopeExit end{[this]() {
+        batchedProperties_.clear();
+        batchedInvalidations_.clear();
+        --batching_;
+    }};
+    commitBatch();
+}
+
+bool ProcessorNetwork::isBatching() const { return batching_ != 0; }
+
+bool ProcessorNetwork::deferPropertyChange(Property* property) {
+    if (batching_ == 0) return false;
+    batchedProperties_[property] = batchCounter_++;
+    return true;
+}
+
+std::vector<Property*> ProcessorNetwork::takeBatchedProperties() {
+    std::vector<std::pair<Property*, size_t>> items(batchedProperties_.begin(),
+                                                    batchedProperties_.end());
+    batchedProperties_.clear();
+    std::sort(items.begin(), items.end(),
+              [](const auto& a, const auto& b) { return a.second < b.second; });
+    return util::transform(items, [](const auto& item) { return item.first; });
+}
+
+void ProcessorNetwork::commitBatch() {
+    // The batch stays active while committing, changes caused by the links and by invalidating
+    // composite properties are collected and handled in the next round.
+    NetworkLock lock(this);
+    IVW_TRACE_SCOPE("network", "Commit batch");
+
+    const auto depth = [](PropertyOwner* owner) {
+        size_t d = 0;
+        for (; owner; owner = owner->getOwner()) ++d;
+        return d;
+    };
+
+    std::unordered_set<Property*> evaluated;
+    std::vector<Processor*> changed;
+    while (!batchedProperties_.empty() || !batchedInvalidations_.empty()) {
+        if (!batchedProperties_.empty()) {
+            const auto modified = takeBatchedProperties();
+            for (auto* property : modified) {
+                auto* owner = property->getOwner();
+                if (!owner) continue;
+                if (auto processor = owner->getProcessor()) {
+                    util::push_back_unique(changed, processor);
+                }
+                const auto level = property->getInvalidationLevel();
+                if (level > InvalidationLevel::Valid) {
+                    auto& item = batchedInvalidations_[owner];
+                    item.first = std::max(item.first, level);
+                    item.second = property;
+                }
+            }
+            linkEvaluator_.evaluateLinksFromProperties(modified, evaluated);
+            continue;
+        }
+
+        // Invalidate the deepest composite properties first. Invalidating a composite modifies
+        // it, which invalidates its owner in a later round. Its owner is then only invalidated
+        // once for all its changes.
+        size_t maxDepth = 0;
+        for (auto& item : batchedInvalidations_) maxDepth = std::max(maxDepth, depth(item.first));
+        auto invalidations = util::copy_if(batchedInvalidations_, [&](const auto& item) {
+            return depth(item.first) == maxDepth;
+        });
+        for (auto& item : invalidations) batchedInvalidations_.erase(item.first);
+        for (auto& [owner, levelAndProperty] : invalidations) {
+            owner->invalidate(levelAndProperty.first, levelAndProperty.second);
+        }
+    }
+
+    // Tell observers once per processor, the nullptr avoids evaluating the links again.
+    for (auto* processor : changed) {
+        if (util::contains_if(processors_, [&](auto& item) { return item.second == processor; })) {
+            processor->notifyObserversAboutPropertyChange(nullptr);
+        }
+    }
+}
+
 void ProcessorNetwork::clear() {
     NetworkLock lock(this);
 
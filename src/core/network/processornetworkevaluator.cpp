@@ -35,12 +35,17 @@
 #include <inviwo/core/network/networkutils.h>
 #include <inviwo/core/network/networklock.h>
 #include <inviwo/core/util/clock.h>
+#include <inviwo/core/util/tracer.h>
+#include <inviwo/core/util/metriccounters.h>
+
+#include <chrono>
 
 namespace inviwo {
 
 ProcessorNetworkEvaluator::ProcessorNetworkEvaluator(ProcessorNetwork* processorNetwork)
     : processorNetwork_(processorNetwork)
-    , processorsSorted_(util::topologicalSortFiltered(processorNetwork_))
+    , processorsSorted_()
+    , sortDirty_(true)
     , evaulationQueued_(false)
     , exceptionHandler_(StandardEvaluationErrorHandler()) {
 
@@ -51,6 +56,10 @@ void ProcessorNetworkEvaluator::setExceptionHandler(EvaluationErrorHandler handl
     exceptionHandler_ = handler;
 }
 
+ProcessorMetrics& ProcessorNetworkEvaluator::getMetrics() { return metrics_; }
+
+const ProcessorMetrics& ProcessorNetworkEvaluator::getMetrics() const { return metrics_; }
+
 void ProcessorNetworkEvaluator::onProcessorNetworkEvaluateRequest() {
     // Direct request, thus we don't want to queue the evaluation anymore
     evaulationQueued_ = false;
@@ -97,9 +106,17 @@ void ProcessorNetworkEvaluator::evaluate() {
     // lock processor network to avoid concurrent evaluation
     NetworkLock lock(processorNetwork_);
 
+    if (sortDirty_) {
+        IVW_TRACE_SCOPE("network", "Sort network");
+        processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+        sortDirty_ = false;
+    }
+
     notifyObserversProcessorNetworkEvaluationBegin();
+    metrics_.evaluationBegin();
 
     IVW_CPU_PROFILING_IF(500, "Evaluated Processor Network");
+    IVW_TRACE_SCOPE("network", "Evaluate network");
 
     for (auto processor : processorsSorted_) {
         if (!processor->isValid()) {
@@ -107,6 +124,7 @@ void ProcessorNetworkEvaluator::evaluate() {
                 try {
                     // re-initialize resources (e.g., shaders) if necessary
                     if (processor->getInvalidationLevel() >= InvalidationLevel::InvalidResources) {
+                        IVW_TRACE_SCOPE_NAMED("initializeResources", processor->getIdentifier());
                         processor->initializeResources();
                     }
                 } catch (...) {
@@ -128,8 +146,13 @@ void ProcessorNetworkEvaluator::evaluate() {
 
                 try {
                     IVW_CPU_PROFILING_IF(500, "Processed " << processor->getIdentifier());
+                    IVW_TRACE_SCOPE_NAMED("process", processor->getIdentifier());
                     // do the actual processing
+                    const auto counters = util::getThreadMetricCounters();
+                    const auto start = std::chrono::steady_clock::now();
                     processor->process();
+                    metrics_.processed(processor, std::chrono::steady_clock::now() - start,
+                                       counters, util::getThreadMetricCounters());
 
                     // Set processor as valid only if we still are ready.
                     // Callbacks might have made our inports invalid, if so abort
@@ -152,33 +175,43 @@ void ProcessorNetworkEvaluator::evaluate() {
         }
     }
 
+    // The topology changed during the evaluation, evaluate again when the lock is released to
+    // pick up processors that became active
+    if (sortDirty_) evaulationQueued_ = true;
+
+    metrics_.evaluationEnd();
     notifyObserversProcessorNetworkEvaluationEnd();
 }
 
+void ProcessorNetworkEvaluator::onProcessorInvalidationEnd(Processor* p) {
+    if (!p->isValid()) metrics_.invalidated(p);
+}
+
 void ProcessorNetworkEvaluator::onProcessorSinkChanged(Processor*) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    sortDirty_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorActiveConnectionsChanged(Processor*) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    sortDirty_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidAddProcessor(Processor* p) {
     p->ProcessorObservable::addObserver(this);
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    sortDirty_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveProcessor(Processor* p) {
     p->ProcessorObservable::removeObserver(this);
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    metrics_.remove(p);
+    sortDirty_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidAddConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    sortDirty_ = true;
 }
 
 void ProcessorNetworkEvaluator::onProcessorNetworkDidRemoveConnection(const PortConnection&) {
-    processorsSorted_ = util::topologicalSortFiltered(processorNetwork_);
+    sortDirty_ = true;
 }
 
 }  // namespace inviwo
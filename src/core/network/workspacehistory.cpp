@@ -0,0 +1,365 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/network/workspacehistory.h>
+
+#include <inviwo/core/network/workspacemanager.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/processors/processorobserver.h>
+#include <inviwo/core/metadata/processormetadata.h>
+#include <inviwo/core/io/serialization/serializer.h>
+#include <inviwo/core/io/serialization/deserializer.h>
+#include <inviwo/core/util/raiiutils.h>
+
+#include <sstream>
+#include <algorithm>
+
+namespace inviwo {
+
+class WorkspaceHistory::Watcher : public ProcessorObserver, public ProcessorMetaDataObserver {
+public:
+    Watcher(WorkspaceHistory* history, Processor* processor)
+        : history_{history}, processor_{processor} {
+        processor_->ProcessorObservable::addObserver(this);
+        if (auto meta = processor_->getMetaData<ProcessorMetaData>(
+                ProcessorMetaData::CLASS_IDENTIFIER)) {
+            meta->addObserver(this);
+        }
+        identifierHandle_ = processor_->onIdentifierChange(
+            [this](std::string_view, std::string_view) { history_->markDirty(); });
+        displayNameHandle_ = processor_->onDisplayNameChange(
+            [this](std::string_view, std::string_view) { changed(false); });
+    }
+
+    // The network reports a network change for each of these as well
+    virtual void onAboutPropertyChange(Property*) override { changed(true); }
+    virtual void onProcessorPortAdded(Processor*, Port*) override { history_->markDirty(); }
+    virtual void onProcessorPortRemoved(Processor*, Port*) override { history_->markDirty(); }
+
+    virtual void onProcessorMetaDataPositionChange() override { changed(true); }
+    virtual void onProcessorMetaDataVisibilityChange() override { changed(true); }
+    virtual void onProcessorMetaDataSelectionChange() override { changed(true); }
+
+private:
+    void changed(bool networkChange) { history_->markChanged(processor_, networkChange); }
+
+    WorkspaceHistory* history_;
+    Processor* processor_;
+    Processor::NameDispatcherHandle identifierHandle_;
+    Processor::NameDispatcherHandle displayNameHandle_;
+};
+
+WorkspaceHistory::WorkspaceHistory(WorkspaceManager* manager, ProcessorNetwork* network,
+                                   std::string refPath, size_t memoryLimit)
+    : ProcessorNetworkObserver()
+    , manager_{manager}
+    , network_{network}
+    , refPath_{std::move(refPath)}
+    , memoryLimit_{memoryLimit} {
+
+    network_->addObserver(this);
+    network_->forEachProcessor([&](Processor* p) {
+        watchers_.emplace(p, std::make_unique<Watcher>(this, p));
+    });
+}
+
+WorkspaceHistory::~WorkspaceHistory() = default;
+
+bool WorkspaceHistory::pushState() {
+    if (restoring_ || !dirty_) return false;
+
+    if (structural_ || unattributed_ != 0 || states_.empty() || changed_.empty()) {
+        return pushSnapshot();
+    }
+
+    State state;
+    for (auto* processor : changed_) {
+        auto it = current_.find(processor->getIdentifier());
+        if (it == current_.end()) return pushSnapshot();
+
+        auto text = serialize(*processor);
+        if (!text) return false;
+        if (*text == *it->second) continue;
+        state.changes.emplace_back(processor->getIdentifier(), it->second, text);
+    }
+    resetChanges();
+    if (state.changes.empty()) return false;
+
+    for (auto& [id, before, after] : state.changes) current_[id] = after;
+    append(std::move(state));
+    return true;
+}
+
+bool WorkspaceHistory::pushSnapshot() {
+    std::stringstream stream;
+    try {
+        manager_->save(
+            stream, refPath_, [](ExceptionContext) -> void { throw; }, WorkspaceSaveMode::Undo);
+    } catch (...) {
+        return false;
+    }
+
+    State state;
+    state.workspace = std::make_shared<const std::string>(std::move(stream).str());
+    bool failed = false;
+    network_->forEachProcessor([&](Processor* p) {
+        auto text = serialize(*p);
+        if (!text) {
+            failed = true;
+            return;
+        }
+        // Share the text with earlier states if the processor did not change
+        auto it = current_.find(p->getIdentifier());
+        state.processors.emplace(p->getIdentifier(),
+                                 it != current_.end() && *it->second == *text ? it->second : text);
+    });
+    if (failed) return false;
+    resetChanges();
+
+    if (head_ < states_.size() && states_[head_].workspace &&
+        *states_[head_].workspace == *state.workspace) {
+        return false;  // No Change
+    }
+
+    current_ = state.processors;
+    append(std::move(state));
+    return true;
+}
+
+void WorkspaceHistory::append(State state) {
+    if (!states_.empty()) {
+        erase(states_.begin() + head_ + 1, states_.end());
+    }
+    track(state, true);
+    states_.push_back(std::move(state));
+    head_ = states_.size() - 1;
+    enforceMemoryLimit();
+}
+
+void WorkspaceHistory::erase(std::vector<State>::iterator begin,
+                             std::vector<State>::iterator end) {
+    for (auto it = begin; it != end; ++it) track(*it, false);
+    states_.erase(begin, end);
+}
+
+void WorkspaceHistory::track(const State& state, bool add) {
+    // Texts are shared between states, count each one once.
+    const auto count = [&](const Text& text) {
+        if (!text) return;
+        if (add) {
+            if (references_[text.get()]++ == 0) memoryUsage_ += text->size();
+        } else if (auto it = references_.find(text.get()); it != references_.end()) {
+            if (--it->second == 0) {
+                memoryUsage_ -= text->size();
+                references_.erase(it);
+            }
+        }
+    };
+    count(state.workspace);
+    for (const auto& item : state.processors) count(item.second);
+    for (const auto& [id, before, after] : state.changes) {
+        count(before);
+        count(after);
+    }
+}
+
+void WorkspaceHistory::enforceMemoryLimit() {
+    if (states_.size() < 2 || memoryUsage_ <= memoryLimit_) return;
+
+    // Find the last full snapshot at or before the head. All states before it can be dropped,
+    // since the head can always be reconstructed from that snapshot.
+    for (size_t i = head_; i > 0; --i) {
+        if (states_[i].workspace) {
+            erase(states_.begin(), states_.begin() + i);
+            head_ -= i;
+            return;
+        }
+    }
+    // No snapshot to start from, request one with the next push.
+    structural_ = true;
+}
+
+bool WorkspaceHistory::undo() {
+    if (!canUndo()) return false;
+    restore(head_ - 1);
+    return true;
+}
+
+bool WorkspaceHistory::redo() {
+    if (!canRedo()) return false;
+    restore(head_ + 1);
+    return true;
+}
+
+bool WorkspaceHistory::canUndo() const { return head_ > 0 && head_ < states_.size(); }
+bool WorkspaceHistory::canRedo() const { return head_ + 1 < states_.size(); }
+
+void WorkspaceHistory::restore(size_t index) {
+    util::KeepTrueWhileInScope restoring(&restoring_);
+
+    const auto rebuild = [&]() {
+        // Load the closest full snapshot and replay the deltas up to the target
+        size_t start = index;
+        while (!states_[start].workspace) --start;
+
+        std::stringstream stream;
+        stream << *states_[start].workspace;
+        manager_->load(stream, refPath_);
+        current_ = states_[start].processors;
+        head_ = start;
+        while (head_ < index) apply(states_[++head_], false);
+    };
+
+    const auto partial = [&]() {
+        if (index + 1 == head_ && !states_[head_].workspace) {
+            apply(states_[head_], true);
+        } else if (index == head_ + 1 && !states_[index].workspace) {
+            apply(states_[index], false);
+        } else {
+            return false;
+        }
+        head_ = index;
+        return !structural_;
+    };
+
+    structural_ = false;
+    try {
+        if (!partial()) rebuild();
+    } catch (const Exception&) {
+        rebuild();
+    }
+    resetChanges();
+}
+
+void WorkspaceHistory::apply(const State& state, bool undo) {
+    NetworkLock lock(network_);
+    for (auto& [id, before, after] : state.changes) {
+        const auto& text = undo ? before : after;
+        if (auto* processor = network_->getProcessorByIdentifier(id)) {
+            deserialize(*processor, *text);
+            current_[id] = text;
+        } else {
+            throw Exception("Processor '" + id + "' not found in network",
+                            IVW_CONTEXT_CUSTOM("WorkspaceHistory"));
+        }
+    }
+}
+
+auto WorkspaceHistory::serialize(const Processor& processor) const -> Text {
+    try {
+        std::stringstream stream;
+        Serializer serializer(refPath_);
+        serializer.serialize("Processor", processor);
+        serializer.writeFile(stream);
+        return std::make_shared<const std::string>(std::move(stream).str());
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void WorkspaceHistory::deserialize(Processor& processor, const std::string& text) const {
+    std::stringstream stream;
+    stream << text;
+    auto deserializer = manager_->createWorkspaceDeserializer(stream, refPath_);
+    deserializer.deserialize("Processor", processor);
+}
+
+void WorkspaceHistory::clear() {
+    states_.clear();
+    references_.clear();
+    memoryUsage_ = 0;
+    current_.clear();
+    head_ = 0;
+    markDirty();
+}
+
+void WorkspaceHistory::markDirty() {
+    // Also recorded while restoring, to detect deltas that could not be applied in place
+    structural_ = true;
+    if (!restoring_) dirty_ = true;
+}
+
+void WorkspaceHistory::markChanged(Processor* processor, bool networkChange) {
+    if (restoring_) return;
+    dirty_ = true;
+    if (networkChange) --unattributed_;
+    changed_.insert(processor);
+}
+
+void WorkspaceHistory::resetChanges() {
+    dirty_ = false;
+    structural_ = false;
+    unattributed_ = 0;
+    changed_.clear();
+}
+
+bool WorkspaceHistory::isDirty() const { return dirty_; }
+bool WorkspaceHistory::isRestoring() const { return restoring_; }
+
+void WorkspaceHistory::setMemoryLimit(size_t bytes) {
+    memoryLimit_ = bytes;
+    enforceMemoryLimit();
+}
+size_t WorkspaceHistory::getMemoryLimit() const { return memoryLimit_; }
+
+size_t WorkspaceHistory::getMemoryUsage() const { return memoryUsage_; }
+
+size_t WorkspaceHistory::getNumberOfStates() const { return states_.size(); }
+
+auto WorkspaceHistory::getWorkspace() const -> Text {
+    if (head_ < states_.size()) return states_[head_].workspace;
+    return nullptr;
+}
+
+void WorkspaceHistory::onProcessorNetworkChange() {
+    // Also emitted for every property and meta data change of a processor, those are matched by
+    // a call to markChanged. Any other network change can not be captured by a delta.
+    if (restoring_) return;
+    dirty_ = true;
+    ++unattributed_;
+}
+void WorkspaceHistory::onProcessorNetworkDidAddProcessor(Processor* processor) {
+    watchers_[processor] = std::make_unique<Watcher>(this, processor);
+    markDirty();
+}
+void WorkspaceHistory::onProcessorNetworkWillRemoveProcessor(Processor* processor) {
+    watchers_.erase(processor);
+    changed_.erase(processor);
+    markDirty();
+}
+void WorkspaceHistory::onProcessorNetworkDidAddConnection(const PortConnection&) { markDirty(); }
+void WorkspaceHistory::onProcessorNetworkDidRemoveConnection(const PortConnection&) {
+    markDirty();
+}
+void WorkspaceHistory::onProcessorNetworkDidAddLink(const PropertyLink&) { markDirty(); }
+void WorkspaceHistory::onProcessorNetworkDidRemoveLink(const PropertyLink&) { markDirty(); }
+
+}  // namespace inviwo
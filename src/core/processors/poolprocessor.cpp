@@ -50,15 +50,12 @@ void pool::detail::State::setProgress(size_t id, float newProgress) {
 
     progress[id] = newProgress;
 
-    if (!progressUpdate.valid() || util::is_future_ready(progressUpdate)) {
-        const auto total =
-            std::accumulate(progress.begin(), progress.end(), 0.0f) / progress.size();
-        progressUpdate = dispatchFront([this, p = processor, total]() {
-            if (auto wrapper = p.lock()) {
-                wrapper->processor.progress(this, total);
-            }
-        });
-    }
+    // At most one update per state is waiting in the queue, it reads the latest progress when run
+    InviwoApplication::getPtr()->dispatchFrontCoalesced(progressUpdate, [this, p = processor]() {
+        if (auto wrapper = p.lock()) {
+            wrapper->processor.progress(this);
+        }
+    });
 }
 
 PoolProcessor::PoolProcessor(pool::Options options, const std::string& identifier,
@@ -149,9 +146,11 @@ void PoolProcessor::newResults(const std::vector<Outport*>& outports) {
     notifyObserversInvalidationEnd(this);
 }
 
-void PoolProcessor::progress(pool::detail::State* state, float progress) {
+void PoolProcessor::progress(pool::detail::State* state) {
+    // Only dereference the state if it is still alive, i.e. in states_
     if (!states_.empty() && states_.back().get() == state) {
-        updateProgress(progress);
+        const auto& progress = state->progress;
+        updateProgress(std::accumulate(progress.begin(), progress.end(), 0.0f) / progress.size());
     }
 }
 
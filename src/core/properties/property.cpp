@@ -28,6 +28,7 @@
  *********************************************************************************/
 
 #include <inviwo/core/properties/property.h>
+#include <inviwo/core/properties/propertyowner.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/util/stdextensions.h>
@@ -81,10 +82,13 @@ Property::~Property() {
 const std::string& Property::getIdentifier() const { return identifier_; }
 Property& Property::setIdentifier(std::string_view identifier) {
     if (identifier_ != identifier) {
-        identifier_ = identifier;
-
         util::validateIdentifier(identifier, "Property", IVW_CONTEXT);
 
+        // The owner's index refers to the identifier string, update it around the change
+        if (owner_) owner_->unindexProperty(this);
+        identifier_ = identifier;
+        if (owner_) owner_->indexProperty(this);
+
         notifyObserversOnSetIdentifier(this, identifier_);
         notifyAboutChange();
     }
@@ -180,8 +184,17 @@ Property& Property::propertyModified() {
     setModified();
 
     if (auto owner = getOwner()) {
+        auto processor = owner->getProcessor();
+
+        // Within a NetworkBatch the links and the invalidation are handled when the batch ends
+        if (auto network = processor ? processor->getNetwork() : nullptr;
+            network && network->deferPropertyChange(this)) {
+            updateWidgets();
+            return *this;
+        }
+
         // Evaluate property links
-        if (auto processor = owner->getProcessor()) {
+        if (processor) {
             processor->notifyObserversAboutPropertyChange(this);
         }
 
@@ -226,9 +239,12 @@ void Property::deserialize(Deserializer& d) {
     }
 
     {
-        auto old = identifier_;
-        d.deserialize("identifier", identifier_, SerializationTarget::Attribute);
-        if (old != identifier_) {
+        auto identifier = identifier_;
+        d.deserialize("identifier", identifier, SerializationTarget::Attribute);
+        if (identifier != identifier_) {
+            if (owner_) owner_->unindexProperty(this);
+            identifier_ = std::move(identifier);
+            if (owner_) owner_->indexProperty(this);
             notifyObserversOnSetIdentifier(this, identifier_);
         }
     }
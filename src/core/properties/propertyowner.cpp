@@ -34,6 +34,7 @@
 #include <inviwo/core/properties/propertyowner.h>
 #include <inviwo/core/io/serialization/serializable.h>
 #include <inviwo/core/io/serialization/versionconverter.h>
+#include <inviwo/core/io/serialization/deserializer.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/exception.h>
 #include <inviwo/core/network/networkvisitor.h>
@@ -53,6 +54,9 @@ PropertyOwner::PropertyOwner(const PropertyOwner& rhs)
 }
 
 PropertyOwner::~PropertyOwner() {
+    // Member properties of derived classes might already be destroyed here, so don't look at
+    // their identifiers again
+    identifierIndex_.clear();
     while (size() != 0) {
         removeProperty(begin());
     }
@@ -99,6 +103,7 @@ void PropertyOwner::insertProperty(size_t index, Property* property, bool owner)
     notifyObserversWillAddProperty(property, index);
     properties_.insert(properties_.begin() + index, property);
     property->setOwner(this);
+    indexProperty(property);
 
     if (dynamic_cast<EventProperty*>(property)) {
         eventProperties_.push_back(static_cast<EventProperty*>(property));
@@ -120,9 +125,10 @@ void PropertyOwner::insertProperty(size_t index, Property& property) {
 }
 
 Property* PropertyOwner::removeProperty(std::string_view identifier) {
-    return removeProperty(
-        std::find_if(properties_.begin(), properties_.end(),
-                     [&identifier](Property* p) { return p->getIdentifier() == identifier; }));
+    if (auto it = identifierIndex_.find(identifier); it != identifierIndex_.end()) {
+        return removeProperty(it->second);
+    }
+    return nullptr;
 }
 
 Property* PropertyOwner::removeProperty(Property* property) {
@@ -161,8 +167,10 @@ Property* PropertyOwner::removeProperty(std::vector<Property*>::iterator it) {
         util::erase_remove(eventProperties_, *it);
         util::erase_remove(compositeProperties_, *it);
 
+        unindexProperty(prop);
         prop->setOwner(nullptr);
         properties_.erase(it);
+        invalidatePathCache();
         notifyObserversDidRemoveProperty(prop, index);
 
         // This will delete the property if owned; in that case set prop to nullptr.
@@ -204,8 +212,8 @@ std::vector<Property*> PropertyOwner::getPropertiesRecursive() const {
 
 Property* PropertyOwner::getPropertyByIdentifier(std::string_view identifier,
                                                  bool recursiveSearch) const {
-    for (auto* property : properties_) {
-        if (property->getIdentifier() == identifier) return property;
+    if (auto it = identifierIndex_.find(identifier); it != identifierIndex_.end()) {
+        return it->second;
     }
     if (recursiveSearch) {
         for (auto* compositeProperty : compositeProperties_) {
@@ -218,18 +226,54 @@ Property* PropertyOwner::getPropertyByIdentifier(std::string_view identifier,
 Property* PropertyOwner::getPropertyByPath(std::string_view path) const {
     if (path.empty()) return nullptr;
 
-    const auto [first, rest] = util::splitByFirst(path, '.');
-    if (rest.empty()) {
-        return getPropertyByIdentifier(first);
-    } else {
-        auto it = std::find_if(compositeProperties_.begin(), compositeProperties_.end(),
-                               [f = first](auto* comp) { return comp->getIdentifier() == f; });
-        if (it != compositeProperties_.end()) {
-            return (*it)->getPropertyByPath(rest);
-        } else {
-            return nullptr;
+    const auto hash = std::hash<std::string_view>{}(path);
+    if (auto it = pathCache_.find(hash); it != pathCache_.end() && it->second.first == path) {
+        return it->second.second;
+    }
+
+    const PropertyOwner* owner = this;
+    std::string_view remaining = path;
+    Property* property = nullptr;
+    while (owner) {
+        const auto [first, rest] = util::splitByFirst(remaining, '.');
+        property = owner->getPropertyByIdentifier(first);
+        if (rest.empty() || !property) break;
+        owner = dynamic_cast<CompositeProperty*>(property);
+        property = nullptr;
+        remaining = rest;
+    }
+
+    // Only found paths are cached, any property added later invalidates the cache anyway
+    if (property) pathCache_[hash] = {std::string{path}, property};
+    return property;
+}
+
+void PropertyOwner::indexProperty(Property* property) {
+    identifierIndex_.try_emplace(property->getIdentifier(), property);
+    invalidatePathCache();
+}
+
+void PropertyOwner::unindexProperty(Property* property) {
+    if (identifierIndex_.empty()) return;
+
+    const std::string_view identifier = property->getIdentifier();
+    auto it = identifierIndex_.find(identifier);
+    if (it == identifierIndex_.end() || it->second != property) return;
+    identifierIndex_.erase(it);
+
+    // A renamed property might have shadowed another one with the same identifier
+    for (auto* p : properties_) {
+        if (p != property && p->getIdentifier() == identifier) {
+            identifierIndex_.try_emplace(p->getIdentifier(), p);
+            break;
         }
     }
+    invalidatePathCache();
+}
+
+void PropertyOwner::invalidatePathCache() {
+    if (!pathCache_.empty()) pathCache_.clear();
+    if (auto owner = getOwner()) owner->invalidatePathCache();
 }
 
 bool PropertyOwner::empty() const { return properties_.empty(); }
@@ -282,10 +326,57 @@ void PropertyOwner::serialize(Serializer& s) const {
                 [](const Property* p) { return p->needsSerialization(); });
 }
 
+namespace {
+
+struct SerializedProperty {
+    std::string type;
+    std::string identifier;
+};
+
+std::vector<SerializedProperty> getSerializedProperties(Deserializer& d) {
+    std::vector<SerializedProperty> serialized;
+    Property* unused = nullptr;
+    ContainerWrapper<Property*> cont(
+        "Property", [&](const std::string&, size_t) -> ContainerWrapper<Property*>::Item {
+            return {false, unused, [](Property*&) {}};
+        });
+    cont.setIdentityGetter([&](ElementRef node) {
+        serialized.push_back({detail::getNodeAttribute(node, SerializeConstants::TypeAttribute),
+                              detail::getNodeAttribute(node, "identifier")});
+        return serialized.back().identifier;
+    });
+    d.deserialize("Properties", cont);
+    return serialized;
+}
+
+// Run xml::findMatchingSubPropertiesForComposites on an xml copy of only the type and identifier
+// of the serialized properties, to find out whether a conversion is needed.
+bool hasPropsForComposites(Deserializer& d, const std::vector<CompositeProperty*>& composites) {
+    if (composites.empty()) return false;
+
+    TxElement list("Properties");
+    for (const auto& serialized : getSerializedProperties(d)) {
+        TxElement item("Property");
+        item.SetAttribute(std::string{SerializeConstants::TypeAttribute}, serialized.type);
+        item.SetAttribute("identifier", serialized.identifier);
+        list.InsertEndChild(item);
+    }
+    TxElement node("PropertyOwner");
+    node.InsertEndChild(list);
+
+    const std::vector<const CompositeProperty*> props(composites.begin(), composites.end());
+    return xml::findMatchingSubPropertiesForComposites(&node, props);
+}
+
+}  // namespace
+
 void PropertyOwner::deserialize(Deserializer& d) {
     // This is for finding renamed composites, and moving old properties to new composites.
-    NodeVersionConverter tvc(this, &PropertyOwner::findPropsForComposites);
-    d.convertVersion(&tvc);
+    // Binary workspaces are copied to xml to convert, only do that when needed.
+    if (!d.isBinary() || hasPropsForComposites(d, compositeProperties_)) {
+        NodeVersionConverter tvc(this, &PropertyOwner::findPropsForComposites);
+        d.convertVersion(&tvc);
+    }
 
     std::vector<std::string> ownedIdentifiers;
     d.deserialize("OwnedPropertyIdentifiers", ownedIdentifiers, "PropertyIdentifier");
@@ -0,0 +1,92 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <inviwo/core/datastructures/histogram.h>
+#include <inviwo/core/util/quantilesketch.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace inviwo;
+
+std::vector<float> randomValues(size_t size) {
+    std::vector<float> values(size);
+    std::mt19937 rand{42};
+    std::normal_distribution<float> dist{0.5f, 0.15f};
+    std::generate(values.begin(), values.end(), [&]() { return dist(rand); });
+    return values;
+}
+
+void Histogram(benchmark::State& state) {
+    const auto values = randomValues(static_cast<size_t>(state.range(0)) << 20);
+    for (auto _ : state) {
+        HistogramContainer histograms{dvec2{0.0, 1.0}, 2048, values.begin(), values.end()};
+        benchmark::DoNotOptimize(histograms);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * values.size()));
+}
+
+void MinMax(benchmark::State& state) {
+    const auto values = randomValues(static_cast<size_t>(state.range(0)) << 20);
+    for (auto _ : state) {
+        auto minmax = std::minmax_element(values.begin(), values.end());
+        benchmark::DoNotOptimize(minmax);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * values.size()));
+}
+
+void QuantileSketch(benchmark::State& state) {
+    const auto values = randomValues(static_cast<size_t>(state.range(0)) << 20);
+    const std::vector<double> quantiles{0.01, 0.25, 0.5, 0.75, 0.99};
+    for (auto _ : state) {
+        util::QuantileSketch sketch;
+        for (auto v : values) sketch.add(v);
+        auto res = sketch.quantiles(quantiles);
+        benchmark::DoNotOptimize(res);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * values.size()));
+}
+
+}  // namespace
+
+// Sizes in millions of values
+BENCHMARK(Histogram)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK(MinMax)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMillisecond);
+BENCHMARK(QuantileSketch)->RangeMultiplier(4)->Range(1, 64)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,115 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <inviwo/core/util/rampool.h>
+
+#include <algorithm>
+#include <memory>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+using namespace inviwo;
+
+// Minor page faults of the process so far, 0 where not available
+long pageFaults() {
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+#else
+    return 0;
+#endif
+}
+
+// Mimics a producer that overwrites the full output, e.g. a texture download
+template <typename Alloc>
+void produce(benchmark::State& state, Alloc alloc) {
+    const auto size = static_cast<size_t>(state.range(0)) << 20;
+    const auto faults = pageFaults();
+    for (auto _ : state) {
+        auto data = alloc(size);
+        std::fill(data.get(), data.get() + size / sizeof(float), 1.0f);
+        benchmark::DoNotOptimize(data.get());
+        benchmark::ClobberMemory();
+    }
+    state.counters["faults"] = benchmark::Counter(static_cast<double>(pageFaults() - faults),
+                                                  benchmark::Counter::kAvgIterations);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+
+void ValueInitialized(benchmark::State& state) {
+    produce(state, [](size_t bytes) { return std::unique_ptr<float[]>(new float[bytes / 4]()); });
+}
+
+void PoolZero(benchmark::State& state) {
+    RAMPool::get().setHugePages(false);
+    produce(state, [](size_t bytes) { return util::allocateRAM<float>(bytes / 4); });
+    RAMPool::get().clear();
+}
+
+void PoolUninitialized(benchmark::State& state) {
+    RAMPool::get().setHugePages(false);
+    produce(state, [](size_t bytes) {
+        return util::allocateRAM<float>(bytes / 4, DataInitialization::Uninitialized);
+    });
+    RAMPool::get().clear();
+}
+
+void PoolUninitializedHugePages(benchmark::State& state) {
+    RAMPool::get().setHugePages(true);
+    RAMPool::get().clear();
+    produce(state, [](size_t bytes) {
+        return util::allocateRAM<float>(bytes / 4, DataInitialization::Uninitialized);
+    });
+    RAMPool::get().setHugePages(false);
+    RAMPool::get().clear();
+}
+
+}  // namespace
+
+// Sizes in MB
+BENCHMARK(ValueInitialized)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK(PoolZero)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK(PoolUninitialized)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK(PoolUninitializedHugePages)
+    ->RangeMultiplier(4)
+    ->Range(4, 256)
+    ->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
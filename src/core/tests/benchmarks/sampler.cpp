@@ -0,0 +1,100 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <benchmark/benchmark.h>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/volumesampler.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace inviwo;
+
+constexpr size_t samples = 1 << 16;
+
+std::shared_ptr<Volume> makeVolume(size_t size) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(size3_t{size});
+    std::mt19937 rand{42};
+    std::uniform_real_distribution<float> dist{0.0f, 1.0f};
+    std::generate(ram->getDataTyped(), ram->getDataTyped() + glm::compMul(size3_t{size}),
+                  [&]() { return dist(rand); });
+    return std::make_shared<Volume>(ram);
+}
+
+std::vector<dvec3> randomPositions() {
+    std::vector<dvec3> positions(samples);
+    std::mt19937 rand{7};
+    std::uniform_real_distribution<double> dist{0.0, 1.0};
+    std::generate(positions.begin(), positions.end(),
+                  [&]() { return dvec3{dist(rand), dist(rand), dist(rand)}; });
+    return positions;
+}
+
+void SamplerSingle(benchmark::State& state) {
+    const auto volume = makeVolume(static_cast<size_t>(state.range(0)));
+    const auto positions = randomPositions();
+    VolumeSampler sampler(volume);
+    for (auto _ : state) {
+        dvec4 sum{0.0};
+        for (auto& pos : positions) sum += sampler.sample(pos);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * samples));
+}
+
+void SamplerBatch(benchmark::State& state) {
+    const auto volume = makeVolume(static_cast<size_t>(state.range(0)));
+    const auto positions = randomPositions();
+    std::vector<dvec4> result(samples);
+    VolumeSampler sampler(volume);
+    for (auto _ : state) {
+        sampler.sample(positions.data(), result.data(), samples);
+        benchmark::DoNotOptimize(result.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * samples));
+}
+
+}  // namespace
+
+// Volume sizes in voxels per side, 2^16 random samples per iteration
+BENCHMARK(SamplerSingle)->RangeMultiplier(2)->Range(32, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK(SamplerBatch)->RangeMultiplier(2)->Range(32, 256)->Unit(benchmark::kMicrosecond);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    return 0;
+}
@@ -0,0 +1,276 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/io/serialization/serialization.h>
+#include <inviwo/core/io/serialization/binaryworkspace.h>
+#include <inviwo/core/io/serialization/versionconverter.h>
+#include <inviwo/core/util/filesystem.h>
+
+#include <sstream>
+#include <limits>
+#include <variant>
+
+namespace inviwo {
+
+namespace {
+
+struct Item : Serializable {
+    std::string name;
+    int count = 0;
+    float weight = 0.0f;
+    double precise = 0.0;
+    size_t big = 0;
+    std::vector<int> values;
+
+    virtual void serialize(Serializer& s) const override {
+        s.serialize("name", name, SerializationTarget::Attribute);
+        s.serialize("count", count);
+        s.serialize("weight", weight);
+        s.serialize("precise", precise);
+        s.serialize("big", big);
+        s.serialize("values", values, "value");
+    }
+    virtual void deserialize(Deserializer& d) override {
+        d.deserialize("name", name, SerializationTarget::Attribute);
+        d.deserialize("count", count);
+        d.deserialize("weight", weight);
+        d.deserialize("precise", precise);
+        d.deserialize("big", big);
+        d.deserialize("values", values, "value");
+    }
+};
+
+// Reads the numbers of an Item as text
+struct ItemText : Serializable {
+    std::string count;
+    std::string weight;
+    std::string precise;
+    std::string big;
+
+    virtual void serialize(Serializer&) const override {}
+    virtual void deserialize(Deserializer& d) override {
+        d.deserialize("count", count);
+        d.deserialize("weight", weight);
+        d.deserialize("precise", precise);
+        d.deserialize("big", big);
+    }
+};
+
+std::vector<Item> makeItems(size_t size) {
+    std::vector<Item> items(size);
+    for (size_t i = 0; i < size; ++i) {
+        items[i].name = "item <" + std::to_string(i) + "> & \"more\"";
+        items[i].count = -static_cast<int>(i);
+        items[i].weight = 0.1f * static_cast<float>(i);
+        items[i].precise = 1.0 / static_cast<double>(i + 3);
+        items[i].big = std::numeric_limits<size_t>::max() - i;
+        items[i].values = {static_cast<int>(i), 0, std::numeric_limits<int>::min()};
+    }
+    return items;
+}
+
+}  // namespace
+
+TEST(BinaryWorkspace, RoundTrip) {
+    const auto refPath = filesystem::findBasePath();
+    // Large enough for the parallel decoding of the items
+    const auto items = makeItems(2000);
+
+    Serializer serializer(refPath);
+    serializer.serialize("Items", items, "Item");
+    std::stringstream xml;
+    serializer.writeFile(xml, true);
+    std::stringstream binary;
+    serializer.writeBinaryFile(binary);
+
+    EXPECT_LT(binary.str().size(), xml.str().size());
+    EXPECT_TRUE(binaryworkspace::isBinary(binary));
+    EXPECT_FALSE(binaryworkspace::isBinary(xml));
+
+    Deserializer deserializer(binary, refPath);
+    std::vector<Item> result;
+    deserializer.deserialize("Items", result, "Item");
+
+    ASSERT_EQ(result.size(), items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        EXPECT_EQ(result[i].name, items[i].name);
+        EXPECT_EQ(result[i].count, items[i].count);
+        EXPECT_EQ(result[i].weight, items[i].weight);
+        EXPECT_EQ(result[i].precise, items[i].precise);
+        EXPECT_EQ(result[i].big, items[i].big);
+        EXPECT_EQ(result[i].values, items[i].values);
+    }
+}
+
+TEST(BinaryWorkspace, XmlConversion) {
+    const auto refPath = filesystem::findBasePath();
+    const auto items = makeItems(10);
+
+    Serializer serializer(refPath);
+    serializer.serialize("Items", items, "Item");
+    std::stringstream xml;
+    serializer.writeFile(xml, true);
+
+    std::stringstream xmlIn{xml.str()};
+    std::stringstream binary;
+    binaryworkspace::xmlToBinary(xmlIn, binary);
+    std::stringstream xmlOut;
+    binaryworkspace::binaryToXml(binary, xmlOut, true);
+
+    EXPECT_EQ(xmlOut.str(), xml.str());
+}
+
+TEST(BinaryWorkspace, TypedValues) {
+    std::stringstream xml{R"(<?xml version="1.0" ?>
+<InviwoWorkspace version="2">
+    <Values int="-42" large="3000000000" flag="1" float="0.1" double="0.30000000000000004"
+            inf="inf" text="0.10" />
+</InviwoWorkspace>
+)"};
+    std::stringstream binary;
+    binaryworkspace::xmlToBinary(xml, binary);
+    const binaryworkspace::Document doc{binary};
+
+    ASSERT_NE(doc.root(), nullptr);
+    const auto* values = doc.root()->firstChildElement("Values");
+    ASSERT_NE(values, nullptr);
+    EXPECT_EQ(values->parent, doc.root());
+    EXPECT_EQ(values->firstChildElement(), nullptr);
+
+    EXPECT_TRUE(std::holds_alternative<std::int64_t>(values->attribute("int")->value));
+    EXPECT_TRUE(std::holds_alternative<std::string_view>(values->attribute("text")->value));
+    EXPECT_EQ(values->getAttribute("text"), "0.10");
+    EXPECT_EQ(values->getAttribute("int"), "-42");
+    EXPECT_EQ(values->getAttribute("missing"), "");
+
+    int i = 0;
+    EXPECT_TRUE(values->getNumber("int", i));
+    EXPECT_EQ(i, -42);
+    unsigned int u = 0;
+    EXPECT_FALSE(values->getNumber("int", u));
+    EXPECT_FALSE(values->getNumber("large", i));
+    EXPECT_EQ(i, -42);
+    bool flag = false;
+    EXPECT_TRUE(values->getNumber("flag", flag));
+    EXPECT_TRUE(flag);
+    double d = 0.0;
+    EXPECT_TRUE(values->getNumber("int", d));
+    EXPECT_EQ(d, -42.0);
+    EXPECT_FALSE(values->getNumber("text", d));
+    EXPECT_FALSE(values->getNumber("missing", d));
+
+    if constexpr (config::charconv) {
+        EXPECT_TRUE(std::holds_alternative<float>(values->attribute("float")->value));
+        EXPECT_TRUE(std::holds_alternative<double>(values->attribute("double")->value));
+        EXPECT_EQ(values->getAttribute("double"), "0.30000000000000004");
+
+        float f = 0.0f;
+        EXPECT_TRUE(values->getNumber("float", f));
+        EXPECT_EQ(f, 0.1f);
+        // Parsing "0.1" as a double does not give the widened float
+        EXPECT_FALSE(values->getNumber("float", d));
+        EXPECT_TRUE(values->getNumber("double", d));
+        EXPECT_EQ(d, 0.30000000000000004);
+        // Non-finite values are left to the text path, which reports them
+        EXPECT_FALSE(values->getNumber("inf", f));
+    }
+}
+
+TEST(BinaryWorkspace, NumbersAsText) {
+    const auto refPath = filesystem::findBasePath();
+    const auto items = makeItems(10);
+
+    Serializer serializer(refPath);
+    serializer.serialize("Items", items, "Item");
+    std::stringstream xml;
+    serializer.writeFile(xml, true);
+    std::stringstream binary;
+    serializer.writeBinaryFile(binary);
+
+    std::vector<ItemText> fromXml;
+    Deserializer{xml, refPath}.deserialize("Items", fromXml, "Item");
+    std::vector<ItemText> fromBinary;
+    Deserializer{binary, refPath}.deserialize("Items", fromBinary, "Item");
+
+    ASSERT_EQ(fromBinary.size(), fromXml.size());
+    for (size_t i = 0; i < fromXml.size(); ++i) {
+        EXPECT_EQ(fromBinary[i].count, fromXml[i].count);
+        EXPECT_EQ(fromBinary[i].weight, fromXml[i].weight);
+        EXPECT_EQ(fromBinary[i].precise, fromXml[i].precise);
+        EXPECT_EQ(fromBinary[i].big, fromXml[i].big);
+    }
+    EXPECT_EQ(fromBinary[1].count, "-1");
+}
+
+TEST(BinaryWorkspace, ConvertVersion) {
+    const auto refPath = filesystem::findBasePath();
+    const auto items = makeItems(10);
+
+    Serializer serializer(refPath);
+    serializer.serialize("Items", items, "Item");
+    std::stringstream binary;
+    serializer.writeBinaryFile(binary);
+
+    // Converters work on xml, the binary tree is copied to xml before converting
+    Deserializer deserializer(binary, refPath);
+    NodeVersionConverter converter([](TxElement* root) {
+        root->FirstChildElement("Items")->SetValue("Renamed");
+        return true;
+    });
+    deserializer.convertVersion(&converter);
+
+    std::vector<Item> result;
+    deserializer.deserialize("Renamed", result, "Item");
+    ASSERT_EQ(result.size(), items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+        EXPECT_EQ(result[i].name, items[i].name);
+        EXPECT_EQ(result[i].weight, items[i].weight);
+        EXPECT_EQ(result[i].values, items[i].values);
+    }
+}
+
+TEST(BinaryWorkspace, Corrupt) {
+    const auto refPath = filesystem::findBasePath();
+    Serializer serializer(refPath);
+    serializer.serialize("Items", makeItems(10), "Item");
+    std::stringstream binary;
+    serializer.writeBinaryFile(binary);
+
+    const auto str = binary.str();
+    std::stringstream truncated{str.substr(0, str.size() / 2)};
+    std::stringstream xml;
+    EXPECT_THROW(binaryworkspace::binaryToXml(truncated, xml), SerializationException);
+}
+
+}  // namespace inviwo
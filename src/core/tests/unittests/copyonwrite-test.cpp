@@ -0,0 +1,158 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/buffer/buffer.h>
+#include <inviwo/core/datastructures/buffer/bufferramprecision.h>
+#include <inviwo/core/datastructures/geometry/mesh.h>
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/util/imagesampler.h>
+
+namespace inviwo {
+
+TEST(CopyOnWriteTest, VolumeCopySharesRepresentation) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(size3_t{4, 4, 4});
+    ram->getDataTyped()[0] = 1.0f;
+    Volume volume(ram);
+    Volume copy(volume);
+
+    const auto* shared = copy.getRepresentation<VolumeRAM>();
+    EXPECT_EQ(ram.get(), shared);
+    EXPECT_TRUE(volume.isShared(ram.get()));
+    EXPECT_TRUE(copy.isShared(shared));
+}
+
+TEST(CopyOnWriteTest, EditDetachesCopy) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(size3_t{4, 4, 4});
+    ram->getDataTyped()[0] = 1.0f;
+    Volume volume(ram);
+    Volume copy(volume);
+
+    auto edit =
+        static_cast<VolumeRAMPrecision<float>*>(copy.getEditableRepresentation<VolumeRAM>());
+    EXPECT_NE(ram.get(), edit);
+    edit->getDataTyped()[0] = 2.0f;
+
+    EXPECT_EQ(1.0f, ram->getDataTyped()[0]);
+    EXPECT_EQ(1.0, volume.getRepresentation<VolumeRAM>()->getAsDouble(size3_t{0}));
+    EXPECT_EQ(2.0, copy.getRepresentation<VolumeRAM>()->getAsDouble(size3_t{0}));
+    EXPECT_FALSE(volume.isShared(ram.get()));
+    EXPECT_FALSE(copy.isShared(edit));
+}
+
+TEST(CopyOnWriteTest, SharedRepresentationKeepsOwner) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(size3_t{4, 4, 4});
+    Volume volume(ram);
+    auto copy = std::make_unique<Volume>(volume);
+
+    EXPECT_EQ(&volume, copy->getRepresentation<VolumeRAM>()->getOwner());
+    EXPECT_EQ(&volume, volume.getRepresentation<VolumeRAM>()->getOwner());
+
+    auto edit = copy->getEditableRepresentation<VolumeRAM>();
+    EXPECT_EQ(copy.get(), edit->getOwner());
+    EXPECT_EQ(&volume, ram->getOwner());
+
+    // Once the original owner has detached, the remaining holder takes over the representation
+    copy = std::make_unique<Volume>(volume);
+    const auto* shared = volume.getRepresentation<VolumeRAM>();
+    EXPECT_NE(shared, volume.getEditableRepresentation<VolumeRAM>());
+    EXPECT_EQ(&volume, shared->getOwner());
+    EXPECT_EQ(shared, copy->getEditableRepresentation<VolumeRAM>());
+    EXPECT_EQ(copy.get(), shared->getOwner());
+}
+
+TEST(CopyOnWriteTest, EditSourceDetachesSource) {
+    auto ram = std::make_shared<VolumeRAMPrecision<float>>(size3_t{4, 4, 4});
+    Volume volume(ram);
+    auto copy = std::make_unique<Volume>(volume);
+
+    auto edit = volume.getEditableRepresentation<VolumeRAM>();
+    EXPECT_NE(ram.get(), edit);
+    edit->setFromDouble(size3_t{1, 2, 3}, 5.0);
+    EXPECT_EQ(0.0, copy->getRepresentation<VolumeRAM>()->getAsDouble(size3_t{1, 2, 3}));
+
+    // Once the copy is gone the representation is no longer shared
+    Volume copy2(volume);
+    copy.reset();
+    EXPECT_TRUE(volume.isShared(edit));
+    copy2.setInterpolation(InterpolationType::Nearest);
+    EXPECT_FALSE(volume.isShared(edit));
+    EXPECT_EQ(edit, volume.getEditableRepresentation<VolumeRAM>());
+    EXPECT_EQ(InterpolationType::Linear, volume.getInterpolation());
+    EXPECT_EQ(InterpolationType::Nearest, copy2.getInterpolation());
+}
+
+TEST(CopyOnWriteTest, LayerSamplerUsesCopySpatialData) {
+    auto ram = std::make_shared<LayerRAMPrecision<vec4>>(size2_t{2, 2});
+    ram->getDataTyped()[0] = vec4{1.0f};
+    auto layer = std::make_unique<Layer>(ram);
+    Layer copy(*layer);
+    copy.setOffset(vec2{3.0f, 4.0f});
+
+    ImageSpatialSampler<4, double> sampler(&copy);
+    EXPECT_EQ(copy.getModelMatrix(), sampler.getModelMatrix());
+    EXPECT_NE(layer->getModelMatrix(), sampler.getModelMatrix());
+
+    // The sampler does not depend on the layer that owns the shared representation
+    layer.reset();
+    EXPECT_EQ(dvec4{1.0}, sampler.sample(dvec2{0.0}));
+}
+
+TEST(CopyOnWriteTest, BufferResize) {
+    auto buffer = util::makeBuffer<vec3>({vec3{1.0f}, vec3{2.0f}, vec3{3.0f}});
+    Buffer<vec3> copy(*buffer);
+
+    copy.setSize(5);
+    EXPECT_EQ(size_t{3}, buffer->getSize());
+    EXPECT_EQ(size_t{5}, copy.getSize());
+    EXPECT_EQ(vec3{2.0f}, buffer->getRAMRepresentation()->getDataContainer()[1]);
+}
+
+TEST(CopyOnWriteTest, MeshCopySharesBuffers) {
+    Mesh mesh;
+    mesh.addBuffer(BufferType::PositionAttrib, util::makeBuffer<vec3>({vec3{1.0f}, vec3{2.0f}}));
+    Mesh copy(mesh);
+
+    auto source = static_cast<const Buffer<vec3>*>(mesh.getBuffer(0));
+    auto target = static_cast<Buffer<vec3>*>(copy.getBuffer(0));
+    EXPECT_EQ(source->getRAMRepresentation(), target->getRAMRepresentation());
+
+    target->getEditableRAMRepresentation()->getDataContainer()[0] = vec3{0.0f};
+    EXPECT_NE(source->getRAMRepresentation(), target->getRAMRepresentation());
+    EXPECT_EQ(vec3{1.0f}, source->getRAMRepresentation()->getDataContainer()[0]);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,136 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/frontqueue.h>
+
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace inviwo {
+
+TEST(FrontQueueTest, RunsTasksInOrder) {
+    FrontQueue queue(4);
+    std::vector<int> order;
+    // More tasks than the capacity, the rest spill over
+    for (int i = 0; i < 20; ++i) {
+        queue.push([&order, i]() { order.push_back(i); });
+    }
+    EXPECT_EQ(20u, queue.size());
+    EXPECT_EQ(0u, queue.process());
+
+    ASSERT_EQ(20u, order.size());
+    for (int i = 0; i < 20; ++i) EXPECT_EQ(i, order[i]);
+    EXPECT_EQ(20u, queue.getMetrics().processed);
+    EXPECT_LT(0u, queue.getMetrics().overflowed);
+}
+
+TEST(FrontQueueTest, WakesUpOncePerProcess) {
+    FrontQueue queue;
+    EXPECT_TRUE(queue.push([]() {}));
+    EXPECT_FALSE(queue.push([]() {}));
+    queue.process();
+    EXPECT_TRUE(queue.push([]() {}));
+}
+
+TEST(FrontQueueTest, CoalescesTokens) {
+    FrontQueue queue;
+    auto token = FrontQueue::makeToken();
+    int count = 0;
+    for (int i = 0; i < 10; ++i) queue.push(token, [&count]() { ++count; });
+    queue.process();
+    EXPECT_EQ(1, count);
+    EXPECT_EQ(9u, queue.getMetrics().coalesced);
+
+    // The token is released once the task has run
+    queue.push(token, [&count]() { ++count; });
+    queue.process();
+    EXPECT_EQ(2, count);
+}
+
+TEST(FrontQueueTest, ProcessWithinBudget) {
+    FrontQueue queue;
+    int count = 0;
+    for (int i = 0; i < 10; ++i) {
+        queue.push([&count]() {
+            ++count;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        });
+    }
+    const auto left = queue.process(std::chrono::milliseconds(1));
+    EXPECT_EQ(1, count);
+    EXPECT_EQ(9u, left);
+    EXPECT_EQ(0u, queue.process());
+    EXPECT_EQ(10, count);
+}
+
+TEST(FrontQueueTest, MoveOnlyAndLargeTasks) {
+    FrontQueue queue;
+    int sum = 0;
+    queue.push([&sum, value = std::make_unique<int>(1)]() { sum += *value; });
+    std::array<int, 64> large{};
+    large.fill(1);
+    queue.push([&sum, large]() {
+        for (auto v : large) sum += v;
+    });
+    queue.process();
+    EXPECT_EQ(65, sum);
+}
+
+TEST(FrontQueueTest, MultipleProducers) {
+    constexpr size_t nThreads = 4;
+    constexpr size_t nTasks = 10000;
+    FrontQueue queue(64);
+    std::array<std::vector<size_t>, nThreads> results;
+
+    std::vector<std::thread> producers;
+    for (size_t t = 0; t < nThreads; ++t) {
+        producers.emplace_back([&, t]() {
+            for (size_t i = 0; i < nTasks; ++i) {
+                queue.push([&results, t, i]() { results[t].push_back(i); });
+            }
+        });
+    }
+    for (auto& producer : producers) producer.join();
+    queue.process();
+
+    // Tasks of each producer run in the order they were posted
+    for (auto& result : results) {
+        ASSERT_EQ(nTasks, result.size());
+        for (size_t i = 0; i < nTasks; ++i) EXPECT_EQ(i, result[i]);
+    }
+}
+
+}  // namespace inviwo
@@ -38,11 +38,14 @@
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/core/network/processornetworkevaluator.h>
 #include <inviwo/core/network/networklock.h>
+#include <inviwo/core/util/metriccounters.h>
 
 #include <inviwo/core/ports/datainport.h>
 #include <inviwo/core/ports/dataoutport.h>
+#include <inviwo/core/properties/ordinalproperty.h>
 
 #include <functional>
+#include <sstream>
 
 namespace inviwo {
 
@@ -256,4 +259,151 @@ TEST(NetworkEvaluator, Error) {
     }
 }
 
+TEST(NetworkEvaluator, SortAfterUnlock) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+
+    std::vector<std::string> order;
+    const auto record = [&](TestProcessor& p) {
+        order.push_back(p.getIdentifier());
+        for (auto outport : p.getOutports()) {
+            static_cast<DataOutport<int>*>(outport)->setData(std::make_shared<int>(0));
+        }
+    };
+
+    auto at = createA();
+    auto a = at.get();
+    a->onProcess = record;
+
+    auto mt = std::make_unique<TestProcessor>("m");
+    auto m = mt.get();
+    m->addPort(std::make_unique<DataInport<int>>("in"));
+    m->addPort(std::make_unique<DataOutport<int>>("out"));
+    m->onProcess = record;
+
+    auto bt = createB();
+    auto b = bt.get();
+    b->onProcess = record;
+
+    {
+        // Add in reverse order, the order is only computed once the network is unlocked
+        NetworkLock lock(&network);
+        network.addProcessor(std::move(bt));
+        network.addProcessor(std::move(mt));
+        network.addProcessor(std::move(at));
+        network.addConnection(m->getOutports()[0], b->getInports()[0]);
+        network.addConnection(a->getOutports()[0], m->getInports()[0]);
+        EXPECT_TRUE(order.empty());
+    }
+    EXPECT_EQ(order, (std::vector<std::string>{"a", "m", "b"}));
+}
+
+TEST(NetworkEvaluator, Metrics) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+    ProcessorNetworkEvaluator evaluator{&network};
+    const auto& metrics = evaluator.getMetrics();
+
+    auto at = createA();
+    auto a = at.get();
+    a->onProcess = [](TestProcessor& p) {
+        util::countRepresentationConversion();
+        util::countAllocatedBytes(100);
+        static_cast<DataOutport<int>*>(p.getOutports()[0])->setData(std::make_shared<int>(0));
+    };
+    network.addProcessor(std::move(at));
+
+    auto bt = createB();
+    auto b = bt.get();
+    network.addProcessor(std::move(bt));
+    network.addConnection(a->getOutports()[0], b->getInports()[0]);
+
+    ASSERT_NE(metrics.get(a), nullptr);
+    ASSERT_NE(metrics.get(b), nullptr);
+    EXPECT_EQ(metrics.get(a)->evaluations, 1u);
+    EXPECT_EQ(metrics.get(b)->evaluations, 1u);
+    EXPECT_EQ(metrics.get(a)->conversions, 1u);
+    EXPECT_EQ(metrics.get(a)->bytesAllocated, 100u);
+    EXPECT_EQ(metrics.get(b)->conversions, 0u);
+    EXPECT_EQ(metrics.get(b)->bytesAllocated, 0u);
+
+    const auto invalidations = metrics.get(a)->invalidations;
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    a->invalidate(InvalidationLevel::InvalidOutput);
+    EXPECT_EQ(metrics.get(a)->invalidations, invalidations + 2u);
+    EXPECT_EQ(metrics.get(a)->evaluations, 3u);
+    EXPECT_EQ(metrics.get(a)->lastConversions, 1u);
+    EXPECT_EQ(metrics.get(a)->conversions, 3u);
+    EXPECT_EQ(metrics.get(a)->bytesAllocated, 300u);
+    EXPECT_EQ(metrics.get(a)->lastEvaluation, metrics.getEvaluationCount());
+    EXPECT_GE(metrics.get(a)->p95Ms(), 0.0);
+    EXPECT_LE(metrics.get(a)->lastMs, metrics.get(a)->totalMs);
+
+    const auto entries = metrics.getEntries();
+    ASSERT_EQ(entries.size(), 2u);
+    EXPECT_EQ(entries[0].identifier, "a");
+    EXPECT_EQ(entries[1].identifier, "b");
+    EXPECT_EQ(entries[0].classIdentifier, "org.inviwo.TestProcessor");
+
+    std::stringstream csv;
+    metrics.writeCSV(csv);
+    std::string line;
+    size_t lines = 0;
+    while (std::getline(csv, line)) ++lines;
+    EXPECT_EQ(lines, 3u);
+
+    network.removeProcessor(b);
+    EXPECT_EQ(metrics.get(b), nullptr);
+    EXPECT_EQ(metrics.getEntries().size(), 1u);
+}
+
+TEST(NetworkEvaluator, BatchedPropertyChanges) {
+    ProcessorNetwork network{InviwoApplication::getPtr()};
+
+    auto a = network.addProcessor(createA());
+    auto b = network.addProcessor(createB());
+    auto ax = static_cast<IntProperty*>(a->addProperty(std::make_unique<IntProperty>("x", "x", 0)));
+    auto bx = static_cast<IntProperty*>(b->addProperty(std::make_unique<IntProperty>("x", "x", 0)));
+    network.addLink(ax, bx);
+    network.addLink(bx, ax);
+
+    struct InvalidationCounter : ProcessorObserver {
+        virtual void onProcessorInvalidationBegin(Processor*) override { ++count; }
+        int count = 0;
+    } invalidations;
+    b->ProcessorObservable::addObserver(&invalidations);
+    int changes = 0;
+    bx->onChange([&]() { ++changes; });
+
+    {
+        NetworkBatch batch(&network);
+        ax->set(1);
+        ax->set(2);
+        ax->set(3);
+        EXPECT_TRUE(network.isBatching());
+        EXPECT_EQ(0, bx->get());
+    }
+    EXPECT_FALSE(network.isBatching());
+    EXPECT_EQ(3, bx->get());
+    EXPECT_EQ(1, changes);
+    EXPECT_EQ(1, invalidations.count);
+
+    // The last explicitly set property wins, as if the changes had been propagated in order
+    {
+        NetworkBatch batch(&network);
+        ax->set(4);
+        bx->set(5);
+    }
+    EXPECT_EQ(5, ax->get());
+    EXPECT_EQ(5, bx->get());
+    {
+        NetworkBatch batch(&network);
+        bx->set(6);
+        ax->set(7);
+    }
+    EXPECT_EQ(7, ax->get());
+    EXPECT_EQ(7, bx->get());
+
+    b->ProcessorObservable::removeObserver(&invalidations);
+}
+
 }  // namespace inviwo
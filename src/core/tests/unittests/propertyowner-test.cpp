@@ -0,0 +1,110 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/properties/compositeproperty.h>
+#include <inviwo/core/properties/boolproperty.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+#include <inviwo/core/util/exception.h>
+
+#include <memory>
+
+namespace inviwo {
+
+TEST(PropertyOwnerTest, FindByIdentifier) {
+    CompositeProperty root("root", "Root");
+    BoolProperty a("a", "A");
+    FloatProperty b("b", "B");
+    CompositeProperty comp("comp", "Comp");
+    IntProperty c("c", "C");
+    comp.addProperty(c);
+    root.addProperties(a, b, comp);
+
+    EXPECT_EQ(&a, root.getPropertyByIdentifier("a"));
+    EXPECT_EQ(&b, root.getPropertyByIdentifier("b"));
+    EXPECT_EQ(nullptr, root.getPropertyByIdentifier("c"));
+    EXPECT_EQ(&c, root.getPropertyByIdentifier("c", true));
+    EXPECT_EQ(nullptr, root.getPropertyByIdentifier("d", true));
+
+    EXPECT_THROW(root.addProperty(std::make_unique<BoolProperty>("a", "A")), Exception);
+
+    root.removeProperty("a");
+    EXPECT_EQ(nullptr, root.getPropertyByIdentifier("a"));
+    EXPECT_EQ(nullptr, root.removeProperty("a"));
+}
+
+TEST(PropertyOwnerTest, FindByPath) {
+    CompositeProperty root("root", "Root");
+    CompositeProperty comp("comp", "Comp");
+    CompositeProperty sub("sub", "Sub");
+    IntProperty c("c", "C");
+    sub.addProperty(c);
+    comp.addProperty(sub);
+    root.addProperty(comp);
+
+    EXPECT_EQ(&comp, root.getPropertyByPath("comp"));
+    EXPECT_EQ(&c, root.getPropertyByPath("comp.sub.c"));
+    // Cached
+    EXPECT_EQ(&c, root.getPropertyByPath("comp.sub.c"));
+    EXPECT_EQ(nullptr, root.getPropertyByPath("comp.c"));
+    EXPECT_EQ(nullptr, root.getPropertyByPath("comp.sub.c.d"));
+    EXPECT_EQ(nullptr, root.getPropertyByPath(""));
+
+    // Structural changes further down invalidate the cache
+    sub.removeProperty(c);
+    EXPECT_EQ(nullptr, root.getPropertyByPath("comp.sub.c"));
+    sub.addProperty(c);
+    EXPECT_EQ(&c, root.getPropertyByPath("comp.sub.c"));
+}
+
+TEST(PropertyOwnerTest, RenameUpdatesLookup) {
+    CompositeProperty root("root", "Root");
+    CompositeProperty comp("comp", "Comp");
+    IntProperty c("c", "C");
+    comp.addProperty(c);
+    root.addProperty(comp);
+
+    EXPECT_EQ(&c, root.getPropertyByPath("comp.c"));
+
+    c.setIdentifier("d");
+    EXPECT_EQ(nullptr, comp.getPropertyByIdentifier("c"));
+    EXPECT_EQ(&c, comp.getPropertyByIdentifier("d"));
+    EXPECT_EQ(nullptr, root.getPropertyByPath("comp.c"));
+    EXPECT_EQ(&c, root.getPropertyByPath("comp.d"));
+
+    comp.setIdentifier("other");
+    EXPECT_EQ(nullptr, root.getPropertyByPath("comp.d"));
+    EXPECT_EQ(&c, root.getPropertyByPath("other.d"));
+}
+
+}  // namespace inviwo
@@ -0,0 +1,93 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/quantilesketch.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace inviwo {
+
+TEST(QuantileSketchTest, ExactForSmallData) {
+    util::QuantileSketch sketch;
+    for (auto v : {20.0, 15.0, 50.0, 40.0, 35.0}) sketch.add(v);
+    sketch.add(std::nan(""));
+
+    EXPECT_TRUE(sketch.isExact());
+    EXPECT_EQ(5, sketch.count());
+    const auto q = sketch.quantiles({0.0, 0.05, 0.30, 0.40, 0.5, 1.0});
+    EXPECT_DOUBLE_EQ(15.0, q[0]);
+    EXPECT_DOUBLE_EQ(15.0, q[1]);
+    EXPECT_DOUBLE_EQ(20.0, q[2]);
+    EXPECT_DOUBLE_EQ(20.0, q[3]);
+    EXPECT_DOUBLE_EQ(35.0, q[4]);
+    EXPECT_DOUBLE_EQ(50.0, q[5]);
+
+    EXPECT_THROW(sketch.quantile(1.5), Exception);
+    EXPECT_THROW(util::QuantileSketch{}.quantile(0.5), Exception);
+}
+
+TEST(QuantileSketchTest, MergedRankError) {
+    std::mt19937 rng(42);
+    std::normal_distribution<double> dist(10.0, 3.0);
+
+    const size_t n = 500000;
+    std::vector<double> data(n);
+    std::vector<util::QuantileSketch> parts(8);
+    for (size_t i = 0; i < n; ++i) {
+        data[i] = dist(rng);
+        parts[i % parts.size()].add(data[i]);
+    }
+    util::QuantileSketch sketch;
+    for (const auto& part : parts) sketch.merge(part);
+    std::sort(data.begin(), data.end());
+
+    EXPECT_FALSE(sketch.isExact());
+    EXPECT_EQ(n, sketch.count());
+    EXPECT_LT(sketch.retained(), 4 * sketch.getK());
+    EXPECT_DOUBLE_EQ(data.front(), sketch.quantile(0.0));
+    EXPECT_DOUBLE_EQ(data.back(), sketch.quantile(1.0));
+
+    for (int p = 1; p < 100; ++p) {
+        const auto q = static_cast<double>(p) / 100.0;
+        const auto value = sketch.quantile(q);
+        const auto rank = std::lower_bound(data.begin(), data.end(), value) - data.begin();
+        EXPECT_NEAR(q, static_cast<double>(rank) / static_cast<double>(n), 0.02) << p;
+    }
+}
+
+}  // namespace inviwo
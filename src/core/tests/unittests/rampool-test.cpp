@@ -0,0 +1,117 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/rampool.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace inviwo {
+
+TEST(RAMPoolTest, SizeClasses) {
+    EXPECT_EQ(64, RAMPool::sizeClass(0));
+    EXPECT_EQ(128, RAMPool::sizeClass(100));
+    EXPECT_EQ(RAMPool::minPooledBytes, RAMPool::sizeClass(RAMPool::minPooledBytes));
+    EXPECT_EQ(RAMPool::minPooledBytes * 5 / 4, RAMPool::sizeClass(RAMPool::minPooledBytes + 1));
+    for (size_t bytes : {size_t{100000}, size_t{3} << 20, size_t{12345678}}) {
+        const auto size = RAMPool::sizeClass(bytes);
+        EXPECT_GE(size, bytes);
+        EXPECT_LE(size, bytes + bytes / 4);
+    }
+}
+
+TEST(RAMPoolTest, RecyclesBlocks) {
+    RAMPool pool;
+    const size_t bytes = size_t{1} << 20;
+
+    auto first = pool.allocate(bytes, DataInitialization::Uninitialized);
+    EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(first) % 64);
+    pool.deallocate(first);
+    EXPECT_EQ(RAMPool::sizeClass(bytes), pool.getStats().cachedBytes);
+
+    auto second = pool.allocate(bytes - 100, DataInitialization::Uninitialized);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(1, pool.getStats().poolHits);
+    EXPECT_EQ(0, pool.getStats().cachedBytes);
+    pool.deallocate(second);
+
+    pool.clear();
+    EXPECT_EQ(0, pool.getStats().cachedBytes);
+    EXPECT_EQ(0, pool.getStats().liveBytes);
+}
+
+TEST(RAMPoolTest, ZeroesRecycledBlocks) {
+    RAMPool pool;
+    const size_t bytes = size_t{1} << 20;
+
+    auto data = static_cast<unsigned char*>(pool.allocate(bytes));
+    std::fill(data, data + bytes, 0xff);
+    pool.deallocate(data);
+
+    data = static_cast<unsigned char*>(pool.allocate(bytes));
+    EXPECT_TRUE(std::all_of(data, data + bytes, [](unsigned char c) { return c == 0; }));
+    pool.deallocate(data);
+}
+
+TEST(RAMPoolTest, CacheLimit) {
+    RAMPool pool(size_t{3} << 20);
+    auto a = pool.allocate(size_t{2} << 20, DataInitialization::Uninitialized);
+    auto b = pool.allocate(size_t{2} << 20, DataInitialization::Uninitialized);
+    pool.deallocate(a);
+    pool.deallocate(b);
+    EXPECT_EQ(size_t{2} << 20, pool.getStats().cachedBytes);
+
+    pool.setCacheLimit(0);
+    EXPECT_EQ(0, pool.getStats().cachedBytes);
+}
+
+TEST(RAMPoolTest, RepresentationStorage) {
+    VolumeRAMPrecision<float> volume(size3_t{64, 64, 64});
+    const auto data = volume.getDataTyped();
+    EXPECT_TRUE(std::all_of(data, data + 64 * 64 * 64, [](float v) { return v == 0.0f; }));
+
+    LayerRAMPrecision<float> depth(size2_t{256, 256}, LayerType::Depth);
+    const auto depthData = depth.getDataTyped();
+    EXPECT_TRUE(
+        std::all_of(depthData, depthData + 256 * 256, [](float v) { return v == 1.0f; }));
+
+    auto external = new float[8]();
+    external[3] = 3.0f;
+    VolumeRAMPrecision<float> adopted(external, size3_t{2, 2, 2});
+    EXPECT_EQ(3.0, adopted.getAsDouble(size3_t{1, 1, 0}));
+}
+
+}  // namespace inviwo
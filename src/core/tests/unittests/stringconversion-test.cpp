@@ -34,6 +34,7 @@
 
 #include <inviwo/core/util/stringconversion.h>
 
+#include <sstream>
 #include <string>
 #include <string_view>
 
@@ -140,4 +141,17 @@ TEST(StringView, trim) {
     EXPECT_EQ("a"sv, util::trim("  \r a  \r"sv));
 }
 
+TEST(String, writeJSONString) {
+    const auto json = [](std::string_view str) {
+        std::stringstream ss;
+        util::writeJSONString(ss, str);
+        return ss.str();
+    };
+    EXPECT_EQ(R"("")", json(""));
+    EXPECT_EQ(R"("abc")", json("abc"));
+    EXPECT_EQ(R"("a\"b\\c")", json(R"(a"b\c)"));
+    EXPECT_EQ(R"("a\nb\rc\td")", json("a\nb\rc\td"));
+    EXPECT_EQ(R"("\u0001\u001f")", json("\x01\x1f"));
+}
+
 }  // namespace inviwo
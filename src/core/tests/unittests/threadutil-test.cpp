@@ -0,0 +1,106 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/threadutil.h>
+
+#include <atomic>
+#include <numeric>
+#include <vector>
+
+namespace inviwo {
+
+TEST(ThreadUtilTest, ParallelForVisitsEachIndexOnce) {
+    std::vector<int> visits(1000, 0);
+    util::parallelFor(10, visits.size(), [&](size_t i) { ++visits[i]; });
+
+    EXPECT_EQ(0, std::accumulate(visits.begin(), visits.begin() + 10, 0));
+    EXPECT_EQ(990, std::accumulate(visits.begin() + 10, visits.end(), 0));
+    for (size_t i = 10; i < visits.size(); ++i) EXPECT_EQ(1, visits[i]);
+
+    util::parallelFor(5, 5, [&](size_t) { FAIL(); });
+}
+
+TEST(ThreadUtilTest, ParallelReduceIsOrdered) {
+    std::vector<size_t> values(10000);
+    std::iota(values.begin(), values.end(), size_t{0});
+
+    const auto sum = util::parallelReduce(
+        0, values.size(), size_t{0},
+        [&](size_t first, size_t last) {
+            return std::accumulate(values.begin() + first, values.begin() + last, size_t{0});
+        },
+        [](size_t a, size_t b) { return a + b; }, 64);
+    EXPECT_EQ(values.size() * (values.size() - 1) / 2, sum);
+
+    // Concatenation is not commutative, the chunks have to be combined in order
+    const auto concat = util::parallelReduce(
+        0, size_t{100}, std::vector<size_t>{},
+        [](size_t first, size_t last) {
+            std::vector<size_t> res(last - first);
+            std::iota(res.begin(), res.end(), first);
+            return res;
+        },
+        [](std::vector<size_t> a, const std::vector<size_t>& b) {
+            a.insert(a.end(), b.begin(), b.end());
+            return a;
+        });
+    ASSERT_EQ(100u, concat.size());
+    for (size_t i = 0; i < concat.size(); ++i) EXPECT_EQ(i, concat[i]);
+}
+
+TEST(ThreadUtilTest, NestedRegionsRunSerially) {
+    std::atomic<size_t> count{0};
+    std::atomic<size_t> nestedConcurrency{0};
+    util::parallelFor(0, 16, [&](size_t) {
+        nestedConcurrency = std::max<size_t>(nestedConcurrency, util::concurrency());
+        util::parallelFor(0, 16, [&](size_t) { ++count; });
+    });
+    EXPECT_EQ(256u, count);
+    EXPECT_EQ(1u, nestedConcurrency);
+    EXPECT_LE(1u, util::concurrency());
+}
+
+TEST(ThreadUtilTest, ConcurrencyLimit) {
+    const auto previous = util::getConcurrencyLimit();
+    util::setConcurrencyLimit(1);
+    EXPECT_EQ(1u, util::concurrency());
+
+    std::atomic<size_t> count{0};
+    util::parallelFor(0, 100, [&](size_t) { ++count; });
+    EXPECT_EQ(100u, count);
+
+    util::setConcurrencyLimit(previous);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,123 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/util/tracer.h>
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace inviwo {
+
+namespace {
+
+size_t countOccurrences(const std::string& str, const std::string& pattern) {
+    size_t count = 0;
+    for (auto pos = str.find(pattern); pos != std::string::npos;
+         pos = str.find(pattern, pos + pattern.size())) {
+        ++count;
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST(TracerTest, Intern) {
+    const auto a = Tracer::intern("tracer-test-a");
+    const auto b = Tracer::intern("tracer-test-b");
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a, Tracer::intern(std::string("tracer-test-a")));
+}
+
+TEST(TracerTest, RecordsOnlyWhenEnabled) {
+    Tracer::clear();
+    { TraceScope scope("test", "tracer-test-disabled"); }
+
+    Tracer::setEnabled(true);
+    {
+        TraceScope outer("test", "tracer-test-outer");
+        { TraceScope inner("test", std::string_view{"tracer-test-\"inner\""}); }
+    }
+    std::thread{[]() {
+        Tracer::setThreadName("tracer-test-thread");
+        TraceScope scope("test", "tracer-test-other");
+    }}.join();
+    Tracer::setEnabled(false);
+
+    std::stringstream ss;
+    Tracer::exportChromeTrace(ss);
+    const auto json = ss.str();
+
+    EXPECT_EQ(0, countOccurrences(json, "tracer-test-disabled"));
+    EXPECT_EQ(1, countOccurrences(json, "\"tracer-test-outer\""));
+    EXPECT_EQ(1, countOccurrences(json, R"("tracer-test-\"inner\"")"));
+    EXPECT_EQ(1, countOccurrences(json, "\"tracer-test-other\""));
+    EXPECT_EQ(1, countOccurrences(json, "\"tracer-test-thread\""));
+    EXPECT_EQ(0, json.find("{\"displayTimeUnit\""));
+
+    Tracer::clear();
+    std::stringstream cleared;
+    Tracer::exportChromeTrace(cleared);
+    EXPECT_EQ(0, countOccurrences(cleared.str(), "\"ph\":\"X\""));
+}
+
+TEST(TracerTest, ExportWhileRecording) {
+    std::atomic<bool> done{false};
+    std::thread recorder{[&]() {
+        const auto name = Tracer::intern("tracer-test-concurrent");
+        // Wrap around the buffer a few times while exporting
+        for (size_t i = 0; i < 3 * Tracer::bufferCapacity; ++i) {
+            Tracer::record("test", name, 1000, 2000);
+        }
+        done = true;
+    }};
+
+    for (size_t exports = 0; !done || exports == 0; ++exports) {
+        std::stringstream ss;
+        Tracer::exportChromeTrace(ss);
+        if (exports % 2 == 1) Tracer::clear();
+
+        // Spans that were overwritten while exporting are skipped, the others are complete
+        const auto json = ss.str();
+        const auto spans = countOccurrences(json, "\"ph\":\"X\"");
+        EXPECT_EQ(spans, countOccurrences(json, R"("ts":1.000,"dur":1.000,"cat":"test")"));
+        EXPECT_EQ(spans, countOccurrences(json, "\"tracer-test-concurrent\""));
+        EXPECT_LE(spans, Tracer::bufferCapacity);
+    }
+    recorder.join();
+    Tracer::clear();
+}
+
+}  // namespace inviwo
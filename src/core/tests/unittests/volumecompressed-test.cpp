@@ -0,0 +1,186 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volumecompressed.h>
+#include <inviwo/core/datastructures/volume/volumecompressedconverter.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/io/rawvolumeramloader.h>
+#include <inviwo/core/io/tempfilehandle.h>
+
+#include "volumetestutil.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace inviwo {
+
+using testutil::makeVolume;
+
+namespace {
+
+template <typename T>
+void expectRoundTrip(const VolumeRAMPrecision<T>& ram, const VolumeCompressed& compressed) {
+    std::vector<T> result(glm::compMul(ram.getDimensions()));
+    compressed.decompress(result.data());
+    EXPECT_EQ(0, std::memcmp(result.data(), ram.getDataTyped(), result.size() * sizeof(T)));
+}
+
+}  // namespace
+
+TEST(VolumeCompressedTest, ConstantBricks) {
+    auto ram =
+        makeVolume<std::uint8_t>(size3_t{40, 33, 17}, [](size3_t) { return std::uint8_t{7}; });
+    VolumeCompressed compressed(*ram, size3_t{16});
+
+    EXPECT_EQ(size3_t(3, 3, 2), compressed.getBrickCounts());
+    for (size_t i = 0; i < compressed.getNumberOfBricks(); ++i) {
+        EXPECT_EQ(VolumeCompressed::Codec::Constant, compressed.getCodec(i));
+    }
+    EXPECT_EQ(compressed.getNumberOfBricks(), compressed.getCompressedSize());
+    expectRoundTrip(*ram, compressed);
+}
+
+TEST(VolumeCompressedTest, LabelVolume) {
+    auto ram = makeVolume<std::uint16_t>(size3_t{50, 40, 30}, [](size3_t p) {
+        return static_cast<std::uint16_t>(1000 + (p.x / 10) + 5 * (p.y / 20) + 3 * (p.z / 7));
+    });
+    VolumeCompressed compressed(*ram);
+
+    EXPECT_GT(compressed.getCompressionRatio(), 2.0);
+    expectRoundTrip(*ram, compressed);
+}
+
+TEST(VolumeCompressedTest, Gradient) {
+    auto ram = makeVolume<glm::i32vec2>(size3_t{33, 33, 33}, [](size3_t p) {
+        return glm::i32vec2{static_cast<int>(p.x + 1000 * p.y) - 50000, -static_cast<int>(p.z)};
+    });
+    VolumeCompressed compressed(*ram, size3_t{8});
+
+    EXPECT_EQ(VolumeCompressed::Codec::Delta, compressed.getCodec(0));
+    expectRoundTrip(*ram, compressed);
+}
+
+TEST(VolumeCompressedTest, FloatVolume) {
+    auto ram = makeVolume<float>(size3_t{20, 21, 22},
+                                 [](size3_t p) { return 0.5f * p.x - 0.25f * p.y + p.z; });
+    VolumeCompressed compressed(*ram, size3_t{8});
+
+    EXPECT_EQ(VolumeCompressed::Codec::Raw, compressed.getCodec(0));
+    expectRoundTrip(*ram, compressed);
+}
+
+TEST(VolumeCompressedTest, VoxelAccess) {
+    auto ram = makeVolume<std::int8_t>(size3_t{19, 23, 5}, [](size3_t p) {
+        return static_cast<std::int8_t>(static_cast<int>(p.x + p.y) - 20);
+    });
+    VolumeCompressed compressed(*ram, size3_t{4, 8, 2});
+    compressed.setCacheSize(2);
+
+    for (const auto& p : {size3_t{0, 0, 0}, size3_t{18, 22, 4}, size3_t{7, 9, 3}}) {
+        EXPECT_EQ(ram->getAsDVec4(p), compressed.getAsDVec4(p));
+    }
+}
+
+TEST(VolumeCompressedTest, SetSlab) {
+    const size3_t dims{10, 12, 9};
+    auto ram = makeVolume<std::uint32_t>(
+        dims, [](size3_t p) { return static_cast<std::uint32_t>(p.x * p.y * p.z); });
+    VolumeCompressed compressed(dims, ram->getDataFormat(), swizzlemasks::rgba,
+                                InterpolationType::Linear, wrapping3d::clampAll, size3_t{4});
+
+    const auto slabVoxels = dims.x * dims.y * compressed.getBrickSize().z;
+    for (size_t slab = 0; slab < compressed.getBrickCounts().z; ++slab) {
+        compressed.setSlab(slab, ram->getDataTyped() + slab * slabVoxels);
+    }
+    expectRoundTrip(*ram, compressed);
+}
+
+TEST(VolumeCompressedTest, CloneSharesBricks) {
+    auto ram = makeVolume<std::uint8_t>(size3_t{16},
+                                        [](size3_t p) { return static_cast<std::uint8_t>(p.x); });
+    VolumeCompressed compressed(*ram, size3_t{8});
+    std::unique_ptr<VolumeCompressed> copy(compressed.clone());
+
+    std::vector<std::uint8_t> brick(8 * 8 * 8, 42);
+    copy->setBrick(0, brick.data());
+    EXPECT_EQ(VolumeCompressed::Codec::Constant, copy->getCodec(0));
+    EXPECT_NE(VolumeCompressed::Codec::Constant, compressed.getCodec(0));
+    EXPECT_EQ(42.0, copy->getAsDVec4(size3_t{1, 2, 3}).x);
+    EXPECT_EQ(1.0, compressed.getAsDVec4(size3_t{1, 2, 3}).x);
+}
+
+TEST(VolumeCompressedTest, Converters) {
+    auto ram = makeVolume<std::uint8_t>(size3_t{9, 10, 11}, [](size3_t p) {
+        return static_cast<std::uint8_t>((p.x + 2 * p.y + 3 * p.z) % 4);
+    });
+
+    VolumeRAM2CompressedConverter toCompressed;
+    VolumeCompressed2RAMConverter toRAM;
+    auto compressed = toCompressed.createFrom(ram);
+    auto result = std::static_pointer_cast<VolumeRAMPrecision<std::uint8_t>>(
+        toRAM.createFrom(compressed));
+
+    EXPECT_EQ(ram->getDimensions(), result->getDimensions());
+    EXPECT_EQ(ram->getDataFormat(), result->getDataFormat());
+    expectRoundTrip(*result, *compressed);
+}
+
+TEST(VolumeCompressedTest, ReadRaw) {
+    const size3_t dims{20, 12, 21};
+    const size_t offset = 16;
+    auto ram = makeVolume<std::uint16_t>(dims, [](size3_t p) {
+        return static_cast<std::uint16_t>(p.x + 100 * p.y + 1000 * (p.z / 4));
+    });
+
+    util::TempFileHandle file{"ivw-compressed", ".raw"};
+    {
+        std::ofstream out(file.getFileName(), std::ios::binary);
+        const std::vector<char> header(offset, 0);
+        out.write(header.data(), header.size());
+        out.write(reinterpret_cast<const char*>(ram->getDataTyped()),
+                  glm::compMul(dims) * sizeof(std::uint16_t));
+    }
+
+    std::vector<size_t> slabDepths;
+    auto compressed = util::readRawVolumeCompressed(
+        file.getFileName(), offset, true, dims, DataUInt16::get(), size3_t{8},
+        [&](const VolumeRAM& slab) { slabDepths.push_back(slab.getDimensions().z); });
+
+    EXPECT_EQ(dims, compressed->getDimensions());
+    EXPECT_EQ(DataUInt16::get(), compressed->getDataFormat());
+    EXPECT_EQ((std::vector<size_t>{8, 8, 5}), slabDepths);
+    expectRoundTrip(*ram, *compressed);
+}
+
+}  // namespace inviwo
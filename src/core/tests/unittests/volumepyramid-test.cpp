@@ -0,0 +1,172 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumepyramid.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+
+#include "volumetestutil.h"
+
+#include <algorithm>
+
+namespace inviwo {
+
+using testutil::makeVolume;
+
+namespace {
+
+template <typename T>
+T voxel(const VolumeRAM* ram, size3_t pos) {
+    const auto typed = static_cast<const VolumeRAMPrecision<T>*>(ram);
+    return typed->getDataTyped()[VolumeRAM::posToIndex(pos, typed->getDimensions())];
+}
+
+}  // namespace
+
+TEST(VolumePyramidTest, Dimensions) {
+    auto ram = makeVolume<float>(size3_t{5, 4, 3}, [](size3_t) { return 1.0f; });
+    VolumePyramid pyramid(ram, PyramidFilter::Mean);
+
+    ASSERT_EQ(4u, pyramid.size());
+    EXPECT_EQ(ram.get(), pyramid.getLevel(0));
+    EXPECT_TRUE(pyramid.isBuiltFrom(ram.get()));
+    EXPECT_EQ(size3_t(3, 2, 2), pyramid.getDimensions(1));
+    EXPECT_EQ(size3_t(2, 1, 1), pyramid.getDimensions(2));
+    EXPECT_EQ(size3_t(1, 1, 1), pyramid.getDimensions(3));
+    EXPECT_EQ(1.0f, voxel<float>(pyramid.getLevel(3), size3_t{0}));
+}
+
+TEST(VolumePyramidTest, Filters) {
+    // Values 0..7 in the 2x2x2 block, negated at odd z
+    auto ram = makeVolume<int>(size3_t{2, 2, 2}, [](size3_t p) {
+        const auto v = static_cast<int>(p.x + 2 * p.y + 4 * p.z);
+        return p.z % 2 == 1 ? -v : v;
+    });
+
+    EXPECT_EQ(-2, voxel<int>(VolumePyramid(ram, PyramidFilter::Mean).getLevel(1), size3_t{0}));
+    EXPECT_EQ(-7, voxel<int>(VolumePyramid(ram, PyramidFilter::Min).getLevel(1), size3_t{0}));
+    EXPECT_EQ(3, voxel<int>(VolumePyramid(ram, PyramidFilter::Max).getLevel(1), size3_t{0}));
+    EXPECT_EQ(-7, voxel<int>(VolumePyramid(ram, PyramidFilter::MaxAbs).getLevel(1), size3_t{0}));
+}
+
+TEST(VolumePyramidTest, BorderBlocks) {
+    // The last block along x only has one voxel
+    auto ram = makeVolume<std::uint8_t>(size3_t{3, 1, 1}, [](size3_t p) {
+        return static_cast<std::uint8_t>(10 * (p.x + 1));
+    });
+    VolumePyramid pyramid(ram, PyramidFilter::Mean);
+
+    ASSERT_EQ(size3_t(2, 1, 1), pyramid.getDimensions(1));
+    EXPECT_EQ(15, voxel<std::uint8_t>(pyramid.getLevel(1), size3_t(0, 0, 0)));
+    EXPECT_EQ(30, voxel<std::uint8_t>(pyramid.getLevel(1), size3_t(1, 0, 0)));
+}
+
+TEST(VolumePyramidTest, LevelSelection) {
+    auto ram = makeVolume<float>(size3_t{64, 64, 64}, [](size3_t) { return 0.0f; });
+    VolumePyramid pyramid(ram, PyramidFilter::Mean);
+    ASSERT_EQ(7u, pyramid.size());
+
+    EXPECT_EQ(0u, pyramid.levelForFootprint(0.5));
+    EXPECT_EQ(0u, pyramid.levelForFootprint(1.9));
+    EXPECT_EQ(1u, pyramid.levelForFootprint(2.0));
+    EXPECT_EQ(3u, pyramid.levelForFootprint(10.0));
+    EXPECT_EQ(6u, pyramid.levelForFootprint(1000.0));
+
+    EXPECT_EQ(0u, pyramid.levelForVoxelBudget(64 * 64 * 64));
+    EXPECT_EQ(2u, pyramid.levelForVoxelBudget(20 * 20 * 20));
+    EXPECT_EQ(6u, pyramid.levelForVoxelBudget(0));
+
+    LevelOfDetailBudget budget(LevelOfDetailBudget::Milliseconds{1.0});
+    const auto voxels = [](const size3_t& dims) { return glm::compMul(dims); };
+    EXPECT_EQ(0u, budget.select(pyramid, voxels));
+    // 0.001 ms per voxel gives room for 1000 voxels
+    budget.update(LevelOfDetailBudget::Milliseconds{10.0}, 10000);
+    EXPECT_EQ(3u, budget.select(pyramid, voxels));
+}
+
+TEST(VolumePyramidTest, VolumeCache) {
+    auto volume = std::make_shared<Volume>(
+        makeVolume<float>(size3_t{8, 8, 8}, [](size3_t p) { return static_cast<float>(p.x); }));
+
+    auto mean = volume->getPyramid();
+    EXPECT_EQ(mean, volume->getPyramid(PyramidFilter::Mean));
+    EXPECT_NE(mean, volume->getPyramid(PyramidFilter::Max));
+    EXPECT_EQ(3.5f, voxel<float>(mean->getLevel(3), size3_t{0}));
+
+    auto calculation = volume->calculatePyramid(PyramidFilter::Mean);
+    EXPECT_TRUE(calculation->isDone());
+    EXPECT_EQ(mean, calculation->getPyramid());
+
+    volume->invalidatePyramids();
+    EXPECT_NE(mean, volume->getPyramid());
+
+    // Copies have their own cache, even while they share the representation
+    Volume copy(*volume);
+    EXPECT_NE(volume->getPyramid(), copy.getPyramid());
+}
+
+TEST(VolumePyramidTest, EditInvalidatesCache) {
+    auto volume = std::make_shared<Volume>(
+        makeVolume<float>(size3_t{4, 4, 4}, [](size3_t) { return 1.0f; }));
+    auto before = volume->getPyramid();
+    EXPECT_EQ(1.0f, voxel<float>(before->getLevel(2), size3_t{0}));
+
+    auto ram = static_cast<VolumeRAMPrecision<float>*>(
+        volume->getEditableRepresentation<VolumeRAM>());
+    std::fill_n(ram->getDataTyped(), 64, 3.0f);
+
+    auto after = volume->getPyramid();
+    EXPECT_NE(before, after);
+    EXPECT_EQ(3.0f, voxel<float>(after->getLevel(2), size3_t{0}));
+    EXPECT_EQ(1.0f, voxel<float>(before->getLevel(2), size3_t{0}));
+}
+
+TEST(VolumePyramidTest, CacheDoesNotKeepSource) {
+    auto volume = std::make_shared<Volume>(
+        makeVolume<float>(size3_t{8, 8, 8}, [](size3_t p) { return static_cast<float>(p.x); }));
+    std::weak_ptr<const VolumePyramid> weakPyramid = volume->getPyramid();
+    EXPECT_TRUE(weakPyramid.expired());
+
+    // The cache rebuilds the pyramid from the coarser levels as long as the source is alive
+    auto pyramid = volume->getPyramid();
+    auto coarse = pyramid->getSharedLevel(1);
+    pyramid.reset();
+    EXPECT_EQ(coarse, volume->getPyramid()->getSharedLevel(1));
+
+    std::weak_ptr<const VolumeRAM> source = volume->getPyramid()->getSharedLevel(0);
+    volume->clearRepresentations();
+    EXPECT_TRUE(source.expired());
+}
+
+}  // namespace inviwo
@@ -0,0 +1,57 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#pragma once
+
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/glm.h>
+#include <inviwo/core/util/indexmapper.h>
+
+#include <memory>
+
+namespace inviwo {
+
+namespace testutil {
+
+/**
+ * Create a VolumeRAM of \p dims where each voxel is set to \p func(pos), pos being the
+ * voxel position.
+ */
+template <typename T, typename Func>
+std::shared_ptr<VolumeRAMPrecision<T>> makeVolume(size3_t dims, Func&& func) {
+    auto ram = std::make_shared<VolumeRAMPrecision<T>>(dims);
+    const util::IndexMapper3D im(dims);
+    auto* data = ram->getDataTyped();
+    for (size_t i = 0; i < glm::compMul(dims); ++i) data[i] = func(im(i));
+    return ram;
+}
+
+}  // namespace testutil
+
+}  // namespace inviwo
@@ -0,0 +1,183 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <warn/push>
+#include <warn/ignore/all>
+#include <gtest/gtest.h>
+#include <warn/pop>
+
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/workspacehistory.h>
+#include <inviwo/core/properties/ordinalproperty.h>
+
+namespace inviwo {
+
+namespace {
+
+struct HistoryProcessor : Processor {
+    HistoryProcessor(const std::string& id) : Processor(id, id), value("value", "Value", 0) {
+        addProperty(value);
+    }
+
+    virtual const ProcessorInfo getProcessorInfo() const override { return processorInfo_; }
+    virtual void process() override {}
+
+    static const ProcessorInfo processorInfo_;
+
+    IntProperty value;
+};
+
+const ProcessorInfo HistoryProcessor::processorInfo_{
+    "org.inviwo.HistoryProcessor",  // Class identifier
+    "HistoryProcessor",             // Display name
+    "Testing",                      // Category
+    CodeState::Stable,              // Code state
+    Tags::CPU,                      // Tags
+};
+
+}  // namespace
+
+TEST(WorkspaceHistory, DeltaUndoRedo) {
+    auto app = InviwoApplication::getPtr();
+    ProcessorNetwork network{app};
+
+    auto a = network.addProcessor(std::make_unique<HistoryProcessor>("a"));
+    auto b = network.addProcessor(std::make_unique<HistoryProcessor>("b"));
+    auto pa = static_cast<HistoryProcessor*>(a);
+    auto pb = static_cast<HistoryProcessor*>(b);
+
+    WorkspaceHistory history{app->getWorkspaceManager(), &network, ""};
+    EXPECT_TRUE(history.pushState());
+    EXPECT_EQ(history.getNumberOfStates(), size_t{1});
+    EXPECT_TRUE(history.getWorkspace());
+    EXPECT_FALSE(history.canUndo());
+    EXPECT_FALSE(history.isDirty());
+
+    pa->value.set(5);
+    EXPECT_TRUE(history.isDirty());
+    EXPECT_TRUE(history.pushState());
+    EXPECT_EQ(history.getNumberOfStates(), size_t{2});
+    EXPECT_FALSE(history.getWorkspace());
+
+    pb->value.set(7);
+    EXPECT_TRUE(history.pushState());
+    EXPECT_FALSE(history.pushState());
+    EXPECT_EQ(history.getNumberOfStates(), size_t{3});
+    EXPECT_GT(history.getMemoryUsage(), size_t{0});
+
+    EXPECT_TRUE(history.undo());
+    EXPECT_EQ(pa->value.get(), 5);
+    EXPECT_EQ(pb->value.get(), 0);
+    EXPECT_FALSE(history.isDirty());
+
+    EXPECT_TRUE(history.undo());
+    EXPECT_EQ(pa->value.get(), 0);
+    EXPECT_EQ(pb->value.get(), 0);
+    EXPECT_FALSE(history.canUndo());
+
+    EXPECT_TRUE(history.redo());
+    EXPECT_TRUE(history.redo());
+    EXPECT_FALSE(history.canRedo());
+    EXPECT_EQ(pa->value.get(), 5);
+    EXPECT_EQ(pb->value.get(), 7);
+
+    // A new change discards the redo states
+    EXPECT_TRUE(history.undo());
+    pa->value.set(3);
+    EXPECT_TRUE(history.pushState());
+    EXPECT_FALSE(history.canRedo());
+    EXPECT_EQ(history.getNumberOfStates(), size_t{3});
+    EXPECT_TRUE(history.undo());
+    EXPECT_EQ(pa->value.get(), 5);
+    EXPECT_EQ(pb->value.get(), 0);
+}
+
+TEST(WorkspaceHistory, UnattributedNetworkChange) {
+    auto app = InviwoApplication::getPtr();
+    ProcessorNetwork network{app};
+    auto pa = static_cast<HistoryProcessor*>(
+        network.addProcessor(std::make_unique<HistoryProcessor>("a")));
+
+    WorkspaceHistory history{app->getWorkspaceManager(), &network, ""};
+    EXPECT_TRUE(history.pushState());
+
+    pa->value.set(1);
+    EXPECT_TRUE(history.pushState());
+    EXPECT_FALSE(history.getWorkspace());
+
+    // A network change that no processor accounts for can not be recorded as a delta
+    pa->value.set(2);
+    network.notifyObserversProcessorNetworkChanged();
+    EXPECT_TRUE(history.pushState());
+    EXPECT_TRUE(history.getWorkspace());
+
+    pa->value.set(3);
+    EXPECT_TRUE(history.pushState());
+    EXPECT_FALSE(history.getWorkspace());
+}
+
+TEST(WorkspaceHistory, MemoryUsage) {
+    auto app = InviwoApplication::getPtr();
+    ProcessorNetwork network{app};
+    auto pa = static_cast<HistoryProcessor*>(
+        network.addProcessor(std::make_unique<HistoryProcessor>("a")));
+    network.addProcessor(std::make_unique<HistoryProcessor>("b"));
+
+    WorkspaceHistory history{app->getWorkspaceManager(), &network, ""};
+    EXPECT_TRUE(history.pushState());
+    const auto snapshot = history.getMemoryUsage();
+    EXPECT_GT(snapshot, history.getWorkspace()->size());
+
+    pa->value.set(1);
+    EXPECT_TRUE(history.pushState());
+    const auto delta = history.getMemoryUsage();
+    EXPECT_GT(delta, snapshot);
+
+    // Undoing and pushing a new state drops the old delta
+    EXPECT_TRUE(history.undo());
+    pa->value.set(2);
+    EXPECT_TRUE(history.pushState());
+    EXPECT_EQ(delta, history.getMemoryUsage());
+
+    // Only the newest snapshot is kept when the limit is exceeded
+    history.markDirty();
+    EXPECT_TRUE(history.pushState());
+    const auto all = history.getMemoryUsage();
+    history.setMemoryLimit(1);
+    EXPECT_EQ(history.getNumberOfStates(), size_t{1});
+    EXPECT_LT(history.getMemoryUsage(), all);
+    EXPECT_GT(history.getMemoryUsage(), history.getWorkspace()->size());
+
+    history.clear();
+    EXPECT_EQ(size_t{0}, history.getMemoryUsage());
+}
+
+}  // namespace inviwo
@@ -62,6 +62,14 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     , workspace_("w", "workspace", "Specify workspace to open", false, "", "workspace file")
     , outputPath_("o", "output", "Specify output path", false, "", "output path")
     , logfile_("l", "logfile", "Write log messages to file.", false, "", "logfile")
+    , tracefile_("", "trace",
+                 "Record a trace of the session and write it to file at exit, in the Chrome trace "
+                 "format (chrome://tracing or ui.perfetto.dev)",
+                 false, "", "tracefile")
+    , metricsfile_("", "metrics",
+                   "Write per processor performance counters to file after every network "
+                   "evaluation, as CSV if the file extension is csv otherwise as JSON lines",
+                   false, "", "metricsfile")
     , logConsole_("c", "logconsole", "Write log messages to console (cout)", false)
     , noSplashScreen_("n", "nosplash", "Pass this flag if you do not want to show a splash screen.")
     , quitAfterStartup_("q", "quit", "Pass this flag if you want to close inviwo after startup.")
@@ -75,6 +83,8 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     cmdQuiet_.add(quitAfterStartup_);
     cmdQuiet_.add(noSplashScreen_);
     cmdQuiet_.add(logfile_);
+    cmdQuiet_.add(tracefile_);
+    cmdQuiet_.add(metricsfile_);
     cmdQuiet_.add(logConsole_);
     cmdQuiet_.add(helpQuiet_);
     cmdQuiet_.add(versionQuiet_);
@@ -86,6 +96,8 @@ CommandLineParser::CommandLineParser(int argc, char** argv)
     cmd_.add(quitAfterStartup_);
     cmd_.add(noSplashScreen_);
     cmd_.add(logfile_);
+    cmd_.add(tracefile_);
+    cmd_.add(metricsfile_);
     cmd_.add(logConsole_);
     cmd_.add(disableResourceManager_);
 
@@ -149,6 +161,16 @@ const std::string CommandLineParser::getLogToFileFileName() const {
         return "";
 }
 
+const std::string CommandLineParser::getTraceFileName() const {
+    if (tracefile_.isSet()) return tracefile_.getValue();
+    return "";
+}
+
+const std::string CommandLineParser::getMetricsFileName() const {
+    if (metricsfile_.isSet()) return metricsfile_.getValue();
+    return "";
+}
+
 bool CommandLineParser::getQuitApplicationAfterStartup() const {
     return quitAfterStartup_.getValue();
 }
@@ -180,6 +202,14 @@ bool CommandLineParser::getLogToFile() const {
     return false;
 }
 
+bool CommandLineParser::getTrace() const {
+    return tracefile_.isSet() && !tracefile_.getValue().empty();
+}
+
+bool CommandLineParser::getMetrics() const {
+    return metricsfile_.isSet() && !metricsfile_.getValue().empty();
+}
+
 bool CommandLineParser::getLogToConsole() const { return logConsole_.isSet(); }
 
 bool CommandLineParser::getDisableResourceManager() const {
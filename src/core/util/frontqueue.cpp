@@ -0,0 +1,236 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/frontqueue.h>
+
+#include <algorithm>
+
+namespace inviwo {
+
+namespace {
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t res = 2;
+    while (res < value) res <<= 1;
+    return res;
+}
+
+template <typename T>
+void storeMax(std::atomic<T>& target, T value) {
+    auto current = target.load(std::memory_order_relaxed);
+    while (current < value &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+}  // namespace
+
+FrontQueue::Task::Task(Task&& rhs) noexcept : ops_{rhs.ops_} {
+    if (ops_) {
+        ops_->move(buffer_, rhs.buffer_);
+        rhs.ops_ = nullptr;
+    }
+}
+
+FrontQueue::Task& FrontQueue::Task::operator=(Task&& rhs) noexcept {
+    if (this != &rhs) {
+        reset();
+        if (rhs.ops_) {
+            rhs.ops_->move(buffer_, rhs.buffer_);
+            ops_ = rhs.ops_;
+            rhs.ops_ = nullptr;
+        }
+    }
+    return *this;
+}
+
+FrontQueue::Task::~Task() { reset(); }
+
+void FrontQueue::Task::operator()() { ops_->invoke(buffer_); }
+
+void FrontQueue::Task::reset() noexcept {
+    if (ops_) {
+        ops_->destroy(buffer_);
+        ops_ = nullptr;
+    }
+}
+
+FrontQueue::FrontQueue(size_t capacity)
+    : mask_{roundUpToPowerOfTwo(capacity) - 1}, cells_{new Cell[mask_ + 1]} {
+    for (size_t i = 0; i <= mask_; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+FrontQueue::~FrontQueue() = default;
+
+FrontQueue::Token FrontQueue::makeToken() { return std::make_shared<std::atomic<bool>>(false); }
+
+bool FrontQueue::push(Task task) {
+    Item item{std::move(task), nullptr, clock_t::now()};
+    return enqueue(item);
+}
+
+bool FrontQueue::push(const Token& token, Task task) {
+    if (token->exchange(true)) {
+        coalesced_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    Item item{std::move(task), token, clock_t::now()};
+    return enqueue(item);
+}
+
+bool FrontQueue::enqueue(Item& item) {
+    const auto depth = posted_.fetch_add(1, std::memory_order_relaxed) + 1 -
+                       processed_.load(std::memory_order_relaxed);
+    storeMax(maxDepth_, depth);
+
+    if (overflowing_.load(std::memory_order_acquire) || !tryPushRing(item)) {
+        std::scoped_lock lock{overflowMutex_};
+        // Once spilled, keep using the overflow until it is drained to preserve the order
+        if (overflowing_.load(std::memory_order_relaxed) || !tryPushRing(item)) {
+            overflow_.push_back(std::move(item));
+            overflowing_.store(true, std::memory_order_release);
+            overflowed_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return !wakeUpPending_.exchange(true, std::memory_order_acq_rel);
+}
+
+bool FrontQueue::tryPushRing(Item& item) {
+    // Bounded queue by Dmitry Vyukov, each cell's sequence tells whether it is free for the
+    // producer at pos (sequence == pos) or holds data for the consumer (sequence == pos + 1)
+    auto pos = enqueuePos_.load(std::memory_order_relaxed);
+    while (true) {
+        auto& cell = cells_[pos & mask_];
+        const auto seq = cell.sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.item = std::move(item);
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;  // full
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool FrontQueue::tryPopRing(Item& item) {
+    auto& cell = cells_[dequeuePos_ & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) return false;
+
+    item = std::move(cell.item);
+    cell.sequence.store(dequeuePos_ + mask_ + 1, std::memory_order_release);
+    ++dequeuePos_;
+    return true;
+}
+
+bool FrontQueue::tryPop(Item& item) {
+    // Tasks that made it into the ring before a spill have to run before the overflow
+    if (tryPopRing(item)) return true;
+    if (!overflowing_.load(std::memory_order_acquire)) return false;
+
+    std::scoped_lock lock{overflowMutex_};
+    if (tryPopRing(item)) return true;
+    if (overflow_.empty()) return false;
+    item = std::move(overflow_.front());
+    overflow_.pop_front();
+    if (overflow_.empty()) overflowing_.store(false, std::memory_order_release);
+    return true;
+}
+
+void FrontQueue::run(Item& item) {
+    const auto latency =
+        std::chrono::duration<double, std::milli>(clock_t::now() - item.posted).count();
+    const auto mean = meanLatency_.load(std::memory_order_relaxed);
+    meanLatency_.store(mean == 0.0 ? latency : 0.95 * mean + 0.05 * latency,
+                       std::memory_order_relaxed);
+    if (latency > maxLatency_.load(std::memory_order_relaxed)) {
+        maxLatency_.store(latency, std::memory_order_relaxed);
+    }
+
+    if (item.token) item.token->store(false, std::memory_order_release);
+    auto task = std::move(item.task);
+    item.token.reset();
+    processed_.fetch_add(1, std::memory_order_relaxed);
+    task();
+}
+
+size_t FrontQueue::process() {
+    // An exchange, not a store, to synchronize with the producer that requested the wake up
+    wakeUpPending_.exchange(false, std::memory_order_acq_rel);
+    Item item;
+    while (tryPop(item)) {
+        run(item);
+    }
+    return size();
+}
+
+size_t FrontQueue::process(clock_t::duration budget) {
+    wakeUpPending_.exchange(false, std::memory_order_acq_rel);
+    const auto end = clock_t::now() + budget;
+    Item item;
+    while (tryPop(item)) {
+        run(item);
+        if (clock_t::now() >= end) break;
+    }
+    return size();
+}
+
+size_t FrontQueue::size() const {
+    const auto processed = processed_.load(std::memory_order_relaxed);
+    const auto posted = posted_.load(std::memory_order_relaxed);
+    return posted > processed ? posted - processed : 0;
+}
+
+auto FrontQueue::getMetrics() const -> Metrics {
+    Metrics metrics;
+    metrics.depth = size();
+    metrics.maxDepth = maxDepth_.load(std::memory_order_relaxed);
+    metrics.processed = processed_.load(std::memory_order_relaxed);
+    metrics.coalesced = coalesced_.load(std::memory_order_relaxed);
+    metrics.overflowed = overflowed_.load(std::memory_order_relaxed);
+    metrics.meanLatency = meanLatency_.load(std::memory_order_relaxed);
+    metrics.maxLatency = maxLatency_.load(std::memory_order_relaxed);
+    return metrics;
+}
+
+void FrontQueue::resetMetrics() {
+    maxDepth_.store(size(), std::memory_order_relaxed);
+    coalesced_.store(0, std::memory_order_relaxed);
+    overflowed_.store(0, std::memory_order_relaxed);
+    meanLatency_.store(0.0, std::memory_order_relaxed);
+    maxLatency_.store(0.0, std::memory_order_relaxed);
+}
+
+}  // namespace inviwo
@@ -0,0 +1,158 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/memorymappedfile.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <utility>
+#include <string>
+
+#ifdef WIN32
+struct IUnknown;  // Workaround for "combaseapi.h(229): error C2187: syntax error: 'identifier' was
+                  // unexpected here" when using /permissive-
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace inviwo {
+
+namespace util {
+
+MemoryMappedFile::MemoryMappedFile(std::string_view filePath) {
+#ifdef WIN32
+    const auto wpath = util::toWstring(filePath);
+    HANDLE file = CreateFileW(wpath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw FileException(std::string("Could not open file: ") + std::string(filePath),
+                            IVW_CONTEXT);
+    }
+    file_ = file;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        unmap();
+        throw FileException(std::string("Could not query size of file: ") + std::string(filePath),
+                            IVW_CONTEXT);
+    }
+    size_ = static_cast<size_t>(size.QuadPart);
+    if (size_ == 0) return;
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        unmap();
+        throw FileException(std::string("Could not map file: ") + std::string(filePath),
+                            IVW_CONTEXT);
+    }
+    mapping_ = mapping;
+
+    data_ = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data_) {
+        unmap();
+        throw FileException(std::string("Could not map file: ") + std::string(filePath),
+                            IVW_CONTEXT);
+    }
+#else
+    const std::string path{filePath};
+    file_ = ::open(path.c_str(), O_RDONLY);
+    if (file_ < 0) {
+        throw FileException("Could not open file: " + path, IVW_CONTEXT);
+    }
+
+    struct stat st;
+    if (::fstat(file_, &st) != 0) {
+        unmap();
+        throw FileException("Could not query size of file: " + path, IVW_CONTEXT);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0) return;
+
+    void* ptr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_, 0);
+    if (ptr == MAP_FAILED) {
+        unmap();
+        throw FileException("Could not map file: " + path, IVW_CONTEXT);
+    }
+    data_ = static_cast<const char*>(ptr);
+    ::madvise(ptr, size_, MADV_SEQUENTIAL);
+#endif
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& rhs) noexcept
+    : data_{std::exchange(rhs.data_, nullptr)}
+    , size_{std::exchange(rhs.size_, 0)}
+#ifdef WIN32
+    , file_{std::exchange(rhs.file_, nullptr)}
+    , mapping_{std::exchange(rhs.mapping_, nullptr)}
+#else
+    , file_{std::exchange(rhs.file_, -1)}
+#endif
+{
+}
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& rhs) noexcept {
+    if (this != &rhs) {
+        unmap();
+        data_ = std::exchange(rhs.data_, nullptr);
+        size_ = std::exchange(rhs.size_, 0);
+#ifdef WIN32
+        file_ = std::exchange(rhs.file_, nullptr);
+        mapping_ = std::exchange(rhs.mapping_, nullptr);
+#else
+        file_ = std::exchange(rhs.file_, -1);
+#endif
+    }
+    return *this;
+}
+
+MemoryMappedFile::~MemoryMappedFile() { unmap(); }
+
+void MemoryMappedFile::unmap() {
+#ifdef WIN32
+    if (data_) UnmapViewOfFile(data_);
+    if (mapping_) CloseHandle(mapping_);
+    if (file_) CloseHandle(file_);
+    mapping_ = nullptr;
+    file_ = nullptr;
+#else
+    if (data_) ::munmap(const_cast<char*>(data_), size_);
+    if (file_ >= 0) ::close(file_);
+    file_ = -1;
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+}  // namespace util
+
+}  // namespace inviwo
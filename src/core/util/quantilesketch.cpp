@@ -0,0 +1,178 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/quantilesketch.h>
+#include <inviwo/core/util/exception.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace inviwo {
+
+namespace util {
+
+QuantileSketch::QuantileSketch(size_t k)
+    : k_{std::max(k, size_t{8})}, levels_(1), parity_(1, false), maxRetained_{k_} {}
+
+void QuantileSketch::add(double value) {
+    if (std::isnan(value)) return;
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+    ++count_;
+    levels_[0].push_back(value);
+    if (++retained_ >= maxRetained_) compress();
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (&other == this || other.empty()) return;
+
+    if (other.levels_.size() > levels_.size()) {
+        levels_.resize(other.levels_.size());
+        parity_.resize(other.levels_.size(), false);
+    }
+    for (size_t h = 0; h < other.levels_.size(); ++h) {
+        levels_[h].insert(levels_[h].end(), other.levels_[h].begin(), other.levels_[h].end());
+    }
+    retained_ += other.retained_;
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+
+    maxRetained_ = 0;
+    for (size_t h = 0; h < levels_.size(); ++h) maxRetained_ += capacity(h);
+    while (retained_ >= maxRetained_) compress();
+}
+
+size_t QuantileSketch::capacity(size_t level) const {
+    const auto depth = static_cast<double>(levels_.size() - 1 - level);
+    const auto cap = std::ceil(static_cast<double>(k_) * std::pow(2.0 / 3.0, depth));
+    return std::max(size_t{2}, static_cast<size_t>(cap));
+}
+
+void QuantileSketch::compress() {
+    // When the sketch is over its total capacity at least one level has to be over its own.
+    for (size_t h = 0; h < levels_.size(); ++h) {
+        if (levels_[h].size() >= capacity(h)) {
+            compact(h);
+            return;
+        }
+    }
+}
+
+void QuantileSketch::compact(size_t level) {
+    if (level + 1 == levels_.size()) {
+        levels_.emplace_back();
+        parity_.push_back(false);
+        maxRetained_ = 0;
+        for (size_t h = 0; h < levels_.size(); ++h) maxRetained_ += capacity(h);
+    }
+
+    auto& items = levels_[level];
+    auto& above = levels_[level + 1];
+    std::sort(items.begin(), items.end());
+
+    // With an odd number of items the smallest one stays behind to keep the pairs even.
+    const size_t keep = items.size() % 2;
+    const size_t offset = parity_[level] ? 1 : 0;
+    parity_[level] = !parity_[level];
+    for (size_t i = keep + offset; i < items.size(); i += 2) {
+        above.push_back(items[i]);
+    }
+    retained_ -= (items.size() - keep) / 2;
+    items.resize(keep);
+}
+
+double QuantileSketch::quantile(double q) const { return quantiles({q}).front(); }
+
+std::vector<double> QuantileSketch::quantiles(const std::vector<double>& qs) const {
+    for (auto q : qs) {
+        if (!(q >= 0.0 && q <= 1.0)) {
+            throw Exception("Quantile must be between 0 and 1",
+                            IVW_CONTEXT_CUSTOM("QuantileSketch"));
+        }
+    }
+    if (empty()) {
+        throw Exception("Quantile of an empty sketch", IVW_CONTEXT_CUSTOM("QuantileSketch"));
+    }
+
+    std::vector<std::pair<double, std::uint64_t>> items;
+    items.reserve(retained_);
+    for (size_t h = 0; h < levels_.size(); ++h) {
+        const std::uint64_t weight = std::uint64_t{1} << h;
+        for (auto value : levels_[h]) items.emplace_back(value, weight);
+    }
+    std::sort(items.begin(), items.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    // Compaction preserves the total weight, so the last cumulative rank equals count_.
+    std::vector<std::uint64_t> ranks(items.size());
+    std::uint64_t rank = 0;
+    for (size_t i = 0; i < items.size(); ++i) {
+        rank += items[i].second;
+        ranks[i] = rank;
+    }
+
+    std::vector<double> result;
+    result.reserve(qs.size());
+    for (auto q : qs) {
+        if (q == 0.0) {
+            result.push_back(min_);
+        } else if (q == 1.0) {
+            result.push_back(max_);
+        } else {
+            const auto target = std::max(
+                std::uint64_t{1},
+                static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count_))));
+            const auto it = std::lower_bound(ranks.begin(), ranks.end(), target);
+            result.push_back(items[std::min(static_cast<size_t>(it - ranks.begin()),
+                                            items.size() - 1)]
+                                 .first);
+        }
+    }
+    return result;
+}
+
+std::uint64_t QuantileSketch::count() const { return count_; }
+
+bool QuantileSketch::empty() const { return count_ == 0; }
+
+bool QuantileSketch::isExact() const { return levels_.size() == 1; }
+
+double QuantileSketch::min() const { return min_; }
+
+double QuantileSketch::max() const { return max_; }
+
+size_t QuantileSketch::getK() const { return k_; }
+
+size_t QuantileSketch::retained() const { return retained_; }
+
+}  // namespace util
+
+}  // namespace inviwo
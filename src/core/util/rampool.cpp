@@ -0,0 +1,244 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/rampool.h>
+#include <inviwo/core/util/threadutil.h>
+#include <inviwo/core/util/metriccounters.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace inviwo {
+
+namespace {
+
+constexpr size_t alignment = 64;
+constexpr size_t firstTouchChunk = size_t{1} << 20;
+constexpr size_t parallelZeroBytes = size_t{8} << 20;
+
+#if defined(__linux__)
+constexpr bool hugePagesSupported = true;
+#else
+constexpr bool hugePagesSupported = false;
+#endif
+
+size_t mappedSize(size_t bytes) {
+    return (bytes + RAMPool::hugePageSize - 1) / RAMPool::hugePageSize * RAMPool::hugePageSize;
+}
+
+}  // namespace
+
+RAMPool& RAMPool::get() {
+    // Intentionally leaked, representations held in static objects may outlive a local static.
+    static RAMPool* pool = new RAMPool();
+    return *pool;
+}
+
+RAMPool::RAMPool(size_t cacheLimit) : cacheLimit_{cacheLimit} {}
+
+RAMPool::~RAMPool() {
+    clear();
+    for (auto& [ptr, block] : live_) releaseBlock(ptr, block);
+}
+
+size_t RAMPool::sizeClass(size_t bytes) {
+    if (bytes < minPooledBytes) {
+        return std::max(alignment, (bytes + alignment - 1) / alignment * alignment);
+    }
+    size_t pow2 = minPooledBytes;
+    while (pow2 <= bytes / 2) pow2 <<= 1;
+    const auto step = pow2 / 4;
+    return (bytes + step - 1) / step * step;
+}
+
+void* RAMPool::allocateBlock(size_t bytes, bool mapped) {
+#if defined(__linux__)
+    if (mapped) {
+        const auto size = mappedSize(bytes);
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) throw std::bad_alloc();
+        madvise(ptr, size, MADV_HUGEPAGE);
+        return ptr;
+    }
+#endif
+    return ::operator new(bytes, std::align_val_t{alignment});
+}
+
+void RAMPool::releaseBlock(void* ptr, const Block& block) noexcept {
+#if defined(__linux__)
+    if (block.mapped) {
+        munmap(ptr, mappedSize(block.bytes));
+        return;
+    }
+#endif
+    ::operator delete(ptr, std::align_val_t{alignment});
+}
+
+void RAMPool::zero(void* ptr, size_t bytes, bool parallel) {
+    if (!parallel || bytes < parallelZeroBytes) {
+        std::memset(ptr, 0, bytes);
+        return;
+    }
+    auto data = static_cast<unsigned char*>(ptr);
+    const auto chunks = (bytes + firstTouchChunk - 1) / firstTouchChunk;
+    util::cooperativeFor(chunks, [&](size_t i) {
+        const auto begin = i * firstTouchChunk;
+        std::memset(data + begin, 0, std::min(firstTouchChunk, bytes - begin));
+    });
+}
+
+void* RAMPool::allocate(size_t bytes, DataInitialization init) {
+    util::countAllocatedBytes(bytes);
+    const auto size = sizeClass(bytes);
+    Block block{size, false};
+    void* ptr = nullptr;
+    bool parallel = false;
+    {
+        std::scoped_lock lock{mutex_};
+        ++stats_.allocations;
+        parallel = parallelFirstTouch_;
+        if (auto it = cache_.find(size); it != cache_.end()) {
+            ptr = it->second.ptr;
+            block.mapped = it->second.mapped;
+            cache_.erase(it);
+            stats_.cachedBytes -= size;
+            ++stats_.poolHits;
+            live_.emplace(ptr, block);
+            stats_.liveBytes += size;
+        } else {
+            block.mapped = hugePagesSupported && hugePages_ && size >= hugePageSize;
+        }
+    }
+
+    // Freshly mapped pages are already zeroed by the kernel
+    bool zeroed = false;
+    if (!ptr) {
+        ptr = allocateBlock(size, block.mapped);
+        zeroed = block.mapped;
+        std::scoped_lock lock{mutex_};
+        live_.emplace(ptr, block);
+        stats_.liveBytes += size;
+    }
+
+    if (init == DataInitialization::Zero && !zeroed) zero(ptr, bytes, parallel);
+    return ptr;
+}
+
+void RAMPool::deallocate(void* ptr) noexcept {
+    if (!ptr) return;
+
+    Block block{};
+    std::vector<std::pair<void*, Block>> evicted;
+    {
+        std::scoped_lock lock{mutex_};
+        auto it = live_.find(ptr);
+        if (it == live_.end()) return;
+        block = it->second;
+        live_.erase(it);
+        stats_.liveBytes -= block.bytes;
+
+        if (block.bytes >= minPooledBytes && block.bytes <= cacheLimit_) {
+            evicted = evict(cacheLimit_ - block.bytes);
+            cache_.emplace(block.bytes, Cached{ptr, block.mapped});
+            stats_.cachedBytes += block.bytes;
+            ptr = nullptr;
+        }
+    }
+    for (auto& [p, b] : evicted) releaseBlock(p, b);
+    if (ptr) releaseBlock(ptr, block);
+}
+
+std::vector<std::pair<void*, RAMPool::Block>> RAMPool::evict(size_t limit) {
+    // Evict the largest blocks first, they are the least likely to be requested again.
+    std::vector<std::pair<void*, Block>> evicted;
+    while (stats_.cachedBytes > limit && !cache_.empty()) {
+        auto it = std::prev(cache_.end());
+        evicted.emplace_back(it->second.ptr, Block{it->first, it->second.mapped});
+        stats_.cachedBytes -= it->first;
+        cache_.erase(it);
+    }
+    return evicted;
+}
+
+void RAMPool::setCacheLimit(size_t bytes) {
+    std::vector<std::pair<void*, Block>> evicted;
+    {
+        std::scoped_lock lock{mutex_};
+        cacheLimit_ = bytes;
+        evicted = evict(cacheLimit_);
+    }
+    for (auto& [p, b] : evicted) releaseBlock(p, b);
+}
+
+size_t RAMPool::getCacheLimit() const {
+    std::scoped_lock lock{mutex_};
+    return cacheLimit_;
+}
+
+void RAMPool::setHugePages(bool enable) {
+    std::scoped_lock lock{mutex_};
+    hugePages_ = enable;
+}
+
+bool RAMPool::getHugePages() const {
+    std::scoped_lock lock{mutex_};
+    return hugePages_;
+}
+
+void RAMPool::setParallelFirstTouch(bool enable) {
+    std::scoped_lock lock{mutex_};
+    parallelFirstTouch_ = enable;
+}
+
+bool RAMPool::getParallelFirstTouch() const {
+    std::scoped_lock lock{mutex_};
+    return parallelFirstTouch_;
+}
+
+void RAMPool::clear() {
+    std::vector<std::pair<void*, Block>> evicted;
+    {
+        std::scoped_lock lock{mutex_};
+        evicted = evict(0);
+    }
+    for (auto& [p, b] : evicted) releaseBlock(p, b);
+}
+
+RAMPool::Stats RAMPool::getStats() const {
+    std::scoped_lock lock{mutex_};
+    return stats_;
+}
+
+}  // namespace inviwo
@@ -30,6 +30,8 @@
 #include <inviwo/core/util/settings/systemsettings.h>
 #include <inviwo/core/common/inviwoapplication.h>
 #include <inviwo/core/util/logstream.h>
+#include <inviwo/core/util/rampool.h>
+#include <inviwo/core/util/threadutil.h>
 
 namespace inviwo {
 
@@ -41,6 +43,12 @@ SystemSettings::SystemSettings(InviwoApplication* app)
                              {"developerMode", "Developer Mode", UsageMode::Development}},
                             1)
     , poolSize_("poolSize", "Pool Size", defaultPoolSize(), 0, 32)
+    , maxConcurrency_("maxConcurrency", "Max Threads per Parallel Task", 0, 0, 1024)
+    , frontQueueBudget_("frontQueueBudget", "GUI Task Time Budget (ms)", 8, 0, 1000)
+    , ramPoolCacheSize_("ramPoolCacheSize", "Data Memory Cache (MB)",
+                        RAMPool::defaultCacheLimit >> 20, 0, 65536)
+    , ramPoolHugePages_("ramPoolHugePages", "Use Huge Pages for Data", false)
+    , ramPoolFirstTouch_("ramPoolFirstTouch", "Parallel Data Initialization", true)
     , enablePortInspectors_("enablePortInspectors", "Enable port inspectors", true)
     , portInspectorSize_("portInspectorSize", "Port inspector size", 128, 1, 1024)
 #if __APPLE__
@@ -64,11 +72,28 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     , redirectCout_{"redirectCout", "Redirect cout to LogCentral", false}
     , redirectCerr_{"redirectCerr", "Redirect cerr to LogCentral", false} {
 
-    addProperties(workspaceAuthor_, applicationUsageMode_, poolSize_, enablePortInspectors_,
-                  portInspectorSize_, enableTouchProperty_, enableGesturesProperty_,
-                  enablePickingProperty_, enableSoundProperty_, logStackTraceProperty_,
-                  runtimeModuleReloading_, enableResourceManager_, breakOnMessage_,
-                  breakOnException_, stackTraceInException_, redirectCout_, redirectCerr_);
+    addProperties(workspaceAuthor_, applicationUsageMode_, poolSize_, maxConcurrency_,
+                  frontQueueBudget_, ramPoolCacheSize_, ramPoolHugePages_, ramPoolFirstTouch_,
+                  enablePortInspectors_, portInspectorSize_, enableTouchProperty_,
+                  enableGesturesProperty_, enablePickingProperty_, enableSoundProperty_,
+                  logStackTraceProperty_, runtimeModuleReloading_, enableResourceManager_,
+                  breakOnMessage_, breakOnException_, stackTraceInException_, redirectCout_,
+                  redirectCerr_);
+
+    maxConcurrency_.setSemantics(PropertySemantics::Text);
+    frontQueueBudget_.setSemantics(PropertySemantics::Text);
+    maxConcurrency_.onChange([this]() { util::setConcurrencyLimit(maxConcurrency_.get()); });
+
+    ramPoolCacheSize_.setSemantics(PropertySemantics::Text);
+    const auto updateRAMPool = [this]() {
+        auto& pool = RAMPool::get();
+        pool.setCacheLimit(ramPoolCacheSize_.get() << 20);
+        pool.setHugePages(ramPoolHugePages_.get());
+        pool.setParallelFirstTouch(ramPoolFirstTouch_.get());
+    };
+    ramPoolCacheSize_.onChange(updateRAMPool);
+    ramPoolHugePages_.onChange(updateRAMPool);
+    ramPoolFirstTouch_.onChange(updateRAMPool);
 
     logStackTraceProperty_.onChange(
         [this]() { LogCentral::getPtr()->setLogStacktrace(logStackTraceProperty_.get()); });
@@ -100,6 +125,7 @@ SystemSettings::SystemSettings(InviwoApplication* app)
     });
 
     load();
+    updateRAMPool();
 }
 
 SystemSettings::~SystemSettings() = default;
@@ -147,6 +147,37 @@ std::string elideLines(std::string_view str, std::string_view abbrev, size_t max
     return result;
 }
 
+void writeJSONString(std::ostream& os, std::string_view str) {
+    os << '"';
+    for (const char c : str) {
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            case '\r':
+                os << "\\r";
+                break;
+            case '\t':
+                os << "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    constexpr std::string_view hex = "0123456789abcdef";
+                    os << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
 }  // namespace util
 
 std::vector<std::string> util::splitString(std::string_view str, char delimiter) {
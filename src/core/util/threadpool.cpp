@@ -31,6 +31,7 @@
 #include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/stdextensions.h>
 #include <inviwo/core/util/threadutil.h>
+#include <inviwo/core/util/tracer.h>
 
 namespace inviwo {
 
@@ -102,6 +103,7 @@ ThreadPool::Worker::Worker(ThreadPool& pool)
             }
             state = State::Working;
             try {
+                IVW_TRACE_SCOPE("pool", "Task");
                 task();
             } catch (...) {  // Make sure we don't leak any exceptions.
             }
@@ -29,6 +29,13 @@
 
 #include <inviwo/core/util/threadutil.h>
 #include <inviwo/core/util/stringconversion.h>
+#include <inviwo/core/common/inviwoapplication.h>
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <algorithm>
 
 #ifdef WIN32
 #include <windows.h>
@@ -60,4 +67,68 @@ void util::setThreadDescription(std::thread& thread, const std::string& desc) {
 #endif
 }
 
+namespace {
+
+std::atomic<size_t> concurrencyLimit{0};
+// Set while the thread runs tasks of a parallel region
+thread_local bool inParallelRegion = false;
+
+}  // namespace
+
+void util::setConcurrencyLimit(size_t limit) { concurrencyLimit = limit; }
+
+size_t util::getConcurrencyLimit() { return concurrencyLimit; }
+
+size_t util::concurrency() {
+    if (inParallelRegion) return 1;
+    const size_t poolSize =
+        InviwoApplication::isInitialized() ? InviwoApplication::getPtr()->getPoolSize() : 0;
+    const size_t limit = concurrencyLimit;
+    return limit == 0 ? poolSize + 1 : std::min(poolSize + 1, limit);
+}
+
+void util::cooperativeFor(size_t count, std::function<void(size_t)> task) {
+    struct State {
+        std::function<void(size_t)> task;
+        size_t count;
+        std::atomic<size_t> next{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t finished = 0;
+        std::exception_ptr error;
+
+        void run() {
+            const bool previous = inParallelRegion;
+            inParallelRegion = true;
+            for (size_t i = next++; i < count; i = next++) {
+                std::exception_ptr e;
+                try {
+                    task(i);
+                } catch (...) {
+                    e = std::current_exception();
+                }
+                std::scoped_lock lock{mutex};
+                if (e && !error) error = e;
+                if (++finished == count) cv.notify_all();
+            }
+            inParallelRegion = previous;
+        }
+    };
+    if (count == 0) return;
+
+    auto state = std::make_shared<State>();
+    state->task = std::move(task);
+    state->count = count;
+
+    const auto helpers = std::min(concurrency() - 1, count - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        dispatchPool([state]() { state->run(); });
+    }
+    state->run();
+
+    std::unique_lock lock{state->mutex};
+    state->cv.wait(lock, [&]() { return state->finished == state->count; });
+    if (state->error) std::rethrow_exception(state->error);
+}
+
 }  // namespace inviwo
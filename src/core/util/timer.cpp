@@ -140,15 +140,13 @@ void TimerThread::TimerLoop() {
                 } else {
                     timers_.pop_back();
                 }
-                if (!cb->finished_.valid() ||
-                    cb->finished_.wait_for(std::chrono::duration<int, std::milli>(0)) ==
-                        std::future_status::ready) {
-                    cb->finished_ = dispatchFront([ctrlblk = std::weak_ptr<ControlBlock>{cb}]() {
+                // Skip the tick if the previous one has not run yet
+                InviwoApplication::getPtr()->dispatchFrontCoalesced(
+                    cb->finished_, [ctrlblk = std::weak_ptr<ControlBlock>{cb}]() {
                         if (auto cb2 = ctrlblk.lock()) {
                             cb2->callback_();
                         }
                     });
-                }
             } else {
                 timers_.pop_back();
             }
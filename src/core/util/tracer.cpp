@@ -0,0 +1,241 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <inviwo/core/util/tracer.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/exception.h>
+#include <inviwo/core/util/stringconversion.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <vector>
+
+namespace inviwo {
+
+namespace {
+
+struct Span {
+    std::int64_t begin;
+    std::int64_t end;
+    const char* category;
+    std::uint32_t name;
+};
+
+// A slot of the ring buffer, the exporter might read it while the owning thread overwrites it
+struct SpanSlot {
+    std::atomic<std::int64_t> begin;
+    std::atomic<std::int64_t> end;
+    std::atomic<const char*> category;
+    std::atomic<std::uint32_t> name;
+};
+
+struct ThreadBuffer {
+    ThreadBuffer(std::uint32_t aTid, std::string aName)
+        : spans(Tracer::bufferCapacity), tid{aTid}, name{std::move(aName)} {}
+
+    std::vector<SpanSlot> spans;
+    // Only written by the owning thread, read by the exporter
+    std::atomic<std::uint64_t> written{0};
+    // Value of written at the last clear, spans before it are not exported
+    std::uint64_t cleared = 0;  // guarded by Registry::mutex
+    const std::uint32_t tid;
+    std::string name;  // guarded by Registry::mutex
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+    std::shared_mutex namesMutex;
+    std::map<std::string, std::uint32_t, std::less<>> ids;
+    std::deque<std::string> names;
+};
+
+Registry& registry() {
+    // Leaked on purpose, thread local buffers might be flushed after static destruction
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+const auto epoch = std::chrono::steady_clock::now();
+
+thread_local std::string threadName;
+// The registry keeps the buffers alive, a plain pointer avoids the thread local init guard.
+thread_local ThreadBuffer* threadBuffer = nullptr;
+
+ThreadBuffer& localBuffer() {
+    if (!threadBuffer) {
+        auto& reg = registry();
+        std::scoped_lock lock{reg.mutex};
+        const auto tid = static_cast<std::uint32_t>(reg.buffers.size() + 1);
+        reg.buffers.push_back(std::make_shared<ThreadBuffer>(
+            tid, threadName.empty() ? "Thread " + std::to_string(tid) : threadName));
+        threadBuffer = reg.buffers.back().get();
+    }
+    return *threadBuffer;
+}
+
+}  // namespace
+
+std::atomic<bool> Tracer::enabled_{false};
+
+void Tracer::setEnabled(bool enabled) { enabled_.store(enabled); }
+
+std::uint32_t Tracer::intern(std::string_view name) {
+    auto& reg = registry();
+    {
+        std::shared_lock lock{reg.namesMutex};
+        if (auto it = reg.ids.find(name); it != reg.ids.end()) return it->second;
+    }
+    std::unique_lock lock{reg.namesMutex};
+    auto [it, inserted] =
+        reg.ids.try_emplace(std::string{name}, static_cast<std::uint32_t>(reg.names.size()));
+    if (inserted) reg.names.emplace_back(name);
+    return it->second;
+}
+
+std::int64_t Tracer::now() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - epoch)
+        .count();
+}
+
+void Tracer::record(const char* category, std::uint32_t name, std::int64_t begin,
+                    std::int64_t end) noexcept {
+    try {
+        auto& buffer = localBuffer();
+        const auto i = buffer.written.load(std::memory_order_relaxed);
+        // An exporter that reads any of the stores to the slot below also sees written == i,
+        // and can tell that the span it read was overwritten
+        std::atomic_thread_fence(std::memory_order_release);
+        auto& slot = buffer.spans[i % bufferCapacity];
+        slot.begin.store(begin, std::memory_order_relaxed);
+        slot.end.store(end, std::memory_order_relaxed);
+        slot.category.store(category, std::memory_order_relaxed);
+        slot.name.store(name, std::memory_order_relaxed);
+        buffer.written.store(i + 1, std::memory_order_release);
+    } catch (...) {  // Only allocating the buffer can throw, then we drop the span.
+    }
+}
+
+void Tracer::setThreadName(std::string_view name) {
+    threadName = name;
+    if (threadBuffer) {
+        std::scoped_lock lock{registry().mutex};
+        threadBuffer->name = name;
+    }
+}
+
+void Tracer::clear() {
+    auto& reg = registry();
+    std::scoped_lock lock{reg.mutex};
+    for (auto& buffer : reg.buffers) {
+        buffer->cleared = buffer->written.load(std::memory_order_acquire);
+    }
+}
+
+void Tracer::exportChromeTrace(std::ostream& os) {
+    auto& reg = registry();
+    std::scoped_lock lock{reg.mutex};
+    std::shared_lock namesLock{reg.namesMutex};
+
+    const auto writeTime = [&](std::int64_t ns) {
+        os << ns / 1000 << '.' << static_cast<char>('0' + (ns / 100) % 10)
+           << static_cast<char>('0' + (ns / 10) % 10) << static_cast<char>('0' + ns % 10);
+    };
+
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    const auto separator = [&]() {
+        if (!first) os << ",";
+        os << "\n";
+        first = false;
+    };
+
+    std::vector<Span> spans;
+    for (const auto& buffer : reg.buffers) {
+        separator();
+        os << R"({"ph":"M","pid":1,"tid":)" << buffer->tid
+           << R"(,"name":"thread_name","args":{"name":)";
+        util::writeJSONString(os, buffer->name);
+        os << "}}";
+
+        // Copy the spans, then drop the ones that the owning thread started to overwrite
+        const auto written = buffer->written.load(std::memory_order_acquire);
+        const auto first = std::max<std::uint64_t>(
+            buffer->cleared, written - std::min<std::uint64_t>(written, bufferCapacity));
+        spans.clear();
+        for (auto i = first; i < written; ++i) {
+            const auto& slot = buffer->spans[i % bufferCapacity];
+            spans.push_back(Span{slot.begin.load(std::memory_order_relaxed),
+                                 slot.end.load(std::memory_order_relaxed),
+                                 slot.category.load(std::memory_order_relaxed),
+                                 slot.name.load(std::memory_order_relaxed)});
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto overwritten = buffer->written.load(std::memory_order_relaxed) + 1;
+        if (overwritten > first + bufferCapacity) {
+            const auto skip = std::min<std::uint64_t>(overwritten - bufferCapacity - first,
+                                                      spans.size());
+            spans.erase(spans.begin(), spans.begin() + skip);
+        }
+
+        for (const auto& span : spans) {
+            separator();
+            os << R"({"ph":"X","pid":1,"tid":)" << buffer->tid << ",\"ts\":";
+            writeTime(span.begin);
+            os << ",\"dur\":";
+            writeTime(span.end - span.begin);
+            os << ",\"cat\":";
+            util::writeJSONString(os, span.category);
+            os << ",\"name\":";
+            util::writeJSONString(os, span.name < reg.names.size() ? std::string_view{reg.names[span.name]}
+                                                          : std::string_view{"?"});
+            os << "}";
+        }
+    }
+    os << "\n]}\n";
+}
+
+void Tracer::exportChromeTrace(const std::string& filename) {
+    auto file = filesystem::ofstream(filename);
+    if (!file) {
+        throw FileException("Could not open file \"" + filename + "\" for writing",
+                            IVW_CONTEXT_CUSTOM("Tracer"));
+    }
+    exportChromeTrace(file);
+}
+
+}  // namespace inviwo
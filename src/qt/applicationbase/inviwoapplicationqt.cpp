@@ -310,7 +310,14 @@ void InviwoApplicationQt::logQtMessages([[maybe_unused]] QtMsgType type,
 bool InviwoApplicationQt::event(QEvent* e) {
     if (e->type() == InviwoQtEvent::type()) {
         e->accept();
-        processFront();
+        // Run the queued tasks in slices such that the GUI stays responsive under a flood of
+        // tasks, the rest are run in a later event.
+        const auto budget = getSystemSettings().frontQueueBudget_.get();
+        if (budget > 0) {
+            processFrontFor(std::chrono::milliseconds{budget});
+        } else {
+            processFront();
+        }
         return true;
     } else {
         return QApplication::event(e);
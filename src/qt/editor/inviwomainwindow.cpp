@@ -1107,6 +1107,7 @@ std::optional<QString> InviwoMainWindow::askForWorkspaceToOpen() {
         openFileDialog.addSidebarPath(PathType::Workspaces);
         openFileDialog.addSidebarPath(workspaceFileDir_);
         openFileDialog.addExtension("inv", "Inviwo File");
+        openFileDialog.addExtension("invb", "Inviwo Binary File");
         openFileDialog.setFileMode(FileMode::AnyFile);
 
         if (openFileDialog.exec()) {
@@ -1172,7 +1173,7 @@ bool InviwoMainWindow::openWorkspace(QString workspaceFileName, bool isExample)
 
 void InviwoMainWindow::appendWorkspace(const std::string& file) {
     NetworkLock lock(app_->getProcessorNetwork());
-    std::ifstream fs(file);
+    std::ifstream fs(file, std::ios::in | std::ios::binary);
     if (!fs) {
         LogError("Could not open workspace file: " << file);
         return;
@@ -1223,10 +1224,11 @@ void InviwoMainWindow::saveWorkspaceAs() {
     saveFileDialog.addSidebarPath(workspaceFileDir_);
 
     saveFileDialog.addExtension("inv", "Inviwo File");
+    saveFileDialog.addExtension("invb", "Inviwo Binary File");
 
     if (saveFileDialog.exec()) {
         QString path = saveFileDialog.selectedFiles().at(0);
-        if (!path.endsWith(".inv")) path.append(".inv");
+        if (!path.endsWith(".inv") && !path.endsWith(".invb")) path.append(".inv");
 
         saveWorkspace(path);
         setCurrentWorkspace(path);
@@ -1245,11 +1247,12 @@ void InviwoMainWindow::saveWorkspaceAsCopy() {
     saveFileDialog.addSidebarPath(workspaceFileDir_);
 
     saveFileDialog.addExtension("inv", "Inviwo File");
+    saveFileDialog.addExtension("invb", "Inviwo Binary File");
 
     if (saveFileDialog.exec()) {
         QString path = saveFileDialog.selectedFiles().at(0);
 
-        if (!path.endsWith(".inv")) path.append(".inv");
+        if (!path.endsWith(".inv") && !path.endsWith(".invb")) path.append(".inv");
 
         saveWorkspace(path);
         addToRecentWorkspaces(path);
@@ -1457,7 +1460,7 @@ void InviwoMainWindow::dragMoveEvent(QDragMoveEvent* event) {
         auto filename = utilqt::fromQString(urlList.front().toLocalFile());
         auto ext = toLower(filesystem::getFileExtension(filename));
 
-        if (ext == "inv" ||
+        if (ext == "inv" || ext == "invb" ||
             !app_->getDataVisualizerManager()->getDataVisualizersForFile(filename).empty()) {
 
             if (event->keyboardModifiers() & Qt::ControlModifier) {
@@ -1488,7 +1491,9 @@ void InviwoMainWindow::dropEvent(QDropEvent* event) {
             for (auto& file : urlList) {
                 auto filename = file.toLocalFile();
 
-                if (toLower(filesystem::getFileExtension(utilqt::fromQString(filename))) == "inv") {
+                const auto ext =
+                    toLower(filesystem::getFileExtension(utilqt::fromQString(filename)));
+                if (ext == "inv" || ext == "invb") {
                     if (!first || keyModifiers & Qt::ControlModifier) {
                         appendWorkspace(utilqt::fromQString(filename));
                     } else {
@@ -31,7 +31,6 @@
 #include <inviwo/core/network/processornetwork.h>
 #include <inviwo/qt/editor/inviwomainwindow.h>
 #include <inviwo/qt/editor/undomanager.h>
-#include <inviwo/core/util/raiiutils.h>
 #include <inviwo/core/util/filesystem.h>
 #include <inviwo/qt/applicationbase/inviwoapplicationqt.h>
 
@@ -41,6 +40,7 @@
 #include <QEvent>
 #include <QApplication>
 #include <QGuiApplication>
+#include <QTimer>
 #include <warn/pop>
 
 #include <thread>
@@ -49,9 +49,14 @@
 #include <atomic>
 #include <vector>
 #include <string>
+#include <sstream>
 
 namespace inviwo {
 
+namespace {
+constexpr auto autoSaveInterval = std::chrono::seconds(30);
+}
+
 class AutoSaver {
 public:
     AutoSaver()
@@ -124,10 +129,14 @@ UndoManager::UndoManager(InviwoMainWindow* mainWindow)
     : mainWindow_(mainWindow)
     , manager_{mainWindow_->getInviwoApplication()->getWorkspaceManager()}
     , refPath_{filesystem::findBasePath()}
+    , history_{manager_, mainWindow_->getInviwoApplication()->getProcessorNetwork(), refPath_}
+    , autoSaveTimer_{std::make_unique<QTimer>()}
     , autoSaver_{std::make_unique<AutoSaver>()} {
 
+    autoSaveTimer_->setSingleShot(true);
+    QObject::connect(autoSaveTimer_.get(), &QTimer::timeout, [this]() { saveWorkspace(); });
+
     mainWindow_->getInviwoApplicationQt()->setUndoTrigger([this]() { pushStateIfDirty(); });
-    mainWindow_->getInviwoApplication()->getProcessorNetwork()->addObserver(this);
 
     undoAction_ = new QAction(QIcon(":/svgicons/undo.svg"), QAction::tr("&Undo"), mainWindow_);
     undoAction_->setShortcut(QKeySequence::Undo);
@@ -142,7 +151,7 @@ UndoManager::UndoManager(InviwoMainWindow* mainWindow)
         pushState();
     });
     loadHandle_ = manager_->onLoad([&](Deserializer&) {
-        if (isRestoring) return;
+        if (history_.isRestoring()) return;
         clear();
         pushState();
     });
@@ -154,67 +163,56 @@ UndoManager::UndoManager(InviwoMainWindow* mainWindow)
 UndoManager::~UndoManager() = default;
 
 void UndoManager::pushStateIfDirty() {
-    if (dirty_) pushState();
+    if (history_.isDirty()) pushState();
 }
-void UndoManager::markDirty() { dirty_ = true; }
+void UndoManager::markDirty() { history_.markDirty(); }
 
 void UndoManager::pushState() {
-    if (isRestoring) return;
+    if (history_.pushState()) {
+        autoSave();
+        updateActions();
+    }
+}
+
+void UndoManager::autoSave() {
+    // Full snapshots are already serialized, for deltas serialize the workspace at most every
+    // autoSaveInterval to keep small edits cheap. A delta that is not saved right away is saved
+    // when the interval has passed, together with any later deltas.
+    const auto now = std::chrono::steady_clock::now();
+    if (auto str = history_.getWorkspace()) {
+        autoSaveTimer_->stop();
+        autoSaver_->save(str);
+        lastAutoSave_ = now;
+    } else if (now - lastAutoSave_ > autoSaveInterval) {
+        saveWorkspace();
+    } else if (!autoSaveTimer_->isActive()) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            autoSaveInterval - (now - lastAutoSave_));
+        autoSaveTimer_->start(static_cast<int>(remaining.count()) + 1);
+    }
+}
 
+void UndoManager::saveWorkspace() {
+    autoSaveTimer_->stop();
+    lastAutoSave_ = std::chrono::steady_clock::now();
     std::stringstream stream;
     try {
         manager_->save(
-            stream, refPath_, [](ExceptionContext context) -> void { throw; },
-            WorkspaceSaveMode::Undo);
+            stream, refPath_, [](ExceptionContext) -> void { throw; }, WorkspaceSaveMode::Undo);
     } catch (...) {
         return;
     }
-    auto str = std::make_shared<const std::string>(std::move(stream).str());
-
-    dirty_ = false;
-    if (head_ >= 0 && *str == *undoBuffer_[head_]) return;  // No Change
-
-    ++head_;
-    auto offset = std::min(std::distance(undoBuffer_.begin(), undoBuffer_.end()), head_);
-    undoBuffer_.erase(undoBuffer_.begin() + offset, undoBuffer_.end());
-    undoBuffer_.push_back(str);
-
-    autoSaver_->save(str);
-
-    updateActions();
+    autoSaver_->save(std::make_shared<const std::string>(std::move(stream).str()));
 }
-void UndoManager::undoState() {
-    if (head_ > 0) {
-        util::KeepTrueWhileInScope restore(&isRestoring);
-        --head_;
-
-        std::stringstream stream;
-        stream << *undoBuffer_[head_];
-        manager_->load(stream, refPath_);
 
-        dirty_ = false;
-        updateActions();
-    }
+void UndoManager::undoState() {
+    if (history_.undo()) updateActions();
 }
 void UndoManager::redoState() {
-    if (head_ >= -1 && head_ < static_cast<DiffType>(undoBuffer_.size()) - 1) {
-
-        util::KeepTrueWhileInScope restore(&isRestoring);
-        ++head_;
-
-        std::stringstream stream;
-        stream << *undoBuffer_[head_];
-        manager_->load(stream, refPath_);
-
-        dirty_ = false;
-        updateActions();
-    }
+    if (history_.redo()) updateActions();
 }
 
-void UndoManager::clear() {
-    head_ = -1;
-    undoBuffer_.clear();
-}
+void UndoManager::clear() { history_.clear(); }
 
 QAction* UndoManager::getUndoAction() const { return undoAction_; }
 
@@ -238,15 +236,8 @@ void UndoManager::restore() {
 }
 
 void UndoManager::updateActions() {
-    undoAction_->setEnabled(head_ > 0);
-    redoAction_->setEnabled(head_ >= -1 && head_ < static_cast<DiffType>(undoBuffer_.size()) - 1);
+    undoAction_->setEnabled(history_.canUndo());
+    redoAction_->setEnabled(history_.canRedo());
 }
 
-void UndoManager::onProcessorNetworkChange() { dirty_ = true; }
-void UndoManager::onProcessorNetworkDidAddProcessor(Processor*) { dirty_ = true; }
-void UndoManager::onProcessorNetworkDidRemoveProcessor(Processor*) { dirty_ = true; }
-void UndoManager::onProcessorNetworkDidAddConnection(const PortConnection&) { dirty_ = true; }
-void UndoManager::onProcessorNetworkDidRemoveConnection(const PortConnection&) { dirty_ = true; }
-void UndoManager::onProcessorNetworkDidAddLink(const PropertyLink&) { dirty_ = true; }
-void UndoManager::onProcessorNetworkDidRemoveLink(const PropertyLink&) { dirty_ = true; }
 }  // namespace inviwo
@@ -0,0 +1,98 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#include <modules/opengl/inviwoopengl.h>
+#include <modules/opengl/image/layergl.h>
+#include <modules/opengl/volume/volumegl.h>
+
+#include <inviwo/core/datastructures/image/layer.h>
+#include <inviwo/core/datastructures/image/layerramprecision.h>
+#include <inviwo/core/datastructures/volume/volume.h>
+#include <inviwo/core/datastructures/volume/volumeramprecision.h>
+#include <inviwo/core/util/rendercontext.h>
+
+#include <benchmark/benchmark.h>
+
+namespace {
+
+using namespace inviwo;
+
+// Each iteration edits the source representation, which invalidates the destination, and then
+// requests the destination to trigger an update through the representation converters.
+template <typename Data, typename From, typename To>
+void convert(benchmark::State& state, Data& data, size_t bytes) {
+    RenderContext::getPtr()->activateDefaultRenderContext();
+    data.template getRepresentation<To>();
+    glFinish();
+    for (auto _ : state) {
+        data.template getEditableRepresentation<From>();
+        benchmark::DoNotOptimize(data.template getRepresentation<To>());
+        glFinish();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+Volume makeVolume(benchmark::State& state) {
+    return Volume{std::make_shared<VolumeRAMPrecision<float>>(
+        size3_t{static_cast<size_t>(state.range(0))})};
+}
+
+Layer makeLayer(benchmark::State& state) {
+    return Layer{std::make_shared<LayerRAMPrecision<vec4>>(
+        size2_t{static_cast<size_t>(state.range(0))})};
+}
+
+void VolumeRAMToGL(benchmark::State& state) {
+    auto volume = makeVolume(state);
+    convert<Volume, VolumeRAM, VolumeGL>(state, volume, glm::compMul(volume.getDimensions()) * 4);
+}
+
+void VolumeGLToRAM(benchmark::State& state) {
+    auto volume = makeVolume(state);
+    convert<Volume, VolumeGL, VolumeRAM>(state, volume, glm::compMul(volume.getDimensions()) * 4);
+}
+
+void LayerRAMToGL(benchmark::State& state) {
+    auto layer = makeLayer(state);
+    convert<Layer, LayerRAM, LayerGL>(state, layer, glm::compMul(layer.getDimensions()) * 16);
+}
+
+void LayerGLToRAM(benchmark::State& state) {
+    auto layer = makeLayer(state);
+    convert<Layer, LayerGL, LayerRAM>(state, layer, glm::compMul(layer.getDimensions()) * 16);
+}
+
+}  // namespace
+
+// Volume sizes in voxels per side of a float volume
+BENCHMARK(VolumeRAMToGL)->RangeMultiplier(2)->Range(64, 256)->Unit(benchmark::kMillisecond);
+BENCHMARK(VolumeGLToRAM)->RangeMultiplier(2)->Range(64, 256)->Unit(benchmark::kMillisecond);
+// Layer sizes in pixels per side of a vec4 layer
+BENCHMARK(LayerRAMToGL)->RangeMultiplier(2)->Range(512, 4096)->Unit(benchmark::kMillisecond);
+BENCHMARK(LayerGLToRAM)->RangeMultiplier(2)->Range(512, 4096)->Unit(benchmark::kMillisecond);
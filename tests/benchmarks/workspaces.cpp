@@ -0,0 +1,281 @@
+/*********************************************************************************
+ *
+ * Inviwo - Interactive Visualization Workshop
+ *
+ * Copyright (c) 2021 Inviwo Foundation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *********************************************************************************/
+
+#ifdef _MSC_VER
+#pragma comment(linker, "/SUBSYSTEM:CONSOLE")
+#endif
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include <modules/opengl/inviwoopengl.h>
+#include <modules/glfw/canvasglfw.h>
+
+#include <inviwo/core/common/defaulttohighperformancegpu.h>
+#include <inviwo/core/common/inviwoapplication.h>
+#include <inviwo/core/io/serialization/binaryworkspace.h>
+#include <inviwo/core/network/workspacemanager.h>
+#include <inviwo/core/network/networklock.h>
+#include <inviwo/core/network/processornetwork.h>
+#include <inviwo/core/network/processornetworkevaluator.h>
+#include <inviwo/core/processors/processor.h>
+#include <inviwo/core/properties/cameraproperty.h>
+#include <inviwo/core/util/consolelogger.h>
+#include <inviwo/core/util/filesystem.h>
+#include <inviwo/core/util/logcentral.h>
+#include <inviwo/core/util/raiiutils.h>
+#include <inviwo/core/util/rendercontext.h>
+#include <inviwo/core/moduleregistration.h>
+#include <inviwo/core/util/commandlineparser.h>
+
+#include <benchmark/benchmark.h>
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+
+#include <chrono>
+#include <thread>
+#include <sstream>
+
+using namespace inviwo;
+
+namespace {
+
+void logError(ExceptionContext ec) {
+    try {
+        throw;
+    } catch (const Exception& e) {
+        util::log(e.getContext(), e.getMessage(), LogLevel::Error);
+    } catch (const std::exception& e) {
+        util::log(ec, e.what(), LogLevel::Error);
+    }
+}
+
+bool load(InviwoApplication& app, const std::string& workspace) {
+    bool success = true;
+    app.getWorkspaceManager()->load(workspace, [&](ExceptionContext ec) {
+        success = false;
+        logError(ec);
+    });
+    return success;
+}
+
+bool load(InviwoApplication& app, std::istream& stream, const std::string& refPath) {
+    bool success = true;
+    app.getWorkspaceManager()->load(stream, refPath, [&](ExceptionContext ec) {
+        success = false;
+        logError(ec);
+    });
+    return success;
+}
+
+// Run the queued main thread tasks until all background jobs are done, and wait for the GPU
+void waitForNetwork(InviwoApplication& app) {
+    auto network = app.getProcessorNetwork();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::minutes(1);
+    while ((app.processFront() > 0 || network->runningBackgroundJobs() > 0) &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    RenderContext::getPtr()->activateDefaultRenderContext();
+    glFinish();
+}
+
+// The scripted change for the steady state: rotate every camera a small step around its up
+// axis, or invalidate all processors with inports if there are no cameras.
+void change(ProcessorNetwork& network) {
+    NetworkLock lock(&network);
+    bool changed = false;
+    network.forEachProcessor([&](Processor* p) {
+        for (auto camera : p->getPropertiesByType<CameraProperty>(true)) {
+            const auto dir = glm::rotate(camera->getLookFrom() - camera->getLookTo(),
+                                         glm::radians(1.0f), camera->getLookUp());
+            camera->setLookFrom(camera->getLookTo() + dir);
+            changed = true;
+        }
+    });
+    if (changed) return;
+    network.forEachProcessor([&](Processor* p) {
+        if (!p->getInports().empty()) p->invalidate(InvalidationLevel::InvalidOutput);
+    });
+}
+
+// Report the mean and 95th percentile of the process time of every processor as counters
+void addProcessorCounters(benchmark::State& state, const ProcessorMetrics& metrics) {
+    for (const auto& entry : metrics.getEntries()) {
+        if (entry.evaluations == 0) continue;
+        state.counters[entry.identifier + " mean ms"] = entry.meanMs();
+        state.counters[entry.identifier + " p95 ms"] = entry.p95Ms();
+    }
+}
+
+void Load(benchmark::State& state, InviwoApplication& app, const std::string& workspace) {
+    auto network = app.getProcessorNetwork();
+    network->lock();
+    for (auto _ : state) {
+        state.PauseTiming();
+        app.getWorkspaceManager()->clear();
+        state.ResumeTiming();
+        if (!load(app, workspace)) {
+            state.SkipWithError("Error loading workspace");
+            break;
+        }
+    }
+    state.counters["processors"] = static_cast<double>(network->getProcessors().size());
+    app.getWorkspaceManager()->clear();
+    network->unlock();
+}
+
+// Load the workspace converted to the binary format, from memory to leave out the disk access
+void LoadBinary(benchmark::State& state, InviwoApplication& app, const std::string& workspace) {
+    std::stringstream binary;
+    {
+        auto xml = filesystem::ifstream(workspace, std::ios::in | std::ios::binary);
+        binaryworkspace::xmlToBinary(xml, binary);
+    }
+    const auto data = binary.str();
+
+    auto network = app.getProcessorNetwork();
+    network->lock();
+    for (auto _ : state) {
+        state.PauseTiming();
+        app.getWorkspaceManager()->clear();
+        std::istringstream stream{data};
+        state.ResumeTiming();
+        if (!load(app, stream, workspace)) {
+            state.SkipWithError("Error loading workspace");
+            break;
+        }
+    }
+    state.counters["processors"] = static_cast<double>(network->getProcessors().size());
+    state.counters["bytes"] = static_cast<double>(data.size());
+    app.getWorkspaceManager()->clear();
+    network->unlock();
+}
+
+void FirstEvaluation(benchmark::State& state, InviwoApplication& app,
+                     const std::string& workspace) {
+    auto network = app.getProcessorNetwork();
+    auto& metrics = app.getProcessorNetworkEvaluator()->getMetrics();
+    metrics.reset();
+    for (auto _ : state) {
+        state.PauseTiming();
+        network->lock();
+        app.getWorkspaceManager()->clear();
+        const auto loaded = load(app, workspace);
+        state.ResumeTiming();
+        network->unlock();
+        waitForNetwork(app);
+        if (!loaded) {
+            state.SkipWithError("Error loading workspace");
+            break;
+        }
+    }
+    addProcessorCounters(state, metrics);
+    app.getWorkspaceManager()->clear();
+}
+
+void ReEvaluation(benchmark::State& state, InviwoApplication& app, const std::string& workspace) {
+    auto network = app.getProcessorNetwork();
+    auto& metrics = app.getProcessorNetworkEvaluator()->getMetrics();
+    network->lock();
+    app.getWorkspaceManager()->clear();
+    const auto loaded = load(app, workspace);
+    network->unlock();
+    waitForNetwork(app);
+    if (!loaded) state.SkipWithError("Error loading workspace");
+
+    metrics.reset();
+    for (auto _ : state) {
+        change(*network);
+        waitForNetwork(app);
+    }
+    addProcessorCounters(state, metrics);
+    app.getWorkspaceManager()->clear();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    {
+        LogCentral::init();
+        util::OnScopeExit deleteLogcentral([]() { LogCentral::deleteInstance(); });
+        // Keep the output readable, only report warnings and errors
+        LogCentral::getPtr()->setVerbosity(LogVerbosity::Warn);
+        auto consoleLogger = std::make_shared<ConsoleLogger>();
+        LogCentral::getPtr()->registerLogger(consoleLogger);
+
+        InviwoApplication inviwoApp(argc, argv, "Inviwo-Benchmarks");
+        inviwoApp.setPostEnqueueFront([]() { glfwPostEmptyEvent(); });
+        inviwoApp.registerModules(inviwo::getModuleList());
+        RenderContext::getPtr()->activateDefaultRenderContext();
+
+        auto& cmdparser = inviwoApp.getCommandLineParser();
+        cmdparser.parse(inviwo::CommandLineParser::Mode::Normal);
+        cmdparser.processCallbacks();
+
+        // Benchmark the workspace given by -w, otherwise all workspaces in data/workspaces
+        std::vector<std::string> workspaces;
+        if (cmdparser.getLoadWorkspaceFromArg()) {
+            workspaces.push_back(cmdparser.getWorkspacePath());
+        } else {
+            const auto dir = inviwoApp.getPath(PathType::Workspaces);
+            for (const auto& file : filesystem::getDirectoryContents(dir)) {
+                if (filesystem::getFileExtension(file) == "inv") {
+                    workspaces.push_back(dir + "/" + file);
+                }
+            }
+        }
+
+        for (const auto& workspace : workspaces) {
+            const auto name = filesystem::getFileNameWithoutExtension(workspace);
+            benchmark::RegisterBenchmark(("Load/" + name).c_str(), Load, std::ref(inviwoApp),
+                                         workspace)
+                ->Unit(benchmark::kMillisecond);
+            benchmark::RegisterBenchmark(("LoadBinary/" + name).c_str(), LoadBinary,
+                                         std::ref(inviwoApp), workspace)
+                ->Unit(benchmark::kMillisecond);
+            benchmark::RegisterBenchmark(("FirstEvaluation/" + name).c_str(), FirstEvaluation,
+                                         std::ref(inviwoApp), workspace)
+                ->Unit(benchmark::kMillisecond);
+            benchmark::RegisterBenchmark(("ReEvaluation/" + name).c_str(), ReEvaluation,
+                                         std::ref(inviwoApp), workspace)
+                ->Unit(benchmark::kMillisecond);
+        }
+
+        benchmark::RunSpecifiedBenchmarks();
+        inviwoApp.getWorkspaceManager()->clear();
+    }
+
+    glfwTerminate();
+    return 0;
+}